@@ -0,0 +1,270 @@
+#include "Fr3File.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "third-party/fmt/core.h"
+
+namespace tfrag3 {
+
+namespace {
+
+// compressing with worker threads only pays off for big sections.
+constexpr size_t MIN_SIZE_FOR_WORKERS = 1024 * 1024;
+
+/*!
+ * The info section: everything needed to size the vectors in the level before the other sections
+ * are loaded.
+ */
+struct LevelInfo {
+  u16 version = TFRAG3_VERSION;
+  std::string level_name;
+  size_t texture_count = 0;
+  std::array<size_t, TFRAG_GEOS> tfrag_tree_counts = {};
+  std::array<size_t, TIE_GEOS> tie_tree_counts = {};
+  size_t shrub_tree_count = 0;
+  size_t merc_model_count = 0;
+
+  void serialize(Serializer& ser) {
+    ser.from_ptr(&version);
+    if (ser.is_loading() && version != TFRAG3_VERSION) {
+      ASSERT_MSG(false, fmt::format("version mismatch when loading tfrag3 data. Got {}, expected "
+                                    "{}, did you forget to re-decompile?",
+                                    version, TFRAG3_VERSION));
+    }
+    ser.from_str(&level_name);
+    ser.from_ptr(&texture_count);
+    ser.from_ptr(&tfrag_tree_counts);
+    ser.from_ptr(&tie_tree_counts);
+    ser.from_ptr(&shrub_tree_count);
+    ser.from_ptr(&merc_model_count);
+  }
+};
+
+struct MercBuffers {
+  std::vector<MercVertex>* vertices = nullptr;
+  std::vector<u32>* indices = nullptr;
+  void serialize(Serializer& ser) {
+    ser.from_pod_vector(indices);
+    ser.from_pod_vector(vertices);
+  }
+};
+
+/*!
+ * Compresses sections one at a time, and remembers where they went.
+ */
+struct ChunkedWriter {
+  compression::ZstdSettings settings;
+  std::vector<u8> data;
+  std::vector<Fr3Section> sections;
+  size_t uncompressed_size = 0;
+
+  template <typename T>
+  void save_section(Fr3SectionKind kind, u16 geom, u32 index, const T& thing) {
+    Serializer ser;
+    // safe, saving only reads from thing.
+    const_cast<T&>(thing).serialize(ser);
+    auto [ser_data, ser_size] = ser.get_save_result();
+    uncompressed_size += ser_size;
+
+    auto section_settings = settings;
+    if (ser_size < MIN_SIZE_FOR_WORKERS) {
+      section_settings.num_workers = 0;
+    }
+    auto compressed = compression::compress_zstd(ser_data, ser_size, section_settings);
+
+    auto& section = sections.emplace_back();
+    section.kind = kind;
+    section.geom = geom;
+    section.index = index;
+    section.offset = data.size();  // relative to the data, fixed up once the header size is known
+    section.size = compressed.size();
+    data.insert(data.end(), compressed.begin(), compressed.end());
+  }
+};
+
+template <typename T>
+void load_section(const u8* data, const Fr3Section& section, T* thing) {
+  auto decompressed = compression::decompress_zstd(data + section.offset, section.size);
+  Serializer ser(decompressed.data(), decompressed.size(), Serializer::LoadMode::BORROW);
+  thing->serialize(ser);
+  ASSERT(ser.get_load_finished());
+}
+
+}  // namespace
+
+/*!
+ * Write a level as a version 2 (chunked) .fr3 file.
+ */
+std::vector<u8> write_fr3_chunked(const Level& level,
+                                  const compression::ZstdSettings& settings,
+                                  size_t* uncompressed_size) {
+  ChunkedWriter writer;
+  writer.settings = settings;
+
+  LevelInfo info;
+  info.level_name = level.level_name;
+  info.texture_count = level.textures.size();
+  for (int geom = 0; geom < TFRAG_GEOS; geom++) {
+    info.tfrag_tree_counts[geom] = level.tfrag_trees[geom].size();
+  }
+  for (int geom = 0; geom < TIE_GEOS; geom++) {
+    info.tie_tree_counts[geom] = level.tie_trees[geom].size();
+  }
+  info.shrub_tree_count = level.shrub_trees.size();
+  info.merc_model_count = level.merc_data.models.size();
+  writer.save_section(Fr3SectionKind::INFO, 0, 0, info);
+
+  for (size_t i = 0; i < level.textures.size(); i++) {
+    writer.save_section(Fr3SectionKind::TEXTURE, 0, i, level.textures[i]);
+  }
+  for (int geom = 0; geom < TFRAG_GEOS; geom++) {
+    for (size_t i = 0; i < level.tfrag_trees[geom].size(); i++) {
+      writer.save_section(Fr3SectionKind::TFRAG_TREE, geom, i, level.tfrag_trees[geom][i]);
+    }
+  }
+  for (int geom = 0; geom < TIE_GEOS; geom++) {
+    for (size_t i = 0; i < level.tie_trees[geom].size(); i++) {
+      writer.save_section(Fr3SectionKind::TIE_TREE, geom, i, level.tie_trees[geom][i]);
+    }
+  }
+  for (size_t i = 0; i < level.shrub_trees.size(); i++) {
+    writer.save_section(Fr3SectionKind::SHRUB_TREE, 0, i, level.shrub_trees[i]);
+  }
+  writer.save_section(Fr3SectionKind::COLLISION, 0, 0, level.collision);
+
+  // safe, saving only reads.
+  auto& merc = const_cast<MercModelGroup&>(level.merc_data);
+  MercBuffers merc_buffers{&merc.vertices, &merc.indices};
+  writer.save_section(Fr3SectionKind::MERC_BUFFERS, 0, 0, merc_buffers);
+  for (size_t i = 0; i < level.merc_data.models.size(); i++) {
+    writer.save_section(Fr3SectionKind::MERC_MODEL, 0, i, level.merc_data.models[i]);
+  }
+
+  if (uncompressed_size) {
+    *uncompressed_size = writer.uncompressed_size;
+  }
+
+  // header, table, then all the sections.
+  auto& sections = writer.sections;
+  u32 section_count = sections.size();
+  size_t header_size = sizeof(u64) + sizeof(u32) * 2 + sizeof(Fr3Section) * section_count;
+  for (auto& section : sections) {
+    section.offset += header_size;
+  }
+
+  std::vector<u8> result(header_size);
+  u8* ptr = result.data();
+  memcpy(ptr, &FR3_CHUNKED_MAGIC, sizeof(u64));
+  ptr += sizeof(u64);
+  memcpy(ptr, &FR3_CONTAINER_VERSION, sizeof(u32));
+  ptr += sizeof(u32);
+  memcpy(ptr, &section_count, sizeof(u32));
+  ptr += sizeof(u32);
+  memcpy(ptr, sections.data(), sizeof(Fr3Section) * section_count);
+  result.insert(result.end(), writer.data.begin(), writer.data.end());
+  return result;
+}
+
+Fr3Reader::Fr3Reader(const u8* data, size_t size) : m_data(data), m_size(size) {
+  u64 magic = 0;
+  if (size >= sizeof(u64)) {
+    memcpy(&magic, data, sizeof(u64));
+  }
+  m_chunked = magic == FR3_CHUNKED_MAGIC;
+  if (!m_chunked) {
+    return;
+  }
+
+  size_t header_size = sizeof(u64) + sizeof(u32) * 2;
+  ASSERT(size >= header_size);
+  u32 container_version, section_count;
+  memcpy(&container_version, data + sizeof(u64), sizeof(u32));
+  memcpy(&section_count, data + sizeof(u64) + sizeof(u32), sizeof(u32));
+  ASSERT_MSG(container_version == FR3_CONTAINER_VERSION,
+             fmt::format("fr3 container version mismatch. Got {}, expected {}", container_version,
+                         FR3_CONTAINER_VERSION));
+
+  ASSERT(size >= header_size + sizeof(Fr3Section) * section_count);
+  m_sections.resize(section_count);
+  memcpy(m_sections.data(), data + header_size, sizeof(Fr3Section) * section_count);
+  for (auto& section : m_sections) {
+    ASSERT(section.offset + section.size <= size);
+  }
+  ASSERT(!m_sections.empty() && m_sections.front().kind == Fr3SectionKind::INFO);
+}
+
+void Fr3Reader::read_all(Level* level) const {
+  if (!m_chunked) {
+    auto decompressed = compression::decompress_zstd(m_data, m_size);
+    Serializer ser(decompressed.data(), decompressed.size(), Serializer::LoadMode::BORROW);
+    level->serialize(ser);
+    return;
+  }
+
+  read_info(level);
+  for (auto& section : m_sections) {
+    if (section.kind != Fr3SectionKind::INFO) {
+      read_section(section, level);
+    }
+  }
+}
+
+void Fr3Reader::read_info(Level* level) const {
+  ASSERT(m_chunked);
+  LevelInfo info;
+  load_section(m_data, m_sections.front(), &info);
+  level->version = info.version;
+  level->version2 = info.version;
+  level->level_name = info.level_name;
+  level->textures.resize(info.texture_count);
+  for (int geom = 0; geom < TFRAG_GEOS; geom++) {
+    level->tfrag_trees[geom].resize(info.tfrag_tree_counts[geom]);
+  }
+  for (int geom = 0; geom < TIE_GEOS; geom++) {
+    level->tie_trees[geom].resize(info.tie_tree_counts[geom]);
+  }
+  level->shrub_trees.resize(info.shrub_tree_count);
+  level->merc_data.models.resize(info.merc_model_count);
+}
+
+void Fr3Reader::read_section(const Fr3Section& section, Level* level) const {
+  switch (section.kind) {
+    case Fr3SectionKind::TEXTURE:
+      load_section(m_data, section, &level->textures.at(section.index));
+      break;
+    case Fr3SectionKind::TFRAG_TREE:
+      load_section(m_data, section, &level->tfrag_trees.at(section.geom).at(section.index));
+      break;
+    case Fr3SectionKind::TIE_TREE:
+      load_section(m_data, section, &level->tie_trees.at(section.geom).at(section.index));
+      break;
+    case Fr3SectionKind::SHRUB_TREE:
+      load_section(m_data, section, &level->shrub_trees.at(section.index));
+      break;
+    case Fr3SectionKind::COLLISION:
+      load_section(m_data, section, &level->collision);
+      break;
+    case Fr3SectionKind::MERC_BUFFERS: {
+      MercBuffers buffers{&level->merc_data.vertices, &level->merc_data.indices};
+      load_section(m_data, section, &buffers);
+    } break;
+    case Fr3SectionKind::MERC_MODEL:
+      load_section(m_data, section, &level->merc_data.models.at(section.index));
+      break;
+    default:
+      ASSERT_MSG(false, fmt::format("unknown fr3 section kind {}", (int)section.kind));
+  }
+}
+
+std::vector<Fr3Section> Fr3Reader::data_sections() const {
+  std::vector<Fr3Section> result;
+  for (auto& section : m_sections) {
+    if (section.kind != Fr3SectionKind::INFO) {
+      result.push_back(section);
+    }
+  }
+  return result;
+}
+
+}  // namespace tfrag3
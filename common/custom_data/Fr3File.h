@@ -0,0 +1,108 @@
+#pragma once
+
+/*!
+ * @file Fr3File.h
+ * The .fr3 file container.
+ *
+ * Version 1 files are a single compressed Level::serialize. To use anything in them, the whole
+ * level must be decompressed and deserialized.
+ *
+ * Version 2 files are split into sections: a small "info" section with the level name and the
+ * number of each kind of thing, then one independently compressed section per texture, tree and
+ * merc model. A section table at the start of the file gives the location of each one, so a
+ * loader can decompress sections in parallel, in whatever order it likes, or skip them entirely.
+ *
+ * Layout of a version 2 file:
+ *   u64 magic (FR3_CHUNKED_MAGIC)
+ *   u32 container version
+ *   u32 section count
+ *   Fr3Section[section count]
+ *   section data, each section is in the format of compression::compress_zstd.
+ *
+ * A version 1 file starts with the decompressed size (u64), which can't collide with the magic.
+ */
+
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/custom_data/Tfrag3Data.h"
+#include "common/util/compress.h"
+
+namespace tfrag3 {
+
+constexpr u64 FR3_CHUNKED_MAGIC = 0x4b4e484333524645;  // "EFR3CHNK"
+constexpr u32 FR3_CONTAINER_VERSION = 2;
+
+enum class Fr3SectionKind : u16 {
+  INFO = 0,          // level name and counts, needed before any other section is read
+  TEXTURE = 1,       // textures[index]
+  TFRAG_TREE = 2,    // tfrag_trees[geom][index]
+  TIE_TREE = 3,      // tie_trees[geom][index]
+  SHRUB_TREE = 4,    // shrub_trees[index]
+  COLLISION = 5,     // collision
+  MERC_BUFFERS = 6,  // merc_data.vertices and merc_data.indices
+  MERC_MODEL = 7,    // merc_data.models[index]
+};
+
+struct Fr3Section {
+  Fr3SectionKind kind = Fr3SectionKind::INFO;
+  u16 geom = 0;
+  u32 index = 0;
+  u64 offset = 0;  // from the start of the file
+  u64 size = 0;    // compressed size
+
+  bool is_tree() const {
+    return kind == Fr3SectionKind::TFRAG_TREE || kind == Fr3SectionKind::TIE_TREE ||
+           kind == Fr3SectionKind::SHRUB_TREE;
+  }
+};
+static_assert(sizeof(Fr3Section) == 24);
+
+/*!
+ * Write a level as a version 2 file. If uncompressed_size is set, it gets the total size of the
+ * sections before compression.
+ */
+std::vector<u8> write_fr3_chunked(const Level& level,
+                                  const compression::ZstdSettings& settings = {},
+                                  size_t* uncompressed_size = nullptr);
+
+/*!
+ * Reads either version of .fr3 file. The file data is not copied, and must stay alive as long as
+ * the reader is used.
+ */
+class Fr3Reader {
+ public:
+  Fr3Reader(const u8* data, size_t size);
+
+  bool is_chunked() const { return m_chunked; }
+
+  /*!
+   * Read the entire level, from either version.
+   */
+  void read_all(Level* level) const;
+
+  /*!
+   * Read the info section of a chunked file. This sizes the vectors in the level, so it must be
+   * done before reading any other section.
+   */
+  void read_info(Level* level) const;
+
+  /*!
+   * Read a single section of a chunked file into the level. Different sections never write to the
+   * same part of the level, so sections may be read from multiple threads at once.
+   */
+  void read_section(const Fr3Section& section, Level* level) const;
+
+  /*!
+   * All sections except for info, in file order.
+   */
+  std::vector<Fr3Section> data_sections() const;
+
+ private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+  bool m_chunked = false;
+  std::vector<Fr3Section> m_sections;
+};
+
+}  // namespace tfrag3
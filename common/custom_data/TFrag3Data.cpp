@@ -29,9 +29,45 @@ void StripDraw::serialize(Serializer& ser) {
   ser.from_pod_vector(&runs);
   ser.from_pod_vector(&plain_indices);
   ser.from_pod_vector(&vis_groups);
+  ser.from_pod_vector(&vis_group_starts);
   ser.from_ptr(&num_triangles);
 }
 
+void StripDraw::sort_by_vis_group() {
+  ASSERT(runs.size() == vis_groups.size());
+  ASSERT(plain_indices.empty());
+  std::vector<u32> order(vis_groups.size());
+  for (u32 i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+    return vis_groups[a].vis_idx_in_pc_bvh < vis_groups[b].vis_idx_in_pc_bvh;
+  });
+
+  std::vector<VertexRun> sorted_runs;
+  std::vector<VisGroup> sorted_groups;
+  sorted_runs.reserve(order.size());
+  sorted_groups.reserve(order.size());
+  for (auto i : order) {
+    sorted_runs.push_back(runs[i]);
+    sorted_groups.push_back(vis_groups[i]);
+  }
+  std::swap(runs, sorted_runs);
+  std::swap(vis_groups, sorted_groups);
+}
+
+void StripDraw::compute_vis_group_starts() {
+  vis_group_starts.clear();
+  VisGroupStart start;
+  for (size_t i = 0; i < vis_groups.size(); i++) {
+    ASSERT(i == 0 || vis_groups[i - 1].vis_idx_in_pc_bvh <= vis_groups[i].vis_idx_in_pc_bvh);
+    vis_group_starts.push_back(start);
+    start.first_ind += vis_groups[i].num_inds;
+    start.first_tri += vis_groups[i].num_tris;
+  }
+  vis_group_starts.push_back(start);
+}
+
 void ShrubDraw::serialize(Serializer& ser) {
   ser.from_ptr(&mode);
   ser.from_ptr(&tree_tex_id);
@@ -653,6 +689,8 @@ void TieTree::memory_usage(MemoryUsageTracker* tracker) const {
     tracker->add(MemoryUsageCategory::TIE_DEINST_INDEX, draw.plain_indices.size() * sizeof(u32));
     tracker->add(MemoryUsageCategory::TIE_DEINST_VIS,
                  draw.vis_groups.size() * sizeof(StripDraw::VisGroup));
+    tracker->add(MemoryUsageCategory::TIE_DEINST_VIS,
+                 draw.vis_group_starts.size() * sizeof(StripDraw::VisGroupStart));
   }
   packed_vertices.memory_usage(tracker);
   tracker->add(MemoryUsageCategory::TIE_TIME_OF_DAY, sizeof(TimeOfDayColor) * colors.size());
@@ -677,6 +715,8 @@ void TfragTree::memory_usage(MemoryUsageTracker* tracker) const {
     tracker->add(MemoryUsageCategory::TFRAG_INDEX, draw.plain_indices.size() * sizeof(u32));
     tracker->add(MemoryUsageCategory::TFRAG_VIS,
                  draw.vis_groups.size() * sizeof(StripDraw::VisGroup));
+    tracker->add(MemoryUsageCategory::TFRAG_VIS,
+                 draw.vis_group_starts.size() * sizeof(StripDraw::VisGroupStart));
   }
   packed_vertices.memory_usage(tracker);
   tracker->add(MemoryUsageCategory::TFRAG_TIME_OF_DAY, sizeof(TimeOfDayColor) * colors.size());
@@ -18,7 +18,7 @@ namespace tfrag3 {
 // - if changing any large things (vertices, vis, bvh, colors, textures) update get_memory_usage
 // - if adding a new category to the memory usage, update extract_level to print it.
 
-constexpr int TFRAG3_VERSION = 37;
+constexpr int TFRAG3_VERSION = 38;
 
 enum MemoryUsageCategory {
   TEXTURE,
@@ -203,9 +203,25 @@ struct StripDraw {
   };
   std::vector<VisGroup> vis_groups;
 
+  // The extractor sorts the vis groups by vis_idx_in_pc_bvh (always visible groups last), so the
+  // groups for a range of vis nodes are next to each other. This has the offset of the first index
+  // and triangle of each group, relative to the start of this draw, plus one more entry for the
+  // end. Empty for draws that weren't sorted.
+  struct VisGroupStart {
+    u32 first_ind = 0;
+    u32 first_tri = 0;
+  };
+  std::vector<VisGroupStart> vis_group_starts;
+
   // for debug counting.
   u32 num_triangles = 0;
   void serialize(Serializer& ser);
+
+  // Sort runs and vis_groups by vis_idx_in_pc_bvh, keeping the order within each vis node. There
+  // must be one run per vis group, and no plain indices.
+  void sort_by_vis_group();
+  // Fill out vis_group_starts. The vis_groups must be sorted.
+  void compute_vis_group_starts();
 };
 
 struct ShrubDraw {
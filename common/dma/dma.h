@@ -15,6 +15,12 @@
 
 struct DmaStats {
   double sync_time_ms = 0;
+  // time the game thread spent sending the chain, and waiting for the renderer in sync_path.
+  double send_chain_ms = 0;
+  double sync_path_wait_ms = 0;
+  // time from send_chain until the frame was on the screen, and the chains sent but not shown yet.
+  double frame_latency_ms = 0;
+  int frames_in_flight = 0;
   int num_tags = 0;
   int num_data_bytes = 0;
   int num_chunks = 0;
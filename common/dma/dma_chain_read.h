@@ -125,6 +125,11 @@ class DmaFollower {
   u32 current_tag_offset() const { return m_tag_offset; }
   bool ended() const { return m_ended; }
 
+  /*!
+   * Get a new follower for the same memory, starting at the given tag.
+   */
+  DmaFollower follower_at(u32 tag_offset) const { return DmaFollower(m_base, tag_offset); }
+
  private:
   const void* m_base = nullptr;
   u32 m_tag_offset = 0;
@@ -33,7 +33,11 @@
 #include <Windows.h>
 #else
 #include <cstring>
+#include <fcntl.h>
 #include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
 #endif
 #include "common/log/log.h"
 #include "common/util/Assert.h"
@@ -653,4 +657,88 @@ std::string make_screenshot_filepath(const GameVersion game_version, const std::
   return file_path;
 }
 
+#ifdef _WIN32
+MappedFile::MappedFile(const fs::path& path) {
+  m_file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                       OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (m_file == INVALID_HANDLE_VALUE) {
+    m_file = nullptr;
+    throw std::runtime_error(fmt::format("File {} cannot be opened.", path.string()));
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(m_file, &size)) {
+    CloseHandle(m_file);
+    throw std::runtime_error(fmt::format("File {} cannot be opened: bad size.", path.string()));
+  }
+  m_size = size.QuadPart;
+  if (m_size == 0) {
+    // can't map an empty file.
+    return;
+  }
+
+  m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (m_mapping) {
+    m_data = (const u8*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+  }
+  if (!m_data) {
+    if (m_mapping) {
+      CloseHandle(m_mapping);
+    }
+    CloseHandle(m_file);
+    throw std::runtime_error(fmt::format("File {} cannot be mapped.", path.string()));
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping) {
+    CloseHandle(m_mapping);
+  }
+  if (m_file) {
+    CloseHandle(m_file);
+  }
+}
+#else
+MappedFile::MappedFile(const fs::path& path) {
+  int fd = open(path.string().c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(fmt::format("File {} cannot be opened: {}", path.string(),
+                                         std::string(strerror(errno))));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    throw std::runtime_error(
+        fmt::format("File {} cannot be opened: not a regular file.", path.string()));
+  }
+  m_size = st.st_size;
+  if (m_size == 0) {
+    // can't map an empty file.
+    close(fd);
+    return;
+  }
+
+  void* mem = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after the file is closed.
+  close(fd);
+  if (mem == MAP_FAILED) {
+    throw std::runtime_error(fmt::format("File {} cannot be mapped: {}", path.string(),
+                                         std::string(strerror(errno))));
+  }
+  // we read these front to back, so let the OS start reading ahead now.
+  madvise(mem, m_size, MADV_SEQUENTIAL);
+  madvise(mem, m_size, MADV_WILLNEED);
+  m_data = (const u8*)mem;
+}
+
+MappedFile::~MappedFile() {
+  if (m_data) {
+    munmap(const_cast<u8*>(m_data), m_size);
+  }
+}
+#endif
 }  // namespace file_util
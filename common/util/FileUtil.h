@@ -67,4 +67,28 @@ std::vector<fs::path> find_directories_in_dir(const fs::path& base_dir);
 /// Will overwrite the destination if it exists
 void copy_file(const fs::path& src, const fs::path& dst);
 std::string make_screenshot_filepath(const GameVersion game_version, const std::string& name = "");
+
+/*!
+ * A read-only, memory-mapped file. This avoids copying the whole file into a buffer when it is
+ * only going to be read once, like a compressed file that is decompressed right away.
+ * The data is valid until the MappedFile is destroyed.
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const fs::path& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const u8* data() const { return m_data; }
+  size_t size() const { return m_size; }
+
+ private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void* m_file = nullptr;
+  void* m_mapping = nullptr;
+#endif
+};
 }  // namespace file_util
@@ -4,7 +4,7 @@
 
 #include "common/common_types.h"
 
-double FrameLimiter::round_to_nearest_60fps(double current) {
+double FrameLimiter::round_to_nearest_60fps(double current) const {
   double one_frame = 1.f / 60.f;
   int frames_missed = (current / one_frame);  // rounds down
   if (frames_missed > 4) {
@@ -13,6 +13,16 @@ double FrameLimiter::round_to_nearest_60fps(double current) {
   return (frames_missed + 1) * one_frame;
 }
 
+double FrameLimiter::target_seconds(double target_fps,
+                                    bool experimental_accurate_lag,
+                                    double engine_time) const {
+  if (experimental_accurate_lag) {
+    return round_to_nearest_60fps(engine_time);
+  } else {
+    return 1.f / target_fps;
+  }
+}
+
 #ifdef OS_POSIX
 
 FrameLimiter::FrameLimiter() {}
@@ -23,20 +33,15 @@ void FrameLimiter::run(double target_fps,
                        bool experimental_accurate_lag,
                        bool do_sleeps,
                        double engine_time) {
-  double target_seconds;
-  if (experimental_accurate_lag) {
-    target_seconds = round_to_nearest_60fps(engine_time);
-  } else {
-    target_seconds = 1.f / target_fps;
-  }
-  double remaining_time = target_seconds - m_timer.getSeconds();
+  double target = target_seconds(target_fps, experimental_accurate_lag, engine_time);
+  double remaining_time = target - m_timer.getSeconds();
 
   if (do_sleeps && remaining_time > 0.001) {
     std::this_thread::sleep_for(std::chrono::microseconds(int((remaining_time - 0.001) * 1e6)));
   }
 
   while (remaining_time > 0) {
-    remaining_time = target_seconds - m_timer.getSeconds();
+    remaining_time = target - m_timer.getSeconds();
   }
 
   m_timer.start();
@@ -59,20 +64,15 @@ void FrameLimiter::run(double target_fps,
                        bool experimental_accurate_lag,
                        bool do_sleeps,
                        double engine_time) {
-  double target_seconds;
-  if (experimental_accurate_lag) {
-    target_seconds = round_to_nearest_60fps(engine_time);
-  } else {
-    target_seconds = 1.f / target_fps;
-  }
-  double remaining_time = target_seconds - m_timer.getSeconds();
+  double target = target_seconds(target_fps, experimental_accurate_lag, engine_time);
+  double remaining_time = target - m_timer.getSeconds();
 
   if (do_sleeps && remaining_time > 0.001) {
     Sleep((remaining_time * 1000) - 1);
   }
 
   while (remaining_time > 0) {
-    remaining_time = target_seconds - m_timer.getSeconds();
+    remaining_time = target - m_timer.getSeconds();
   }
 
   m_timer.start();
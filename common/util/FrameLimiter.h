@@ -9,8 +9,15 @@ class FrameLimiter {
 
   void run(double target_fps, bool experimental_accurate_lag, bool do_sleeps, double engine_time);
 
+  /*!
+   * How long a frame should take, in seconds, with these settings.
+   */
+  double target_seconds(double target_fps,
+                        bool experimental_accurate_lag,
+                        double engine_time) const;
+
  private:
-  double round_to_nearest_60fps(double current);
+  double round_to_nearest_60fps(double current) const;
 
   Timer m_timer;
 };
\ No newline at end of file
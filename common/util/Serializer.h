@@ -32,6 +32,14 @@
  */
 class Serializer {
  public:
+  /*!
+   * How a loading serializer gets its data.
+   * COPY makes a copy of the input, so the input can be freed right away.
+   * BORROW reads directly from the input, which must stay alive (and unchanged) for as long as the
+   * Serializer is used. Use this for big buffers that exist only to be loaded from.
+   */
+  enum class LoadMode { COPY, BORROW };
+
   /*!
    * Construct a serializer in writing mode. This saves data from the program into a buffer that can
    * later be accessed with get_save_result.
@@ -44,12 +52,18 @@ class Serializer {
 
   /*!
    * Construct a serializer that reads from the given data.
-   * The data is copied to an internal buffer managed by the serializer, there is no need to keep
-   * the input data around.
+   * By default, the data is copied to an internal buffer managed by the serializer, there is no
+   * need to keep the input data around. See LoadMode for avoiding the copy.
    */
-  Serializer(const u8* data, size_t size) : m_size(size), m_writing(false) {
-    m_data = (u8*)malloc(size);
-    memcpy(m_data, data, size);
+  Serializer(const u8* data, size_t size, LoadMode mode = LoadMode::COPY)
+      : m_size(size), m_writing(false), m_owns_data(mode == LoadMode::COPY) {
+    if (m_owns_data) {
+      m_data = (u8*)malloc(size);
+      memcpy(m_data, data, size);
+    } else {
+      // safe, we're loading, so we only read from m_data.
+      m_data = const_cast<u8*>(data);
+    }
   }
 
   // don't allow copying, assigning, or move constructing.
@@ -63,10 +77,15 @@ class Serializer {
       return *this;
     }
 
+    if (m_owns_data) {
+      free(m_data);
+    }
+
     m_data = other.m_data;
     m_size = other.m_size;
     m_offset = other.m_offset;
     m_writing = other.m_writing;
+    m_owns_data = other.m_owns_data;
 
     other.m_data = nullptr;
     other.m_size = 0;
@@ -74,7 +93,11 @@ class Serializer {
     return *this;
   }
 
-  ~Serializer() { free(m_data); }
+  ~Serializer() {
+    if (m_owns_data) {
+      free(m_data);
+    }
+  }
 
   /*!
    * Save or load the thing pointed to by ptr.
@@ -230,4 +253,5 @@ class Serializer {
   size_t m_size = 0;
   size_t m_offset = 0;
   bool m_writing = false;
+  bool m_owns_data = true;
 };
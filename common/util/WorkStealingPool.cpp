@@ -0,0 +1,166 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+#include "common/util/Assert.h"
+
+namespace {
+// the pool and queue index of the worker running on this thread, if any.
+thread_local const WorkStealingPool* t_pool = nullptr;
+thread_local int t_worker_idx = -1;
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(int num_threads) {
+  num_threads = std::max(1, num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    m_queues.push_back(std::make_unique<WorkerQueue>());
+  }
+  for (int i = 0; i < num_threads; i++) {
+    m_threads.emplace_back([this, i]() { worker_loop(i); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_done = true;
+  }
+  m_cv.notify_all();
+  for (auto& t : m_threads) {
+    t.join();
+  }
+}
+
+int WorkStealingPool::current_worker() const {
+  return t_pool == this ? t_worker_idx : -1;
+}
+
+void WorkStealingPool::push(Task&& task) {
+  int idx = current_worker();
+  if (idx < 0) {
+    // not from a worker, spread tasks over the queues.
+    idx = m_next_queue.fetch_add(1) % (int)m_queues.size();
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(m_queues[idx]->mutex);
+    m_queues[idx]->tasks.push_back(std::move(task));
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_queued++;
+  }
+  m_cv.notify_all();
+}
+
+/*!
+ * Run a single task: the newest one in our own queue if there is one, otherwise the oldest from
+ * someone else's. If only_group is set, only run tasks from that group. Returns false if there was
+ * nothing to run.
+ */
+bool WorkStealingPool::try_run_one(const TaskGroup* only_group) {
+  Task task;
+  bool found = false;
+  int num_queues = m_queues.size();
+  int self = current_worker();
+  auto matches = [&](const Task& t) { return !only_group || t.group == only_group; };
+
+  if (self >= 0) {
+    auto& q = *m_queues[self];
+    std::unique_lock<std::mutex> lk(q.mutex);
+    auto it = std::find_if(q.tasks.rbegin(), q.tasks.rend(), matches);
+    if (it != q.tasks.rend()) {
+      task = std::move(*it);
+      q.tasks.erase(std::next(it).base());
+      found = true;
+    }
+  }
+
+  int start = self >= 0 ? self + 1 : 0;
+  for (int i = 0; i < num_queues && !found; i++) {
+    auto& q = *m_queues[(start + i) % num_queues];
+    std::unique_lock<std::mutex> lk(q.mutex);
+    auto it = std::find_if(q.tasks.begin(), q.tasks.end(), matches);
+    if (it != q.tasks.end()) {
+      task = std::move(*it);
+      q.tasks.erase(it);
+      found = true;
+    }
+  }
+
+  if (!found) {
+    return false;
+  }
+
+  m_queued--;
+  task.group->m_queued--;
+  std::exception_ptr error;
+  try {
+    task.func();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  task.group->finish_one(error);
+  return true;
+}
+
+void WorkStealingPool::worker_loop(int idx) {
+  t_pool = this;
+  t_worker_idx = idx;
+  for (;;) {
+    if (try_run_one()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_cv.wait(lk, [&]() { return m_done || m_queued > 0; });
+    if (m_done && m_queued <= 0) {
+      return;
+    }
+  }
+}
+
+TaskGroup::~TaskGroup() {
+  ASSERT_MSG(m_pending == 0, "TaskGroup destroyed without waiting for its tasks");
+}
+
+void TaskGroup::run(std::function<void()> func) {
+  m_pending++;
+  m_queued++;
+  m_pool.push({std::move(func), this});
+}
+
+void TaskGroup::finish_one(std::exception_ptr error) {
+  if (error) {
+    std::unique_lock<std::mutex> lk(m_error_mutex);
+    if (!m_error) {
+      m_error = error;
+    }
+  }
+
+  // once m_pending hits zero, wait() may return and this group may be destroyed.
+  auto& pool = m_pool;
+  if (--m_pending == 0) {
+    // lock, so a thread in wait() can't check m_pending and then miss this notification.
+    std::unique_lock<std::mutex> lk(pool.m_mutex);
+    pool.m_cv.notify_all();
+  }
+}
+
+void TaskGroup::wait() {
+  while (m_pending > 0) {
+    // help out with our own tasks. The rest are already running on other threads.
+    if (m_pool.try_run_one(this)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lk(m_pool.m_mutex);
+    m_pool.m_cv.wait(lk, [&]() { return m_pending == 0 || m_queued > 0; });
+  }
+
+  std::unique_lock<std::mutex> lk(m_error_mutex);
+  if (m_error) {
+    auto error = m_error;
+    m_error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
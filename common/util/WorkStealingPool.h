@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskGroup;
+
+/*!
+ * A pool of threads for running tasks of very different sizes.
+ * Each worker has its own queue of tasks. A worker runs the newest task from its own queue, and
+ * when it runs out, it steals the oldest task from another queue. Tasks added from inside a task
+ * go on the current worker's queue, so a task that splits itself into smaller tasks keeps its
+ * data on one thread until someone else is idle.
+ *
+ * Tasks are added and waited on with a TaskGroup (below). Waiting runs the group's own queued
+ * tasks instead of blocking, so a task can wait on a group of its own sub-tasks without
+ * deadlocking the pool. It never runs tasks from other groups, which could be much bigger than
+ * what is being waited on and would nest on the waiting thread's stack.
+ */
+class WorkStealingPool {
+ public:
+  explicit WorkStealingPool(int num_threads = std::thread::hardware_concurrency());
+  ~WorkStealingPool();
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  int num_threads() const { return (int)m_threads.size(); }
+
+ private:
+  friend class TaskGroup;
+
+  struct Task {
+    std::function<void()> func;
+    TaskGroup* group = nullptr;
+  };
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void push(Task&& task);
+  bool try_run_one(const TaskGroup* only_group = nullptr);
+  void worker_loop(int idx);
+  int current_worker() const;
+
+  std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+  std::vector<std::thread> m_threads;
+  std::atomic<int> m_next_queue = 0;
+
+  // protects sleeping and waking. Anybody waiting for work or for a group to finish sleeps on
+  // m_cv.
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::atomic<int> m_queued = 0;
+  bool m_done = false;
+};
+
+/*!
+ * A set of tasks that can be waited on together.
+ * You must call wait() before the group is destroyed. If a task throws, the first exception is
+ * rethrown from wait(), after all tasks in the group have finished.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(WorkStealingPool& pool) : m_pool(pool) {}
+  ~TaskGroup();
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void run(std::function<void()> func);
+  void wait();
+
+ private:
+  friend class WorkStealingPool;
+  void finish_one(std::exception_ptr error);
+
+  WorkStealingPool& m_pool;
+  std::atomic<int> m_pending = 0;
+  std::atomic<int> m_queued = 0;  // pending tasks that haven't started yet
+  std::mutex m_error_mutex;
+  std::exception_ptr m_error;
+};
@@ -1,7 +1,9 @@
 #include "compress.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <thread>
 
 #include "common/util/Assert.h"
 
@@ -26,6 +28,89 @@ std::vector<u8> compress_zstd(const void* data, size_t size) {
   return result;
 }
 
+ZstdSettings ZstdSettings::fast() {
+  ZstdSettings settings;
+  settings.level = 1;
+  settings.num_workers = std::max(1, (int)std::thread::hardware_concurrency());
+  return settings;
+}
+
+ZstdSettings ZstdSettings::release() {
+  ZstdSettings settings;
+  settings.level = 19;
+  settings.num_workers = std::max(1, (int)std::thread::hardware_concurrency());
+  settings.long_distance_matching = true;
+  return settings;
+}
+
+/*!
+ * Compress data with zstd, using the given settings. Same format as the version above.
+ */
+std::vector<u8> compress_zstd(const void* data, size_t size, const ZstdSettings& settings) {
+  ZstdCompressor compressor(settings);
+  compressor.add(data, size);
+  return compressor.finish();
+}
+
+namespace {
+void check_zstd_error(size_t result) {
+  if (ZSTD_isError(result)) {
+    ASSERT_MSG(false, fmt::format("ZSTD error: {}", ZSTD_getErrorName(result)));
+  }
+}
+}  // namespace
+
+ZstdCompressor::ZstdCompressor(const ZstdSettings& settings) {
+  m_ctx = ZSTD_createCCtx();
+  ASSERT(m_ctx);
+  check_zstd_error(ZSTD_CCtx_setParameter(m_ctx, ZSTD_c_compressionLevel, settings.level));
+  check_zstd_error(ZSTD_CCtx_setParameter(m_ctx, ZSTD_c_enableLongDistanceMatching,
+                                          settings.long_distance_matching ? 1 : 0));
+  // this fails if zstd was built without multithreading support. Just compress on this thread.
+  ZSTD_CCtx_setParameter(m_ctx, ZSTD_c_nbWorkers, settings.num_workers);
+
+  // space for the size header, filled in by finish()
+  m_result.resize(sizeof(size_t));
+}
+
+ZstdCompressor::~ZstdCompressor() {
+  ZSTD_freeCCtx(m_ctx);
+}
+
+void ZstdCompressor::add(const void* data, size_t size) {
+  m_input_size += size;
+  run(data, size, false);
+}
+
+std::vector<u8> ZstdCompressor::finish() {
+  run(nullptr, 0, true);
+  memcpy(m_result.data(), &m_input_size, sizeof(size_t));
+  auto result = std::move(m_result);
+  // zstd starts a new frame with the same context on the next add.
+  m_result.assign(sizeof(size_t), 0);
+  m_input_size = 0;
+  return result;
+}
+
+void ZstdCompressor::run(const void* data, size_t size, bool end) {
+  ZSTD_inBuffer input = {data, size, 0};
+  const size_t chunk_size = ZSTD_CStreamOutSize();
+  for (;;) {
+    size_t old_size = m_result.size();
+    m_result.resize(old_size + chunk_size);
+    ZSTD_outBuffer output = {m_result.data() + old_size, chunk_size, 0};
+    size_t remaining =
+        ZSTD_compressStream2(m_ctx, &output, &input, end ? ZSTD_e_end : ZSTD_e_continue);
+    check_zstd_error(remaining);
+    m_result.resize(old_size + output.pos);
+    // when ending, zstd returns the amount of data it still needs to flush.
+    // otherwise, it's done when it has taken all of the input.
+    if (end ? remaining == 0 : input.pos == input.size) {
+      break;
+    }
+  }
+}
+
 /*!
  * Decompress data with zstd.  The first 8-bytes of the data should be a header containing the
  * decompressed data's size.
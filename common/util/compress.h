@@ -4,8 +4,54 @@
 #include <vector>
 
 #include "common/common_types.h"
+
+struct ZSTD_CCtx_s;
+
 namespace compression {
+/*!
+ * Settings for zstd compression.
+ */
+struct ZstdSettings {
+  int level = 1;
+  // number of threads compressing in the background. 0 compresses on the calling thread.
+  int num_workers = 0;
+  // look for matches much further back than normal. Helps on large files with repeated data.
+  bool long_distance_matching = false;
+
+  // these both use a worker per core. Set num_workers to 0 when several files are already being
+  // compressed at once.
+
+  // quick to compress, for development.
+  static ZstdSettings fast();
+  // much slower, but smaller, for files that will be shipped.
+  static ZstdSettings release();
+};
+
 // compress and decompress data with zstd
 std::vector<u8> compress_zstd(const void* data, size_t size);
+std::vector<u8> compress_zstd(const void* data, size_t size, const ZstdSettings& settings);
 std::vector<u8> decompress_zstd(const void* data, size_t size);
-}  // namespace compression
\ No newline at end of file
+
+/*!
+ * Compress data that is added in pieces. The result of finish() is the same format as
+ * compress_zstd, and can be decompressed with decompress_zstd. After finish(), the compressor can
+ * be used again, which saves setting up a new zstd context each time.
+ */
+class ZstdCompressor {
+ public:
+  explicit ZstdCompressor(const ZstdSettings& settings);
+  ~ZstdCompressor();
+  ZstdCompressor(const ZstdCompressor&) = delete;
+  ZstdCompressor& operator=(const ZstdCompressor&) = delete;
+
+  void add(const void* data, size_t size);
+  std::vector<u8> finish();
+
+ private:
+  void run(const void* data, size_t size, bool end);
+
+  ZSTD_CCtx_s* m_ctx = nullptr;
+  std::vector<u8> m_result;
+  size_t m_input_size = 0;
+};
+}  // namespace compression
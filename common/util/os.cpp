@@ -19,8 +19,11 @@ size_t get_peak_rss() {
 #endif
 
 #ifdef _WIN32
-// windows has a __cpuid
+// windows has a __cpuid and _xgetbv
 #include <intrin.h>
+u64 read_xcr0() {
+  return _xgetbv(0);
+}
 #elif __APPLE__
 // for now, just return 0's.
 void __cpuidex(int result[4], int eax, int ecx) {
@@ -28,6 +31,9 @@ void __cpuidex(int result[4], int eax, int ecx) {
     result[i] = 0;
   }
 }
+u64 read_xcr0() {
+  return 0;
+}
 #else
 // using int to be compatible with msvc's intrinsic
 void __cpuidex(int result[4], int eax, int ecx) {
@@ -35,6 +41,12 @@ void __cpuidex(int result[4], int eax, int ecx) {
       : "=a"(result[0]), "=b"(result[1]), "=c"(result[2]), "=d"(result[3])
       : "0"(eax), "2"(ecx));
 }
+// the register that says which register state the OS saves. Only valid if cpuid says OSXSAVE.
+u64 read_xcr0() {
+  u32 eax, edx;
+  asm("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((u64)edx << 32) | eax;
+}
 #endif
 
 CpuInfo gCpuInfo;
@@ -67,17 +79,28 @@ void setup_cpu_info() {
     }
   }
 
-  // check for AVX2
+  // the CPU supporting an extension isn't enough, the OS also has to save the registers it adds.
+  bool os_saves_ymm = false;
+  bool os_saves_zmm = false;
   {
     int result[4];
-    __cpuidex(result, 7, 0);
-    gCpuInfo.has_avx2 = result[1] & (1 << 5);
+    __cpuidex(result, 1, 0);
+    bool osxsave = result[2] & (1 << 27);
+    if (osxsave) {
+      u64 xcr0 = read_xcr0();
+      os_saves_ymm = (xcr0 & 0b110) == 0b110;  // SSE and AVX state
+      // and opmask, upper half of zmm0-15, zmm16-31
+      os_saves_zmm = os_saves_ymm && (xcr0 & 0b11100000) == 0b11100000;
+    }
+    gCpuInfo.has_avx = (result[2] & (1 << 28)) && os_saves_ymm;
   }
 
+  // check for AVX2 and AVX-512
   {
     int result[4];
-    __cpuidex(result, 1, 0);
-    gCpuInfo.has_avx = result[2] & (1 << 28);
+    __cpuidex(result, 7, 0);
+    gCpuInfo.has_avx2 = (result[1] & (1 << 5)) && os_saves_ymm;
+    gCpuInfo.has_avx512 = (result[1] & (1 << 16)) && (result[1] & (1 << 30)) && os_saves_zmm;
   }
 
   printf("-------- CPU Information --------\n");
@@ -85,6 +108,7 @@ void setup_cpu_info() {
   printf(" Model: %s\n", gCpuInfo.model.c_str());
   printf(" AVX  : %s\n", gCpuInfo.has_avx ? "true" : "false");
   printf(" AVX2 : %s\n", gCpuInfo.has_avx2 ? "true" : "false");
+  printf(" AVX512: %s\n", gCpuInfo.has_avx512 ? "true" : "false");
   fflush(stdout);
 
   gCpuInfo.initialized = true;
@@ -7,13 +7,27 @@
 size_t get_peak_rss();
 void setup_cpu_info();
 
+// These are only set if both the CPU and the OS support them (the OS must save the larger
+// registers on context switches).
 struct CpuInfo {
   bool initialized = false;
   bool has_avx = false;
   bool has_avx2 = false;
+  bool has_avx512 = false;  // AVX-512 F and BW
 
   std::string brand;
   std::string model;
 };
 
 CpuInfo& get_cpu_info();
+
+// Build a single function with AVX2 or AVX-512 instructions, while the rest of the program is built
+// for plain AVX. These functions must only be called if get_cpu_info() says they are supported.
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512BW __attribute__((target("avx2,avx512f,avx512bw")))
+#else
+// MSVC allows these instructions in any function.
+#define TARGET_AVX2
+#define TARGET_AVX512BW
+#endif
@@ -53,7 +53,8 @@ InstructionParser::InstructionParser() {
                  InstructionKind::VSUB,   InstructionKind::LQC2,   InstructionKind::SQC2,
                  InstructionKind::MULAS,  InstructionKind::MADDAS, InstructionKind::QMTC2,
                  InstructionKind::QMFC2,  InstructionKind::VITOF0, InstructionKind::VFTOI0,
-                 InstructionKind::PSLLW,  InstructionKind::PSRAW}) {
+                 InstructionKind::PSLLW,  InstructionKind::PSRAW,  InstructionKind::VADD,
+                 InstructionKind::VMUL}) {
     auto& info = gOpcodeInfo[int(i)];
     if (info.defined) {
       m_opcode_name_lookup[info.name] = int(i);
@@ -61,7 +62,7 @@ InstructionParser::InstructionParser() {
     }
   }
 
-  for (auto i : {InstructionKind::VMUL_BC}) {
+  for (auto i : {InstructionKind::VMUL_BC, InstructionKind::VADD_BC}) {
     auto& info = gOpcodeInfo[int(i)];
     if (info.defined) {
       m_opcode_name_broadcast_lookup[info.name] = int(i);
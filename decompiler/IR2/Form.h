@@ -2074,6 +2074,9 @@ class FormPool {
     m_vtx_to_form_cache[vtx] = form;
   }
 
+  size_t form_count() const { return m_forms.size(); }
+  size_t element_count() const { return m_elements.size(); }
+
   ~FormPool();
 
  private:
@@ -79,8 +79,8 @@ static uint32_t c_symlink2(LinkedObjectFile& f,
                            SymbolLinkKind kind,
                            const char* name,
                            int seg_id,
-                           DecompilerTypeSystem& dts) {
-  dts.add_symbol(name);
+                           LinkTypeUpdates& type_updates) {
+  type_updates.add_symbol(name);
   auto initial_offset = code_ptr_offset;
   do {
     auto table_value = data.at(link_ptr_offset);
@@ -129,7 +129,7 @@ static uint32_t c_symlink2(LinkedObjectFile& f,
           // hack for jak 2: this symbol is used as a type in village 1 and also the oracle level
           // level info. We'll just leave it out, as we don't really need these definitions.
           if (std::string(name) != "oracle") {
-            dts.add_symbol(name, "type", {});
+            type_updates.add_type_symbol(name);
           }
           word_kind = LinkedWord::TYPE_PTR;
           break;
@@ -163,8 +163,8 @@ static uint32_t c_symlink3(LinkedObjectFile& f,
                            SymbolLinkKind kind,
                            const char* name,
                            int seg,
-                           DecompilerTypeSystem& dts) {
-  dts.add_symbol(name);
+                           LinkTypeUpdates& type_updates) {
+  type_updates.add_symbol(name);
   auto initial_offset = code_ptr;
   do {
     // seek, with a variable length encoding that sucks.
@@ -188,7 +188,7 @@ static uint32_t c_symlink3(LinkedObjectFile& f,
           word_kind = LinkedWord::EMPTY_PTR;
           break;
         case SymbolLinkKind::TYPE:
-          dts.add_symbol(name, "type", {});
+          type_updates.add_type_symbol(name);
           word_kind = LinkedWord::TYPE_PTR;
           break;
         default:
@@ -229,7 +229,7 @@ static uint32_t c_symlink3(LinkedObjectFile& f,
 static void link_v2_or_v4(LinkedObjectFile& f,
                           const std::vector<uint8_t>& data,
                           const std::string& name,
-                          DecompilerTypeSystem& dts,
+                          LinkTypeUpdates& type_updates,
                           GameVersion version) {
   (void)name;
   const auto* header = (const LinkHeaderV4*)&data.at(0);
@@ -391,7 +391,8 @@ static void link_v2_or_v4(LinkedObjectFile& f,
 
       link_ptr_offset += strlen(s_name) + 1;
       f.stats.total_v2_symbol_count++;
-      link_ptr_offset = c_symlink2(f, data, code_offset, link_ptr_offset, kind, s_name, 0, dts);
+      link_ptr_offset =
+          c_symlink2(f, data, code_offset, link_ptr_offset, kind, s_name, 0, type_updates);
       if (data.at(link_ptr_offset) == 0)
         break;
     }
@@ -419,7 +420,7 @@ static void assert_string_empty_after(const char* str, int size) {
 static void link_v5(LinkedObjectFile& f,
                     const std::vector<uint8_t>& data,
                     const std::string& name,
-                    DecompilerTypeSystem& dts) {
+                    LinkTypeUpdates& type_updates) {
   auto header = (const LinkHeaderV5*)(&data.at(0));
   if (header->n_segments == 1) {
     printf("abandon %s!\n", name.c_str());
@@ -574,10 +575,10 @@ static void link_v5(LinkedObjectFile& f,
 
           if (std::string("_empty_") == sname) {
             link_ptr = c_symlink2(f, data, segment_data_offsets[seg_id], link_ptr,
-                                  SymbolLinkKind::EMPTY_LIST, sname, seg_id, dts);
+                                  SymbolLinkKind::EMPTY_LIST, sname, seg_id, type_updates);
           } else {
             link_ptr = c_symlink2(f, data, segment_data_offsets[seg_id], link_ptr,
-                                  SymbolLinkKind::SYMBOL, sname, seg_id, dts);
+                                  SymbolLinkKind::SYMBOL, sname, seg_id, type_updates);
           }
         } else if ((reloc & 0x3f) == 0x3f) {
           ASSERT(false);  // todo, does this ever get hit?
@@ -593,7 +594,7 @@ static void link_v5(LinkedObjectFile& f,
           const char* sname = (const char*)(&data.at(link_ptr));
           link_ptr += strlen(sname) + 1;
           link_ptr = c_symlink2(f, data, segment_data_offsets[seg_id], link_ptr,
-                                SymbolLinkKind::TYPE, sname, seg_id, dts);
+                                SymbolLinkKind::TYPE, sname, seg_id, type_updates);
         }
 
         sub_link_ptr = link_ptr;
@@ -624,7 +625,7 @@ static void link_v5(LinkedObjectFile& f,
 static void link_v3(LinkedObjectFile& f,
                     const std::vector<uint8_t>& data,
                     const std::string& name,
-                    DecompilerTypeSystem& dts,
+                    LinkTypeUpdates& type_updates,
                     GameVersion game_version) {
   auto header = (const LinkHeaderV3*)(&data.at(0));
   ASSERT(name == header->name);
@@ -771,10 +772,11 @@ static void link_v3(LinkedObjectFile& f,
         s_name = (const char*)(&data.at(link_ptr));
         switch (game_version) {
           case GameVersion::Jak1:
-            dts.ts.forward_declare_type_method_count(s_name, (reloc & 0x7f));
+            type_updates.forward_declare_type_method_count(s_name, (reloc & 0x7f));
             break;
           case GameVersion::Jak2:
-            dts.ts.forward_declare_type_method_count_multiple_of_4(s_name, (reloc & 0x7f) * 4 + 3);
+            type_updates.forward_declare_type_method_count_multiple_of_4(s_name,
+                                                                         (reloc & 0x7f) * 4 + 3);
             break;
           default:
             ASSERT(false);
@@ -789,7 +791,7 @@ static void link_v3(LinkedObjectFile& f,
 
       link_ptr += strlen(s_name) + 1;
       f.stats.v3_symbol_count++;
-      link_ptr = c_symlink3(f, data, base_ptr, link_ptr, kind, s_name, seg_id, dts);
+      link_ptr = c_symlink3(f, data, base_ptr, link_ptr, kind, s_name, seg_id, type_updates);
     }
     segment_link_ends[seg_id] = link_ptr;
   }
@@ -816,7 +818,7 @@ static void link_v3(LinkedObjectFile& f,
  */
 LinkedObjectFile to_linked_object_file(const std::vector<uint8_t>& data,
                                        const std::string& name,
-                                       DecompilerTypeSystem& dts,
+                                       LinkTypeUpdates& type_updates,
                                        GameVersion game_version) {
   LinkedObjectFile result(game_version);
   const auto* header = (const LinkHeaderCommon*)&data.at(0);
@@ -824,16 +826,67 @@ LinkedObjectFile to_linked_object_file(const std::vector<uint8_t>& data,
   // use appropriate linker
   if (header->version == 3) {
     ASSERT(header->type_tag == 0);
-    link_v3(result, data, name, dts, game_version);
+    link_v3(result, data, name, type_updates, game_version);
   } else if (header->version == 4 || header->version == 2) {
     ASSERT(header->type_tag == 0xffffffff);
-    link_v2_or_v4(result, data, name, dts, game_version);
+    link_v2_or_v4(result, data, name, type_updates, game_version);
   } else if (header->version == 5) {
-    link_v5(result, data, name, dts);
+    link_v5(result, data, name, type_updates);
   } else {
     ASSERT_MSG(false, fmt::format("Unsupported version {}", header->version));
   }
 
   return result;
 }
+
+LinkedObjectFile to_linked_object_file(const std::vector<uint8_t>& data,
+                                       const std::string& name,
+                                       DecompilerTypeSystem& dts,
+                                       GameVersion game_version) {
+  LinkTypeUpdates type_updates;
+  auto result = to_linked_object_file(data, name, type_updates, game_version);
+  type_updates.apply(dts);
+  return result;
+}
+
+void LinkTypeUpdates::add_symbol(const std::string& name) {
+  m_updates.push_back({Kind::SYMBOL, name});
+}
+
+void LinkTypeUpdates::add_type_symbol(const std::string& name) {
+  m_updates.push_back({Kind::TYPE_SYMBOL, name});
+}
+
+void LinkTypeUpdates::forward_declare_type_method_count(const std::string& name, int num_methods) {
+  m_updates.push_back({Kind::METHOD_COUNT, name, num_methods});
+}
+
+void LinkTypeUpdates::forward_declare_type_method_count_multiple_of_4(const std::string& name,
+                                                                      int num_methods) {
+  m_updates.push_back({Kind::METHOD_COUNT_MULTIPLE_OF_4, name, num_methods});
+}
+
+/*!
+ * Apply the recorded changes, in the order the linker found them.
+ */
+void LinkTypeUpdates::apply(DecompilerTypeSystem& dts) const {
+  for (const auto& update : m_updates) {
+    switch (update.kind) {
+      case Kind::SYMBOL:
+        dts.add_symbol(update.name);
+        break;
+      case Kind::TYPE_SYMBOL:
+        dts.add_symbol(update.name, "type", {});
+        break;
+      case Kind::METHOD_COUNT:
+        dts.ts.forward_declare_type_method_count(update.name, update.num_methods);
+        break;
+      case Kind::METHOD_COUNT_MULTIPLE_OF_4:
+        dts.ts.forward_declare_type_method_count_multiple_of_4(update.name, update.num_methods);
+        break;
+      default:
+        ASSERT(false);
+    }
+  }
+}
 }  // namespace decompiler
@@ -10,6 +10,35 @@
 
 namespace decompiler {
 class DecompilerTypeSystem;
+
+/*!
+ * Changes to the type system that are discovered while linking an object file.
+ * Linking only records these, so multiple object files can be linked in parallel without touching
+ * the shared DecompilerTypeSystem. Applying them in object file order gives the same result as
+ * linking serially.
+ */
+class LinkTypeUpdates {
+ public:
+  void add_symbol(const std::string& name);
+  void add_type_symbol(const std::string& name);
+  void forward_declare_type_method_count(const std::string& name, int num_methods);
+  void forward_declare_type_method_count_multiple_of_4(const std::string& name, int num_methods);
+  void apply(DecompilerTypeSystem& dts) const;
+
+ private:
+  enum class Kind { SYMBOL, TYPE_SYMBOL, METHOD_COUNT, METHOD_COUNT_MULTIPLE_OF_4 };
+  struct Update {
+    Kind kind;
+    std::string name;
+    int num_methods = 0;
+  };
+  std::vector<Update> m_updates;
+};
+
+LinkedObjectFile to_linked_object_file(const std::vector<uint8_t>& data,
+                                       const std::string& name,
+                                       LinkTypeUpdates& type_updates,
+                                       GameVersion game_version);
 LinkedObjectFile to_linked_object_file(const std::vector<uint8_t>& data,
                                        const std::string& name,
                                        DecompilerTypeSystem& dts,
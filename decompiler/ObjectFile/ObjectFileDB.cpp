@@ -33,6 +33,7 @@
 #include "decompiler/data/game_text.h"
 #include "decompiler/data/tpage.h"
 
+#include "third-party/BS_thread_pool.hpp"
 #include "third-party/xdelta3/xdelta3.h"
 
 namespace decompiler {
@@ -533,23 +534,80 @@ std::string ObjectFileDB::generate_obj_listing(const std::unordered_set<std::str
   return result + "]";
 }
 
+ObjectFileDB::~ObjectFileDB() = default;
+
+/*!
+ * Get the thread pool shared by the per-object passes. It is created on first use.
+ */
+BS::thread_pool& ObjectFileDB::thread_pool() {
+  if (!m_thread_pool) {
+    m_thread_pool = std::make_unique<BS::thread_pool>();
+  }
+  return *m_thread_pool;
+}
+
+/*!
+ * Apply f to all ObjectFileData's, in parallel. The objects are split into contiguous blocks and
+ * f is called as f(obj, result), where result is local to the block. This lets f accumulate stats
+ * without locking. The per-block results are returned in object order, so merging them in order
+ * gives the same result as a serial for_each_obj.
+ */
+template <typename Result, typename Func>
+std::vector<Result> ObjectFileDB::for_each_obj_parallel(Func f) {
+  std::vector<ObjectFileData*> objs;
+  for_each_obj([&](ObjectFileData& obj) { objs.push_back(&obj); });
+  if (objs.empty()) {
+    return {};
+  }
+
+  auto& pool = thread_pool();
+  // use more blocks than threads, so a few huge objects don't leave the other threads idle.
+  return pool
+      .parallelize_loop(
+          objs.size(),
+          [&](size_t start, size_t end) {
+            Result result{};
+            for (size_t i = start; i < end; i++) {
+              f(*objs[i], result);
+            }
+            return result;
+          },
+          pool.get_thread_count() * 8)
+      .get();
+}
+
 /*!
  * Process all of the linking data of all objects.
+ * The linking is done in parallel, then the type system changes are applied in order.
  */
 void ObjectFileDB::process_link_data(const Config& config) {
   lg::info("Processing Link Data...");
   Timer process_link_timer;
 
-  LinkedObjectFile::Stats combined_stats;
+  struct LinkBlockResult {
+    LinkedObjectFile::Stats stats;
+    LinkTypeUpdates type_updates;
+  };
 
-  for_each_obj([&](ObjectFileData& obj) {
-    obj.linked_data = to_linked_object_file(obj.data, obj.record.name, dts, config.game_version);
-    combined_stats.add(obj.linked_data.stats);
-  });
+  auto results = for_each_obj_parallel<LinkBlockResult>(
+      [&](ObjectFileData& obj, LinkBlockResult& result) {
+        obj.linked_data = to_linked_object_file(obj.data, obj.record.name, result.type_updates,
+                                                config.game_version);
+        result.stats.add(obj.linked_data.stats);
+      });
+  float link_ms = process_link_timer.getMs();
+
+  Timer type_timer;
+  LinkedObjectFile::Stats combined_stats;
+  for (const auto& result : results) {
+    result.type_updates.apply(dts);
+    combined_stats.add(result.stats);
+  }
 
   lg::info("Processed Link Data");
+  lg::info(" Link {:.2f} ms ({} threads)", link_ms, thread_pool().get_thread_count());
+  lg::info(" Types {:.2f} ms", type_timer.getMs());
   lg::info(" Total {:.2f} ms", process_link_timer.getMs());
-  // printf("\n");
 }
 
 /*!
@@ -559,7 +617,12 @@ void ObjectFileDB::process_labels() {
   lg::info("Processing Labels...");
   Timer process_label_timer;
   uint32_t total = 0;
-  for_each_obj([&](ObjectFileData& obj) { total += obj.linked_data.set_ordered_label_names(); });
+  auto results = for_each_obj_parallel<uint32_t>([&](ObjectFileData& obj, uint32_t& count) {
+    count += obj.linked_data.set_ordered_label_names();
+  });
+  for (auto count : results) {
+    total += count;
+  }
 
   lg::info("Processed Labels:");
   lg::info(" Total {} labels", total);
@@ -639,25 +702,29 @@ void ObjectFileDB::find_code(const Config& config) {
   LinkedObjectFile::Stats combined_stats;
   Timer timer;
 
-  for_each_obj([&](ObjectFileData& obj) {
-    //      printf("fc %s\n", obj.record.to_unique_name().c_str());
-    obj.linked_data.find_code();
-    obj.linked_data.find_functions(config.game_version);
-    obj.linked_data.disassemble_functions();
+  auto results = for_each_obj_parallel<LinkedObjectFile::Stats>(
+      [&](ObjectFileData& obj, LinkedObjectFile::Stats& block_stats) {
+        obj.linked_data.find_code();
+        obj.linked_data.find_functions(config.game_version);
+        obj.linked_data.disassemble_functions();
 
-    if (config.game_version == GameVersion::Jak1 || obj.to_unique_name() != "effect-control-v0") {
-      obj.linked_data.process_fp_relative_links();
-    } else {
-      lg::warn("Skipping process_fp_relative_links in {}", obj.to_unique_name().c_str());
-    }
+        if (config.game_version == GameVersion::Jak1 ||
+            obj.to_unique_name() != "effect-control-v0") {
+          obj.linked_data.process_fp_relative_links();
+        } else {
+          lg::warn("Skipping process_fp_relative_links in {}", obj.to_unique_name().c_str());
+        }
 
-    auto& obj_stats = obj.linked_data.stats;
-    if (obj_stats.code_bytes / 4 > obj_stats.decoded_ops) {
-      lg::warn("Failed to decode all in {} ({} / {})", obj.to_unique_name().c_str(),
-               obj_stats.decoded_ops, obj_stats.code_bytes / 4);
-    }
-    combined_stats.add(obj.linked_data.stats);
-  });
+        auto& obj_stats = obj.linked_data.stats;
+        if (obj_stats.code_bytes / 4 > obj_stats.decoded_ops) {
+          lg::warn("Failed to decode all in {} ({} / {})", obj.to_unique_name().c_str(),
+                   obj_stats.decoded_ops, obj_stats.code_bytes / 4);
+        }
+        block_stats.add(obj.linked_data.stats);
+      });
+  for (const auto& block_stats : results) {
+    combined_stats.add(block_stats);
+  }
 
   lg::info("Found code:");
   lg::info(" Code {:.3f} MB", combined_stats.code_bytes / (float)(1 << 20));
@@ -7,6 +7,7 @@
  * (there may be different object files with the same name sometimes)
  */
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -20,9 +21,14 @@
 #include "decompiler/analysis/symbol_def_map.h"
 #include "decompiler/data/TextureDB.h"
 #include "decompiler/util/DecompilerTypeSystem.h"
+#include "decompiler/util/PassProfiler.h"
 
 #include "third-party/fmt/core.h"
 
+namespace BS {
+class thread_pool;
+}
+
 namespace decompiler {
 /*!
  * A "record" which can be used to identify an object file.
@@ -164,6 +170,7 @@ class ObjectFileDB {
                const std::vector<fs::path>& object_files,
                const std::vector<fs::path>& str_files,
                const Config& config);
+  ~ObjectFileDB();
   std::string generate_dgo_listing();
   std::string generate_obj_listing(const std::unordered_set<std::string>& merged_objs);
   void process_link_data(const Config& config);
@@ -365,6 +372,21 @@ class ObjectFileDB {
     }
   }
 
+  /*!
+   * Like for_each_function_in_seg_in_obj, but each call is timed as the given pass, if the
+   * pass profiler is enabled.
+   */
+  template <typename Func>
+  void for_each_function_in_seg_in_obj_profiled(const char* pass,
+                                                int seg,
+                                                ObjectFileData& data,
+                                                Func f) {
+    for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+      auto pass_timer = pass_profiler.scoped(pass, func);
+      f(func);
+    });
+  }
+
   // Danger: after adding all object files, we assume that the vector never reallocates.
   std::unordered_map<std::string, std::vector<ObjectFileData>> obj_files_by_name;
   std::unordered_map<std::string, std::vector<ObjectFileRecord>> obj_files_by_dgo;
@@ -373,6 +395,7 @@ class ObjectFileDB {
   std::unordered_map<std::string, std::unordered_map<std::string, std::string>> dgo_obj_name_map;
 
   SymbolMapBuilder map_builder;
+  PassProfiler pass_profiler;
 
   struct {
     LetRewriteStats let;
@@ -385,7 +408,12 @@ class ObjectFileDB {
   GameVersion version() const { return m_version; }
 
  private:
+  template <typename Result, typename Func>
+  std::vector<Result> for_each_obj_parallel(Func f);
+  BS::thread_pool& thread_pool();
+
   GameVersion m_version;
+  std::unique_ptr<BS::thread_pool> m_thread_pool;
 };
 
 std::string print_art_elt_for_dump(const std::string& group_name, const std::string& name, int idx);
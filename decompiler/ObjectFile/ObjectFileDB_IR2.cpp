@@ -40,6 +40,7 @@ void ObjectFileDB::process_object_file_data(
     const std::unordered_set<std::string>& skip_functions,
     const std::unordered_map<std::string, std::unordered_set<std::string>>& skip_states) {
   Timer file_timer;
+  pass_profiler.set_current_object(data.to_unique_name());
   ir2_do_segment_analysis_phase1(TOP_LEVEL_SEGMENT, config, data);
   ir2_do_segment_analysis_phase1(DEBUG_SEGMENT, config, data);
   ir2_do_segment_analysis_phase1(MAIN_SEGMENT, config, data);
@@ -97,6 +98,11 @@ void ObjectFileDB::process_object_file_data(
     data.full_output = ir2_final_out(data, imports, {});
   }
 
+  if (pass_profiler.enabled()) {
+    for_each_function_def_order_in_obj(data,
+                                       [&](Function& f, int) { pass_profiler.record_ir_sizes(f); });
+  }
+
   if (!config.generate_all_types) {
     // this frees ir2 memory, but means future passes can't look back on this function.
     for_each_function_def_order_in_obj(data, [&](Function& f, int) { f.ir2 = {}; });
@@ -134,6 +140,7 @@ void ObjectFileDB::analyze_functions_ir2(
     total_file_count += f.second.size();
   }
   int file_idx = 1;
+  pass_profiler.set_enabled(config.profile_ir2_passes, config.profile_ir2_chrome_trace);
   for_each_obj([&](ObjectFileData& data) {
     if (prefile_callback) {
       prefile_callback.value()(data.to_unique_name());
@@ -147,6 +154,10 @@ void ObjectFileDB::analyze_functions_ir2(
 
   lg::info("{}", stats.let.print());
 
+  if (!output_dir.empty()) {
+    pass_profiler.write_reports(output_dir / "profile");
+  }
+
   if (config.generate_symbol_definition_map) {
     lg::info("Generating symbol definition map...");
     map_builder.build_map();
@@ -198,9 +209,10 @@ void ObjectFileDB::ir2_setup_labels(const Config& config, ObjectFileData& data)
 
 void ObjectFileDB::ir2_run_mips2c(const Config& config, ObjectFileData& data) {
   for_each_function_def_order_in_obj(data, [&](Function& func, int) {
+    auto pass_timer = pass_profiler.scoped("mips2c", func);
     if (config.hacks.mips2c_functions_by_name.count(func.name())) {
       lg::info("MIPS2C on {}", func.name());
-      run_mips2c(&func, config.game_version);
+      run_mips2c(&func, config.game_version, config.mips2c_remove_dead_vf_lanes);
     }
 
     auto it = config.hacks.mips2c_jump_table_functions.find(func.name());
@@ -395,7 +407,7 @@ void ObjectFileDB::ir2_analyze_all_types(const fs::path& output_file,
  * - Build control flow graph
  */
 void ObjectFileDB::ir2_basic_block_pass(int seg, const Config& config, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("basic_blocks", seg, data, [&](Function& func) {
     func.ir2.env.file = &data.linked_data;
     func.ir2.env.dts = &dts;
     func.ir2.env.func = &func;
@@ -446,7 +458,7 @@ void ObjectFileDB::ir2_basic_block_pass(int seg, const Config& config, ObjectFil
 }
 
 void ObjectFileDB::ir2_stack_spill_slot_pass(int seg, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("stack_spill", seg, data, [&](Function& func) {
     if (!func.cfg_ok) {
       return;
     }
@@ -464,7 +476,7 @@ void ObjectFileDB::ir2_stack_spill_slot_pass(int seg, ObjectFileData& data) {
  * think are IR of the original GOAL compiler.
  */
 void ObjectFileDB::ir2_atomic_op_pass(int seg, const Config& config, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("atomic_ops", seg, data, [&](Function& func) {
     if (!func.cfg_ok) {
       return;
     }
@@ -519,7 +531,7 @@ Value try_lookup(const std::unordered_map<Key, Value>& map, const Key& key) {
  */
 void ObjectFileDB::ir2_type_analysis_pass(int seg, const Config& config, ObjectFileData& data) {
   auto obj_name = data.to_unique_name();
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("type_analysis", seg, data, [&](Function& func) {
     if (!func.suspected_asm) {
       TypeSpec ts;
       if (lookup_function_type(func.guessed_name, data.to_unique_name(), config, &ts) &&
@@ -566,6 +578,7 @@ void ObjectFileDB::ir2_type_analysis_pass(int seg, const Config& config, ObjectF
           in.dts = &dts;
           try {
             types2::run(out, in);
+            pass_profiler.record_types2(func, out.iterations, out.blocks_run);
             func.ir2.env.set_types(out.block_init_types, out.op_end_types, *func.ir2.atomic_ops,
                                    ts);
           } catch (const std::exception& e) {
@@ -589,7 +602,7 @@ void ObjectFileDB::ir2_type_analysis_pass(int seg, const Config& config, ObjectF
 }
 
 void ObjectFileDB::ir2_register_usage_pass(int seg, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("register_usage", seg, data, [&](Function& func) {
     if (!func.suspected_asm && func.ir2.atomic_ops_succeeded) {
       func.ir2.env.set_reg_use(analyze_ir2_register_usage(func));
 
@@ -639,7 +652,7 @@ void ObjectFileDB::ir2_register_usage_pass(int seg, ObjectFileData& data) {
 }
 
 void ObjectFileDB::ir2_variable_pass(int seg, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("variables", seg, data, [&](Function& func) {
     (void)data;
     if (!func.suspected_asm && func.ir2.atomic_ops_succeeded && func.ir2.env.has_type_analysis()) {
       try {
@@ -656,15 +669,9 @@ void ObjectFileDB::ir2_variable_pass(int seg, ObjectFileData& data) {
 }
 
 void ObjectFileDB::ir2_cfg_build_pass(int seg, ObjectFileData& data) {
-  Timer timer;
-  int total = 0;
-  int attempted = 0;
-  int successful = 0;
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("cfg_build", seg, data, [&](Function& func) {
     (void)data;
-    total++;
     if (!func.suspected_asm && func.ir2.atomic_ops_succeeded && func.cfg->is_fully_resolved()) {
-      attempted++;
       try {
         build_initial_forms(func);
       } catch (std::exception& e) {
@@ -672,15 +679,11 @@ void ObjectFileDB::ir2_cfg_build_pass(int seg, ObjectFileData& data) {
         func.ir2.top_form = nullptr;
       }
     }
-
-    if (func.ir2.top_form) {
-      successful++;
-    }
   });
 }
 
 void ObjectFileDB::ir2_build_expressions(int seg, const Config& config, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("build_expressions", seg, data, [&](Function& func) {
     (void)data;
     if (func.ir2.top_form && func.ir2.env.has_type_analysis() && func.ir2.env.has_local_vars() &&
         func.ir2.env.types_succeeded) {
@@ -703,7 +706,7 @@ void ObjectFileDB::ir2_build_expressions(int seg, const Config& config, ObjectFi
 }
 
 void ObjectFileDB::ir2_insert_lets(int seg, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("insert_lets", seg, data, [&](Function& func) {
     if (func.ir2.expressions_succeeded) {
       try {
         insert_lets(func, func.ir2.env, *func.ir2.form_pool, func.ir2.top_form, stats.let);
@@ -720,7 +723,7 @@ void ObjectFileDB::ir2_insert_lets(int seg, ObjectFileData& data) {
 }
 
 void ObjectFileDB::ir2_add_store_errors(int seg, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("store_errors", seg, data, [&](Function& func) {
     if (func.ir2.expressions_succeeded && !func.warnings.has_errors()) {
       // print warning about failed store, but only if decompilation passes without any major
       // errors
@@ -736,7 +739,7 @@ void ObjectFileDB::ir2_add_store_errors(int seg, ObjectFileData& data) {
 }
 
 void ObjectFileDB::ir2_rewrite_inline_asm_instructions(int seg, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("inline_asm_rewrite", seg, data, [&](Function& func) {
     (void)data;
     if (func.ir2.top_form && func.ir2.env.has_type_analysis()) {
       if (rewrite_inline_asm_instructions(func.ir2.top_form, *func.ir2.form_pool, func, dts)) {
@@ -747,7 +750,7 @@ void ObjectFileDB::ir2_rewrite_inline_asm_instructions(int seg, ObjectFileData&
 }
 
 void ObjectFileDB::ir2_insert_anonymous_functions(int seg, ObjectFileData& data) {
-  for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
+  for_each_function_in_seg_in_obj_profiled("static_refs", seg, data, [&](Function& func) {
     (void)data;
     if (func.ir2.top_form && func.ir2.env.has_type_analysis()) {
       try {
@@ -0,0 +1,1340 @@
+#include "Vu2C.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <set>
+#include <stdexcept>
+
+#include "common/util/Assert.h"
+
+#include "third-party/fmt/core.h"
+
+namespace decompiler {
+
+namespace {
+
+// lane masks have x in the lowest bit. The accumulator is tracked after the 32 vf registers.
+constexpr int ACC = 32;
+constexpr int kAllLanes = 0b1111;
+using Lanes = std::array<u8, 33>;
+
+int bit(int lane) {
+  return 1 << lane;
+}
+
+bool is_conditional_branch(VuInstrK kind) {
+  switch (kind) {
+    case VuInstrK::IBEQ:
+    case VuInstrK::IBNE:
+    case VuInstrK::IBLTZ:
+    case VuInstrK::IBGTZ:
+    case VuInstrK::IBLEZ:
+    case VuInstrK::IBGEZ:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool is_jump(VuInstrK kind) {
+  switch (kind) {
+    case VuInstrK::B:
+    case VuInstrK::BAL:
+    case VuInstrK::JR:
+    case VuInstrK::JALR:
+      return true;
+    default:
+      return is_conditional_branch(kind);
+  }
+}
+
+bool has_ebit(const VuInstructionPair& pair) {
+  return pair.upper.e_bit() || pair.lower.e_bit();
+}
+
+bool is_vi(const VuInstructionAtom& atom, int reg) {
+  return atom.kind() == VuInstructionAtom::Kind::VI && atom.value() == reg;
+}
+
+struct VfDest {
+  int reg = -1;  // vf register or ACC, -1 if none.
+  int lanes = 0;
+};
+
+/*!
+ * The vf register or accumulator written by an instruction.
+ */
+VfDest vf_dest(const VuInstruction& instr) {
+  switch (instr.kind) {
+    case VuInstrK::ADD:
+    case VuInstrK::ADDbc:
+    case VuInstrK::ADDq:
+    case VuInstrK::ADDi:
+    case VuInstrK::SUB:
+    case VuInstrK::SUBbc:
+    case VuInstrK::MUL:
+    case VuInstrK::MULbc:
+    case VuInstrK::MULq:
+    case VuInstrK::MULi:
+    case VuInstrK::MAX:
+    case VuInstrK::MAXbc:
+    case VuInstrK::MAXi:
+    case VuInstrK::MINI:
+    case VuInstrK::MINIbc:
+    case VuInstrK::MINIi:
+    case VuInstrK::MADD:
+    case VuInstrK::MADDbc:
+    case VuInstrK::MADDq:
+    case VuInstrK::MSUBbc:
+    case VuInstrK::OPMSUB:
+    case VuInstrK::FTOI0:
+    case VuInstrK::FTOI4:
+    case VuInstrK::FTOI12:
+    case VuInstrK::ITOF0:
+    case VuInstrK::ITOF12:
+    case VuInstrK::ITOF15:
+    case VuInstrK::LQ:
+    case VuInstrK::LQI:
+    case VuInstrK::MOVE:
+    case VuInstrK::MR32:
+    case VuInstrK::MFIR:
+    case VuInstrK::MFP:
+      return {(int)instr.dst->value(), instr.mask_lanes()};
+    case VuInstrK::ADDA:
+    case VuInstrK::ADDAbc:
+    case VuInstrK::MULA:
+    case VuInstrK::MULAbc:
+    case VuInstrK::MULAq:
+    case VuInstrK::MADDA:
+    case VuInstrK::MADDAbc:
+    case VuInstrK::MSUBAbc:
+    case VuInstrK::OPMULA:
+      return {ACC, instr.mask_lanes()};
+    default:
+      return {};
+  }
+}
+
+/*!
+ * Lanes of a source needed by the outer product (opmula/opmsub), for the needed lanes of the
+ * result. The first source is rotated by 1 and the second by 2.
+ */
+int outer_product_lanes(int needed, int rotate) {
+  int result = 0;
+  for (int i = 0; i < 4; i++) {
+    if (needed & bit(i)) {
+      result |= i == 3 ? bit(3) : bit((i + rotate) % 3);
+    }
+  }
+  return result;
+}
+
+/*!
+ * Add the lanes of vf registers and the accumulator read by an instruction. needed is the lanes of
+ * its vf destination that are used later, if it has one: the other lanes don't need their sources.
+ */
+void add_vf_uses(const VuInstruction& instr, int needed, Lanes* live) {
+  auto use = [&](const VuInstructionAtom& atom, int lanes) {
+    if (atom.kind() == VuInstructionAtom::Kind::VF && atom.value() != 0) {
+      (*live)[atom.value()] |= lanes;
+    }
+  };
+  auto use_acc = [&](int lanes) { (*live)[ACC] |= lanes; };
+  const auto& src = instr.src;
+  int bc_lane = needed && instr.bc ? bit(*instr.bc) : 0;
+
+  switch (instr.kind) {
+    case VuInstrK::ADD:
+    case VuInstrK::SUB:
+    case VuInstrK::MUL:
+    case VuInstrK::MAX:
+    case VuInstrK::MINI:
+    case VuInstrK::ADDA:
+    case VuInstrK::MULA:
+      use(src.at(0), needed);
+      use(src.at(1), needed);
+      break;
+    case VuInstrK::ADDbc:
+    case VuInstrK::SUBbc:
+    case VuInstrK::MULbc:
+    case VuInstrK::MAXbc:
+    case VuInstrK::MINIbc:
+    case VuInstrK::MULAbc:
+      use(src.at(0), needed);
+      use(src.at(1), bc_lane);
+      break;
+    case VuInstrK::ADDq:
+    case VuInstrK::ADDi:
+    case VuInstrK::MULq:
+    case VuInstrK::MULi:
+    case VuInstrK::MAXi:
+    case VuInstrK::MINIi:
+    case VuInstrK::MULAq:
+    case VuInstrK::FTOI0:
+    case VuInstrK::FTOI4:
+    case VuInstrK::FTOI12:
+    case VuInstrK::ITOF0:
+    case VuInstrK::ITOF12:
+    case VuInstrK::ITOF15:
+    case VuInstrK::MOVE:
+      use(src.at(0), needed);
+      break;
+    case VuInstrK::MADD:
+    case VuInstrK::MADDA:
+      use_acc(needed);
+      use(src.at(0), needed);
+      use(src.at(1), needed);
+      break;
+    case VuInstrK::MADDbc:
+    case VuInstrK::MSUBbc:
+    case VuInstrK::MADDAbc:
+    case VuInstrK::MSUBAbc:
+      use_acc(needed);
+      use(src.at(0), needed);
+      use(src.at(1), bc_lane);
+      break;
+    case VuInstrK::MADDq:
+      use_acc(needed);
+      use(src.at(0), needed);
+      break;
+    case VuInstrK::ADDAbc:
+      // the first source is decoded as the destination.
+      use(*instr.dst, needed);
+      use(src.at(0), bc_lane);
+      break;
+    case VuInstrK::OPMSUB:
+      use_acc(needed);
+      [[fallthrough]];
+    case VuInstrK::OPMULA:
+      use(src.at(0), outer_product_lanes(needed, 1));
+      use(src.at(1), outer_product_lanes(needed, 2));
+      break;
+    case VuInstrK::MR32: {
+      int lanes = 0;
+      for (int i = 0; i < 4; i++) {
+        if (needed & bit(i)) {
+          lanes |= bit((i + 1) % 4);
+        }
+      }
+      use(src.at(0), lanes);
+    } break;
+    case VuInstrK::CLIP:
+      use(src.at(0), 0b0111);
+      use(src.at(1), bit(*instr.bc));
+      break;
+    case VuInstrK::SQ:
+    case VuInstrK::SQI:
+      use(*instr.dst, instr.mask_lanes());
+      break;
+    case VuInstrK::SQD:
+      use(src.at(0), instr.mask_lanes());
+      break;
+    case VuInstrK::DIV:
+    case VuInstrK::RSQRT:
+      use(src.at(0), bit(*instr.first_src_field));
+      use(src.at(1), bit(*instr.second_src_field));
+      break;
+    case VuInstrK::SQRT:
+    case VuInstrK::MTIR:
+      use(src.at(0), bit(*instr.first_src_field));
+      break;
+    case VuInstrK::ESADD:
+    case VuInstrK::ELENG:
+    case VuInstrK::ERLENG:
+      use(src.at(0), 0b0111);
+      break;
+    case VuInstrK::ESUM:
+      use(src.at(0), kAllLanes);
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+ * Update live lanes from after an instruction to before it.
+ */
+void transfer(const VuInstruction& instr, Lanes* live) {
+  auto dest = vf_dest(instr);
+  int needed = kAllLanes;
+  if (dest.reg >= 0) {
+    needed = dest.reg == 0 ? 0 : (dest.lanes & (*live)[dest.reg]);
+    (*live)[dest.reg] &= ~dest.lanes;
+  }
+  add_vf_uses(instr, needed, live);
+}
+
+/*!
+ * The vi register an instruction writes, if any.
+ */
+std::optional<int> vi_dest(const VuInstruction& instr) {
+  switch (instr.kind) {
+    case VuInstrK::FCAND:
+    case VuInstrK::FCOR:
+      return 1;
+    case VuInstrK::XTOP:
+    case VuInstrK::LQI:
+    case VuInstrK::SQI:
+      return instr.src.at(0).value();
+    case VuInstrK::SQD:
+      return instr.src.at(1).value();
+    default:
+      if (instr.dst && instr.dst->kind() == VuInstructionAtom::Kind::VI) {
+        return instr.dst->value();
+      }
+      return std::nullopt;
+  }
+}
+
+enum class Exit {
+  NEXT,            // fall through to the next node
+  BRANCH,          // conditional branch to target, or fall through to fallthrough
+  GOTO,            // go to target
+  JUMP_REGISTER,   // jr/jalr, to one of the bal return addresses
+  END,             // the program is done
+};
+
+/*!
+ * An instruction pair, in the order the generated code runs them. An instruction in a delay slot
+ * or after an e-bit gets its own node, and unrolled loops have a node per iteration.
+ */
+struct Node {
+  int instr = -1;
+  bool in_slot = false;       // the delay slot of a jump, or the instruction after an e-bit
+  bool branch_known = false;  // the lower instruction is a branch already resolved by unrolling
+  Exit exit = Exit::NEXT;
+  int target = -1;
+  int fallthrough = -1;
+  std::string comment;
+
+  Lanes live_in = {};
+  Lanes live_mid = {};  // after the upper instruction, before the lower
+  Lanes live_out = {};
+};
+
+class Generator {
+ public:
+  Generator(const VuProgram& prog, const VuDisassembler& disasm, const Vu2CSettings& settings)
+      : m_instrs(prog.instructions()),
+        m_disasm(disasm),
+        m_settings(settings),
+        m_qw_mask(disasm.kind() == VuDisassembler::VuKind::VU0 ? 0xff : 0x3ff) {}
+
+  std::string run();
+
+ private:
+  int branch_target(const VuInstruction& instr) const;
+  bool is_label_target(int instr) const;
+  void find_reachable();
+  bool try_unroll(int head);
+  void build_nodes();
+  std::vector<int> successors(int node_idx) const;
+  void compute_liveness();
+  bool falls_into(int node_idx, int instr) const;
+  void find_labels();
+  std::string label(int instr) const;
+
+  std::string vf_src(const VuInstructionAtom& atom);
+  std::string vi_src(const VuInstructionAtom& atom);
+  std::string acc_src();
+  std::string vi_assign(const VuInstructionAtom& atom, const std::string& value);
+  std::string vf_assign(const VfDest& dest, const Lanes& live_after, const std::string& value);
+  std::string address(const VuInstructionAtom& base, s64 offset);
+  std::string upper_cpp(const VuInstruction& instr, const Lanes& live_after);
+  std::string lower_cpp(const VuInstruction& instr, int idx, const Node& node);
+  std::string node_cpp(int node_idx);
+  std::string declarations() const;
+  std::string stores() const;
+
+  const std::vector<VuInstructionPair>& m_instrs;
+  const VuDisassembler& m_disasm;
+  const Vu2CSettings& m_settings;
+  u32 m_qw_mask;
+
+  std::vector<bool> m_reachable;  // reached other than as a delay slot
+  std::vector<bool> m_unrolled;
+  std::map<int, int> m_branch_count;  // branches to each instruction
+  std::set<int> m_return_sites;       // instructions after the delay slot of bal/jalr
+  std::vector<Node> m_nodes;
+  std::map<int, int> m_node_of_instr;
+  std::set<int> m_labels;
+
+  std::set<int> m_vf_used, m_vf_written, m_vi_used, m_vi_written;
+  bool m_acc_used = false, m_acc_written = false;
+  bool m_q_used = false, m_q_written = false;
+  bool m_p_used = false, m_p_written = false;
+  bool m_i_used = false, m_i_written = false;
+  bool m_cf_used = false, m_cf_written = false;
+  bool m_bc_used = false, m_jr_used = false, m_kick_used = false, m_end_used = false;
+};
+
+int Generator::branch_target(const VuInstruction& instr) const {
+  for (auto& atom : instr.src) {
+    if (atom.kind() == VuInstructionAtom::Kind::LABEL) {
+      return m_disasm.label_instruction(atom.value());
+    }
+  }
+  ASSERT_NOT_REACHED();
+}
+
+bool Generator::is_label_target(int instr) const {
+  const auto& entries = m_settings.entry_points;
+  return m_branch_count.count(instr) || m_return_sites.count(instr) ||
+         std::find(entries.begin(), entries.end(), instr) != entries.end();
+}
+
+/*!
+ * Find the instructions that can run, other than as a delay slot, starting from the entry points.
+ */
+void Generator::find_reachable() {
+  int count = m_instrs.size();
+  m_reachable.assign(count, false);
+  std::vector<int> work = m_settings.entry_points;
+  while (!work.empty()) {
+    int i = work.back();
+    work.pop_back();
+    if (i < 0 || i >= count) {
+      throw std::runtime_error(fmt::format("vu2c: instruction {} is outside of the program", i));
+    }
+    if (m_reachable[i]) {
+      continue;
+    }
+    m_reachable[i] = true;
+
+    const auto& pair = m_instrs[i];
+    auto kind = pair.lower.kind;
+    if (!is_jump(kind) && !has_ebit(pair)) {
+      work.push_back(i + 1);
+      continue;
+    }
+
+    if (is_jump(kind) && has_ebit(pair)) {
+      throw std::runtime_error(fmt::format("vu2c: jump with an e-bit at {}", i));
+    }
+    if (i + 1 >= count || is_jump(m_instrs[i + 1].lower.kind) || has_ebit(m_instrs[i + 1])) {
+      throw std::runtime_error(fmt::format("vu2c: unsupported delay slot after {}", i));
+    }
+    if (has_ebit(pair)) {
+      continue;
+    }
+
+    switch (kind) {
+      case VuInstrK::JR:
+        // goes to one of the return sites, which are all added below.
+        break;
+      case VuInstrK::JALR:
+        m_return_sites.insert(i + 2);
+        work.push_back(i + 2);
+        break;
+      case VuInstrK::BAL:
+        m_return_sites.insert(i + 2);
+        work.push_back(i + 2);
+        [[fallthrough]];
+      case VuInstrK::B:
+        m_branch_count[branch_target(pair.lower)]++;
+        work.push_back(branch_target(pair.lower));
+        break;
+      default:
+        ASSERT(is_conditional_branch(kind));
+        m_branch_count[branch_target(pair.lower)]++;
+        work.push_back(branch_target(pair.lower));
+        work.push_back(i + 2);
+        break;
+    }
+  }
+}
+
+/*!
+ * If head is the start of a loop that runs a constant number of times, add nodes for each
+ * iteration. The loop must be entered only by falling into head, and end with a conditional branch
+ * back to head that tests a counter. The counter must be set to a constant before the loop, with
+ * no way in between, and only changed in the loop by adding a constant to itself.
+ */
+bool Generator::try_unroll(int head) {
+  auto branches = m_branch_count.find(head);
+  if (head == 0 || branches == m_branch_count.end() || branches->second != 1 ||
+      m_return_sites.count(head) ||
+      std::find(m_settings.entry_points.begin(), m_settings.entry_points.end(), head) !=
+          m_settings.entry_points.end()) {
+    return false;
+  }
+
+  // find the branch back to head.
+  int count = m_instrs.size();
+  int branch = -1;
+  for (int i = head; i < count - 1; i++) {
+    const auto& pair = m_instrs[i];
+    if (has_ebit(pair) || (i > head && is_label_target(i))) {
+      return false;
+    }
+    if (is_jump(pair.lower.kind)) {
+      if (is_conditional_branch(pair.lower.kind) && branch_target(pair.lower) == head) {
+        branch = i;
+        break;
+      }
+      return false;
+    }
+  }
+  if (branch < 0 || is_label_target(branch + 1)) {
+    return false;
+  }
+
+  // the counter
+  const auto& branch_instr = m_instrs[branch].lower;
+  const auto& bsrc = branch_instr.src;
+  int counter;
+  if (branch_instr.kind == VuInstrK::IBEQ || branch_instr.kind == VuInstrK::IBNE) {
+    if (is_vi(bsrc.at(0), 0)) {
+      counter = bsrc.at(1).value();
+    } else if (is_vi(bsrc.at(1), 0)) {
+      counter = bsrc.at(0).value();
+    } else {
+      return false;
+    }
+  } else {
+    counter = bsrc.at(0).value();
+  }
+  if (counter == 0) {
+    return false;
+  }
+
+  // how an instruction changes the counter: false if it does something we can't follow.
+  auto counter_step = [&](const VuInstruction& instr, const VuInstructionAtom& expected_base,
+                          s64* step) {
+    auto dest = vi_dest(instr);
+    *step = 0;
+    if (!dest || *dest != counter) {
+      return true;
+    }
+    if ((instr.kind != VuInstrK::IADDI && instr.kind != VuInstrK::IADDIU &&
+         instr.kind != VuInstrK::ISUBIU) ||
+        !is_vi(instr.src.at(0), expected_base.value())) {
+      return false;
+    }
+    *step = instr.kind == VuInstrK::ISUBIU ? -instr.src.at(1).value() : instr.src.at(1).value();
+    return true;
+  };
+
+  // the value of the counter when entering the loop.
+  auto counter_atom = VuInstructionAtom::make_vi(counter);
+  auto zero_atom = VuInstructionAtom::make_vi(0);
+  std::optional<u16> initial;
+  for (int i = head - 1; i >= 0 && !initial; i--) {
+    const auto& pair = m_instrs[i];
+    if (!m_reachable[i] || is_jump(pair.lower.kind) || has_ebit(pair)) {
+      return false;
+    }
+    auto dest = vi_dest(pair.lower);
+    if (dest && *dest == counter) {
+      s64 value;
+      if (!counter_step(pair.lower, zero_atom, &value)) {
+        return false;
+      }
+      initial = value;
+    } else if (is_label_target(i)) {
+      return false;
+    }
+  }
+  if (!initial) {
+    return false;
+  }
+
+  // run the counter through the loop to count iterations.
+  std::vector<s64> steps;
+  for (int i = head; i <= branch + 1; i++) {
+    s64 step;
+    if (!counter_step(m_instrs[i].lower, counter_atom, &step)) {
+      return false;
+    }
+    steps.push_back(step);
+  }
+  u16 value = *initial;
+  int iterations = 0;
+  bool again = true;
+  while (again) {
+    if (++iterations > m_settings.max_unroll) {
+      return false;
+    }
+    for (int i = head; i < branch; i++) {
+      value += steps.at(i - head);
+    }
+    switch (branch_instr.kind) {
+      case VuInstrK::IBEQ:
+        again = value == 0;
+        break;
+      case VuInstrK::IBNE:
+        again = value != 0;
+        break;
+      case VuInstrK::IBLTZ:
+        again = (s16)value < 0;
+        break;
+      case VuInstrK::IBGTZ:
+        again = (s16)value > 0;
+        break;
+      case VuInstrK::IBLEZ:
+        again = (s16)value <= 0;
+        break;
+      case VuInstrK::IBGEZ:
+        again = (s16)value >= 0;
+        break;
+      default:
+        ASSERT_NOT_REACHED();
+    }
+    value += steps.back();
+  }
+
+  m_node_of_instr[head] = m_nodes.size();
+  for (int iter = 0; iter < iterations; iter++) {
+    for (int i = head; i <= branch; i++) {
+      auto& node = m_nodes.emplace_back();
+      node.instr = i;
+      node.branch_known = i == branch;
+      if (i == head) {
+        node.comment = fmt::format("unrolled loop: iteration {} of {}", iter + 1, iterations);
+      }
+    }
+    auto& slot = m_nodes.emplace_back();
+    slot.instr = branch + 1;
+    slot.in_slot = true;
+    if (iter == iterations - 1) {
+      slot.exit = Exit::GOTO;
+      slot.target = branch + 2;
+    }
+  }
+  for (int i = head; i <= branch + 1; i++) {
+    m_unrolled[i] = true;
+  }
+  return true;
+}
+
+void Generator::build_nodes() {
+  int count = m_instrs.size();
+  m_unrolled.assign(count, false);
+  for (int i = 0; i < count; i++) {
+    if (!m_reachable[i] || m_unrolled[i] || try_unroll(i)) {
+      continue;
+    }
+    m_node_of_instr[i] = m_nodes.size();
+    m_nodes.emplace_back().instr = i;
+
+    const auto& pair = m_instrs[i];
+    auto kind = pair.lower.kind;
+    if (!is_jump(kind) && !has_ebit(pair)) {
+      if (i + 1 >= count) {
+        throw std::runtime_error(fmt::format("vu2c: program runs off the end after {}", i));
+      }
+      continue;
+    }
+
+    auto& slot = m_nodes.emplace_back();
+    slot.instr = i + 1;
+    slot.in_slot = true;
+    if (has_ebit(pair)) {
+      slot.exit = Exit::END;
+    } else if (kind == VuInstrK::JR || kind == VuInstrK::JALR) {
+      slot.exit = Exit::JUMP_REGISTER;
+    } else if (kind == VuInstrK::B || kind == VuInstrK::BAL) {
+      slot.exit = Exit::GOTO;
+      slot.target = branch_target(pair.lower);
+    } else {
+      slot.exit = Exit::BRANCH;
+      slot.target = branch_target(pair.lower);
+      slot.fallthrough = i + 2;
+    }
+  }
+}
+
+std::vector<int> Generator::successors(int node_idx) const {
+  const auto& node = m_nodes.at(node_idx);
+  switch (node.exit) {
+    case Exit::NEXT:
+      return {node_idx + 1};
+    case Exit::BRANCH:
+      return {m_node_of_instr.at(node.target), m_node_of_instr.at(node.fallthrough)};
+    case Exit::GOTO:
+      return {m_node_of_instr.at(node.target)};
+    case Exit::JUMP_REGISTER: {
+      std::vector<int> result;
+      for (int site : m_return_sites) {
+        result.push_back(m_node_of_instr.at(site));
+      }
+      return result;
+    }
+    case Exit::END:
+      return {};
+    default:
+      ASSERT_NOT_REACHED();
+  }
+}
+
+/*!
+ * Find the lanes of each vf register and the accumulator that may be read later, before each
+ * instruction. A source lane only counts as read if the lane of the result it is used for is live.
+ */
+void Generator::compute_liveness() {
+  Lanes exit_live = {};
+  if (m_settings.registers_live_on_exit) {
+    for (int i = 1; i <= ACC; i++) {
+      exit_live[i] = kAllLanes;
+    }
+  }
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int idx = m_nodes.size(); idx-- > 0;) {
+      auto& node = m_nodes[idx];
+      Lanes live = {};
+      if (node.exit == Exit::END) {
+        live = exit_live;
+      }
+      for (int succ : successors(idx)) {
+        for (int i = 0; i <= ACC; i++) {
+          live[i] |= m_nodes.at(succ).live_in[i];
+        }
+      }
+      node.live_out = live;
+      transfer(m_instrs[node.instr].lower, &live);
+      node.live_mid = live;
+      transfer(m_instrs[node.instr].upper, &live);
+      if (live != node.live_in) {
+        node.live_in = live;
+        changed = true;
+      }
+    }
+  }
+}
+
+/*!
+ * Does the node after this one run the given instruction?
+ */
+bool Generator::falls_into(int node_idx, int instr) const {
+  auto it = m_node_of_instr.find(instr);
+  return it != m_node_of_instr.end() && it->second == node_idx + 1;
+}
+
+void Generator::find_labels() {
+  for (int entry : m_settings.entry_points) {
+    m_labels.insert(entry);
+  }
+  for (int idx = 0; idx < (int)m_nodes.size(); idx++) {
+    const auto& node = m_nodes[idx];
+    switch (node.exit) {
+      case Exit::BRANCH:
+        m_labels.insert(node.target);
+        if (!falls_into(idx, node.fallthrough)) {
+          m_labels.insert(node.fallthrough);
+        }
+        break;
+      case Exit::GOTO:
+        if (!falls_into(idx, node.target)) {
+          m_labels.insert(node.target);
+        }
+        break;
+      case Exit::JUMP_REGISTER:
+        m_labels.insert(m_return_sites.begin(), m_return_sites.end());
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+/*!
+ * Labels use the name from the disassembler if there is one, so they match the comments.
+ */
+std::string Generator::label(int instr) const {
+  for (auto& pair : m_instrs) {
+    for (auto& atom : pair.lower.src) {
+      if (atom.kind() == VuInstructionAtom::Kind::LABEL &&
+          m_disasm.label_instruction(atom.value()) == instr) {
+        return m_disasm.label_name(atom.value());
+      }
+    }
+  }
+  return fmt::format("I{}", instr);
+}
+
+std::string Generator::vf_src(const VuInstructionAtom& atom) {
+  ASSERT(atom.kind() == VuInstructionAtom::Kind::VF);
+  m_vf_used.insert(atom.value());
+  return fmt::format("vf{:02d}", atom.value());
+}
+
+std::string Generator::vi_src(const VuInstructionAtom& atom) {
+  ASSERT(atom.kind() == VuInstructionAtom::Kind::VI);
+  if (atom.value() == 0) {
+    return "0";
+  }
+  m_vi_used.insert(atom.value());
+  return fmt::format("vi{:02d}", atom.value());
+}
+
+std::string Generator::acc_src() {
+  m_acc_used = true;
+  return "acc";
+}
+
+std::string Generator::vi_assign(const VuInstructionAtom& atom, const std::string& value) {
+  ASSERT(atom.kind() == VuInstructionAtom::Kind::VI);
+  if (atom.value() == 0) {
+    return "";
+  }
+  m_vi_used.insert(atom.value());
+  m_vi_written.insert(atom.value());
+  return fmt::format("  vi{:02d} = {};\n", atom.value(), value);
+}
+
+/*!
+ * Write value to the lanes of dest. Lanes outside the mask are only kept if they are live, and
+ * nothing is written if none of the lanes in the mask are live.
+ */
+std::string Generator::vf_assign(const VfDest& dest,
+                                 const Lanes& live_after,
+                                 const std::string& value) {
+  std::string name;
+  if (dest.reg == ACC) {
+    m_acc_used = true;
+    m_acc_written = true;
+    name = "acc";
+  } else {
+    m_vf_used.insert(dest.reg);
+    m_vf_written.insert(dest.reg);
+    name = fmt::format("vf{:02d}", dest.reg);
+  }
+  if ((live_after[dest.reg] & ~dest.lanes & kAllLanes) == 0) {
+    return fmt::format("  {} = {};\n", name, value);
+  }
+  return fmt::format("  {} = _mm_blend_ps({}, {}, 0b{:04b});\n", name, name, value, dest.lanes);
+}
+
+std::string Generator::address(const VuInstructionAtom& base, s64 offset) {
+  if (is_vi(base, 0)) {
+    return fmt::format("{}", offset & m_qw_mask);
+  }
+  auto reg = vi_src(base);
+  if (offset == 0) {
+    return fmt::format("{} & 0x{:x}", reg, m_qw_mask);
+  }
+  return fmt::format("({} {} {}) & 0x{:x}", reg, offset < 0 ? '-' : '+', std::abs(offset),
+                     m_qw_mask);
+}
+
+std::string Generator::upper_cpp(const VuInstruction& instr, const Lanes& live_after) {
+  if (instr.kind == VuInstrK::NOP) {
+    return "";
+  }
+  if (instr.kind == VuInstrK::CLIP) {
+    m_cf_used = true;
+    m_cf_written = true;
+    return fmt::format("  cf = vu_clip({}, vu_lane<{}>({}), cf);\n", vf_src(instr.src.at(0)),
+                       *instr.bc, vf_src(instr.src.at(1)));
+  }
+
+  auto dest = vf_dest(instr);
+  if (dest.reg < 0) {
+    throw std::runtime_error(
+        fmt::format("vu2c: unsupported instruction {}", m_disasm.to_string(instr)));
+  }
+  if (dest.reg == 0 || (dest.lanes & live_after[dest.reg]) == 0) {
+    return "";
+  }
+
+  const auto& src = instr.src;
+  auto fs = [&]() { return vf_src(src.at(0)); };
+  auto ft = [&]() { return vf_src(src.at(1)); };
+  auto ft_bc = [&]() { return fmt::format("vu_bc<{}>({})", *instr.bc, vf_src(src.at(1))); };
+  auto q = [&]() {
+    m_q_used = true;
+    return std::string("_mm_set1_ps(Q)");
+  };
+  auto i_reg = [&]() {
+    m_i_used = true;
+    return std::string("_mm_set1_ps(I)");
+  };
+  auto op = [&](const char* name, const std::string& a, const std::string& b) {
+    return fmt::format("{}({}, {})", name, a, b);
+  };
+  auto madd = [&](const char* name, const std::string& a, const std::string& b) {
+    auto acc = acc_src();
+    return fmt::format("{}({}, _mm_mul_ps({}, {}))", name, acc, a, b);
+  };
+
+  std::string value;
+  switch (instr.kind) {
+    case VuInstrK::ADD:
+    case VuInstrK::ADDA:
+      value = op("_mm_add_ps", fs(), ft());
+      break;
+    case VuInstrK::ADDbc:
+      value = op("_mm_add_ps", fs(), ft_bc());
+      break;
+    case VuInstrK::ADDq:
+      value = op("_mm_add_ps", fs(), q());
+      break;
+    case VuInstrK::ADDi:
+      value = op("_mm_add_ps", fs(), i_reg());
+      break;
+    case VuInstrK::ADDAbc:
+      value = op("_mm_add_ps", vf_src(*instr.dst),
+                 fmt::format("vu_bc<{}>({})", *instr.bc, vf_src(src.at(0))));
+      break;
+    case VuInstrK::SUB:
+      value = op("_mm_sub_ps", fs(), ft());
+      break;
+    case VuInstrK::SUBbc:
+      value = op("_mm_sub_ps", fs(), ft_bc());
+      break;
+    case VuInstrK::MUL:
+    case VuInstrK::MULA:
+      value = op("_mm_mul_ps", fs(), ft());
+      break;
+    case VuInstrK::MULbc:
+    case VuInstrK::MULAbc:
+      value = op("_mm_mul_ps", fs(), ft_bc());
+      break;
+    case VuInstrK::MULq:
+    case VuInstrK::MULAq:
+      value = op("_mm_mul_ps", fs(), q());
+      break;
+    case VuInstrK::MULi:
+      value = op("_mm_mul_ps", fs(), i_reg());
+      break;
+    case VuInstrK::MAX:
+      value = op("vu_max_ps", fs(), ft());
+      break;
+    case VuInstrK::MAXbc:
+      value = op("vu_max_ps", fs(), ft_bc());
+      break;
+    case VuInstrK::MAXi:
+      value = op("vu_max_ps", fs(), i_reg());
+      break;
+    case VuInstrK::MINI:
+      value = op("vu_min_ps", fs(), ft());
+      break;
+    case VuInstrK::MINIbc:
+      value = op("vu_min_ps", fs(), ft_bc());
+      break;
+    case VuInstrK::MINIi:
+      value = op("vu_min_ps", fs(), i_reg());
+      break;
+    case VuInstrK::MADD:
+    case VuInstrK::MADDA:
+      value = madd("_mm_add_ps", fs(), ft());
+      break;
+    case VuInstrK::MADDbc:
+    case VuInstrK::MADDAbc:
+      value = madd("_mm_add_ps", fs(), ft_bc());
+      break;
+    case VuInstrK::MADDq:
+      value = madd("_mm_add_ps", fs(), q());
+      break;
+    case VuInstrK::MSUBbc:
+    case VuInstrK::MSUBAbc:
+      value = madd("_mm_sub_ps", fs(), ft_bc());
+      break;
+    case VuInstrK::OPMULA:
+      value = op("vu_opmul", fs(), ft());
+      break;
+    case VuInstrK::OPMSUB:
+      value = op("_mm_sub_ps", acc_src(), op("vu_opmul", fs(), ft()));
+      break;
+    case VuInstrK::FTOI0:
+      value = fmt::format("vu_ftoi<0>({})", fs());
+      break;
+    case VuInstrK::FTOI4:
+      value = fmt::format("vu_ftoi<4>({})", fs());
+      break;
+    case VuInstrK::FTOI12:
+      value = fmt::format("vu_ftoi<12>({})", fs());
+      break;
+    case VuInstrK::ITOF0:
+      value = fmt::format("vu_itof<0>({})", fs());
+      break;
+    case VuInstrK::ITOF12:
+      value = fmt::format("vu_itof<12>({})", fs());
+      break;
+    case VuInstrK::ITOF15:
+      value = fmt::format("vu_itof<15>({})", fs());
+      break;
+    default:
+      ASSERT_NOT_REACHED();
+  }
+  return vf_assign(dest, live_after, value);
+}
+
+std::string Generator::lower_cpp(const VuInstruction& instr, int idx, const Node& node) {
+  const auto& src = instr.src;
+  const auto& live_after = node.live_out;
+  auto dest = vf_dest(instr);
+  bool dest_live = dest.reg > 0 && (dest.lanes & live_after[dest.reg]);
+  auto lanes = [&]() { return fmt::format("0b{:04b}", instr.mask_lanes()); };
+  auto single_lane = [&]() {
+    int mask = instr.mask_lanes();
+    for (int i = 0; i < 4; i++) {
+      if (mask == bit(i)) {
+        return i;
+      }
+    }
+    throw std::runtime_error(
+        fmt::format("vu2c: {} needs a single lane", m_disasm.to_string(instr)));
+  };
+  auto step = [&](const VuInstructionAtom& reg, const char* op) {
+    if (is_vi(reg, 0)) {
+      return std::string();
+    }
+    m_vi_used.insert(reg.value());
+    m_vi_written.insert(reg.value());
+    return fmt::format("  vi{:02d}{};\n", reg.value(), op);
+  };
+  auto store = [&](const VuInstructionAtom& val, const std::string& addr) {
+    return fmt::format("  vu_sq<{}>(vu.data, {}, {});\n", lanes(), addr, vf_src(val));
+  };
+  auto branch = [&](const std::string& cond) {
+    if (node.branch_known) {
+      return std::string();
+    }
+    m_bc_used = true;
+    return fmt::format("  bc = {};\n", cond);
+  };
+  auto float_reg = [&](bool* used, bool* written, const char* name, const std::string& value) {
+    *used = true;
+    *written = true;
+    return fmt::format("  {} = {};\n", name, value);
+  };
+  auto lane = [&](const VuInstructionAtom& atom, int field) {
+    return fmt::format("vu_lane<{}>({})", field, vf_src(atom));
+  };
+
+  switch (instr.kind) {
+    case VuInstrK::LOWER_NOP:
+    case VuInstrK::WAITQ:
+    case VuInstrK::WAITP:
+      return "";
+    case VuInstrK::FP_CONSTANT: {
+      u32 bits;
+      memcpy(&bits, &instr.fp, 4);
+      return float_reg(&m_i_used, &m_i_written, "I",
+                       fmt::format("vu_float_bits(0x{:x});  // {}", bits, instr.fp));
+    }
+
+    case VuInstrK::LQ:
+      if (!dest_live) {
+        return "";
+      }
+      return vf_assign(dest, live_after,
+                       fmt::format("vu_lq(vu.data, {})", address(src.at(1), src.at(0).value())));
+    case VuInstrK::LQI: {
+      std::string result;
+      if (dest_live) {
+        result = vf_assign(dest, live_after,
+                           fmt::format("vu_lq(vu.data, {})", address(src.at(0), 0)));
+      }
+      return result + step(src.at(0), "++");
+    }
+    case VuInstrK::SQ:
+      return store(*instr.dst, address(src.at(1), src.at(0).value()));
+    case VuInstrK::SQI:
+      return store(*instr.dst, address(src.at(0), 0)) + step(src.at(0), "++");
+    case VuInstrK::SQD:
+      return step(src.at(1), "--") + store(src.at(0), address(src.at(1), 0));
+    case VuInstrK::ILW:
+      return vi_assign(*instr.dst, fmt::format("vu_ilw<{}>(vu.data, {})", single_lane(),
+                                               address(src.at(1), src.at(0).value())));
+    case VuInstrK::ILWR:
+      return vi_assign(*instr.dst, fmt::format("vu_ilw<{}>(vu.data, {})", single_lane(),
+                                               address(src.at(0), 0)));
+    case VuInstrK::ISW:
+      return fmt::format("  vu_isw<{}>(vu.data, {}, {});\n", lanes(),
+                         address(src.at(2), src.at(1).value()), vi_src(src.at(0)));
+    case VuInstrK::ISWR:
+      return fmt::format("  vu_isw<{}>(vu.data, {}, {});\n", lanes(), address(src.at(1), 0),
+                         vi_src(src.at(0)));
+
+    case VuInstrK::IADD:
+      return vi_assign(*instr.dst, fmt::format("{} + {}", vi_src(src.at(0)), vi_src(src.at(1))));
+    case VuInstrK::ISUB:
+      return vi_assign(*instr.dst, fmt::format("{} - {}", vi_src(src.at(0)), vi_src(src.at(1))));
+    case VuInstrK::IAND:
+      return vi_assign(*instr.dst, fmt::format("{} & {}", vi_src(src.at(0)), vi_src(src.at(1))));
+    case VuInstrK::IOR:
+      if (is_vi(src.at(1), 0)) {
+        return vi_assign(*instr.dst, vi_src(src.at(0)));
+      }
+      return vi_assign(*instr.dst, fmt::format("{} | {}", vi_src(src.at(0)), vi_src(src.at(1))));
+    case VuInstrK::IADDI:
+    case VuInstrK::IADDIU:
+    case VuInstrK::ISUBIU: {
+      s64 imm = instr.kind == VuInstrK::ISUBIU ? -src.at(1).value() : src.at(1).value();
+      if (is_vi(src.at(0), 0)) {
+        return vi_assign(*instr.dst, fmt::format("0x{:x}", (u16)imm));
+      }
+      return vi_assign(*instr.dst, fmt::format("{} {} {}", vi_src(src.at(0)), imm < 0 ? '-' : '+',
+                                               std::abs(imm)));
+    }
+
+    case VuInstrK::MOVE:
+      return dest_live ? vf_assign(dest, live_after, vf_src(src.at(0))) : "";
+    case VuInstrK::MR32:
+      return dest_live
+                 ? vf_assign(dest, live_after, fmt::format("vu_mr32({})", vf_src(src.at(0))))
+                 : "";
+    case VuInstrK::MFIR:
+      return dest_live
+                 ? vf_assign(dest, live_after, fmt::format("vu_mfir({})", vi_src(src.at(0))))
+                 : "";
+    case VuInstrK::MFP:
+      if (!dest_live) {
+        return "";
+      }
+      m_p_used = true;
+      return vf_assign(dest, live_after, "_mm_set1_ps(P)");
+    case VuInstrK::MTIR:
+      return vi_assign(*instr.dst, fmt::format("vu_lane_u16<{}>({})", *instr.first_src_field,
+                                               vf_src(src.at(0))));
+
+    case VuInstrK::DIV:
+      return float_reg(&m_q_used, &m_q_written, "Q",
+                       fmt::format("{} / {}", lane(src.at(0), *instr.first_src_field),
+                                   lane(src.at(1), *instr.second_src_field)));
+    case VuInstrK::SQRT:
+      return float_reg(&m_q_used, &m_q_written, "Q",
+                       fmt::format("std::sqrt({})", lane(src.at(0), *instr.first_src_field)));
+    case VuInstrK::RSQRT:
+      return float_reg(&m_q_used, &m_q_written, "Q",
+                       fmt::format("{} / std::sqrt({})", lane(src.at(0), *instr.first_src_field),
+                                   lane(src.at(1), *instr.second_src_field)));
+    case VuInstrK::ESADD:
+      return float_reg(&m_p_used, &m_p_written, "P",
+                       fmt::format("vu_esadd({})", vf_src(src.at(0))));
+    case VuInstrK::ELENG:
+      return float_reg(&m_p_used, &m_p_written, "P",
+                       fmt::format("std::sqrt(vu_esadd({}))", vf_src(src.at(0))));
+    case VuInstrK::ERLENG:
+      return float_reg(&m_p_used, &m_p_written, "P",
+                       fmt::format("1.f / std::sqrt(vu_esadd({}))", vf_src(src.at(0))));
+    case VuInstrK::ESUM:
+      return float_reg(&m_p_used, &m_p_written, "P", fmt::format("vu_esum({})", vf_src(src.at(0))));
+
+    case VuInstrK::FCSET:
+      return float_reg(&m_cf_used, &m_cf_written, "cf", fmt::format("0x{:x}", src.at(0).value()));
+    case VuInstrK::FCAND:
+    case VuInstrK::FCOR:
+      m_cf_used = true;
+      return vi_assign(VuInstructionAtom::make_vi(1),
+                       fmt::format("{}(cf, 0x{:x})",
+                                   instr.kind == VuInstrK::FCAND ? "vu_fcand" : "vu_fcor",
+                                   src.at(0).value()));
+    case VuInstrK::FCGET:
+      m_cf_used = true;
+      return vi_assign(*instr.dst, "cf & 0xfff");
+
+    case VuInstrK::IBEQ:
+      return branch(fmt::format("{} == {}", vi_src(src.at(0)), vi_src(src.at(1))));
+    case VuInstrK::IBNE:
+      return branch(fmt::format("{} != {}", vi_src(src.at(0)), vi_src(src.at(1))));
+    case VuInstrK::IBLTZ:
+      return branch(fmt::format("((s16){}) < 0", vi_src(src.at(0))));
+    case VuInstrK::IBGTZ:
+      return branch(fmt::format("((s16){}) > 0", vi_src(src.at(0))));
+    case VuInstrK::IBLEZ:
+      return branch(fmt::format("((s16){}) <= 0", vi_src(src.at(0))));
+    case VuInstrK::IBGEZ:
+      return branch(fmt::format("((s16){}) >= 0", vi_src(src.at(0))));
+    case VuInstrK::B:
+      return "";
+    case VuInstrK::BAL:
+      return vi_assign(*instr.dst, fmt::format("{}", idx + 2));
+    case VuInstrK::JR:
+      m_jr_used = true;
+      return fmt::format("  jr_target = {};\n", vi_src(src.at(0)));
+    case VuInstrK::JALR:
+      m_jr_used = true;
+      return fmt::format("  jr_target = {};\n", vi_src(src.at(0))) +
+             vi_assign(*instr.dst, fmt::format("{}", idx + 2));
+
+    case VuInstrK::XGKICK:
+      m_kick_used = true;
+      return fmt::format("  xgkick({});\n", vi_src(src.at(0)));
+    case VuInstrK::XTOP:
+      return vi_assign(src.at(0), "vu.top");
+
+    default:
+      throw std::runtime_error(
+          fmt::format("vu2c: unsupported instruction {}", m_disasm.to_string(instr)));
+  }
+}
+
+std::string Generator::node_cpp(int node_idx) {
+  const auto& node = m_nodes.at(node_idx);
+  const auto& pair = m_instrs.at(node.instr);
+  std::string result;
+  if (!node.comment.empty()) {
+    result += fmt::format("  // {}\n", node.comment);
+  }
+  if (!node.in_slot && m_labels.count(node.instr) && m_node_of_instr.at(node.instr) == node_idx) {
+    result += fmt::format("{}:\n", label(node.instr));
+  }
+  result += fmt::format("  // {:25s}  |  {:30s} {}\n", m_disasm.to_string(pair.lower),
+                        m_disasm.to_string(pair.upper), node.instr);
+  result += upper_cpp(pair.upper, node.live_mid);
+  result += lower_cpp(pair.lower, node.instr, node);
+
+  switch (node.exit) {
+    case Exit::NEXT:
+      break;
+    case Exit::BRANCH:
+      result += fmt::format("  if (bc) {{\n    goto {};\n  }}\n", label(node.target));
+      if (!falls_into(node_idx, node.fallthrough)) {
+        result += fmt::format("  goto {};\n", label(node.fallthrough));
+      }
+      break;
+    case Exit::GOTO:
+      if (!falls_into(node_idx, node.target)) {
+        result += fmt::format("  goto {};\n", label(node.target));
+      }
+      break;
+    case Exit::JUMP_REGISTER:
+      result += "  goto JUMP_REGISTER;\n";
+      break;
+    case Exit::END:
+      if (node_idx + 1 != (int)m_nodes.size()) {
+        m_end_used = true;
+        result += "  goto END;\n";
+      }
+      break;
+  }
+  return result;
+}
+
+std::string Generator::declarations() const {
+  std::string result;
+  for (int reg : m_vf_used) {
+    if (reg == 0) {
+      result += "  const __m128 vf00 = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);\n";
+    } else {
+      result += fmt::format("  __m128 vf{:02d} = vu.vf[{}].load();\n", reg, reg);
+    }
+  }
+  if (m_acc_used) {
+    result += "  __m128 acc = vu.acc.load();\n";
+  }
+  for (int reg : m_vi_used) {
+    result += fmt::format("  u16 vi{:02d} = vu.vi[{}];\n", reg, reg);
+  }
+  if (m_q_used) {
+    result += "  float Q = vu.Q;\n";
+  }
+  if (m_p_used) {
+    result += "  float P = vu.P;\n";
+  }
+  if (m_i_used) {
+    result += "  float I = vu.I;\n";
+  }
+  if (m_cf_used) {
+    result += "  u32 cf = vu.clip_flags;\n";
+  }
+  if (m_bc_used) {
+    result += "  bool bc = false;\n";
+  }
+  if (m_jr_used) {
+    result += "  u16 jr_target = 0;\n";
+  }
+  return result;
+}
+
+std::string Generator::stores() const {
+  std::string result;
+  if (m_settings.registers_live_on_exit) {
+    for (int reg : m_vf_written) {
+      result += fmt::format("  _mm_store_ps(vu.vf[{}].data, vf{:02d});\n", reg, reg);
+    }
+    if (m_acc_written) {
+      result += "  _mm_store_ps(vu.acc.data, acc);\n";
+    }
+  }
+  for (int reg : m_vi_written) {
+    result += fmt::format("  vu.vi[{}] = vi{:02d};\n", reg, reg);
+  }
+  if (m_q_written) {
+    result += "  vu.Q = Q;\n";
+  }
+  if (m_p_written) {
+    result += "  vu.P = P;\n";
+  }
+  if (m_i_written) {
+    result += "  vu.I = I;\n";
+  }
+  if (m_cf_written) {
+    result += "  vu.clip_flags = cf;\n";
+  }
+  return result;
+}
+
+std::string Generator::run() {
+  if (m_settings.entry_points.empty()) {
+    throw std::runtime_error("vu2c: no entry points");
+  }
+  find_reachable();
+  build_nodes();
+  compute_liveness();
+  find_labels();
+
+  // generate the body first, to find the registers used.
+  std::string body;
+  for (int idx = 0; idx < (int)m_nodes.size(); idx++) {
+    body += node_cpp(idx);
+  }
+
+  std::string result = "#pragma once\n\n";
+  if (m_settings.source.empty()) {
+    result += "// Generated by tools/vu2c, regenerate it instead of editing it.\n\n";
+  } else {
+    result += fmt::format(
+        "// Generated by tools/vu2c from {}, regenerate it instead of editing it.\n\n",
+        m_settings.source);
+  }
+  result += "#include \"game/common/vu2c.h\"\n\n";
+  result +=
+      "/*!\n"
+      " * Run the program from the instruction start (the mscal address / 8) until it ends.\n"
+      " * xgkick is called with the address for each xgkick.\n"
+      " */\n";
+  result += "template <typename Kick>\n";
+  result += fmt::format("void {}(VuState& vu, u16 start, Kick&& {}) {{\n",
+                        m_settings.function_name, m_kick_used ? "xgkick" : "/*xgkick*/");
+  result += declarations();
+  result += "\n  switch (start) {\n";
+  for (int entry : m_settings.entry_points) {
+    result += fmt::format("    case {}:\n      goto {};\n", entry, label(entry));
+  }
+  result += "    default:\n      ASSERT_NOT_REACHED();\n  }\n\n";
+  result += body;
+  if (m_end_used) {
+    result += "END:\n";
+  }
+  result += stores();
+  if (m_jr_used) {
+    result += "  return;\n\nJUMP_REGISTER:\n  switch (jr_target) {\n";
+    for (int site : m_return_sites) {
+      result += fmt::format("    case {}:\n      goto {};\n", site, label(site));
+    }
+    result += "    default:\n      ASSERT_NOT_REACHED();\n  }\n";
+  }
+  result += "}\n";
+  return result;
+}
+
+}  // namespace
+
+std::string vu_program_to_cpp(const VuProgram& prog,
+                              const VuDisassembler& disasm,
+                              const Vu2CSettings& settings) {
+  Generator gen(prog, disasm, settings);
+  return gen.run();
+}
+
+}  // namespace decompiler
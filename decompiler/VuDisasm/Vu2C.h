@@ -0,0 +1,43 @@
+#pragma once
+
+/*!
+ * @file Vu2C.h
+ * Convert a VU program to a C++ function, for renderers that run VU programs on the CPU.
+ *
+ * The generated code is a template function in a header that uses the state and helpers in
+ * game/common/vu2c.h. Compared to the one-op-per-line output of VuDisassembler::to_cpp:
+ *  - vf registers, the accumulator, and vi registers are kept in __m128 and u16 locals, and are
+ *    only loaded from and stored to the VuState at the start and end.
+ *  - lane liveness is tracked through the whole program. Instructions that only write dead lanes
+ *    are removed, and masked writes that don't need to keep any live lanes skip the blend.
+ *  - loops with a constant trip count (a counter set to a constant before the loop and stepped by
+ *    a constant inside it) are unrolled to straight-line code.
+ *
+ * It uses the same model of the VU as VuInterpreter, which is used to check the generated code.
+ */
+
+#include <string>
+#include <vector>
+
+#include "decompiler/VuDisasm/VuDisassembler.h"
+
+namespace decompiler {
+
+struct Vu2CSettings {
+  std::string function_name = "vu_program";
+  // a comment for the top of the file, like where the program came from.
+  std::string source;
+  // instructions the program can be started from: the mscal address divided by 8.
+  std::vector<int> entry_points = {0};
+  // when false, the vf registers and accumulator aren't written back to the VuState at the end, so
+  // work that only changes them can be removed.
+  bool registers_live_on_exit = true;
+  // loops with more iterations than this are left as loops.
+  int max_unroll = 16;
+};
+
+std::string vu_program_to_cpp(const VuProgram& prog,
+                              const VuDisassembler& disasm,
+                              const Vu2CSettings& settings);
+
+}  // namespace decompiler
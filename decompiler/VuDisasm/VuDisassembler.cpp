@@ -1176,6 +1176,16 @@ int VuDisassembler::add_label(int instr) {
   }
 }
 
+int VuDisassembler::label_instruction(int label) const {
+  for (auto& [instr, label_idx] : m_labels) {
+    if (label_idx == label) {
+      return instr;
+    }
+  }
+  ASSERT_MSG(false, fmt::format("unknown label {}", label));
+  return -1;
+}
+
 void VuDisassembler::add_label_with_name(int instr, const std::string& name) {
   add_label(instr);
   m_user_named_instructions[instr] = name;
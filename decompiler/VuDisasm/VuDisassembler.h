@@ -65,6 +65,9 @@ class VuDisassembler {
   std::string to_string_with_cpp(const VuProgram& prog, bool mips2c_format) const;
   int add_label(int instr);
   void add_label_with_name(int instr, const std::string& name);
+  int label_instruction(int label) const;
+  const std::string& label_name(int label) const { return m_label_names.at(label); }
+  VuKind kind() const { return m_kind; }
 
  private:
   VuKind m_kind;
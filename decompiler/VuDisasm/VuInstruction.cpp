@@ -88,6 +88,17 @@ std::string VuInstructionAtom::to_string(const std::vector<std::string>& labels)
   }
 }
 
+int VuInstruction::mask_lanes() const {
+  ASSERT(mask);
+  int result = 0;
+  for (int i = 0; i < 4; i++) {
+    if (*mask & (8 >> i)) {
+      result |= 1 << i;
+    }
+  }
+  return result;
+}
+
 VuInstruction VuInstruction::make_fp_constant(u32 value) {
   VuInstruction result;
   memcpy(&result.fp, &value, sizeof(float));
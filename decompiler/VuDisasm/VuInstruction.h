@@ -202,6 +202,10 @@ struct VuInstruction {
   float fp;
 
   bool i_bit() const { return iemdt && (*iemdt & 0b1000000); }
+  bool e_bit() const { return iemdt && (*iemdt & 0b100000); }
+
+  // the destination mask with x in the lowest bit, like Mask in game/common/vu.h.
+  int mask_lanes() const;
 
   static VuInstruction make_fp_constant(u32 value);
 };
@@ -0,0 +1,527 @@
+#include "VuInterpreter.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "third-party/fmt/core.h"
+
+namespace decompiler {
+
+namespace {
+
+float vf(const VuState& vu, const VuInstructionAtom& atom, int lane) {
+  ASSERT(atom.kind() == VuInstructionAtom::Kind::VF);
+  if (atom.value() == 0) {
+    return lane == 3 ? 1.f : 0.f;
+  }
+  return vu.vf[atom.value()][lane];
+}
+
+u16 vi(const VuState& vu, const VuInstructionAtom& atom) {
+  ASSERT(atom.kind() == VuInstructionAtom::Kind::VI);
+  return atom.value() == 0 ? 0 : vu.vi[atom.value()];
+}
+
+void set_vi(VuState& vu, const VuInstructionAtom& atom, u16 val) {
+  ASSERT(atom.kind() == VuInstructionAtom::Kind::VI);
+  if (atom.value() != 0) {
+    vu.vi[atom.value()] = val;
+  }
+}
+
+/*!
+ * Write the lanes in the mask. The results are computed before writing, so the destination can
+ * also be a source.
+ */
+void set_vf(VuState& vu, const VuInstructionAtom& atom, int lanes, const float* vals) {
+  ASSERT(atom.kind() == VuInstructionAtom::Kind::VF);
+  if (atom.value() == 0) {
+    return;
+  }
+  for (int i = 0; i < 4; i++) {
+    if (lanes & (1 << i)) {
+      vu.vf[atom.value()][i] = vals[i];
+    }
+  }
+}
+
+void set_acc(VuState& vu, int lanes, const float* vals) {
+  for (int i = 0; i < 4; i++) {
+    if (lanes & (1 << i)) {
+      vu.acc.data[i] = vals[i];
+    }
+  }
+}
+
+s32 float_bits(float f) {
+  s32 result;
+  memcpy(&result, &f, 4);
+  return result;
+}
+
+float bits_float(s32 i) {
+  float result;
+  memcpy(&result, &i, 4);
+  return result;
+}
+
+// out of range values give 0x80000000, like cvttps2dq.
+float ftoi(float f, float scale) {
+  float scaled = f * scale;
+  if (!(scaled >= -2147483648.f && scaled < 2147483648.f)) {
+    return bits_float(INT32_MIN);
+  }
+  return bits_float((s32)scaled);
+}
+
+float itof(float f, float scale) {
+  return ((float)float_bits(f)) * scale;
+}
+
+u32 clip(float x, float y, float z, float w, u32 old_clip) {
+  u32 result = (old_clip << 6);
+  float plus = std::abs(w);
+  float minus = -plus;
+  float vals[3] = {x, y, z};
+  for (int i = 0; i < 3; i++) {
+    if (vals[i] > plus) {
+      result |= 1 << (2 * i);
+    }
+    if (vals[i] < minus) {
+      result |= 2 << (2 * i);
+    }
+  }
+  return result & 0xffffff;
+}
+
+float sum_of_squares(const VuState& vu, const VuInstructionAtom& atom) {
+  return vf(vu, atom, 0) * vf(vu, atom, 0) + vf(vu, atom, 1) * vf(vu, atom, 1) +
+         vf(vu, atom, 2) * vf(vu, atom, 2);
+}
+
+int single_lane(int lanes) {
+  for (int i = 0; i < 4; i++) {
+    if (lanes == (1 << i)) {
+      return i;
+    }
+  }
+  throw std::runtime_error(fmt::format("VU instruction needs a single lane, got mask {}", lanes));
+}
+
+}  // namespace
+
+VuInterpreter::VuInterpreter(const VuProgram& prog, const VuDisassembler& disasm)
+    : m_prog(prog),
+      m_disasm(disasm),
+      m_qw_mask(disasm.kind() == VuDisassembler::VuKind::VU0 ? 0xff : 0x3ff) {}
+
+int VuInterpreter::branch_target(const VuInstruction& instr) const {
+  for (auto& atom : instr.src) {
+    if (atom.kind() == VuInstructionAtom::Kind::LABEL) {
+      return m_disasm.label_instruction(atom.value());
+    }
+  }
+  ASSERT_NOT_REACHED();
+}
+
+/*!
+ * Run the program from the given instruction until the instruction after the one with the e-bit.
+ */
+void VuInterpreter::run(VuState& vu, u16 start, const std::function<void(u16)>& xgkick) const {
+  int pc = start;
+  int pending_jump = -1;
+  bool end_after_this = false;
+  const auto& instrs = m_prog.instructions();
+  while (true) {
+    if (pc < 0 || pc >= (int)instrs.size()) {
+      throw std::runtime_error(fmt::format("VU program ran off the end at {}", pc));
+    }
+    const auto& pair = instrs.at(pc);
+    run_upper(vu, pair.upper);
+    auto jump = run_lower(vu, pair.lower, pc, xgkick);
+
+    if (end_after_this) {
+      return;
+    }
+
+    int next = pc + 1;
+    if (pending_jump >= 0) {
+      if (jump.taken) {
+        throw std::runtime_error(fmt::format("VU branch in a delay slot at {}", pc));
+      }
+      next = pending_jump;
+      pending_jump = -1;
+    } else if (jump.taken) {
+      pending_jump = jump.target;
+    }
+
+    if (pair.upper.e_bit() || pair.lower.e_bit()) {
+      end_after_this = true;
+    }
+    pc = next;
+  }
+}
+
+void VuInterpreter::run_upper(VuState& vu, const VuInstruction& instr) const {
+  float result[4] = {0, 0, 0, 0};
+  const auto& src = instr.src;
+  int lanes = instr.mask ? instr.mask_lanes() : 0;
+
+  // compute each lane of the result with f, then write it to the destination register.
+  auto vf_op = [&](auto f) {
+    for (int i = 0; i < 4; i++) {
+      if (lanes & (1 << i)) {
+        result[i] = f(i);
+      }
+    }
+    set_vf(vu, *instr.dst, lanes, result);
+  };
+
+  auto acc_op = [&](auto f) {
+    for (int i = 0; i < 4; i++) {
+      if (lanes & (1 << i)) {
+        result[i] = f(i);
+      }
+    }
+    set_acc(vu, lanes, result);
+  };
+
+  auto fs = [&](int i) { return vf(vu, src.at(0), i); };
+  auto ft = [&](int i) { return vf(vu, src.at(1), i); };
+  auto ft_bc = [&](int) { return vf(vu, src.at(1), *instr.bc); };
+  auto acc = [&](int i) { return vu.acc.data[i]; };
+  // outer product for opmula/opmsub. They only write xyz, w is like vu_opmul.
+  auto op = [&](int i) { return i == 3 ? fs(3) * ft(3) : fs((i + 1) % 3) * ft((i + 2) % 3); };
+
+  switch (instr.kind) {
+    case VuInstrK::NOP:
+      break;
+    case VuInstrK::ADD:
+      vf_op([&](int i) { return fs(i) + ft(i); });
+      break;
+    case VuInstrK::ADDbc:
+      vf_op([&](int i) { return fs(i) + ft_bc(i); });
+      break;
+    case VuInstrK::ADDq:
+      vf_op([&](int i) { return fs(i) + vu.Q; });
+      break;
+    case VuInstrK::ADDi:
+      vf_op([&](int i) { return fs(i) + vu.I; });
+      break;
+    case VuInstrK::SUB:
+      vf_op([&](int i) { return fs(i) - ft(i); });
+      break;
+    case VuInstrK::SUBbc:
+      vf_op([&](int i) { return fs(i) - ft_bc(i); });
+      break;
+    case VuInstrK::MUL:
+      vf_op([&](int i) { return fs(i) * ft(i); });
+      break;
+    case VuInstrK::MULbc:
+      vf_op([&](int i) { return fs(i) * ft_bc(i); });
+      break;
+    case VuInstrK::MULq:
+      vf_op([&](int i) { return fs(i) * vu.Q; });
+      break;
+    case VuInstrK::MULi:
+      vf_op([&](int i) { return fs(i) * vu.I; });
+      break;
+    case VuInstrK::MAX:
+      vf_op([&](int i) { return vu_max(fs(i), ft(i)); });
+      break;
+    case VuInstrK::MAXbc:
+      vf_op([&](int i) { return vu_max(fs(i), ft_bc(i)); });
+      break;
+    case VuInstrK::MAXi:
+      vf_op([&](int i) { return vu_max(fs(i), vu.I); });
+      break;
+    case VuInstrK::MINI:
+      vf_op([&](int i) { return vu_min(fs(i), ft(i)); });
+      break;
+    case VuInstrK::MINIbc:
+      vf_op([&](int i) { return vu_min(fs(i), ft_bc(i)); });
+      break;
+    case VuInstrK::MINIi:
+      vf_op([&](int i) { return vu_min(fs(i), vu.I); });
+      break;
+    case VuInstrK::MADD:
+      vf_op([&](int i) { return acc(i) + fs(i) * ft(i); });
+      break;
+    case VuInstrK::MADDbc:
+      vf_op([&](int i) { return acc(i) + fs(i) * ft_bc(i); });
+      break;
+    case VuInstrK::MADDq:
+      vf_op([&](int i) { return acc(i) + fs(i) * vu.Q; });
+      break;
+    case VuInstrK::MSUBbc:
+      vf_op([&](int i) { return acc(i) - fs(i) * ft_bc(i); });
+      break;
+    case VuInstrK::OPMSUB:
+      vf_op([&](int i) { return acc(i) - op(i); });
+      break;
+    case VuInstrK::ADDA:
+      acc_op([&](int i) { return fs(i) + ft(i); });
+      break;
+    case VuInstrK::ADDAbc:
+      // the first source is decoded as the destination.
+      acc_op([&](int i) { return vf(vu, *instr.dst, i) + vf(vu, src.at(0), *instr.bc); });
+      break;
+    case VuInstrK::MULA:
+      acc_op([&](int i) { return fs(i) * ft(i); });
+      break;
+    case VuInstrK::MULAbc:
+      acc_op([&](int i) { return fs(i) * ft_bc(i); });
+      break;
+    case VuInstrK::MULAq:
+      acc_op([&](int i) { return fs(i) * vu.Q; });
+      break;
+    case VuInstrK::MADDA:
+      acc_op([&](int i) { return acc(i) + fs(i) * ft(i); });
+      break;
+    case VuInstrK::MADDAbc:
+      acc_op([&](int i) { return acc(i) + fs(i) * ft_bc(i); });
+      break;
+    case VuInstrK::MSUBAbc:
+      acc_op([&](int i) { return acc(i) - fs(i) * ft_bc(i); });
+      break;
+    case VuInstrK::OPMULA:
+      acc_op([&](int i) { return op(i); });
+      break;
+    case VuInstrK::FTOI0:
+      vf_op([&](int i) { return ftoi(fs(i), 1.f); });
+      break;
+    case VuInstrK::FTOI4:
+      vf_op([&](int i) { return ftoi(fs(i), 16.f); });
+      break;
+    case VuInstrK::FTOI12:
+      vf_op([&](int i) { return ftoi(fs(i), 4096.f); });
+      break;
+    case VuInstrK::ITOF0:
+      vf_op([&](int i) { return itof(fs(i), 1.f); });
+      break;
+    case VuInstrK::ITOF12:
+      vf_op([&](int i) { return itof(fs(i), 1.f / 4096.f); });
+      break;
+    case VuInstrK::ITOF15:
+      vf_op([&](int i) { return itof(fs(i), 1.f / 32768.f); });
+      break;
+    case VuInstrK::CLIP:
+      vu.clip_flags = clip(fs(0), fs(1), fs(2), ft_bc(0), vu.clip_flags);
+      break;
+    default:
+      throw std::runtime_error(
+          fmt::format("VU interpreter doesn't support {}", m_disasm.to_string(instr)));
+  }
+}
+
+VuInterpreter::Jump VuInterpreter::run_lower(VuState& vu,
+                                             const VuInstruction& instr,
+                                             int idx,
+                                             const std::function<void(u16)>& xgkick) const {
+  Jump jump;
+  const auto& src = instr.src;
+  int lanes = instr.mask ? instr.mask_lanes() : 0;
+  float result[4] = {0, 0, 0, 0};
+
+  auto mem = [&](u32 addr) { return (float*)(vu.data + 16 * (addr & m_qw_mask)); };
+  auto load = [&](const VuInstructionAtom& dst, u32 addr) {
+    memcpy(result, mem(addr), 16);
+    set_vf(vu, dst, lanes, result);
+  };
+  auto store = [&](const VuInstructionAtom& val, u32 addr) {
+    float* dst = mem(addr);
+    for (int i = 0; i < 4; i++) {
+      if (lanes & (1 << i)) {
+        dst[i] = vf(vu, val, i);
+      }
+    }
+  };
+  auto branch_if = [&](bool cond) {
+    jump.taken = cond;
+    jump.target = branch_target(instr);
+  };
+
+  switch (instr.kind) {
+    case VuInstrK::LOWER_NOP:
+    case VuInstrK::WAITQ:
+    case VuInstrK::WAITP:
+      break;
+    case VuInstrK::FP_CONSTANT:
+      vu.I = instr.fp;
+      break;
+
+    case VuInstrK::LQ:
+      load(*instr.dst, vi(vu, src.at(1)) + src.at(0).value());
+      break;
+    case VuInstrK::LQI:
+      load(*instr.dst, vi(vu, src.at(0)));
+      set_vi(vu, src.at(0), vi(vu, src.at(0)) + 1);
+      break;
+    case VuInstrK::SQ:
+      store(*instr.dst, vi(vu, src.at(1)) + src.at(0).value());
+      break;
+    case VuInstrK::SQI:
+      store(*instr.dst, vi(vu, src.at(0)));
+      set_vi(vu, src.at(0), vi(vu, src.at(0)) + 1);
+      break;
+    case VuInstrK::SQD:
+      set_vi(vu, src.at(1), vi(vu, src.at(1)) - 1);
+      store(src.at(0), vi(vu, src.at(1)));
+      break;
+    case VuInstrK::ILW: {
+      u16 val;
+      memcpy(&val, mem(vi(vu, src.at(1)) + src.at(0).value()) + single_lane(lanes), 2);
+      set_vi(vu, *instr.dst, val);
+    } break;
+    case VuInstrK::ILWR: {
+      u16 val;
+      memcpy(&val, mem(vi(vu, src.at(0))) + single_lane(lanes), 2);
+      set_vi(vu, *instr.dst, val);
+    } break;
+    case VuInstrK::ISW:
+    case VuInstrK::ISWR: {
+      u32 addr = instr.kind == VuInstrK::ISW ? vi(vu, src.at(2)) + src.at(1).value()
+                                             : vi(vu, src.at(1));
+      u32 val = vi(vu, src.at(0));
+      for (int i = 0; i < 4; i++) {
+        if (lanes & (1 << i)) {
+          memcpy(mem(addr) + i, &val, 4);
+        }
+      }
+    } break;
+
+    case VuInstrK::IADD:
+      set_vi(vu, *instr.dst, vi(vu, src.at(0)) + vi(vu, src.at(1)));
+      break;
+    case VuInstrK::ISUB:
+      set_vi(vu, *instr.dst, vi(vu, src.at(0)) - vi(vu, src.at(1)));
+      break;
+    case VuInstrK::IAND:
+      set_vi(vu, *instr.dst, vi(vu, src.at(0)) & vi(vu, src.at(1)));
+      break;
+    case VuInstrK::IOR:
+      set_vi(vu, *instr.dst, vi(vu, src.at(0)) | vi(vu, src.at(1)));
+      break;
+    case VuInstrK::IADDI:
+    case VuInstrK::IADDIU:
+      set_vi(vu, *instr.dst, vi(vu, src.at(0)) + src.at(1).value());
+      break;
+    case VuInstrK::ISUBIU:
+      set_vi(vu, *instr.dst, vi(vu, src.at(0)) - src.at(1).value());
+      break;
+
+    case VuInstrK::MOVE:
+      for (int i = 0; i < 4; i++) {
+        result[i] = vf(vu, src.at(0), i);
+      }
+      set_vf(vu, *instr.dst, lanes, result);
+      break;
+    case VuInstrK::MR32:
+      for (int i = 0; i < 4; i++) {
+        result[i] = vf(vu, src.at(0), (i + 1) % 4);
+      }
+      set_vf(vu, *instr.dst, lanes, result);
+      break;
+    case VuInstrK::MFIR:
+      for (int i = 0; i < 4; i++) {
+        result[i] = bits_float((s16)vi(vu, src.at(0)));
+      }
+      set_vf(vu, *instr.dst, lanes, result);
+      break;
+    case VuInstrK::MFP:
+      for (int i = 0; i < 4; i++) {
+        result[i] = vu.P;
+      }
+      set_vf(vu, *instr.dst, lanes, result);
+      break;
+    case VuInstrK::MTIR:
+      set_vi(vu, *instr.dst, (u16)float_bits(vf(vu, src.at(0), *instr.first_src_field)));
+      break;
+
+    case VuInstrK::DIV:
+      vu.Q = vf(vu, src.at(0), *instr.first_src_field) / vf(vu, src.at(1), *instr.second_src_field);
+      break;
+    case VuInstrK::SQRT:
+      vu.Q = std::sqrt(vf(vu, src.at(0), *instr.first_src_field));
+      break;
+    case VuInstrK::RSQRT:
+      vu.Q = vf(vu, src.at(0), *instr.first_src_field) /
+             std::sqrt(vf(vu, src.at(1), *instr.second_src_field));
+      break;
+    case VuInstrK::ESADD:
+      vu.P = sum_of_squares(vu, src.at(0));
+      break;
+    case VuInstrK::ELENG:
+      vu.P = std::sqrt(sum_of_squares(vu, src.at(0)));
+      break;
+    case VuInstrK::ERLENG:
+      vu.P = 1.f / std::sqrt(sum_of_squares(vu, src.at(0)));
+      break;
+    case VuInstrK::ESUM:
+      vu.P = vf(vu, src.at(0), 0) + vf(vu, src.at(0), 1) + vf(vu, src.at(0), 2) +
+             vf(vu, src.at(0), 3);
+      break;
+
+    case VuInstrK::FCSET:
+      vu.clip_flags = src.at(0).value();
+      break;
+    case VuInstrK::FCAND:
+      vu.vi[1] = (vu.clip_flags & src.at(0).value() & 0xffffff) ? 1 : 0;
+      break;
+    case VuInstrK::FCOR:
+      vu.vi[1] = ((vu.clip_flags | src.at(0).value()) & 0xffffff) == 0xffffff ? 1 : 0;
+      break;
+    case VuInstrK::FCGET:
+      set_vi(vu, *instr.dst, vu.clip_flags & 0xfff);
+      break;
+
+    case VuInstrK::IBEQ:
+      branch_if(vi(vu, src.at(0)) == vi(vu, src.at(1)));
+      break;
+    case VuInstrK::IBNE:
+      branch_if(vi(vu, src.at(0)) != vi(vu, src.at(1)));
+      break;
+    case VuInstrK::IBLTZ:
+      branch_if((s16)vi(vu, src.at(0)) < 0);
+      break;
+    case VuInstrK::IBGTZ:
+      branch_if((s16)vi(vu, src.at(0)) > 0);
+      break;
+    case VuInstrK::IBLEZ:
+      branch_if((s16)vi(vu, src.at(0)) <= 0);
+      break;
+    case VuInstrK::IBGEZ:
+      branch_if((s16)vi(vu, src.at(0)) >= 0);
+      break;
+    case VuInstrK::B:
+      branch_if(true);
+      break;
+    case VuInstrK::BAL:
+      set_vi(vu, *instr.dst, idx + 2);
+      branch_if(true);
+      break;
+    case VuInstrK::JR:
+      jump.taken = true;
+      jump.target = vi(vu, src.at(0));
+      break;
+    case VuInstrK::JALR:
+      jump.taken = true;
+      jump.target = vi(vu, src.at(0));
+      set_vi(vu, *instr.dst, idx + 2);
+      break;
+
+    case VuInstrK::XGKICK:
+      xgkick(vi(vu, src.at(0)));
+      break;
+    case VuInstrK::XTOP:
+      set_vi(vu, src.at(0), vu.top);
+      break;
+
+    default:
+      throw std::runtime_error(
+          fmt::format("VU interpreter doesn't support {}", m_disasm.to_string(instr)));
+  }
+  return jump;
+}
+
+}  // namespace decompiler
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+
+#include "decompiler/VuDisasm/VuDisassembler.h"
+#include "game/common/vu2c.h"
+
+namespace decompiler {
+
+/*!
+ * Runs a VU program one instruction at a time, lane by lane. This is the reference that code
+ * generated by vu2c is checked against, and is much too slow to use in a renderer.
+ *
+ * Like the hand-ported programs, the pipeline isn't modeled: a result can be used by the next
+ * instruction, and div/sqrt set Q right away. The upper instruction of a pair runs before the
+ * lower one. The MAC and status flags aren't supported.
+ */
+class VuInterpreter {
+ public:
+  VuInterpreter(const VuProgram& prog, const VuDisassembler& disasm);
+  void run(VuState& vu, u16 start, const std::function<void(u16)>& xgkick) const;
+
+ private:
+  struct Jump {
+    bool taken = false;
+    int target = -1;
+  };
+
+  void run_upper(VuState& vu, const VuInstruction& instr) const;
+  Jump run_lower(VuState& vu,
+                 const VuInstruction& instr,
+                 int idx,
+                 const std::function<void(u16)>& xgkick) const;
+  int branch_target(const VuInstruction& instr) const;
+
+  const VuProgram& m_prog;
+  const VuDisassembler& m_disasm;
+  u32 m_qw_mask;
+};
+
+}  // namespace decompiler
@@ -516,8 +516,132 @@ bool block_requires_label(const Function* f,
 namespace {
 // hack counter for total number of unknown instruction. TODO remove
 int g_unknown = 0;
+
+/*!
+ * Is this a VU0 macro instruction where lane i of the destination only depends on lane i of the
+ * sources, and only the lanes in the dest mask are written?
+ */
+bool is_lane_wise_vf_op(InstructionKind kind) {
+  switch (kind) {
+    case InstructionKind::VADD:
+    case InstructionKind::VSUB:
+    case InstructionKind::VMUL:
+    case InstructionKind::VMINI:
+    case InstructionKind::VMAX:
+    case InstructionKind::VMADD:
+    case InstructionKind::VMSUB:
+    case InstructionKind::VADD_BC:
+    case InstructionKind::VSUB_BC:
+    case InstructionKind::VMUL_BC:
+    case InstructionKind::VMINI_BC:
+    case InstructionKind::VMAX_BC:
+    case InstructionKind::VMADD_BC:
+    case InstructionKind::VMSUB_BC:
+    case InstructionKind::VADDQ:
+    case InstructionKind::VMULQ:
+    case InstructionKind::VMOVE:
+    case InstructionKind::VABS:
+    case InstructionKind::VITOF0:
+    case InstructionKind::VITOF12:
+    case InstructionKind::VITOF15:
+    case InstructionKind::VFTOI0:
+    case InstructionKind::VFTOI4:
+    case InstructionKind::VFTOI12:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool is_bc_vf_op(InstructionKind kind) {
+  switch (kind) {
+    case InstructionKind::VADD_BC:
+    case InstructionKind::VSUB_BC:
+    case InstructionKind::VMUL_BC:
+    case InstructionKind::VMINI_BC:
+    case InstructionKind::VMAX_BC:
+    case InstructionKind::VMADD_BC:
+    case InstructionKind::VMSUB_BC:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool is_vf_atom(const InstructionAtom& atom) {
+  return atom.is_reg() && atom.get_reg().get_kind() == Reg::VF;
+}
 }  // namespace
 
+/*!
+ * Find writes to vf register lanes that are overwritten before they are read, inside the given
+ * range of instructions. The range should be a single basic block: at the end of the range, and
+ * at any function call or vcallms, all lanes of all vf registers are assumed to be used.
+ * Returns a new dest mask (in the PS2 encoding) for each lane-wise instruction that writes dead
+ * lanes. A mask of 0 means that the instruction can be removed entirely.
+ */
+std::unordered_map<int, u8> find_vf_write_masks(const std::vector<Instruction>& instructions,
+                                                int start_instr,
+                                                int end_instr) {
+  constexpr u8 kAllLanes = 0b1111;
+  u8 live[32];
+  for (auto& l : live) {
+    l = kAllLanes;
+  }
+
+  std::unordered_map<int, u8> result;
+  for (int i = end_instr; i-- > start_instr;) {
+    const auto& instr = instructions.at(i);
+
+    if (instr.kind == InstructionKind::JALR || instr.kind == InstructionKind::VCALLMS) {
+      // these can read any register.
+      for (auto& l : live) {
+        l = kAllLanes;
+      }
+      continue;
+    }
+
+    if (is_lane_wise_vf_op(instr.kind) && instr.n_dst == 1 && is_vf_atom(instr.get_dst(0))) {
+      int dst = instr.get_dst(0).get_reg().get_vf();
+      u8 mask = instr.cop2_dest & live[dst];
+      if (mask != instr.cop2_dest) {
+        result[i] = mask;
+      }
+      live[dst] &= ~mask;
+      if (mask) {
+        for (int src_idx = 0; src_idx < instr.n_src; src_idx++) {
+          const auto& src = instr.get_src(src_idx);
+          if (!is_vf_atom(src)) {
+            continue;
+          }
+          int src_vf = src.get_reg().get_vf();
+          if (src_idx == 1 && is_bc_vf_op(instr.kind)) {
+            live[src_vf] |= (8 >> instr.cop2_bc);
+          } else {
+            live[src_vf] |= mask;
+          }
+        }
+      }
+      continue;
+    }
+
+    if (instr.kind == InstructionKind::LQC2 && is_vf_atom(instr.get_dst(0))) {
+      live[instr.get_dst(0).get_reg().get_vf()] = 0;
+      continue;
+    }
+
+    // anything else is assumed to read all lanes of the vf registers it uses, and its writes
+    // don't kill anything.
+    for (int src_idx = 0; src_idx < instr.n_src; src_idx++) {
+      const auto& src = instr.get_src(src_idx);
+      if (is_vf_atom(src)) {
+        live[src.get_reg().get_vf()] = kAllLanes;
+      }
+    }
+  }
+  return result;
+}
+
 /*!
  * Complain about an unknown instruction.
  */
@@ -1365,7 +1489,7 @@ void run_mips2c_jump_table(Function* f,
   }
 }
 
-void run_mips2c(Function* f, GameVersion version) {
+void run_mips2c(Function* f, GameVersion version, bool remove_dead_vf_lanes) {
   g_unknown = 0;
   auto* file = f->ir2.env.file;
   std::unordered_set<int> likely_delay_blocks;
@@ -1373,6 +1497,35 @@ void run_mips2c(Function* f, GameVersion version) {
   Mips2C_Output output;
   int unknown_count = 0;
 
+  // the instructions to generate code for. Comments always show the original instruction.
+  std::vector<Instruction> instructions = f->instructions;
+  std::unordered_set<int> removed_instrs;
+  if (remove_dead_vf_lanes) {
+    int narrowed = 0;
+    for (const auto& block : blocks) {
+      for (auto& [idx, mask] : find_vf_write_masks(instructions, block.start_instr,
+                                                   block.end_instr)) {
+        if (mask) {
+          instructions.at(idx).cop2_dest = mask;
+          narrowed++;
+        } else {
+          removed_instrs.insert(idx);
+        }
+      }
+    }
+    lg::info("MIPS2C dead vf lanes in {}: removed {} writes, narrowed {}", f->name(),
+             removed_instrs.size(), narrowed);
+  }
+
+  auto normal_instr = [&](int idx) -> Mips2C_Line {
+    auto instr_str = f->instructions.at(idx).to_string(file->labels);
+    if (removed_instrs.count(idx)) {
+      return {"// dead vf write removed", instr_str};
+    }
+    return handle_normal_instr(output, instructions.at(idx), instr_str, unknown_count, file,
+                               version);
+  };
+
   for (size_t block_idx = 0; block_idx < blocks.size(); block_idx++) {
     const auto& block = blocks[block_idx];
 
@@ -1386,8 +1539,8 @@ void run_mips2c(Function* f, GameVersion version) {
 
     for (int i = block.start_instr; i < block.end_instr; i++) {
       size_t old_line_count = output.lines.size();
-      auto& instr = f->instructions.at(i);
-      auto instr_str = instr.to_string(file->labels);
+      auto& instr = instructions.at(i);
+      auto instr_str = f->instructions.at(i).to_string(file->labels);
 
       if (is_branch(instr, {})) {
         if (block.branch_likely) {
@@ -1398,10 +1551,7 @@ void run_mips2c(Function* f, GameVersion version) {
           ASSERT((int)block_idx + 1 == block.succ_branch);
           auto& delay_block = blocks.at(block.succ_branch);
           ASSERT(delay_block.end_instr - delay_block.start_instr == 1);  // only 1 instr.
-          auto& delay_instr = f->instructions.at(delay_block.start_instr);
-          auto delay_instr_str = delay_instr.to_string(file->labels);
-          auto delay_instr_line = handle_normal_instr(output, delay_instr, delay_instr_str,
-                                                      unknown_count, file, version);
+          auto delay_instr_line = normal_instr(delay_block.start_instr);
           output.lines.emplace_back(fmt::format("  {}", delay_instr_line.code),
                                     delay_instr_line.comment);
           ASSERT(delay_block.succ_ft == -1);
@@ -1414,10 +1564,7 @@ void run_mips2c(Function* f, GameVersion version) {
             // then the delay slot
             ASSERT(i + 1 < block.end_instr);
             i++;
-            auto& delay_i = f->instructions.at(i);
-            auto delay_i_str = delay_i.to_string(file->labels);
-            output.lines.push_back(
-                handle_normal_instr(output, delay_i, delay_i_str, unknown_count, file, version));
+            output.lines.push_back(normal_instr(i));
             ASSERT(i + 1 == block.end_instr);
             // then the goto
             output.lines.emplace_back(fmt::format("goto block_{};", block.succ_branch),
@@ -1432,10 +1579,7 @@ void run_mips2c(Function* f, GameVersion version) {
               lg::warn("Delay slot weirdness in {}, block {}", f->name(), block_idx);
             }
             i++;
-            auto& delay_i = f->instructions.at(i);
-            auto delay_i_str = delay_i.to_string(file->labels);
-            output.lines.push_back(
-                handle_normal_instr(output, delay_i, delay_i_str, unknown_count, file, version));
+            output.lines.push_back(normal_instr(i));
             // ASSERT(i + 1 == block.end_instr);
             // then the goto
             output.lines.emplace_back(fmt::format("if (bc) {{goto block_{};}}", block.succ_branch),
@@ -1448,10 +1592,7 @@ void run_mips2c(Function* f, GameVersion version) {
         // then the delay slot
         ASSERT(i + 1 < block.end_instr);
         i++;
-        auto& delay_i = f->instructions.at(i);
-        auto delay_i_str = delay_i.to_string(file->labels);
-        output.lines.push_back(
-            handle_normal_instr(output, delay_i, delay_i_str, unknown_count, file, version));
+        output.lines.push_back(normal_instr(i));
 
         // then the goto
         output.lines.emplace_back(fmt::format("goto end_of_function;", block.succ_branch),
@@ -1463,14 +1604,10 @@ void run_mips2c(Function* f, GameVersion version) {
             fmt::format("call_addr = c->gprs[{}].du32[0];", reg_to_name(instr.get_src(0))),
             "function call:");
         i++;
-        auto& delay_i = f->instructions.at(i);
-        auto delay_i_str = delay_i.to_string(file->labels);
-        output.lines.push_back(
-            handle_normal_instr(output, delay_i, delay_i_str, unknown_count, file, version));
+        output.lines.push_back(normal_instr(i));
         output.lines.emplace_back("c->jalr(call_addr);", instr_str);
       } else {
-        output.lines.push_back(
-            handle_normal_instr(output, instr, instr_str, unknown_count, file, version));
+        output.lines.push_back(normal_instr(i));
       }
 
       ASSERT(output.lines.size() > old_line_count);
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
+#include "common/common_types.h"
 #include "common/versions/versions.h"
 
 namespace decompiler {
 class Function;
+class Instruction;
 
-void run_mips2c(Function* f, GameVersion version);
+std::unordered_map<int, u8> find_vf_write_masks(const std::vector<Instruction>& instructions,
+                                                int start_instr,
+                                                int end_instr);
+void run_mips2c(Function* f, GameVersion version, bool remove_dead_vf_lanes = false);
 void run_mips2c_jump_table(Function* f,
                            const std::vector<int>& jump_table_locations,
                            GameVersion version);
@@ -75,9 +75,21 @@ Config make_config_via_json(nlohmann::json& json) {
   config.dump_objs = json.at("dump_objs").get<bool>();
   config.print_cfgs = json.at("print_cfgs").get<bool>();
   config.generate_symbol_definition_map = json.at("generate_symbol_definition_map").get<bool>();
+  if (json.contains("profile_ir2_passes")) {
+    config.profile_ir2_passes = json.at("profile_ir2_passes").get<bool>();
+  }
+  if (json.contains("profile_ir2_chrome_trace")) {
+    config.profile_ir2_chrome_trace = json.at("profile_ir2_chrome_trace").get<bool>();
+  }
+  if (json.contains("mips2c_remove_dead_vf_lanes")) {
+    config.mips2c_remove_dead_vf_lanes = json.at("mips2c_remove_dead_vf_lanes").get<bool>();
+  }
   config.is_pal = json.at("is_pal").get<bool>();
   config.rip_levels = json.at("rip_levels").get<bool>();
   config.extract_collision = json.at("extract_collision").get<bool>();
+  if (json.contains("release_level_compression")) {
+    config.release_level_compression = json.at("release_level_compression").get<bool>();
+  }
   config.generate_all_types = json.at("generate_all_types").get<bool>();
   if (json.contains("read_spools")) {
     config.read_spools = json.at("read_spools").get<bool>();
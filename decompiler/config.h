@@ -117,6 +117,7 @@ struct Config {
   bool dump_art_group_info = false;
   bool rip_levels = false;
   bool extract_collision = false;
+  bool release_level_compression = false;
   bool find_functions = false;
   bool read_spools = false;
 
@@ -128,6 +129,11 @@ struct Config {
 
   bool generate_symbol_definition_map = false;
 
+  bool profile_ir2_passes = false;
+  bool profile_ir2_chrome_trace = false;
+
+  bool mips2c_remove_dead_vf_lanes = false;
+
   bool generate_all_types = false;
   std::optional<std::string> old_all_types_file;
 
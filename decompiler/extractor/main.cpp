@@ -184,7 +184,8 @@ void decompile(const fs::path& iso_data_path, const std::string& data_subfolder)
         file_util::get_jak_project_dir() / "out" / game_version_names[config.game_version] / "fr3";
     file_util::create_dir_if_needed(level_out_path);
     extract_all_levels(db, tex_db, config.levels_to_extract, "GAME.CGO", config.hacks,
-                       config.rip_levels, config.extract_collision, level_out_path);
+                       config.rip_levels, config.extract_collision,
+                       config.release_level_compression, level_out_path);
   }
 }
 
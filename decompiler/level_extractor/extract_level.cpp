@@ -1,11 +1,14 @@
 #include "extract_level.h"
 
+#include <algorithm>
+#include <deque>
 #include <set>
-#include <thread>
 
+#include "common/custom_data/Fr3File.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
-#include "common/util/SimpleThreadGroup.h"
+#include "common/util/Timer.h"
+#include "common/util/WorkStealingPool.h"
 #include "common/util/compress.h"
 #include "common/util/string_util.h"
 
@@ -110,18 +113,186 @@ void confirm_textures_identical(const TextureDB& tex_db) {
   }
 }
 
+namespace {
+
+void remap_texture_ids(std::vector<tfrag3::StripDraw>& draws, const std::vector<u32>& tex_map) {
+  for (auto& draw : draws) {
+    draw.tree_tex_id = tex_map.at(draw.tree_tex_id);
+  }
+}
+
+void remap_texture_ids(std::vector<tfrag3::MercDraw>& draws, const std::vector<u32>& tex_map) {
+  for (auto& draw : draws) {
+    draw.tree_tex_id = tex_map.at(draw.tree_tex_id);
+  }
+}
+
+/*!
+ * Append merc models extracted into a separate level to the merc data of another level.
+ * The index buffer holds indices into the shared vertex buffer for the normal and fixed draws, but
+ * mod draws index into their effect's own vertex buffer, so only some indices are offset.
+ */
+void append_merc_data(tfrag3::MercModelGroup& dst,
+                      tfrag3::MercModelGroup&& src,
+                      const std::vector<u32>& tex_map) {
+  u32 first_vertex = dst.vertices.size();
+  u32 first_index = dst.indices.size();
+
+  std::vector<bool> index_is_vertex(src.indices.size(), false);
+  auto mark_vertex_indices = [&](const std::vector<tfrag3::MercDraw>& draws) {
+    for (auto& draw : draws) {
+      for (u32 i = 0; i < draw.index_count; i++) {
+        index_is_vertex.at(draw.first_index + i) = true;
+      }
+    }
+  };
+
+  for (auto& model : src.models) {
+    for (auto& effect : model.effects) {
+      mark_vertex_indices(effect.all_draws);
+      mark_vertex_indices(effect.mod.fix_draw);
+      for (auto* draws : {&effect.all_draws, &effect.mod.fix_draw, &effect.mod.mod_draw}) {
+        remap_texture_ids(*draws, tex_map);
+        for (auto& draw : *draws) {
+          draw.first_index += first_index;
+        }
+      }
+      if (effect.has_envmap) {
+        effect.envmap_texture = tex_map.at(effect.envmap_texture);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < src.indices.size(); i++) {
+    u32 idx = src.indices[i];
+    if (index_is_vertex[i] && idx != UINT32_MAX) {
+      idx += first_vertex;
+    }
+    dst.indices.push_back(idx);
+  }
+  dst.vertices.insert(dst.vertices.end(), src.vertices.begin(), src.vertices.end());
+  std::move(src.models.begin(), src.models.end(), std::back_inserter(dst.models));
+}
+
+/*!
+ * Parts of a level that are extracted in parallel, then combined in the order they were added.
+ * The result is the same as running the extractors one after another on a single level.
+ *
+ * Each part starts with a placeholder for every texture already in the level, so the extractors
+ * see the same texture indices they would in the real level. New textures are looked up by
+ * combo id when merging, and the draws are renumbered.
+ */
+class LevelParts {
+ public:
+  LevelParts(WorkStealingPool& pool, const tfrag3::Level& level)
+      : m_group(pool), m_num_placeholders(level.textures.size()) {
+    for (auto& tex : level.textures) {
+      m_placeholders.emplace_back();
+      m_placeholders.back().combo_id = tex.combo_id;
+      m_placeholders.back().w = 0;
+      m_placeholders.back().h = 0;
+    }
+  }
+
+  void add(std::function<void(tfrag3::Level&)> func) {
+    auto& part = m_parts.emplace_back();
+    part.textures = m_placeholders;
+    m_group.run([&part, func = std::move(func)]() { func(part); });
+  }
+
+  void merge_into(tfrag3::Level& level) {
+    m_group.wait();
+    for (auto& part : m_parts) {
+      merge_part(level, std::move(part));
+    }
+    m_parts.clear();
+  }
+
+ private:
+  void merge_part(tfrag3::Level& level, tfrag3::Level&& part) {
+    std::vector<u32> tex_map(part.textures.size());
+    for (size_t i = 0; i < part.textures.size(); i++) {
+      if (i < m_num_placeholders) {
+        tex_map[i] = i;
+        continue;
+      }
+      u32 combo_id = part.textures[i].combo_id;
+      auto existing =
+          std::find_if(level.textures.begin(), level.textures.end(),
+                       [&](const tfrag3::Texture& tex) { return tex.combo_id == combo_id; });
+      if (existing == level.textures.end()) {
+        tex_map[i] = level.textures.size();
+        level.textures.push_back(std::move(part.textures[i]));
+      } else {
+        tex_map[i] = existing - level.textures.begin();
+      }
+    }
+
+    for (int geom = 0; geom < tfrag3::TFRAG_GEOS; geom++) {
+      for (auto& tree : part.tfrag_trees[geom]) {
+        remap_texture_ids(tree.draws, tex_map);
+        level.tfrag_trees[geom].push_back(std::move(tree));
+      }
+    }
+
+    for (int geom = 0; geom < tfrag3::TIE_GEOS; geom++) {
+      for (auto& tree : part.tie_trees[geom]) {
+        remap_texture_ids(tree.static_draws, tex_map);
+        for (auto& draw : tree.instanced_wind_draws) {
+          draw.tree_tex_id = tex_map.at(draw.tree_tex_id);
+        }
+        // extract_tie sorts draws by texture. Sorting again gives the same order as extracting
+        // directly into the level.
+        for (int i = 0; i < tfrag3::kNumTieCategories; i++) {
+          std::stable_sort(tree.static_draws.begin() + tree.category_draw_indices[i],
+                           tree.static_draws.begin() + tree.category_draw_indices[i + 1],
+                           [](const tfrag3::StripDraw& a, const tfrag3::StripDraw& b) {
+                             return a.tree_tex_id < b.tree_tex_id;
+                           });
+        }
+        level.tie_trees[geom].push_back(std::move(tree));
+      }
+    }
+
+    for (auto& tree : part.shrub_trees) {
+      for (auto& draw : tree.static_draws) {
+        draw.tree_tex_id = tex_map.at(draw.tree_tex_id);
+      }
+      level.shrub_trees.push_back(std::move(tree));
+    }
+
+    if (!part.collision.vertices.empty()) {
+      ASSERT(level.collision.vertices.empty());
+      level.collision = std::move(part.collision);
+    }
+
+    append_merc_data(level.merc_data, std::move(part.merc_data), tex_map);
+  }
+
+  TaskGroup m_group;
+  size_t m_num_placeholders = 0;
+  std::vector<tfrag3::Texture> m_placeholders;
+  std::deque<tfrag3::Level> m_parts;  // deque so references stay valid as parts are added.
+};
+}  // namespace
+
 void extract_art_groups_from_level(const ObjectFileDB& db,
                                    const TextureDB& tex_db,
                                    const std::vector<level_tools::TextureRemap>& tex_remap,
                                    const std::string& dgo_name,
-                                   tfrag3::Level& level_data) {
+                                   tfrag3::Level& level_data,
+                                   WorkStealingPool& pool) {
+  LevelParts parts(pool, level_data);
   const auto& files = db.obj_files_by_dgo.at(dgo_name);
   for (const auto& file : files) {
     if (file.name.length() > 3 && !file.name.compare(file.name.length() - 3, 3, "-ag")) {
-      const auto& ag_file = db.lookup_record(file);
-      extract_merc(ag_file, tex_db, db.dts, tex_remap, level_data, false, db.version());
+      const auto* ag_file = &db.lookup_record(file);
+      parts.add([&, ag_file](tfrag3::Level& out) {
+        extract_merc(*ag_file, tex_db, db.dts, tex_remap, out, false, db.version());
+      });
     }
   }
+  parts.merge_into(level_data);
 }
 
 std::vector<level_tools::TextureRemap> extract_bsp_from_level(const ObjectFileDB& db,
@@ -129,7 +300,8 @@ std::vector<level_tools::TextureRemap> extract_bsp_from_level(const ObjectFileDB
                                                               const std::string& dgo_name,
                                                               const DecompileHacks& hacks,
                                                               bool extract_collision,
-                                                              tfrag3::Level& level_data) {
+                                                              tfrag3::Level& level_data,
+                                                              WorkStealingPool& pool) {
   auto bsp_rec = get_bsp_file(db.obj_files_by_dgo.at(dgo_name), dgo_name);
   if (!bsp_rec) {
     lg::warn("Skipping extract for {} because the BSP file was not found", dgo_name);
@@ -168,6 +340,8 @@ std::vector<level_tools::TextureRemap> extract_bsp_from_level(const ObjectFileDB
     }
   }
 
+  // each tree is extracted separately, and they are combined in order at the end.
+  LevelParts parts(pool, level_data);
   bool got_collide = false;
   for (auto& draw_tree : bsp_header.drawable_tree_array.trees) {
     if (tfrag_trees.count(draw_tree->my_type())) {
@@ -184,32 +358,43 @@ std::vector<level_tools::TextureRemap> extract_bsp_from_level(const ObjectFileDB
           atest_disable_flag = true;
         }
       }
-      extract_tfrag(as_tfrag_tree, fmt::format("{}-{}", dgo_name, i++),
-                    bsp_header.texture_remap_table, tex_db, expected_missing_textures, level_data,
-                    false, level_name, atest_disable_flag);
+      parts.add([&, as_tfrag_tree, expected_missing_textures, atest_disable_flag,
+                 debug_name = fmt::format("{}-{}", dgo_name, i++)](tfrag3::Level& out) {
+        extract_tfrag(as_tfrag_tree, debug_name, bsp_header.texture_remap_table, tex_db,
+                      expected_missing_textures, out, false, level_name, atest_disable_flag);
+      });
     } else if (draw_tree->my_type() == "drawable-tree-instance-tie") {
       auto as_tie_tree = dynamic_cast<level_tools::DrawableTreeInstanceTie*>(draw_tree.get());
       ASSERT(as_tie_tree);
-      extract_tie(as_tie_tree, fmt::format("{}-{}-tie", dgo_name, i++),
-                  bsp_header.texture_remap_table, tex_db, level_data, false, db.version());
+      parts.add([&, as_tie_tree,
+                 debug_name = fmt::format("{}-{}-tie", dgo_name, i++)](tfrag3::Level& out) {
+        extract_tie(as_tie_tree, debug_name, bsp_header.texture_remap_table, tex_db, out, false,
+                    db.version());
+      });
     } else if (draw_tree->my_type() == "drawable-tree-instance-shrub") {
       auto as_shrub_tree =
           dynamic_cast<level_tools::shrub_types::DrawableTreeInstanceShrub*>(draw_tree.get());
       ASSERT(as_shrub_tree);
-      extract_shrub(as_shrub_tree, fmt::format("{}-{}-shrub", dgo_name, i++),
-                    bsp_header.texture_remap_table, tex_db, {}, level_data, false, db.version());
+      parts.add([&, as_shrub_tree,
+                 debug_name = fmt::format("{}-{}-shrub", dgo_name, i++)](tfrag3::Level& out) {
+        extract_shrub(as_shrub_tree, debug_name, bsp_header.texture_remap_table, tex_db, {}, out,
+                      false, db.version());
+      });
     } else if (draw_tree->my_type() == "drawable-tree-collide-fragment" && extract_collision) {
       auto as_collide_frags =
           dynamic_cast<level_tools::DrawableTreeCollideFragment*>(draw_tree.get());
       ASSERT(as_collide_frags);
       ASSERT(!got_collide);
       got_collide = true;
-      extract_collide_frags(as_collide_frags, all_ties, fmt::format("{}-{}-collide", dgo_name, i++),
-                            level_data, false);
+      parts.add([&, as_collide_frags,
+                 debug_name = fmt::format("{}-{}-collide", dgo_name, i++)](tfrag3::Level& out) {
+        extract_collide_frags(as_collide_frags, all_ties, debug_name, out, false);
+      });
     } else {
       lg::print("  unsupported tree {}\n", draw_tree->my_type());
     }
   }
+  parts.merge_into(level_data);
   level_data.level_name = level_name;
 
   return bsp_header.texture_remap_table;
@@ -224,7 +409,9 @@ void extract_common(const ObjectFileDB& db,
                     const TextureDB& tex_db,
                     const std::string& dgo_name,
                     bool dump_levels,
-                    const fs::path& output_folder) {
+                    const compression::ZstdSettings& compression_settings,
+                    const fs::path& output_folder,
+                    WorkStealingPool& pool) {
   if (db.obj_files_by_dgo.count(dgo_name) == 0) {
     lg::warn("Skipping common extract for {} because the DGO was not part of the input", dgo_name);
     return;
@@ -239,17 +426,17 @@ void extract_common(const ObjectFileDB& db,
 
   tfrag3::Level tfrag_level;
   add_all_textures_from_level(tfrag_level, dgo_name, tex_db);
-  extract_art_groups_from_level(db, tex_db, {}, dgo_name, tfrag_level);
+  extract_art_groups_from_level(db, tex_db, {}, dgo_name, tfrag_level, pool);
 
-  Serializer ser;
-  tfrag_level.serialize(ser);
-  auto compressed =
-      compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  Timer compress_timer;
+  size_t uncompressed_size = 0;
+  auto compressed = tfrag3::write_fr3_chunked(tfrag_level, compression_settings, &uncompressed_size);
+  double compress_ms = compress_timer.getMs();
 
   lg::info("stats for {}", dgo_name);
-  print_memory_usage(tfrag_level, ser.get_save_result().second);
-  lg::info("compressed: {} -> {} ({:.2f}%)", ser.get_save_result().second, compressed.size(),
-           100.f * compressed.size() / ser.get_save_result().second);
+  print_memory_usage(tfrag_level, uncompressed_size);
+  lg::info("compressed: {} -> {} ({:.2f}%) in {:.1f} ms", uncompressed_size, compressed.size(),
+           100.f * compressed.size() / uncompressed_size, compress_ms);
   file_util::write_binary_file(
       output_folder / fmt::format("{}.fr3", dgo_name.substr(0, dgo_name.length() - 4)),
       compressed.data(), compressed.size());
@@ -267,7 +454,9 @@ void extract_from_level(const ObjectFileDB& db,
                         const DecompileHacks& hacks,
                         bool dump_level,
                         bool extract_collision,
-                        const fs::path& output_folder) {
+                        const compression::ZstdSettings& compression_settings,
+                        const fs::path& output_folder,
+                        WorkStealingPool& pool) {
   if (db.obj_files_by_dgo.count(dgo_name) == 0) {
     lg::warn("Skipping extract for {} because the DGO was not part of the input", dgo_name);
     return;
@@ -277,17 +466,17 @@ void extract_from_level(const ObjectFileDB& db,
 
   // the bsp header file data
   auto tex_remap =
-      extract_bsp_from_level(db, tex_db, dgo_name, hacks, extract_collision, level_data);
-  extract_art_groups_from_level(db, tex_db, tex_remap, dgo_name, level_data);
+      extract_bsp_from_level(db, tex_db, dgo_name, hacks, extract_collision, level_data, pool);
+  extract_art_groups_from_level(db, tex_db, tex_remap, dgo_name, level_data, pool);
 
-  Serializer ser;
-  level_data.serialize(ser);
-  auto compressed =
-      compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  Timer compress_timer;
+  size_t uncompressed_size = 0;
+  auto compressed = tfrag3::write_fr3_chunked(level_data, compression_settings, &uncompressed_size);
+  double compress_ms = compress_timer.getMs();
   lg::info("stats for {}", dgo_name);
-  print_memory_usage(level_data, ser.get_save_result().second);
-  lg::info("compressed: {} -> {} ({:.2f}%)", ser.get_save_result().second, compressed.size(),
-           100.f * compressed.size() / ser.get_save_result().second);
+  print_memory_usage(level_data, uncompressed_size);
+  lg::info("compressed: {} -> {} ({:.2f}%) in {:.1f} ms", uncompressed_size, compressed.size(),
+           100.f * compressed.size() / uncompressed_size, compress_ms);
   file_util::write_binary_file(
       output_folder / fmt::format("{}.fr3", dgo_name.substr(0, dgo_name.length() - 4)),
       compressed.data(), compressed.size());
@@ -311,16 +500,43 @@ void extract_all_levels(const ObjectFileDB& db,
                         const DecompileHacks& hacks,
                         bool debug_dump_level,
                         bool extract_collision,
+                        bool release_compression,
                         const fs::path& output_path) {
-  extract_common(db, tex_db, common_name, debug_dump_level, output_path);
-  SimpleThreadGroup threads;
-  threads.run(
-      [&](int idx) {
-        extract_from_level(db, tex_db, dgo_names[idx], hacks, debug_dump_level, extract_collision,
-                           output_path);
-      },
-      dgo_names.size());
-  threads.join();
+  auto compression_settings = release_compression ? compression::ZstdSettings::release()
+                                                  : compression::ZstdSettings::fast();
+  // each level is compressed inside a pool task, and the pool already has a thread per core.
+  // zstd threads on top of that would only fight over the same cores.
+  compression_settings.num_workers = 0;
+  WorkStealingPool pool;
+  TaskGroup levels(pool);
+  levels.run(
+      [&]() {
+        extract_common(db, tex_db, common_name, debug_dump_level, compression_settings,
+                       output_path, pool);
+      });
+
+  // start the biggest levels first, so they don't end up running alone at the end.
+  std::vector<std::pair<size_t, std::string>> levels_by_size;
+  for (auto& dgo_name : dgo_names) {
+    size_t size = 0;
+    auto it = db.obj_files_by_dgo.find(dgo_name);
+    if (it != db.obj_files_by_dgo.end()) {
+      for (auto& rec : it->second) {
+        size += db.lookup_record(rec).data.size();
+      }
+    }
+    levels_by_size.emplace_back(size, dgo_name);
+  }
+  std::stable_sort(levels_by_size.begin(), levels_by_size.end(),
+                   [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  for (auto& [size, dgo_name] : levels_by_size) {
+    levels.run([&, dgo_name = dgo_name]() {
+      extract_from_level(db, tex_db, dgo_name, hacks, debug_dump_level, extract_collision,
+                         compression_settings, output_path, pool);
+    });
+  }
+  levels.wait();
 }
 
 }  // namespace decompiler
@@ -16,5 +16,6 @@ void extract_all_levels(const ObjectFileDB& db,
                         const DecompileHacks& hacks,
                         bool debug_dump_level,
                         bool extract_collision,
+                        bool release_compression,
                         const fs::path& path);
 }  // namespace decompiler
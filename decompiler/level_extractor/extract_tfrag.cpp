@@ -2257,7 +2257,9 @@ void extract_tfrag(const level_tools::DrawableTreeTfrag* tree,
           str.vis_idx_in_pc_bvh = it->second;
         }
       }
+      draw.sort_by_vis_group();
       merge_groups(draw.vis_groups);
+      draw.compute_vis_group_starts();
     }
     out.tfrag_trees[geom].push_back(this_tree);
   }
@@ -2799,7 +2799,7 @@ void extract_tie(const level_tools::DrawableTreeInstanceTie* tree,
     // create draws
     add_vertices_and_static_draw(this_tree, out, tex_db, info, version);
 
-    // remap vis indices and merge
+    // remap vis indices, sort so each vis node's strips are together, and merge
     for (auto& draw : this_tree.static_draws) {
       for (auto& str : draw.vis_groups) {
         auto it = instance_parents.find(str.vis_idx_in_pc_bvh);
@@ -2809,7 +2809,9 @@ void extract_tie(const level_tools::DrawableTreeInstanceTie* tree,
           str.vis_idx_in_pc_bvh = it->second;
         }
       }
+      draw.sort_by_vis_group();
       merge_groups(draw.vis_groups);
+      draw.compute_vis_group_starts();
     }
 
     for (auto& draw : this_tree.instanced_wind_draws) {
@@ -178,10 +178,18 @@ int main(int argc, char** argv) {
   }
 
   // process files (required for all analysis)
+  Timer phase_timer;
   db.process_link_data(config);
+  float link_ms = phase_timer.getMs();
   mem_log("After link data: {} MB", get_peak_rss() / (1024 * 1024));
+  phase_timer.start();
   db.find_code(config);
+  float code_ms = phase_timer.getMs();
+  phase_timer.start();
   db.process_labels();
+  float label_ms = phase_timer.getMs();
+  lg::info("Startup phases: link {:.2f} ms, code {:.2f} ms, labels {:.2f} ms", link_ms, code_ms,
+           label_ms);
   mem_log("After code: {} MB", get_peak_rss() / (1024 * 1024));
 
   // top level decompile (do this before printing asm so we get function names)
@@ -295,7 +303,8 @@ int main(int argc, char** argv) {
         file_util::get_jak_project_dir() / "out" / game_version_names[config.game_version] / "fr3";
     file_util::create_dir_if_needed(level_out_path);
     extract_all_levels(db, tex_db, config.levels_to_extract, "GAME.CGO", config.hacks,
-                       config.rip_levels, config.extract_collision, level_out_path);
+                       config.rip_levels, config.extract_collision,
+                       config.release_level_compression, level_out_path);
   }
 
   mem_log("After extraction: {} MB", get_peak_rss() / (1024 * 1024));
@@ -681,6 +681,8 @@ void run(Output& out, const Input& input) {
   }
 
 end_type_pass:
+  out.iterations = outer_iterations;
+  out.blocks_run = blocks_run;
   std::string error;
   if (!convert_to_old_format(out, function_cache, error, input.func->ir2.env.casts(),
                              input.func->ir2.env.stack_casts(), *input.dts, hit_error)) {
@@ -226,6 +226,9 @@ struct Output {
   std::vector<::decompiler::TypeState> op_end_types;
   std::vector<StackStructureHint> stack_structure_hints;
   bool succeeded = false;
+  // propagation stats, for profiling
+  int iterations = 0;
+  int blocks_run = 0;
 };
 
 struct Input {
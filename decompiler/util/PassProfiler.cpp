@@ -0,0 +1,177 @@
+#include "PassProfiler.h"
+
+#include <algorithm>
+
+#include "common/global_profiler/GlobalProfiler.h"
+#include "common/log/log.h"
+
+#include "decompiler/Function/Function.h"
+#include "decompiler/IR2/Form.h"
+#include "decompiler/analysis/atomic_op_builder.h"
+
+#include "third-party/fmt/core.h"
+#include "third-party/json.hpp"
+
+namespace decompiler {
+
+PassProfiler::ScopedPass::ScopedPass(PassProfiler* profiler,
+                                     const char* pass,
+                                     const Function& func) {
+  if (profiler->enabled()) {
+    m_profiler = profiler;
+    m_pass = pass;
+    m_func = &func;
+    if (m_profiler->m_chrome_trace) {
+      prof().begin_event(fmt::format("{} {}", pass, func.name()).c_str());
+    }
+    m_timer.start();
+  }
+}
+
+PassProfiler::ScopedPass::~ScopedPass() {
+  if (m_profiler) {
+    m_profiler->add_pass_time(*m_func, m_pass, m_timer.getMs());
+    if (m_profiler->m_chrome_trace) {
+      prof().end_event();
+    }
+  }
+}
+
+/*!
+ * Turn profiling on or off. If chrome_trace is set, each pass is also recorded as an event in the
+ * GlobalProfiler, which is dumped by write_reports.
+ */
+void PassProfiler::set_enabled(bool enabled, bool chrome_trace) {
+  m_enabled = enabled;
+  m_chrome_trace = enabled && chrome_trace;
+  if (m_chrome_trace) {
+    prof().set_enable(false);
+    prof().set_max_events(1 << 19);
+    prof().clear();
+    prof().set_enable(true);
+    prof().root_event();
+  }
+}
+
+PassProfiler::FunctionEntry& PassProfiler::entry_for(const Function& func) {
+  auto it = m_entry_by_func.find(&func);
+  if (it != m_entry_by_func.end()) {
+    return m_entries.at(it->second);
+  }
+  m_entry_by_func[&func] = m_entries.size();
+  auto& entry = m_entries.emplace_back();
+  entry.object_name = m_current_object;
+  entry.function_name = func.name();
+  return entry;
+}
+
+void PassProfiler::add_pass_time(const Function& func, const char* pass, double ms) {
+  auto& entry = entry_for(func);
+  entry.total_ms += ms;
+  for (auto& [name, time] : entry.pass_ms) {
+    if (name == pass) {
+      time += ms;
+      return;
+    }
+  }
+  entry.pass_ms.emplace_back(pass, ms);
+}
+
+void PassProfiler::record_types2(const Function& func, int iterations, int blocks_run) {
+  if (!m_enabled) {
+    return;
+  }
+  auto& entry = entry_for(func);
+  entry.types2_iterations += iterations;
+  entry.types2_blocks_run += blocks_run;
+}
+
+/*!
+ * Record the size of the IR of a function. Must be called before the IR2 data is freed.
+ */
+void PassProfiler::record_ir_sizes(const Function& func) {
+  if (!m_enabled) {
+    return;
+  }
+  auto& entry = entry_for(func);
+  entry.instructions = func.instructions.size();
+  entry.basic_blocks = func.basic_blocks.size();
+  if (func.ir2.atomic_ops) {
+    entry.atomic_ops = func.ir2.atomic_ops->ops.size();
+  }
+  if (func.ir2.form_pool) {
+    entry.forms = func.ir2.form_pool->form_count();
+    entry.form_elements = func.ir2.form_pool->element_count();
+  }
+}
+
+std::string PassProfiler::to_json() const {
+  nlohmann::json result = nlohmann::json::array();
+  for (const auto& entry : m_entries) {
+    nlohmann::json& func = result.emplace_back();
+    func["object"] = entry.object_name;
+    func["function"] = entry.function_name;
+    func["total_ms"] = entry.total_ms;
+    auto& passes = func["passes"];
+    passes = nlohmann::json::object();
+    for (const auto& [name, ms] : entry.pass_ms) {
+      passes[name] = ms;
+    }
+    func["instructions"] = entry.instructions;
+    func["basic_blocks"] = entry.basic_blocks;
+    func["atomic_ops"] = entry.atomic_ops;
+    func["forms"] = entry.forms;
+    func["form_elements"] = entry.form_elements;
+    func["types2_iterations"] = entry.types2_iterations;
+    func["types2_blocks_run"] = entry.types2_blocks_run;
+  }
+  return result.dump(1);
+}
+
+std::string PassProfiler::slowest_functions_table(size_t count) const {
+  std::vector<const FunctionEntry*> sorted;
+  for (const auto& entry : m_entries) {
+    sorted.push_back(&entry);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) {
+    return a->total_ms > b->total_ms;
+  });
+
+  std::string result = fmt::format("{:>10} {:>24} {:>10} {:>6} {:>5}  {}\n", "total ms",
+                                   "slowest pass", "pass ms", "ops", "iter", "function");
+  for (size_t i = 0; i < std::min(count, sorted.size()); i++) {
+    const auto& entry = *sorted[i];
+    std::pair<std::string, double> slowest = {"", 0};
+    for (const auto& pass : entry.pass_ms) {
+      if (pass.second > slowest.second) {
+        slowest = pass;
+      }
+    }
+    result += fmt::format("{:10.2f} {:>24} {:10.2f} {:6d} {:5d}  {} ({})\n", entry.total_ms,
+                          slowest.first, slowest.second, entry.atomic_ops,
+                          entry.types2_iterations, entry.function_name, entry.object_name);
+  }
+  return result;
+}
+
+/*!
+ * Write ir2_profile.json, the table of the slowest functions, and the chrome trace (if enabled).
+ */
+void PassProfiler::write_reports(const fs::path& output_dir, size_t table_count) {
+  if (!m_enabled) {
+    return;
+  }
+  file_util::create_dir_if_needed(output_dir);
+  file_util::write_text_file(output_dir / "ir2_profile.json", to_json());
+  auto table = slowest_functions_table(table_count);
+  file_util::write_text_file(output_dir / "ir2_slowest_functions.txt", table);
+  lg::info("Slowest {} functions:\n{}", table_count, table);
+
+  if (m_chrome_trace) {
+    prof().root_event();
+    prof().set_enable(false);
+    prof().dump_to_json((output_dir / "ir2_trace.json").string());
+  }
+  lg::info("Wrote IR2 profile to {}", output_dir.string());
+}
+}  // namespace decompiler
@@ -0,0 +1,78 @@
+#pragma once
+
+/*!
+ * @file PassProfiler.h
+ * Optional per-pass, per-function timing of the IR2 passes.
+ */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+
+namespace decompiler {
+class Function;
+
+class PassProfiler {
+ public:
+  struct FunctionEntry {
+    std::string object_name;
+    std::string function_name;
+    // pass name, total time spent in that pass. In the order the passes first ran.
+    std::vector<std::pair<std::string, double>> pass_ms;
+    double total_ms = 0;
+
+    // IR sizes, recorded once analysis of the object is finished.
+    int instructions = 0;
+    int basic_blocks = 0;
+    int atomic_ops = 0;
+    int forms = 0;
+    int form_elements = 0;
+
+    // only set by types2.
+    int types2_iterations = 0;
+    int types2_blocks_run = 0;
+  };
+
+  /*!
+   * Times a single pass on a single function. Does nothing if the profiler is disabled.
+   */
+  class ScopedPass {
+   public:
+    ScopedPass(PassProfiler* profiler, const char* pass, const Function& func);
+    ScopedPass(const ScopedPass&) = delete;
+    ScopedPass& operator=(const ScopedPass&) = delete;
+    ~ScopedPass();
+
+   private:
+    PassProfiler* m_profiler = nullptr;
+    const char* m_pass = nullptr;
+    const Function* m_func = nullptr;
+    Timer m_timer;
+  };
+
+  void set_enabled(bool enabled, bool chrome_trace);
+  bool enabled() const { return m_enabled; }
+  void set_current_object(const std::string& name) { m_current_object = name; }
+
+  ScopedPass scoped(const char* pass, const Function& func) { return {this, pass, func}; }
+  void add_pass_time(const Function& func, const char* pass, double ms);
+  void record_types2(const Function& func, int iterations, int blocks_run);
+  void record_ir_sizes(const Function& func);
+
+  std::string to_json() const;
+  std::string slowest_functions_table(size_t count) const;
+  void write_reports(const fs::path& output_dir, size_t table_count = 50);
+
+ private:
+  FunctionEntry& entry_for(const Function& func);
+
+  bool m_enabled = false;
+  bool m_chrome_trace = false;
+  std::string m_current_object;
+  std::vector<FunctionEntry> m_entries;
+  std::unordered_map<const Function*, size_t> m_entry_by_func;
+};
+}  // namespace decompiler
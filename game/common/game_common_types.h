@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include "common/listener_common.h"
 #include "common/versions/versions.h"
 
@@ -18,6 +20,14 @@ enum class Language {
 struct GameLaunchOptions {
   GameVersion game_version = GameVersion::Jak1;
   bool disable_display = false;
+  bool null_renderer = false;
+  // record graphics input to this file, if set. See gfx_capture.h.
+  std::string gfx_capture_path;
+  int gfx_capture_skip_frames = 0;
+  int gfx_capture_frames = 300;
+  // write per-frame renderer metrics to this file, if set. See FrameTelemetry.h.
+  std::string telemetry_path;
+  bool telemetry_binary = false;
   bool disable_debug_vm = true;
   int server_port = DECI2_PORT;
 };
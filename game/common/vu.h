@@ -38,6 +38,25 @@ static inline REALLY_INLINE void copy_vector(void* dest, const void* src) {
   _mm_store_ps((float*)dest, val);
 }
 
+// all bits set in the lanes selected by each mask.
+alignas(16) inline const u32 kVuMaskLanes[16][4] = {
+    {0, 0, 0, 0},   {~0u, 0, 0, 0},   {0, ~0u, 0, 0},   {~0u, ~0u, 0, 0},
+    {0, 0, ~0u, 0}, {~0u, 0, ~0u, 0}, {0, ~0u, ~0u, 0}, {~0u, ~0u, ~0u, 0},
+    {0, 0, 0, ~0u}, {~0u, 0, 0, ~0u}, {0, ~0u, 0, ~0u}, {~0u, ~0u, 0, ~0u},
+    {0, 0, ~0u, ~0u}, {~0u, 0, ~0u, ~0u}, {0, ~0u, ~0u, ~0u}, {~0u, ~0u, ~0u, ~0u}};
+
+/*!
+ * Take the lanes selected by the mask from new_val, and the others from old_val.
+ * The masked VU instructions compute all four lanes and blend, which gives the same result as
+ * computing only the selected lanes.
+ */
+static inline REALLY_INLINE __m128 vu_blend_mask(__m128 old_val, __m128 new_val, Mask mask) {
+  if (mask == Mask::xyzw) {
+    return new_val;
+  }
+  return _mm_blendv_ps(old_val, new_val, _mm_load_ps((const float*)kVuMaskLanes[(int)mask]));
+}
+
 inline float vu_max(float a, float b) {
   return std::max(b, a);
   //  s32 ai, bi;
@@ -67,6 +86,9 @@ struct alignas(16) Vf {
   REALLY_INLINE __m128 load() const { return _mm_load_ps(data); }
 
   REALLY_INLINE void move_xyzw(const Vf& src) { copy_vector(data, src.data); }
+  REALLY_INLINE void store_masked(Mask mask, __m128 val) {
+    _mm_store_ps(data, vu_blend_mask(load(), val, mask));
+  }
 
   float data[4];
   float& x() { return data[0]; }
@@ -261,27 +283,15 @@ struct alignas(16) Vf {
   }
 
   void move(Mask mask, const Vf& other) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = other[i];
-      }
-    }
+    store_masked(mask, other.load());
   }
 
   void mfp(Mask mask, float other) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = other;
-      }
-    }
+    store_masked(mask, _mm_set1_ps(other));
   }
 
   void add(Mask mask, const Vf& a, const Vf& b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] + b[i];
-      }
-    }
+    store_masked(mask, _mm_add_ps(a.load(), b.load()));
   }
 
   REALLY_INLINE void add_xyzw(const Vf& a, const Vf& b) {
@@ -289,11 +299,7 @@ struct alignas(16) Vf {
   }
 
   void add(Mask mask, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] + b;
-      }
-    }
+    store_masked(mask, _mm_add_ps(a.load(), _mm_set1_ps(b)));
   }
 
   u32 add_and_set_sf_s(Mask mask, const Vf& a, float b) {
@@ -323,19 +329,11 @@ struct alignas(16) Vf {
   }
 
   void sub(Mask mask, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] - b;
-      }
-    }
+    store_masked(mask, _mm_sub_ps(a.load(), _mm_set1_ps(b)));
   }
 
   void sub(Mask mask, const Vf& a, const Vf& b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] - b[i];
-      }
-    }
+    store_masked(mask, _mm_sub_ps(a.load(), b.load()));
   }
 
   REALLY_INLINE void mul_xyzw(const Vf& a, const Vf& b) {
@@ -347,11 +345,7 @@ struct alignas(16) Vf {
   }
 
   void mul(Mask mask, const Vf& a, const Vf& b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] * b[i];
-      }
-    }
+    store_masked(mask, _mm_mul_ps(a.load(), b.load()));
   }
 
   void saturate_infs() {
@@ -367,50 +361,26 @@ struct alignas(16) Vf {
   }
 
   void mul(Mask mask, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] * b;
-      }
-    }
+    store_masked(mask, _mm_mul_ps(a.load(), _mm_set1_ps(b)));
   }
 
   void itof0(Mask mask, const Vf& a) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        s32 val;
-        memcpy(&val, &a.data[i], 4);
-        data[i] = val;
-      }
-    }
+    store_masked(mask, _mm_cvtepi32_ps(_mm_castps_si128(a.load())));
   }
 
   void itof12(Mask mask, const Vf& a) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        s32 val;
-        memcpy(&val, &a.data[i], 4);
-        data[i] = ((float)val) * (1.f / 4096.f);
-      }
-    }
+    store_masked(mask, _mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(a.load())),
+                                  _mm_set1_ps(1.f / 4096.f)));
   }
 
   void itof15(Mask mask, const Vf& a) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        s32 val;
-        memcpy(&val, &a.data[i], 4);
-        data[i] = ((float)val) * (1.f / 32768.f);
-      }
-    }
+    store_masked(mask, _mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(a.load())),
+                                  _mm_set1_ps(1.f / 32768.f)));
   }
 
   void ftoi4(Mask mask, const Vf& a) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        s32 val = a.data[i] * 16.f;
-        memcpy(&data[i], &val, 4);
-      }
-    }
+    store_masked(mask,
+                 _mm_castsi128_ps(_mm_cvttps_epi32(_mm_mul_ps(a.load(), _mm_set1_ps(16.f)))));
   }
 
   void ftoi4_check(Mask /*mask*/, const Vf& a) {
@@ -425,15 +395,8 @@ struct alignas(16) Vf {
   }
 
   void ftoi12(Mask mask, const Vf& a) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        //        if (std::isnan(a.data[i])) {
-        //          ASSERT(false);
-        //        }
-        s32 val = a.data[i] * 4096.f;
-        memcpy(&data[i], &val, 4);
-      }
-    }
+    store_masked(
+        mask, _mm_castsi128_ps(_mm_cvttps_epi32(_mm_mul_ps(a.load(), _mm_set1_ps(4096.f)))));
   }
 
   void ftoi12_check(Mask mask, const Vf& a) {
@@ -449,44 +412,32 @@ struct alignas(16) Vf {
   }
 
   void ftoi0(Mask mask, const Vf& a) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        s32 val = a.data[i];
-        memcpy(&data[i], &val, 4);
-      }
-    }
+    store_masked(mask, _mm_castsi128_ps(_mm_cvttps_epi32(a.load())));
   }
 };
 
 struct alignas(16) Accumulator {
   float data[4];
 
+  REALLY_INLINE __m128 load() const { return _mm_load_ps(data); }
+  REALLY_INLINE void store_masked(Mask mask, __m128 val) {
+    _mm_store_ps(data, vu_blend_mask(load(), val, mask));
+  }
+
   std::string print() const {
     return fmt::format("{} {} {} {}", data[0], data[1], data[2], data[3]);
   }
 
   void adda(Mask mask, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] + b;
-      }
-    }
+    store_masked(mask, _mm_add_ps(a.load(), _mm_set1_ps(b)));
   }
 
   void madda(Mask mask, const Vf& a, const Vf& b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] += a[i] * b[i];
-      }
-    }
+    store_masked(mask, _mm_add_ps(load(), _mm_mul_ps(a.load(), b.load())));
   }
 
   void madda(Mask mask, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] += a[i] * b;
-      }
-    }
+    store_masked(mask, _mm_add_ps(load(), _mm_mul_ps(a.load(), _mm_set1_ps(b))));
   }
 
   REALLY_INLINE void madda_xyzw(const Vf& _a, float _b) {
@@ -504,11 +455,7 @@ struct alignas(16) Accumulator {
   }
 
   void madd(Mask mask, Vf& dest, const Vf& a, const Vf& b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        dest[i] = data[i] + a[i] * b[i];
-      }
-    }
+    dest.store_masked(mask, _mm_add_ps(load(), _mm_mul_ps(a.load(), b.load())));
   }
 
   REALLY_INLINE void madd_xyzw(Vf& dest, const Vf& _a, float _b) {
@@ -528,27 +475,15 @@ struct alignas(16) Accumulator {
   }
 
   void madd(Mask mask, Vf& dest, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        dest[i] = data[i] + a[i] * b;
-      }
-    }
+    dest.store_masked(mask, _mm_add_ps(load(), _mm_mul_ps(a.load(), _mm_set1_ps(b))));
   }
 
   void msub(Mask mask, Vf& dest, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        dest[i] = data[i] - a[i] * b;
-      }
-    }
+    dest.store_masked(mask, _mm_sub_ps(load(), _mm_mul_ps(a.load(), _mm_set1_ps(b))));
   }
 
   void msuba(Mask mask, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] -= a[i] * b;
-      }
-    }
+    store_masked(mask, _mm_sub_ps(load(), _mm_mul_ps(a.load(), _mm_set1_ps(b))));
   }
 
   u16 madd_flag(Mask mask, Vf& dest, const Vf& a, float b) {
@@ -568,19 +503,11 @@ struct alignas(16) Accumulator {
   }
 
   void mula(Mask mask, const Vf& a, const Vf& b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] * b[i];
-      }
-    }
+    store_masked(mask, _mm_mul_ps(a.load(), b.load()));
   }
 
   void mula(Mask mask, const Vf& a, float b) {
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        data[i] = a[i] * b;
-      }
-    }
+    store_masked(mask, _mm_mul_ps(a.load(), _mm_set1_ps(b)));
   }
 
   REALLY_INLINE void mula_xyzw(const Vf& _a, float _b) {
@@ -607,3 +534,23 @@ struct alignas(16) Accumulator {
     dst.data[2] = data[2] - a.data[0] * b.data[1];
   }
 };
+
+/*!
+ * clipw.xyz: shift the old clip flags up by 6, and set the flags for x, y and z being outside of
+ * +/- |w|. The bits are x+, x-, y+, y-, z+, z- from the lowest. Only 24 bits of flags are kept.
+ * Comparing -v against +|w| is the same as comparing v against -|w|, so both sides of x and y are
+ * checked in a single compare.
+ */
+static inline REALLY_INLINE u32 vu_clip(__m128 v, float val, u32 old_clip) {
+  const __m128 plus = _mm_set1_ps(std::abs(val));
+  const __m128 negate_odd = _mm_castsi128_ps(_mm_setr_epi32(0, 0x80000000, 0, 0x80000000));
+  __m128 xxyy = _mm_xor_ps(_mm_unpacklo_ps(v, v), negate_odd);
+  __m128 zzww = _mm_xor_ps(_mm_unpackhi_ps(v, v), negate_odd);
+  u32 xy_flags = _mm_movemask_ps(_mm_cmpgt_ps(xxyy, plus));
+  u32 z_flags = _mm_movemask_ps(_mm_cmpgt_ps(zzww, plus)) & 0b11;
+  return ((old_clip << 6) | xy_flags | (z_flags << 4)) & 0xffffff;  // only 24 bits
+}
+
+static inline REALLY_INLINE u32 vu_clip(const Vf& vector, float val, u32 old_clip) {
+  return vu_clip(vector.load(), val, old_clip);
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+/*!
+ * @file vu2c.h
+ * The VU state and helpers used by VU programs converted to C++ with tools/vu2c.
+ * See decompiler/VuDisasm/Vu2C.h for how the code is generated.
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include "game/common/vu.h"
+
+/*!
+ * The registers and data memory of a VU. Generated programs keep the registers they use in locals
+ * while running, and write them back here when they end.
+ */
+struct alignas(16) VuState {
+  VuState() {
+    for (auto& vf_reg : vf) {
+      vf_reg.set_zero();
+    }
+    vf[0].w() = 1.f;
+    memset(acc.data, 0, sizeof(acc.data));
+  }
+
+  Vf vf[32];
+  Accumulator acc;
+  u16 vi[16] = {};
+  float Q = 0, P = 0, I = 0;
+  u32 clip_flags = 0;
+  u16 top = 0;         // the value read by xtop
+  u8* data = nullptr;  // data memory, 16-byte aligned. 4 KB on VU0, 16 KB on VU1.
+};
+
+// broadcast a lane to all four lanes.
+template <int lane>
+static inline REALLY_INLINE __m128 vu_bc(__m128 v) {
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane));
+}
+
+template <int lane>
+static inline REALLY_INLINE float vu_lane(__m128 v) {
+  return _mm_cvtss_f32(vu_bc<lane>(v));
+}
+
+// the low 16 bits of a lane, like mtir.
+template <int lane>
+static inline REALLY_INLINE u16 vu_lane_u16(__m128 v) {
+  return (u16)_mm_extract_epi32(_mm_castps_si128(v), lane);
+}
+
+static inline REALLY_INLINE float vu_float_bits(u32 bits) {
+  float result;
+  memcpy(&result, &bits, 4);
+  return result;
+}
+
+// same as vu_max, lane by lane.
+static inline REALLY_INLINE __m128 vu_max_ps(__m128 a, __m128 b) {
+  return _mm_max_ps(a, b);
+}
+
+// same as vu_min, lane by lane: compare as integers, and flip the result if both are negative.
+static inline REALLY_INLINE __m128 vu_min_ps(__m128 a, __m128 b) {
+  __m128i ai = _mm_castps_si128(a);
+  __m128i bi = _mm_castps_si128(b);
+  __m128i flip = _mm_srai_epi32(_mm_and_si128(ai, bi), 31);
+  __m128i take_b = _mm_xor_si128(_mm_cmpgt_epi32(ai, bi), flip);
+  return _mm_blendv_ps(a, b, _mm_castsi128_ps(take_b));
+}
+
+template <int shift>
+static inline REALLY_INLINE __m128 vu_ftoi(__m128 v) {
+  if constexpr (shift != 0) {
+    v = _mm_mul_ps(v, _mm_set1_ps((float)(1 << shift)));
+  }
+  return _mm_castsi128_ps(_mm_cvttps_epi32(v));
+}
+
+template <int shift>
+static inline REALLY_INLINE __m128 vu_itof(__m128 v) {
+  __m128 result = _mm_cvtepi32_ps(_mm_castps_si128(v));
+  if constexpr (shift != 0) {
+    result = _mm_mul_ps(result, _mm_set1_ps(1.f / (float)(1 << shift)));
+  }
+  return result;
+}
+
+static inline REALLY_INLINE __m128 vu_mr32(__m128 v) {
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 3, 2, 1));
+}
+
+// the outer product part of opmula and opmsub: a.yzx * b.zxy
+static inline REALLY_INLINE __m128 vu_opmul(__m128 a, __m128 b) {
+  return _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)),
+                    _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2)));
+}
+
+static inline REALLY_INLINE __m128 vu_mfir(u16 val) {
+  return _mm_castsi128_ps(_mm_set1_epi32((s16)val));
+}
+
+static inline REALLY_INLINE float vu_esadd(__m128 v) {
+  float f[4];
+  _mm_storeu_ps(f, v);
+  return f[0] * f[0] + f[1] * f[1] + f[2] * f[2];
+}
+
+static inline REALLY_INLINE float vu_esum(__m128 v) {
+  float f[4];
+  _mm_storeu_ps(f, v);
+  return f[0] + f[1] + f[2] + f[3];
+}
+
+static inline REALLY_INLINE u16 vu_fcand(u32 cf, u32 imm) {
+  return (cf & imm & 0xffffff) ? 1 : 0;
+}
+
+static inline REALLY_INLINE u16 vu_fcor(u32 cf, u32 imm) {
+  return ((cf | imm) & 0xffffff) == 0xffffff ? 1 : 0;
+}
+
+// addresses are in quadwords, and already wrapped to the size of the data memory.
+static inline REALLY_INLINE __m128 vu_lq(const u8* data, u32 addr) {
+  return _mm_load_ps((const float*)(data + 16 * addr));
+}
+
+template <int lanes>
+static inline REALLY_INLINE void vu_sq(u8* data, u32 addr, __m128 val) {
+  float* dst = (float*)(data + 16 * addr);
+  if constexpr (lanes == 0b1111) {
+    _mm_store_ps(dst, val);
+  } else {
+    _mm_store_ps(dst, _mm_blend_ps(_mm_load_ps(dst), val, lanes));
+  }
+}
+
+template <int lane>
+static inline REALLY_INLINE u16 vu_ilw(const u8* data, u32 addr) {
+  u16 result;
+  memcpy(&result, data + 16 * addr + 4 * lane, 2);
+  return result;
+}
+
+template <int lanes>
+static inline REALLY_INLINE void vu_isw(u8* data, u32 addr, u16 val) {
+  u32 val32 = val;
+  for (int i = 0; i < 4; i++) {
+    if (lanes & (1 << i)) {
+      memcpy(data + 16 * addr + 4 * i, &val32, 4);
+    }
+  }
+}
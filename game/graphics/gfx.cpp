@@ -7,9 +7,11 @@
 
 #include <cstdio>
 #include <functional>
+#include <mutex>
 #include <utility>
 
 #include "display.h"
+#include "gfx_capture.h"
 
 #include "common/global_profiler/GlobalProfiler.h"
 #include "common/log/log.h"
@@ -21,6 +23,7 @@
 #include "game/kernel/common/kmachine.h"
 #include "game/kernel/common/kscheme.h"
 #include "game/runtime.h"
+#include "pipelines/null.h"
 #include "pipelines/opengl.h"
 
 namespace Gfx {
@@ -29,6 +32,24 @@ std::function<void()> vsync_callback;
 GfxGlobalSettings g_global_settings;
 game_settings::DebugSettings g_debug_settings;
 
+// graphics capture state. Jak 2 uploads textures from the VIF interrupt handler on the render
+// thread, so this is shared with the game thread.
+struct CaptureState {
+  std::mutex mutex;
+  std::unique_ptr<GfxCaptureWriter> writer;
+  fs::path path;
+  int skip_frames = 0;
+  int frame_count = 0;
+  bool pending = false;
+  int frames_seen = 0;
+  // the game only sends these when they change, so remember them for the start of the capture.
+  std::vector<std::string> levels, prefetch_levels;
+} g_capture;
+
+// the id passed to the VIF interrupt handler running on this thread, or -1.
+thread_local int t_vif_interrupt_bucket = -1;
+std::function<void(int)> vif_interrupt_replay_callback;
+
 const GfxRendererModule* GetRenderer(GfxPipeline pipeline) {
   switch (pipeline) {
     case GfxPipeline::Invalid:
@@ -36,6 +57,8 @@ const GfxRendererModule* GetRenderer(GfxPipeline pipeline) {
       return NULL;
     case GfxPipeline::OpenGL:
       return &gRendererOpenGL;
+    case GfxPipeline::Null:
+      return &gRendererNull;
     default:
       lg::error("Requested unknown renderer {}", fmt::underlying(pipeline));
       return NULL;
@@ -50,14 +73,14 @@ const GfxRendererModule* GetCurrentRenderer() {
   return g_global_settings.renderer;
 }
 
-u32 Init(GameVersion version) {
+u32 Init(GameVersion version, GfxPipeline pipeline) {
   lg::info("GFX Init");
   prof().instant_event("ROOT");
 
   g_debug_settings = game_settings::DebugSettings();
   {
     auto p = scoped_prof("startup::gfx::get_renderer");
-    g_global_settings.renderer = GetRenderer(GfxPipeline::OpenGL);
+    g_global_settings.renderer = GetRenderer(pipeline);
   }
 
   {
@@ -68,7 +91,9 @@ u32 Init(GameVersion version) {
     }
   }
 
-  if (g_main_thread_id != std::this_thread::get_id()) {
+  if (pipeline == GfxPipeline::Null) {
+    // headless, there's no display to create.
+  } else if (g_main_thread_id != std::this_thread::get_id()) {
     lg::error("Ran Gfx::Init outside main thread. Init display elsewhere?");
   } else {
     {
@@ -99,7 +124,9 @@ void Loop(std::function<bool()> f) {
 
 u32 Exit() {
   lg::info("GFX Exit");
-  Display::KillMainDisplay();
+  if (Display::GetMainDisplay()) {
+    Display::KillMainDisplay();
+  }
   GetCurrentRenderer()->exit();
   g_debug_settings.save_settings();
   return 0;
@@ -130,6 +157,114 @@ u32 sync_path() {
   return 0;
 }
 
+void start_capture(const fs::path& path, int skip_frames, int frame_count) {
+  std::lock_guard<std::mutex> lk(g_capture.mutex);
+  g_capture.path = path;
+  g_capture.skip_frames = g_capture.frames_seen + skip_frames;
+  g_capture.frame_count = frame_count;
+  g_capture.pending = true;
+}
+
+void begin_vif_interrupt(int bucket_id) {
+  t_vif_interrupt_bucket = bucket_id;
+  if (vif_interrupt_replay_callback) {
+    vif_interrupt_replay_callback(bucket_id);
+  }
+}
+
+void end_vif_interrupt() {
+  t_vif_interrupt_bucket = -1;
+}
+
+void register_vif_interrupt_replay_callback(std::function<void(int)> f) {
+  vif_interrupt_replay_callback = std::move(f);
+}
+
+void clear_vif_interrupt_replay_callback() {
+  vif_interrupt_replay_callback = nullptr;
+}
+
+/*!
+ * Record an event, if we are capturing. Starts the capture if it's time to.
+ */
+void capture_event(GfxCaptureEvent::Kind kind,
+                   u32 arg0,
+                   u32 arg1,
+                   u32 arg2,
+                   const std::vector<std::string>* levels) {
+  std::lock_guard<std::mutex> lk(g_capture.mutex);
+  bool in_chain = t_vif_interrupt_bucket >= 0;
+  if (kind == GfxCaptureEvent::Kind::SET_LEVELS) {
+    g_capture.levels = *levels;
+  } else if (kind == GfxCaptureEvent::Kind::SET_PREFETCH_LEVELS) {
+    g_capture.prefetch_levels = *levels;
+  }
+
+  if (g_capture.pending && !in_chain && g_capture.frames_seen >= g_capture.skip_frames) {
+    g_capture.pending = false;
+    g_capture.writer = std::make_unique<GfxCaptureWriter>(g_capture.path, g_game_version,
+                                                          s7.offset, g_capture.frame_count);
+    GfxCaptureEvent set_levels_event;
+    set_levels_event.kind = GfxCaptureEvent::Kind::SET_LEVELS;
+    set_levels_event.levels = g_capture.levels;
+    g_capture.writer->add(set_levels_event, g_ee_main_mem, false);
+    GfxCaptureEvent prefetch_event;
+    prefetch_event.kind = GfxCaptureEvent::Kind::SET_PREFETCH_LEVELS;
+    prefetch_event.levels = g_capture.prefetch_levels;
+    g_capture.writer->add(prefetch_event, g_ee_main_mem, false);
+  }
+
+  if (g_capture.writer) {
+    GfxCaptureEvent event;
+    event.kind = kind;
+    event.args[0] = arg0;
+    event.args[1] = arg1;
+    event.args[2] = arg2;
+    if (levels) {
+      event.levels = *levels;
+    }
+    event.bucket = t_vif_interrupt_bucket;
+    // the chain and the texture pages are in game memory. Uploads during the chain use the memory
+    // from when it was sent: the game thread is already changing memory for the next frame.
+    bool sync_memory = kind == GfxCaptureEvent::Kind::SEND_CHAIN ||
+                       (kind == GfxCaptureEvent::Kind::TEXTURE_UPLOAD_NOW && !in_chain);
+    g_capture.writer->add(event, g_ee_main_mem, sync_memory);
+    if (g_capture.writer->done()) {
+      g_capture.writer.reset();
+    }
+  }
+
+  if (kind == GfxCaptureEvent::Kind::SEND_CHAIN) {
+    g_capture.frames_seen++;
+  }
+}
+
+void send_chain(const void* data, u32 offset) {
+  capture_event(GfxCaptureEvent::Kind::SEND_CHAIN, offset, 0, 0, nullptr);
+  GetCurrentRenderer()->send_chain(data, offset);
+}
+
+void texture_upload_now(const u8* tpage, int mode, u32 s7_ptr) {
+  capture_event(GfxCaptureEvent::Kind::TEXTURE_UPLOAD_NOW, tpage - g_ee_main_mem, mode, s7_ptr,
+                nullptr);
+  GetCurrentRenderer()->texture_upload_now(tpage, mode, s7_ptr);
+}
+
+void texture_relocate(u32 destination, u32 source, u32 format) {
+  capture_event(GfxCaptureEvent::Kind::TEXTURE_RELOCATE, destination, source, format, nullptr);
+  GetCurrentRenderer()->texture_relocate(destination, source, format);
+}
+
+void set_levels(const std::vector<std::string>& levels) {
+  capture_event(GfxCaptureEvent::Kind::SET_LEVELS, 0, 0, 0, &levels);
+  GetCurrentRenderer()->set_levels(levels);
+}
+
+void set_prefetch_levels(const std::vector<std::string>& levels) {
+  capture_event(GfxCaptureEvent::Kind::SET_PREFETCH_LEVELS, 0, 0, 0, &levels);
+  GetCurrentRenderer()->set_prefetch_levels(levels);
+}
+
 bool CollisionRendererGetMask(GfxGlobalSettings::CollisionRendererMode mode, int mask_id) {
   int arr_idx = mask_id / 32;
   int arr_ofs = mask_id % 32;
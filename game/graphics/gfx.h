@@ -8,6 +8,8 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/util/FileUtil.h"
@@ -23,7 +25,7 @@ struct GfxGlobalSettings;
 class GfxDisplay;
 
 // enum for rendering pipeline
-enum class GfxPipeline { Invalid = 0, OpenGL };
+enum class GfxPipeline { Invalid = 0, OpenGL, Null };
 
 // module for the different rendering pipelines
 struct GfxRendererModule {
@@ -42,7 +44,10 @@ struct GfxRendererModule {
   std::function<void(const u8*, int, u32)> texture_upload_now;
   std::function<void(u32, u32, u32)> texture_relocate;
   std::function<void(const std::vector<std::string>&)> set_levels;
+  std::function<void(const std::vector<std::string>&)> set_prefetch_levels;
   std::function<void(float)> set_pmode_alp;
+  // CPU time spent in each bucket during the last frame, in milliseconds.
+  std::function<std::vector<float>()> bucket_times_ms;
   GfxPipeline pipeline;
   const char* name;
 };
@@ -84,6 +89,12 @@ struct GfxGlobalSettings {
   // frame timing things
   bool experimental_accurate_lag = false;
   bool sleep_in_frame_limiter = true;
+  // let the game start its next frame while the renderer presents the last one. Off by default, so
+  // the game and renderer stay in lockstep for accuracy testing.
+  bool pipeline_frames = false;
+  // write per-frame renderer metrics to this file, if set. See FrameTelemetry.h.
+  std::string telemetry_path;
+  bool telemetry_binary = false;
 
   // fancy effect things
   bool hack_no_tex = false;
@@ -107,7 +118,7 @@ extern game_settings::DebugSettings g_debug_settings;
 
 const GfxRendererModule* GetCurrentRenderer();
 
-u32 Init(GameVersion version);
+u32 Init(GameVersion version, GfxPipeline pipeline = GfxPipeline::OpenGL);
 void Loop(std::function<bool()> f);
 u32 Exit();
 
@@ -116,6 +127,24 @@ void register_vsync_callback(std::function<void()> f);
 void clear_vsync_callback();
 u32 sync_path();
 
+// forward to the current renderer, and record for graphics capture.
+void send_chain(const void* data, u32 offset);
+void texture_upload_now(const u8* tpage, int mode, u32 s7_ptr);
+void texture_relocate(u32 destination, u32 source, u32 format);
+void set_levels(const std::vector<std::string>& levels);
+void set_prefetch_levels(const std::vector<std::string>& levels);
+
+// record frame_count frames of graphics input to a file, after skipping skip_frames frames.
+void start_capture(const fs::path& path, int skip_frames, int frame_count);
+
+// the renderer calls the game's VIF interrupt handler between buckets (see vif_interrupt_callback).
+// Texture uploads from the handler are captured with the bucket id.
+void begin_vif_interrupt(int bucket_id);
+void end_vif_interrupt();
+// replay has no game to handle the interrupts, so it does the captured uploads from this callback.
+void register_vif_interrupt_replay_callback(std::function<void(int)> f);
+void clear_vif_interrupt_replay_callback();
+
 // matching enum in kernel-defs.gc !!
 enum class RendererTreeType { NONE = 0, TFRAG3 = 1, TIE3 = 2, INVALID };
 bool CollisionRendererGetMask(GfxGlobalSettings::CollisionRendererMode mode, int mask_id);
@@ -0,0 +1,156 @@
+#include "gfx_capture.h"
+
+#include <cstring>
+
+#include "common/dma/dma_copy.h"
+#include "common/goal_constants.h"
+#include "common/log/log.h"
+#include "common/util/Assert.h"
+#include "common/util/compress.h"
+
+#include "third-party/fmt/core.h"
+
+namespace {
+constexpr u32 CHUNK_SIZE = FixedChunkDmaCopier::chunk_size;
+}
+
+void GfxCaptureEvent::serialize(Serializer& ser) {
+  ser.from_ptr(&kind);
+  ser.from_raw_data(args, sizeof(args));
+  ser.from_string_vector(&levels);
+  ser.from_ptr(&frame);
+  ser.from_ptr(&bucket);
+  ser.from_pod_vector(&chunks);
+  ser.from_pod_vector(&chunk_data);
+}
+
+/*!
+ * Copy the chunks stored in this event to memory.
+ */
+void GfxCaptureEvent::apply_memory(u8* memory, u32 chunk_size) const {
+  if (chunks.empty()) {
+    return;
+  }
+  auto data = compression::decompress_zstd(chunk_data.data(), chunk_data.size());
+  ASSERT(data.size() == chunks.size() * chunk_size);
+  for (size_t i = 0; i < chunks.size(); i++) {
+    memcpy(memory + chunks[i] * chunk_size, data.data() + i * chunk_size, chunk_size);
+  }
+}
+
+GfxCaptureWriter::GfxCaptureWriter(const fs::path& path,
+                                   GameVersion version,
+                                   u32 s7_offset,
+                                   int frame_count)
+    : m_path(path.string()),
+      m_compressor(compression::ZstdSettings::fast()),
+      m_frame_count(frame_count) {
+  file_util::create_dir_if_needed_for_file(path);
+  m_file = file_util::open_file(path, "wb");
+  if (!m_file) {
+    lg::error("Failed to open {} for graphics capture", m_path);
+    return;
+  }
+  GfxCaptureHeader header;
+  header.game_version = (u32)version;
+  header.s7_offset = s7_offset;
+  header.memory_size = EE_MAIN_MEM_SIZE;
+  header.chunk_size = CHUNK_SIZE;
+  fwrite(&header, sizeof(header), 1, m_file);
+  m_bytes_written += sizeof(header);
+  m_last_memory.resize(EE_MAIN_MEM_SIZE);
+  lg::info("Started graphics capture of {} frames to {}", frame_count, m_path);
+}
+
+GfxCaptureWriter::~GfxCaptureWriter() {
+  finish();
+}
+
+void GfxCaptureWriter::diff_memory(GfxCaptureEvent* event, const u8* memory) {
+  for (u32 chunk = 0; chunk < EE_MAIN_MEM_SIZE / CHUNK_SIZE; chunk++) {
+    const u8* src = memory + chunk * CHUNK_SIZE;
+    u8* last = m_last_memory.data() + chunk * CHUNK_SIZE;
+    if (!m_have_memory || memcmp(src, last, CHUNK_SIZE)) {
+      memcpy(last, src, CHUNK_SIZE);
+      event->chunks.push_back(chunk);
+      m_compressor.add(src, CHUNK_SIZE);
+    }
+  }
+  event->chunk_data = m_compressor.finish();
+  m_have_memory = true;
+}
+
+void GfxCaptureWriter::add(GfxCaptureEvent& event, const u8* memory, bool sync_memory) {
+  if (!m_file) {
+    return;
+  }
+
+  if (event.kind == GfxCaptureEvent::Kind::SEND_CHAIN && m_frames_written == m_frame_count) {
+    // the last chain is done rendering, so there are no more uploads from it.
+    finish();
+    return;
+  }
+
+  if (event.bucket >= 0) {
+    if (m_frames_written == 0) {
+      return;  // from a chain that was sent before the capture started.
+    }
+    event.frame = m_frames_written - 1;
+  }
+
+  // the first event has all of memory, so every event after it has something to diff against.
+  if (sync_memory || !m_have_memory) {
+    diff_memory(&event, memory);
+  }
+
+  Serializer ser;
+  event.serialize(ser);
+  auto result = ser.get_save_result();
+  u64 size = result.second;
+  fwrite(&size, sizeof(size), 1, m_file);
+  fwrite(result.first, result.second, 1, m_file);
+  m_bytes_written += sizeof(size) + size;
+
+  if (event.kind == GfxCaptureEvent::Kind::SEND_CHAIN) {
+    m_frames_written++;
+  }
+}
+
+void GfxCaptureWriter::finish() {
+  if (m_file) {
+    fclose(m_file);
+    m_file = nullptr;
+    lg::info("Finished graphics capture: {} frames, {:.2f} MB in {}",
+             m_frames_written, m_bytes_written / (1024. * 1024.), m_path);
+  }
+}
+
+GfxCapture read_gfx_capture(const fs::path& path) {
+  auto data = file_util::read_binary_file(path);
+  GfxCapture result;
+  ASSERT_MSG(data.size() >= sizeof(GfxCaptureHeader),
+             fmt::format("{} is too small to be a graphics capture", path.string()));
+  memcpy(&result.header, data.data(), sizeof(GfxCaptureHeader));
+  ASSERT_MSG(result.header.magic == GFX_CAPTURE_MAGIC,
+             fmt::format("{} is not a graphics capture", path.string()));
+  ASSERT_MSG(result.header.version == GFX_CAPTURE_VERSION,
+             fmt::format("{} has capture version {}, but expected {}", path.string(),
+                         result.header.version, GFX_CAPTURE_VERSION));
+
+  size_t offset = sizeof(GfxCaptureHeader);
+  while (offset < data.size()) {
+    u64 size;
+    ASSERT(offset + sizeof(size) <= data.size());
+    memcpy(&size, data.data() + offset, sizeof(size));
+    offset += sizeof(size);
+    ASSERT(offset + size <= data.size());
+    Serializer ser(data.data() + offset, size, Serializer::LoadMode::BORROW);
+    auto& event = result.events.emplace_back();
+    event.serialize(ser);
+    offset += size;
+    if (event.kind == GfxCaptureEvent::Kind::SEND_CHAIN) {
+      result.frame_count++;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+/*!
+ * @file gfx_capture.h
+ * Record the graphics input from the game for a number of frames, so the renderer can be run on it
+ * later without the game. See tools/gfx_replay.
+ *
+ * The renderers read game memory outside of the DMA chain (texture pages, for example), so each
+ * event also stores the chunks of EE memory that changed since the previous one. The first event
+ * stores all of memory.
+ *
+ * In Jak 2, the game also uploads textures from the VIF interrupt handler, which the renderer runs
+ * between buckets while it renders a chain. These are stored with the chain and bucket they
+ * happened in, so a replay can do them at the same point.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Serializer.h"
+#include "common/util/compress.h"
+#include "common/versions/versions.h"
+
+constexpr u32 GFX_CAPTURE_MAGIC = 0x50414347;  // GCAP
+constexpr u32 GFX_CAPTURE_VERSION = 2;
+
+struct GfxCaptureHeader {
+  u32 magic = GFX_CAPTURE_MAGIC;
+  u32 version = GFX_CAPTURE_VERSION;
+  u32 game_version = 0;
+  u32 s7_offset = 0;
+  u32 memory_size = 0;
+  u32 chunk_size = 0;
+};
+
+/*!
+ * A call from the game to the renderer module.
+ */
+struct GfxCaptureEvent {
+  enum class Kind : u32 {
+    SEND_CHAIN,           // args: offset
+    TEXTURE_UPLOAD_NOW,   // args: page, mode, s7
+    TEXTURE_RELOCATE,     // args: destination, source, format
+    SET_LEVELS,           // levels
+    SET_PREFETCH_LEVELS,  // levels
+  };
+  Kind kind = Kind::SEND_CHAIN;
+  u32 args[3] = {0, 0, 0};
+  std::vector<std::string> levels;
+
+  // for uploads from the VIF interrupt handler: the index of the chain being rendered, and the id
+  // passed to the handler. Both are -1 for events from the game thread.
+  s32 frame = -1;
+  s32 bucket = -1;
+
+  // indices of the memory chunks that changed before this event, and their zstd compressed data.
+  std::vector<u32> chunks;
+  std::vector<u8> chunk_data;
+
+  void serialize(Serializer& ser);
+  void apply_memory(u8* memory, u32 chunk_size) const;
+};
+
+/*!
+ * Writes events to a capture file as they happen. Not thread safe: the caller must lock around it
+ * when events come from both the game and render threads.
+ */
+class GfxCaptureWriter {
+ public:
+  GfxCaptureWriter(const fs::path& path, GameVersion version, u32 s7_offset, int frame_count);
+  ~GfxCaptureWriter();
+  GfxCaptureWriter(const GfxCaptureWriter&) = delete;
+  GfxCaptureWriter& operator=(const GfxCaptureWriter&) = delete;
+
+  bool ok() const { return m_file != nullptr; }
+  bool done() const { return m_file == nullptr; }
+
+  // the memory is compared to the copy from the last sync, only if the event needs it. Events with
+  // a bucket are stored with the last chain.
+  void add(GfxCaptureEvent& event, const u8* memory, bool sync_memory);
+
+ private:
+  void diff_memory(GfxCaptureEvent* event, const u8* memory);
+  void finish();
+
+  FILE* m_file = nullptr;
+  std::string m_path;
+  std::vector<u8> m_last_memory;
+  bool m_have_memory = false;
+  compression::ZstdCompressor m_compressor;
+  int m_frames_written = 0;
+  int m_frame_count = 0;
+  u64 m_bytes_written = 0;
+};
+
+struct GfxCapture {
+  GfxCaptureHeader header;
+  std::vector<GfxCaptureEvent> events;
+  int frame_count = 0;
+};
+
+GfxCapture read_gfx_capture(const fs::path& path);
@@ -7,6 +7,33 @@ std::string BucketRenderer::name_and_id() const {
   return fmt::format("[{:2d}] {}", (int)m_my_id, m_name);
 }
 
+void PreparedBucketRenderer::prepare(DmaFollower& dma,
+                                     u32 next_bucket,
+                                     const SharedRenderState& render_state) {
+  prepare_dma(dma, next_bucket, render_state);
+  m_prepared = true;
+}
+
+void PreparedBucketRenderer::render(DmaFollower& dma,
+                                    SharedRenderState* render_state,
+                                    ScopedProfilerNode& prof) {
+  if (m_enabled && !m_prepared) {
+    auto p = prof.make_scoped_child("prepare");
+    DmaFollower bucket_dma = dma;
+    prepare(bucket_dma, render_state->next_bucket, *render_state);
+  }
+
+  // prepare already read this bucket, so just skip to the next one.
+  while (dma.current_tag_offset() != render_state->next_bucket) {
+    dma.read_and_advance();
+  }
+
+  if (m_enabled && m_prepared) {
+    submit(render_state, prof);
+  }
+  m_prepared = false;
+}
+
 EmptyBucketRenderer::EmptyBucketRenderer(const std::string& name, int my_id)
     : BucketRenderer(name, my_id) {}
 
@@ -117,12 +117,45 @@ class BucketRenderer {
   virtual void init_shaders(ShaderLibrary&) {}
   virtual void init_textures(TexturePool&, GameVersion) {}
 
+  // renderers that can do their CPU work ahead of time, see PreparedBucketRenderer.
+  virtual bool can_prepare() const { return false; }
+  virtual void prepare(DmaFollower& /*dma*/,
+                       u32 /*next_bucket*/,
+                       const SharedRenderState& /*render_state*/) {}
+
  protected:
   std::string m_name;
   int m_my_id;
   bool m_enabled = true;
 };
 
+/*!
+ * A bucket renderer split into a CPU-only prepare step, which reads the DMA and builds everything
+ * that will be drawn, and a submit step that does the OpenGL calls.
+ *
+ * The OpenGLRenderer may run prepare on a worker thread, at the same time as the other buckets are
+ * prepared and rendered. It gets a DmaFollower for just this bucket, and must not use OpenGL or
+ * change anything outside of the renderer. Only the parts of the render state that are set up
+ * before the buckets run (like the version) can be read. If prepare didn't run ahead of time,
+ * render runs it before submitting.
+ */
+class PreparedBucketRenderer : public BucketRenderer {
+ public:
+  PreparedBucketRenderer(const std::string& name, int my_id) : BucketRenderer(name, my_id) {}
+  void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) final;
+  bool can_prepare() const final { return m_enabled; }
+  void prepare(DmaFollower& dma, u32 next_bucket, const SharedRenderState& render_state) final;
+
+ protected:
+  virtual void prepare_dma(DmaFollower& dma,
+                           u32 next_bucket,
+                           const SharedRenderState& render_state) = 0;
+  virtual void submit(SharedRenderState* render_state, ScopedProfilerNode& prof) = 0;
+
+ private:
+  bool m_prepared = false;
+};
+
 class RenderMux : public BucketRenderer {
  public:
   RenderMux(const std::string& name,
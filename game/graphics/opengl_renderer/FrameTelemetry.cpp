@@ -0,0 +1,282 @@
+#include "FrameTelemetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+
+#include "common/log/log.h"
+#include "common/util/Assert.h"
+#include "common/util/BinaryReader.h"
+
+#include "third-party/fmt/format.h"
+
+namespace {
+constexpr u32 kBinaryMagic = 0x4c54474f;  // OGTL
+constexpr u32 kBinaryVersion = 1;
+
+template <typename T>
+void append(std::string* out, const T& obj) {
+  out->append((const char*)&obj, sizeof(T));
+}
+
+void append_name(std::string* out, const std::string& name) {
+  append<u32>(out, name.size());
+  out->append(name);
+}
+
+std::string read_name(BinaryReader& reader) {
+  u32 len = reader.read<u32>();
+  ASSERT(len <= reader.bytes_left());
+  std::string result((const char*)reader.here(), len);
+  reader.ffwd(len);
+  return result;
+}
+}  // namespace
+
+void TimeHistogram::add(float ms) {
+  ms = std::max(ms, 0.f);
+  int bin = std::min(BIN_COUNT - 1, (int)std::ceil(ms / BIN_MS));
+  m_bins[bin]++;
+  m_count++;
+  m_sum += ms;
+  m_max = std::max(m_max, ms);
+}
+
+float TimeHistogram::percentile(float p) const {
+  if (!m_count) {
+    return 0;
+  }
+  u64 rank = std::max<u64>(1, (u64)std::ceil(p * m_count));
+  u64 seen = 0;
+  for (int i = 0; i < BIN_COUNT; i++) {
+    seen += m_bins[i];
+    if (seen >= rank) {
+      // the last bin holds everything slower, so its upper bound is the max.
+      return i == BIN_COUNT - 1 ? m_max : std::min(m_max, i * BIN_MS);
+    }
+  }
+  return m_max;
+}
+
+bool HitchDetector::add(const FrameTelemetryRecord& record) {
+  if (m_average_ms == 0) {
+    m_average_ms = record.frame_ms;
+    return false;
+  }
+
+  bool hitch = record.frame_ms > AVERAGE_FACTOR * m_average_ms &&
+               record.frame_ms > record.target_ms + MIN_LATE_MS;
+  if (!hitch) {
+    // hitches are left out, so a long stall doesn't raise the bar for the next one.
+    m_average_ms += 0.05f * (record.frame_ms - m_average_ms);
+    return false;
+  }
+
+  m_count++;
+  auto it = std::find_if(m_worst.begin(), m_worst.end(), [&](const FrameTelemetryRecord& r) {
+    return r.frame_ms < record.frame_ms;
+  });
+  m_worst.insert(it, record);
+  if ((int)m_worst.size() > WORST_COUNT) {
+    m_worst.pop_back();
+  }
+  return true;
+}
+
+FrameTelemetry::FrameTelemetry(const fs::path& path,
+                               Format format,
+                               const std::vector<std::string>& bucket_names,
+                               const std::vector<std::string>& category_names)
+    : m_path(path),
+      m_format(format),
+      m_bucket_names(bucket_names),
+      m_category_names(category_names),
+      m_bucket_total_ms(bucket_names.size()),
+      m_bucket_max_ms(bucket_names.size()) {
+  m_file = file_util::open_file(path, format == Format::CSV ? "w" : "wb");
+  if (!m_file) {
+    lg::error("Failed to open {} for frame telemetry", path.string());
+    return;
+  }
+  lg::info("Writing frame telemetry to {}", path.string());
+
+  if (m_format == Format::CSV) {
+    m_buffer =
+        "frame,frame_ms,target_ms,render_ms,loader_ms,game_ms,sync_path_wait_ms,send_chain_ms,"
+        "latency_ms,draw_calls,triangles,loader_upload_kb,tpage_uploads,texture_uploads,rendered";
+    for (auto& name : m_category_names) {
+      fmt::format_to(std::back_inserter(m_buffer), ",{}_ms", name);
+    }
+    m_buffer.push_back('\n');
+  } else {
+    append<u32>(&m_buffer, kBinaryMagic);
+    append<u32>(&m_buffer, kBinaryVersion);
+    append<u32>(&m_buffer, sizeof(FrameTelemetryRecord));
+    append<u32>(&m_buffer, m_bucket_names.size());
+    append<u32>(&m_buffer, m_category_names.size());
+    for (auto& name : m_bucket_names) {
+      append_name(&m_buffer, name);
+    }
+    for (auto& name : m_category_names) {
+      append_name(&m_buffer, name);
+    }
+  }
+  flush();
+}
+
+FrameTelemetry::~FrameTelemetry() {
+  if (!m_file) {
+    return;
+  }
+  flush();
+  fclose(m_file);
+
+  auto text = summary();
+  lg::info("{}", text);
+  auto summary_path = m_path;
+  summary_path += ".summary.txt";
+  file_util::write_text_file(summary_path, text);
+}
+
+void FrameTelemetry::add_frame(const FrameTelemetryRecord& record,
+                               const std::vector<float>& bucket_ms,
+                               const std::vector<float>& category_ms) {
+  ASSERT(bucket_ms.size() == m_bucket_names.size());
+  ASSERT(category_ms.size() == m_category_names.size());
+
+  m_frame.add(record.frame_ms);
+  m_game.add(record.game_ms);
+  m_sync_path_wait.add(record.sync_path_wait_ms);
+  m_latency.add(record.latency_ms);
+  m_total_ms += record.frame_ms;
+  m_loader_upload_kb += record.loader_upload_kb;
+  m_tpage_uploads += record.tpage_uploads;
+  m_texture_uploads += record.texture_uploads;
+  if (record.rendered) {
+    m_rendered_frames++;
+    m_render.add(record.render_ms);
+    m_loader.add(record.loader_ms);
+    for (size_t i = 0; i < bucket_ms.size(); i++) {
+      m_bucket_total_ms[i] += bucket_ms[i];
+      m_bucket_max_ms[i] = std::max(m_bucket_max_ms[i], bucket_ms[i]);
+    }
+  }
+  m_hitches.add(record);
+
+  if (!m_file) {
+    return;
+  }
+
+  if (m_format == Format::CSV) {
+    fmt::format_to(std::back_inserter(m_buffer),
+                   "{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{},{},{},{},{},{}",
+                   record.frame, record.frame_ms, record.target_ms, record.render_ms,
+                   record.loader_ms, record.game_ms, record.sync_path_wait_ms,
+                   record.send_chain_ms, record.latency_ms, record.draw_calls, record.triangles,
+                   record.loader_upload_kb, record.tpage_uploads, record.texture_uploads,
+                   record.rendered);
+    for (auto ms : category_ms) {
+      fmt::format_to(std::back_inserter(m_buffer), ",{:.3f}", ms);
+    }
+    m_buffer.push_back('\n');
+  } else {
+    append(&m_buffer, record);
+    m_buffer.append((const char*)bucket_ms.data(), bucket_ms.size() * sizeof(float));
+    m_buffer.append((const char*)category_ms.data(), category_ms.size() * sizeof(float));
+  }
+
+  if (m_buffer.size() >= FLUSH_BYTES) {
+    flush();
+  }
+}
+
+void FrameTelemetry::flush() {
+  if (m_file && !m_buffer.empty()) {
+    fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+    fflush(m_file);
+  }
+  m_buffer.clear();
+}
+
+std::string FrameTelemetry::summary() const {
+  std::string result;
+  auto out = std::back_inserter(result);
+  fmt::format_to(out, "Frame telemetry: {} frames ({} rendered) over {:.1f} s\n", m_frame.count(),
+                 m_rendered_frames, m_total_ms / 1000.);
+  fmt::format_to(out, "  uploads: {} KB by the loader, {} tpages, {} VRAM slots changed\n",
+                 m_loader_upload_kb, m_tpage_uploads, m_texture_uploads);
+
+  fmt::format_to(out, "  {:<16} {:>8} {:>8} {:>8} {:>8} {:>8}\n", "ms", "mean", "p50", "p95",
+                 "p99", "max");
+  auto row = [&](const char* name, const TimeHistogram& hist) {
+    fmt::format_to(out, "  {:<16} {:>8.2f} {:>8.2f} {:>8.2f} {:>8.2f} {:>8.2f}\n", name,
+                   hist.mean(), hist.percentile(0.5f), hist.percentile(0.95f),
+                   hist.percentile(0.99f), hist.max());
+  };
+  row("frame", m_frame);
+  row("game", m_game);
+  row("render", m_render);
+  row("loader", m_loader);
+  row("sync_path wait", m_sync_path_wait);
+  row("latency", m_latency);
+
+  fmt::format_to(out, "  {} hitches (over {:.0f}x the recent average and {:.0f} ms late)\n",
+                 m_hitches.count(), HitchDetector::AVERAGE_FACTOR, HitchDetector::MIN_LATE_MS);
+  for (auto& hitch : m_hitches.worst()) {
+    fmt::format_to(out,
+                   "    frame {}: {:.2f} ms (game {:.2f}, render {:.2f}, loader {:.2f}, "
+                   "sync_path wait {:.2f}, {} KB uploaded, {} tpages, {} VRAM slots)\n",
+                   hitch.frame, hitch.frame_ms, hitch.game_ms, hitch.render_ms, hitch.loader_ms,
+                   hitch.sync_path_wait_ms, hitch.loader_upload_kb, hitch.tpage_uploads,
+                   hitch.texture_uploads);
+  }
+
+  if (m_rendered_frames) {
+    std::vector<size_t> order(m_bucket_names.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return m_bucket_total_ms[a] > m_bucket_total_ms[b]; });
+    fmt::format_to(out, "  slowest buckets (mean, max ms):\n");
+    for (size_t i = 0; i < std::min<size_t>(10, order.size()); i++) {
+      size_t b = order[i];
+      if (m_bucket_total_ms[b] == 0) {
+        break;
+      }
+      fmt::format_to(out, "    {:<32} {:>8.3f} {:>8.3f}\n", m_bucket_names[b],
+                     m_bucket_total_ms[b] / m_rendered_frames, m_bucket_max_ms[b]);
+    }
+  }
+  return result;
+}
+
+FrameTelemetryFile read_frame_telemetry(const fs::path& path) {
+  auto data = file_util::read_binary_file(path);
+  BinaryReader reader(data);
+  ASSERT_MSG(reader.read<u32>() == kBinaryMagic, "not a frame telemetry file");
+  ASSERT_MSG(reader.read<u32>() == kBinaryVersion, "unsupported frame telemetry version");
+  ASSERT(reader.read<u32>() == sizeof(FrameTelemetryRecord));
+  u32 bucket_count = reader.read<u32>();
+  u32 category_count = reader.read<u32>();
+
+  FrameTelemetryFile result;
+  for (u32 i = 0; i < bucket_count; i++) {
+    result.bucket_names.push_back(read_name(reader));
+  }
+  for (u32 i = 0; i < category_count; i++) {
+    result.category_names.push_back(read_name(reader));
+  }
+
+  while (reader.bytes_left()) {
+    auto& frame = result.frames.emplace_back();
+    frame.record = reader.read<FrameTelemetryRecord>();
+    for (u32 i = 0; i < bucket_count; i++) {
+      frame.bucket_ms.push_back(reader.read<float>());
+    }
+    for (u32 i = 0; i < category_count; i++) {
+      frame.category_ms.push_back(reader.read<float>());
+    }
+  }
+  return result;
+}
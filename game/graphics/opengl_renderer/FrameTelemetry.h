@@ -0,0 +1,140 @@
+#pragma once
+
+/*!
+ * @file FrameTelemetry.h
+ * Per-frame renderer metrics written to a file, for long soak tests. Enabled with
+ * gk --telemetry <file>. A summary with percentiles and the worst hitches is written to
+ * <file>.summary.txt and the log at exit.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/util/FileUtil.h"
+
+/*!
+ * Metrics for one displayed frame. The game thread times are for the last chain it sent.
+ * This is written as-is to binary telemetry files.
+ */
+struct FrameTelemetryRecord {
+  u64 frame = 0;
+  float frame_ms = 0;           // from the start of the last frame to the start of this one
+  float target_ms = 0;          // target frame time, from the frame limiter
+  float render_ms = 0;          // OpenGLRenderer::render, including the loader
+  float loader_ms = 0;          // loader update, part of render_ms
+  float game_ms = 0;            // game thread, from the end of the last render until sync_path
+  float sync_path_wait_ms = 0;  // game thread waiting for the renderer in sync_path
+  float send_chain_ms = 0;      // game thread in send_chain
+  float latency_ms = 0;         // from send_chain until the frame was on the screen
+  u32 draw_calls = 0;
+  u32 triangles = 0;
+  u32 loader_upload_kb = 0;  // uploaded to the GPU by the loader this frame
+  u32 tpage_uploads = 0;     // texture pages uploaded by the game this frame
+  u32 texture_uploads = 0;   // VRAM slots given a different texture this frame
+  u32 rendered = 0;          // 0 if there was no new chain from the game, and nothing was rendered
+};
+static_assert(sizeof(FrameTelemetryRecord) == 64);
+
+/*!
+ * Histogram of times, for percentiles over a whole run without keeping every sample.
+ * Times are rounded up to the next BIN_MS, and the slowest bin also holds everything past it.
+ */
+class TimeHistogram {
+ public:
+  static constexpr float BIN_MS = 0.05f;
+  static constexpr int BIN_COUNT = 4000;
+
+  void add(float ms);
+  // p from 0 to 1. Never more than the slowest sample.
+  float percentile(float p) const;
+  float max() const { return m_max; }
+  float mean() const { return m_count ? m_sum / m_count : 0.f; }
+  u64 count() const { return m_count; }
+
+ private:
+  std::vector<u32> m_bins = std::vector<u32>(BIN_COUNT);
+  u64 m_count = 0;
+  double m_sum = 0;
+  float m_max = 0;
+};
+
+/*!
+ * A frame is a hitch if it is much slower than the recent frames and late enough to be seen. Keeps
+ * the slowest hitches, to show what they spent their time on.
+ */
+class HitchDetector {
+ public:
+  static constexpr float AVERAGE_FACTOR = 2.f;  // slower than this times the recent average
+  static constexpr float MIN_LATE_MS = 4.f;     // and at least this far past the target
+  static constexpr int WORST_COUNT = 10;
+
+  bool add(const FrameTelemetryRecord& record);
+  u64 count() const { return m_count; }
+  // slowest first
+  const std::vector<FrameTelemetryRecord>& worst() const { return m_worst; }
+
+ private:
+  float m_average_ms = 0;  // of recent frames that weren't hitches
+  u64 m_count = 0;
+  std::vector<FrameTelemetryRecord> m_worst;
+};
+
+class FrameTelemetry {
+ public:
+  enum class Format {
+    CSV,     // one line per frame, with times per bucket category
+    BINARY,  // header, then a FrameTelemetryRecord, bucket times and category times per frame
+  };
+
+  FrameTelemetry(const fs::path& path,
+                 Format format,
+                 const std::vector<std::string>& bucket_names,
+                 const std::vector<std::string>& category_names);
+  ~FrameTelemetry();
+  FrameTelemetry(const FrameTelemetry&) = delete;
+  FrameTelemetry& operator=(const FrameTelemetry&) = delete;
+
+  bool ok() const { return m_file != nullptr; }
+  void add_frame(const FrameTelemetryRecord& record,
+                 const std::vector<float>& bucket_ms,
+                 const std::vector<float>& category_ms);
+  std::string summary() const;
+
+ private:
+  void flush();
+
+  // write to the file after this many bytes, so a crash only loses a few seconds.
+  static constexpr size_t FLUSH_BYTES = 64 * 1024;
+
+  fs::path m_path;
+  Format m_format;
+  FILE* m_file = nullptr;
+  std::string m_buffer;
+  std::vector<std::string> m_bucket_names;
+  std::vector<std::string> m_category_names;
+
+  TimeHistogram m_frame, m_render, m_loader, m_game, m_sync_path_wait, m_latency;
+  HitchDetector m_hitches;
+  std::vector<double> m_bucket_total_ms;
+  std::vector<float> m_bucket_max_ms;
+  u64 m_rendered_frames = 0;
+  double m_total_ms = 0;
+  u64 m_loader_upload_kb = 0;
+  u64 m_tpage_uploads = 0;
+  u64 m_texture_uploads = 0;
+};
+
+struct FrameTelemetryFile {
+  std::vector<std::string> bucket_names;
+  std::vector<std::string> category_names;
+  struct Frame {
+    FrameTelemetryRecord record;
+    std::vector<float> bucket_ms;
+    std::vector<float> category_ms;
+  };
+  std::vector<Frame> frames;
+};
+
+FrameTelemetryFile read_frame_telemetry(const fs::path& path);
@@ -1,5 +1,8 @@
 #include "OpenGLRenderer.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "common/goal_constants.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
@@ -38,7 +41,12 @@
 
 namespace {
 std::string g_current_render;
+
+int prepare_thread_count() {
+  // the render thread also runs prepares while it waits, so leave cores for the game.
+  return std::clamp((int)std::thread::hardware_concurrency() / 2, 1, 4);
 }
+}  // namespace
 
 /*!
  * OpenGL Error callback. If we do something invalid, this will be called.
@@ -71,6 +79,7 @@ OpenGLRenderer::OpenGLRenderer(std::shared_ptr<TexturePool> texture_pool,
                                GameVersion version)
     : m_render_state(texture_pool, loader, version),
       m_collide_renderer(version),
+      m_prepare_pool(prepare_thread_count()),
       m_version(version) {
   // setup OpenGL errors
   glEnable(GL_DEBUG_OUTPUT);
@@ -651,6 +660,14 @@ void OpenGLRenderer::blit_display() {
   glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+std::vector<std::string> OpenGLRenderer::bucket_names() const {
+  std::vector<std::string> result;
+  for (auto& renderer : m_bucket_renderers) {
+    result.push_back(renderer->name_and_id());
+  }
+  return result;
+}
+
 /*!
  * Main render function. This is called from the gfx loop with the chain passed from the game.
  */
@@ -668,6 +685,8 @@ void OpenGLRenderer::render(DmaFollower dma, const RenderOptions& settings) {
     }
   }
 
+  float loader_ms = 0;
+  float before_loader_ms = m_profiler.root()->get_elapsed_time() * 1000.f;
   {
     auto prof = m_profiler.root()->make_scoped_child("loader");
     if (m_last_pmode_alp == 0 && settings.pmode_alp_register != 0 && m_enable_fast_blackout_loads) {
@@ -675,8 +694,13 @@ void OpenGLRenderer::render(DmaFollower dma, const RenderOptions& settings) {
       m_render_state.loader->update_blocking(*m_render_state.texture_pool);
 
     } else {
-      m_render_state.loader->update(*m_render_state.texture_pool);
+      UploadScheduler::FrameTiming timing;
+      timing.target_ms = settings.target_frame_time_ms;
+      timing.elapsed_ms = settings.frame_time_so_far_ms + before_loader_ms;
+      timing.render_ms = m_last_after_loader_ms;
+      m_render_state.loader->update(*m_render_state.texture_pool, timing);
     }
+    loader_ms = prof.get_elapsed_time() * 1000.f;
   }
 
   // render the buckets!
@@ -749,6 +773,14 @@ void OpenGLRenderer::render(DmaFollower dma, const RenderOptions& settings) {
   }
 
   m_profiler.finish();
+  m_last_after_loader_ms = m_profiler.root_time() * 1000.f - before_loader_ms - loader_ms;
+  m_last_frame_stats.render_ms = m_profiler.root_time() * 1000.f;
+  m_last_frame_stats.loader_ms = loader_ms;
+  m_last_frame_stats.draw_calls = m_profiler.root()->stats().draw_calls;
+  m_last_frame_stats.triangles = m_profiler.root()->stats().triangles;
+  for (int i = 0; i < (int)BucketCategory::MAX_CATEGORIES; i++) {
+    m_last_frame_stats.category_ms[i] = m_category_times[i] * 1000.f;
+  }
   //  if (m_profiler.root_time() > 0.018) {
   //    fmt::print("Slow frame: {:.2f} ms\n", m_profiler.root_time() * 1000);
   //    fmt::print("{}\n", m_profiler.to_string());
@@ -800,6 +832,7 @@ void OpenGLRenderer::draw_renderer_selection_window() {
   ImGui::Checkbox("Sky CPU", &m_render_state.use_sky_cpu);
   ImGui::Checkbox("Occlusion Cull", &m_render_state.use_occlusion_culling);
   ImGui::Checkbox("Blackout Loads", &m_enable_fast_blackout_loads);
+  ImGui::Checkbox("Parallel Prepare", &m_parallel_prepare);
 
   for (size_t i = 0; i < m_bucket_renderers.size(); i++) {
     auto renderer = m_bucket_renderers[i].get();
@@ -933,6 +966,7 @@ void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
   // The first thing the DMA chain should be a call to a common default-registers chain.
   // this chain resets the state of the GS. After this is buckets
   m_category_times.fill(0);
+  m_bucket_times_ms.resize(m_bucket_renderers.size());
 
   m_render_state.buckets_base =
       dma.current_tag_offset() + 16;  // offset by 1 qw for the initial call
@@ -961,6 +995,7 @@ void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
   // now we should point to the first bucket!
   ASSERT(dma.current_tag_offset() == m_render_state.next_bucket);
   m_render_state.next_bucket += 16;
+  start_bucket_prepares(dma);
 
   // loop over the buckets!
   for (size_t bucket_id = 0; bucket_id < m_bucket_renderers.size(); bucket_id++) {
@@ -968,6 +1003,7 @@ void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
     auto bucket_prof = prof.make_scoped_child(renderer->name_and_id());
     g_current_render = renderer->name_and_id();
     // lg::info("Render: {} start", g_current_render);
+    finish_bucket_prepare(bucket_id, bucket_prof);
     renderer->render(dma, &m_render_state, bucket_prof);
     if (sync_after_buckets) {
       auto pp = scoped_prof("finish");
@@ -979,7 +1015,9 @@ void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
     ASSERT(dma.current_tag_offset() == m_render_state.next_bucket);
     m_render_state.next_bucket += 16;
     vif_interrupt_callback(bucket_id);
-    m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_prof.get_elapsed_time();
+    float bucket_time = bucket_prof.get_elapsed_time();
+    m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_time;
+    m_bucket_times_ms[bucket_id] = bucket_time * 1000.f;
 
     // hack to draw the collision mesh in the middle the drawing
     if (bucket_id == 31 - 1 && Gfx::g_global_settings.collision_enable) {
@@ -998,17 +1036,20 @@ void OpenGLRenderer::dispatch_buckets_jak2(DmaFollower dma,
   // The first thing the DMA chain should be a call to a common default-registers chain.
   // this chain resets the state of the GS. After this is buckets
   m_category_times.fill(0);
+  m_bucket_times_ms.resize(m_bucket_renderers.size());
 
   m_render_state.buckets_base = dma.current_tag_offset();  // starts at 0 in jak 2
   m_render_state.next_bucket = m_render_state.buckets_base + 16;
   m_render_state.bucket_for_vis_copy = (int)jak2::BucketId::BUCKET_2;
   m_render_state.num_vis_to_copy = jak2::LEVEL_MAX;
+  start_bucket_prepares(dma);
 
   for (size_t bucket_id = 0; bucket_id < m_bucket_renderers.size(); bucket_id++) {
     auto& renderer = m_bucket_renderers[bucket_id];
     auto bucket_prof = prof.make_scoped_child(renderer->name_and_id());
     g_current_render = renderer->name_and_id();
     // lg::info("Render: {} start", g_current_render);
+    finish_bucket_prepare(bucket_id, bucket_prof);
     renderer->render(dma, &m_render_state, bucket_prof);
     if (sync_after_buckets) {
       auto pp = scoped_prof("finish");
@@ -1020,7 +1061,9 @@ void OpenGLRenderer::dispatch_buckets_jak2(DmaFollower dma,
     ASSERT(dma.current_tag_offset() == m_render_state.next_bucket);
     m_render_state.next_bucket += 16;
     vif_interrupt_callback(bucket_id + 1);
-    m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_prof.get_elapsed_time();
+    float bucket_time = bucket_prof.get_elapsed_time();
+    m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_time;
+    m_bucket_times_ms[bucket_id] = bucket_time * 1000.f;
 
     // hack to draw the collision mesh in the middle the drawing
     if (bucket_id + 1 == (int)jak2::BucketId::TEX_L0_ALPHA &&
@@ -1034,6 +1077,43 @@ void OpenGLRenderer::dispatch_buckets_jak2(DmaFollower dma,
   // TODO ending data.
 }
 
+/*!
+ * Start the prepare step of all bucket renderers that support it on the worker threads. The buckets
+ * read separate parts of the DMA chain, so they can all run at once. The dma follower should point
+ * to the first bucket.
+ */
+void OpenGLRenderer::start_bucket_prepares(const DmaFollower& dma) {
+  m_prepare_tasks.resize(m_bucket_renderers.size());
+  if (!m_parallel_prepare) {
+    return;
+  }
+  for (size_t bucket_id = 0; bucket_id < m_bucket_renderers.size(); bucket_id++) {
+    auto* renderer = m_bucket_renderers[bucket_id].get();
+    if (!renderer || !renderer->can_prepare()) {
+      continue;
+    }
+    u32 bucket = m_render_state.buckets_base + 16 * bucket_id;
+    auto& task = m_prepare_tasks[bucket_id];
+    task = std::make_unique<TaskGroup>(m_prepare_pool);
+    task->run([this, renderer, bucket, bucket_dma = dma.follower_at(bucket)]() mutable {
+      renderer->prepare(bucket_dma, bucket + 16, m_render_state);
+    });
+  }
+}
+
+/*!
+ * Wait for the prepare step of a bucket to finish, if it was started. The render thread runs other
+ * prepares while it waits.
+ */
+void OpenGLRenderer::finish_bucket_prepare(size_t bucket_id, ScopedProfilerNode& prof) {
+  auto& task = m_prepare_tasks[bucket_id];
+  if (task) {
+    auto p = prof.make_scoped_child("wait-prepare");
+    task->wait();
+    task.reset();
+  }
+}
+
 /*!
  * This function finds buckets and dispatches them to the appropriate part.
  */
@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "common/dma/dma_chain_read.h"
+#include "common/util/WorkStealingPool.h"
 
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
 #include "game/graphics/opengl_renderer/CollideMeshRenderer.h"
@@ -48,6 +49,10 @@ struct RenderOptions {
 
   float pmode_alp_register = 0.f;
 
+  // frame timing, used to decide how much time the loader can spend uploading this frame.
+  float target_frame_time_ms = 1000.f / 60.f;
+  float frame_time_so_far_ms = 0.f;
+
   // when enabled, does a `glFinish()` after each major rendering pass. This blocks until the GPU
   // is done working, making it easier to profile GPU utilization.
   bool gpu_sync = false;
@@ -116,11 +121,27 @@ class OpenGLRenderer {
   // the graphics system.
   void render(DmaFollower dma, const RenderOptions& settings);
 
+  // time spent in each bucket renderer during the last frame, in milliseconds.
+  const std::vector<float>& bucket_times_ms() const { return m_bucket_times_ms; }
+  std::vector<std::string> bucket_names() const;
+
+  struct FrameStats {
+    float render_ms = 0;  // all of render, including the loader
+    float loader_ms = 0;
+    u32 draw_calls = 0;
+    u32 triangles = 0;
+    std::vector<float> category_ms = std::vector<float>((int)BucketCategory::MAX_CATEGORIES);
+  };
+  // totals for the last frame, for telemetry.
+  const FrameStats& last_frame_stats() const { return m_last_frame_stats; }
+
  private:
   void setup_frame(const RenderOptions& settings);
   void dispatch_buckets(DmaFollower dma, ScopedProfilerNode& prof, bool sync_after_buckets);
   void dispatch_buckets_jak1(DmaFollower dma, ScopedProfilerNode& prof, bool sync_after_buckets);
   void dispatch_buckets_jak2(DmaFollower dma, ScopedProfilerNode& prof, bool sync_after_buckets);
+  void start_bucket_prepares(const DmaFollower& dma);
+  void finish_bucket_prepare(size_t bucket_id, ScopedProfilerNode& prof);
 
   void do_pcrtc_effects(float alp, SharedRenderState* render_state, ScopedProfilerNode& prof);
   void blit_display();
@@ -157,11 +178,20 @@ class OpenGLRenderer {
   std::vector<BucketCategory> m_bucket_categories;
 
   std::array<float, (int)BucketCategory::MAX_CATEGORIES> m_category_times;
+  std::vector<float> m_bucket_times_ms;
   FullScreenDraw m_blackout_renderer;
   CollideMeshRenderer m_collide_renderer;
 
+  // runs the prepare step of bucket renderers ahead of time, see PreparedBucketRenderer.
+  WorkStealingPool m_prepare_pool;
+  std::vector<std::unique_ptr<TaskGroup>> m_prepare_tasks;
+  bool m_parallel_prepare = true;
+
   float m_last_pmode_alp = 1.;
   bool m_enable_fast_blackout_loads = true;
+  // time spent rendering last frame after the loader ran.
+  float m_last_after_loader_ms = 0;
+  FrameStats m_last_frame_stats;
 
   struct FboState {
     struct {
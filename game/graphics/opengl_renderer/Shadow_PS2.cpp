@@ -31,34 +31,6 @@ void ShadowRenderer::run_mscal10_vu2c() {
 }
 
 namespace {
-u32 clip(const Vf& vector, float val, u32 old_clip) {
-  u32 result = (old_clip << 6);
-  float plus = std::abs(val);
-  float minus = -plus;
-
-  if (vector.x() > plus) {
-    result |= 0b1;
-  }
-  if (vector.x() < minus) {
-    result |= 0b10;
-  }
-
-  if (vector.y() > plus) {
-    result |= 0b100;
-  }
-  if (vector.y() < minus) {
-    result |= 0b1000;
-  }
-
-  if (vector.z() > plus) {
-    result |= 0b10000;
-  }
-  if (vector.z() < minus) {
-    result |= 0b100000;
-  }
-  return result & 0xffffff;  // only 24 bits
-}
-
 void fcand(u16& dest, u32 imm, u32 cf) {
   // dest = (cf & imm) ? 1 : 0;
   if ((cf & 0xFFFFFF) & (imm & 0xFFFFFF))
@@ -285,7 +257,7 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf17, 5(vi02)      |  max.xyzw vf11, vf11, vf18      84
   vu.vf11.max(Mask::xyzw, vu.vf11, vu.vf18);   sq_buffer(Mask::xyzw, vu.vf17, vu.vi02 + 5);
   // nop                        |  clipw.xyz vf21, vf21           85
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   // nop                        |  mul.xy vf26, vf26, vf04        86
   vu.vf26.mul(Mask::xy, vu.vf26, vu.vf04);
   // nop                        |  addz.x vf29, vf29, vf29        87
@@ -297,10 +269,10 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf26, 6(vi02)      |  add.xyzw vf19, vf19, vf05      90
   vu.vf19.add(Mask::xyzw, vu.vf19, vu.vf05);   sq_buffer(Mask::xyzw, vu.vf26, vu.vi02 + 6);
   // fsand vi01, 0x2            |  clipw.xyz vf22, vf22           91
-  cf = clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
 
   // sq.xyzw vf18, 7(vi02)      |  clipw.xyz vf23, vf23           92
-  cf = clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
+  cf = vu_clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
   // BRANCH!
   // ibeq vi00, vi01, L4        |  mul.xy vf27, vf27, vf04        93
   vu.vf27.mul(Mask::xy, vu.vf27, vu.vf04);   bc = (vu.vi01 == 0);
@@ -448,7 +420,7 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf17, 5(vi02)      |  max.xyzw vf11, vf11, vf18      156
   vu.vf11.max(Mask::xyzw, vu.vf11, vu.vf18);   sq_buffer(Mask::xyzw, vu.vf17, vu.vi02 + 5);
   // nop                        |  clipw.xyz vf21, vf21           157
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   // nop                        |  mul.xy vf26, vf26, vf04        158
   vu.vf26.mul(Mask::xy, vu.vf26, vu.vf04);
   // iaddi vi08, vi08, -0x1     |  addz.x vf29, vf29, vf29        159
@@ -460,10 +432,10 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf26, 6(vi02)      |  add.xyzw vf19, vf19, vf05      162
   vu.vf19.add(Mask::xyzw, vu.vf19, vu.vf05);   sq_buffer(Mask::xyzw, vu.vf26, vu.vi02 + 6);
   // fsand vi01, 0x2            |  clipw.xyz vf22, vf22           163
-  cf = clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
 
   // sq.xyzw vf18, 7(vi02)      |  clipw.xyz vf23, vf23           164
-  cf = clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
+  cf = vu_clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
   // BRANCH!
   // ibeq vi00, vi01, L8        |  mul.xy vf27, vf27, vf04        165
   vu.vf27.mul(Mask::xy, vu.vf27, vu.vf04);   bc = (vu.vi01 == 0);
@@ -751,7 +723,7 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf17, 5(vi02)      |  max.xyzw vf11, vf11, vf18      285
   vu.vf11.max(Mask::xyzw, vu.vf11, vu.vf18);   sq_buffer(Mask::xyzw, vu.vf17, vu.vi02 + 5);
   // nop                        |  clipw.xyz vf21, vf21           286
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   // nop                        |  mul.xy vf26, vf26, vf04        287
   vu.vf26.mul(Mask::xy, vu.vf26, vu.vf04);
   // nop                        |  addz.x vf29, vf29, vf29        288
@@ -763,12 +735,12 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf26, 6(vi02)      |  add.xyzw vf19, vf19, vf05      291
   vu.vf19.add(Mask::xyzw, vu.vf19, vu.vf05);   sq_buffer(Mask::xyzw, vu.vf26, vu.vi02 + 6);
   // fsand vi01, 0x2            |  clipw.xyz vf22, vf22           292
-  cf = clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
 
   // sq.xyzw vf18, 7(vi02)      |  clipw.xyz vf23, vf23           293
-  cf = clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
+  cf = vu_clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
   // nop                        |  clipw.xyz vf24, vf24           294
-  cf = clip(vu.vf24, vu.vf24.w(), cf);
+  cf = vu_clip(vu.vf24, vu.vf24.w(), cf);
   // nop                        |  add.xy vf28, vf20, vf03        295
   vu.vf28.add(Mask::xy, vu.vf20, vu.vf03);
   // nop                        |  add.xyzw vf20, vf20, vf05      296
@@ -1021,7 +993,7 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf17, 5(vi02)      |  max.xyzw vf11, vf11, vf18      401
   vu.vf11.max(Mask::xyzw, vu.vf11, vu.vf18);   sq_buffer(Mask::xyzw, vu.vf17, vu.vi02 + 5);
   // nop                        |  clipw.xyz vf21, vf21           402
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   // nop                        |  mul.xy vf26, vf26, vf04        403
   vu.vf26.mul(Mask::xy, vu.vf26, vu.vf04);
   // nop                        |  addz.x vf29, vf29, vf29        404
@@ -1033,10 +1005,10 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf26, 6(vi02)      |  add.xyzw vf19, vf19, vf05      407
   vu.vf19.add(Mask::xyzw, vu.vf19, vu.vf05);   sq_buffer(Mask::xyzw, vu.vf26, vu.vi02 + 6);
   // fsand vi01, 0x2            |  clipw.xyz vf22, vf22           408
-  cf = clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
 
   // sq.xyzw vf18, 7(vi02)      |  clipw.xyz vf23, vf23           409
-  cf = clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
+  cf = vu_clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
   // BRANCH!
   // ibeq vi00, vi01, L25       |  mul.xy vf27, vf27, vf04        410
   vu.vf27.mul(Mask::xy, vu.vf27, vu.vf04);   bc = (vu.vi01 == 0);
@@ -1200,7 +1172,7 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf17, 5(vi02)      |  max.xyzw vf11, vf11, vf18      477
   vu.vf11.max(Mask::xyzw, vu.vf11, vu.vf18);   sq_buffer(Mask::xyzw, vu.vf17, vu.vi02 + 5);
   // nop                        |  clipw.xyz vf21, vf21           478
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   // nop                        |  mul.xy vf26, vf26, vf04        479
   vu.vf26.mul(Mask::xy, vu.vf26, vu.vf04);
   // nop                        |  addz.x vf29, vf29, vf29        480
@@ -1212,10 +1184,10 @@ void ShadowRenderer::run_mscal_vu2c(u16 imm) {
   // sq.xyzw vf26, 6(vi02)      |  add.xyzw vf19, vf19, vf05      483
   vu.vf19.add(Mask::xyzw, vu.vf19, vu.vf05);   sq_buffer(Mask::xyzw, vu.vf26, vu.vi02 + 6);
   // fsand vi01, 0x2            |  clipw.xyz vf22, vf22           484
-  cf = clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);   fsand(vu.vi01, 0x2, sf0);
 
   // sq.xyzw vf18, 7(vi02)      |  clipw.xyz vf23, vf23           485
-  cf = clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
+  cf = vu_clip(vu.vf23, vu.vf23.w(), cf);   sq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 7);
   // BRANCH!
   // ibeq vi00, vi01, L31       |  mul.xy vf27, vf27, vf04        486
   vu.vf27.mul(Mask::xy, vu.vf27, vu.vf04);   bc = (vu.vi01 == 0);
@@ -1,17 +1,21 @@
 #include "Warp.h"
 
 Warp::Warp(const std::string& name, int id, std::shared_ptr<Generic2> generic)
-    : BucketRenderer(name, id), m_generic(generic) {}
+    : PreparedBucketRenderer(name, id), m_generic(generic) {}
 
 void Warp::draw_debug_window() {
-  m_generic->draw_debug_window();
+  m_generic->draw_debug_window(m_data);
 }
 
-void Warp::render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) {
+void Warp::prepare_dma(DmaFollower& dma, u32 next_bucket, const SharedRenderState& render_state) {
+  m_data.prepare(dma, next_bucket, render_state.version, Generic2::Mode::WARP);
+}
+
+void Warp::submit(SharedRenderState* render_state, ScopedProfilerNode& prof) {
   m_fb_copier.copy_now(render_state->render_fb_w, render_state->render_fb_h,
                        render_state->render_fb);
   render_state->texture_pool->move_existing_to_vram(m_warp_src_tex, m_tbp);
-  m_generic->render_in_mode(dma, render_state, prof, Generic2::Mode::WARP);
+  m_generic->submit(m_data, render_state, prof);
 }
 
 void Warp::init_textures(TexturePool& tex_pool, GameVersion version) {
@@ -5,15 +5,21 @@
 #include "game/graphics/opengl_renderer/foreground/Generic2.h"
 #include "game/graphics/opengl_renderer/opengl_utils.h"
 
-class Warp : public BucketRenderer {
+class Warp : public PreparedBucketRenderer {
  public:
   Warp(const std::string& name, int id, std::shared_ptr<Generic2> generic);
-  void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) override;
   void draw_debug_window() override;
   void init_textures(TexturePool& tex_pool, GameVersion version) override;
 
+ protected:
+  void prepare_dma(DmaFollower& dma,
+                   u32 next_bucket,
+                   const SharedRenderState& render_state) override;
+  void submit(SharedRenderState* render_state, ScopedProfilerNode& prof) override;
+
  private:
   std::shared_ptr<Generic2> m_generic;
+  Generic2::BucketData m_data;
   FramebufferCopier m_fb_copier;
   GpuTexture* m_warp_src_tex = nullptr;
   u32 m_tbp = 1216;  // hack, jak 2
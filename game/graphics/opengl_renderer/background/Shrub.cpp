@@ -243,14 +243,20 @@ void Shrub::render_tree(int idx,
   }
 
   Timer interp_timer;
-  interp_time_of_day_fast(settings.itimes, tree.tod_cache, m_color_result.data());
+  bool tod_changed = time_of_day_needs_update(&tree.tod_cache, settings.itimes);
+  if (tod_changed) {
+    interp_time_of_day_fast(settings.itimes, tree.tod_cache, m_color_result.data());
+  }
   tree.perf.tod_time.add(interp_timer.getSeconds());
 
   Timer setup_timer;
   glActiveTexture(GL_TEXTURE10);
   glBindTexture(GL_TEXTURE_1D, tree.time_of_day_texture);
-  glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
-                  m_color_result.data());
+  // the texture still has the colors from last time if the time of day hasn't changed.
+  if (tod_changed) {
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA,
+                    GL_UNSIGNED_INT_8_8_8_8_REV, m_color_result.data());
+  }
 
   first_tfrag_draw_setup(settings, render_state, ShaderId::SHRUB);
 
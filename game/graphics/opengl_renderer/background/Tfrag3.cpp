@@ -84,6 +84,7 @@ void Tfrag3::update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_kind
         tree_cache.vis = &tree.bvh;
         tree_cache.index_data = tree.unpacked.indices.data();
         tree_cache.tod_cache = swizzle_time_of_day(tree.colors);
+        tree_cache.culling = make_culling_tree(tree.bvh);
         tree_cache.draw_mode = tree.use_strips ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
         vis_temp_len = std::max(vis_temp_len, tree.bvh.vis_nodes.size());
         glBindBuffer(GL_ARRAY_BUFFER, tree_cache.vertex_buffer);
@@ -207,15 +208,18 @@ void Tfrag3::render_tree(int geom,
   if (m_color_result.size() < tree.colors->size()) {
     m_color_result.resize(tree.colors->size());
   }
-  if (m_use_fast_time_of_day) {
-    interp_time_of_day_fast(itimes, tree.tod_cache, m_color_result.data());
-  } else {
-    interp_time_of_day_slow(itimes, *tree.colors, m_color_result.data());
-  }
   glActiveTexture(GL_TEXTURE10);
   glBindTexture(GL_TEXTURE_1D, tree.time_of_day_texture);
-  glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
-                  m_color_result.data());
+  // the texture still has the colors from last time if the time of day hasn't changed.
+  if (time_of_day_needs_update(&tree.tod_cache, itimes)) {
+    if (m_use_fast_time_of_day) {
+      interp_time_of_day_fast(itimes, tree.tod_cache, m_color_result.data());
+    } else {
+      interp_time_of_day_slow(itimes, *tree.colors, m_color_result.data());
+    }
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA,
+                    GL_UNSIGNED_INT_8_8_8_8_REV, m_color_result.data());
+  }
 
   first_tfrag_draw_setup(settings, render_state, ShaderId::TFRAG3);
 
@@ -227,20 +231,22 @@ void Tfrag3::render_tree(int geom,
   glEnable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
 
-  cull_check_all_slow(settings.planes, tree.vis->vis_nodes, settings.occlusion_culling,
+  cull_check_all_fast(settings.planes, tree.culling, settings.occlusion_culling,
                       m_cache.vis_temp.data());
+  find_vis_runs(m_cache.vis_temp.data(), tree.culling.node_count, &m_cache.vis_runs);
 
   u32 total_tris;
   if (render_state->no_multidraw) {
     u32 idx_buffer_size = make_index_list_from_vis_string(
         m_cache.draw_idx_temp.data(), m_cache.index_temp.data(), *tree.draws, m_cache.vis_temp,
-        tree.index_data, &total_tris);
+        m_cache.vis_runs, tree.index_data, &total_tris);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size * sizeof(u32), m_cache.index_temp.data(),
                  GL_STREAM_DRAW);
   } else {
     total_tris = make_multidraws_from_vis_string(
         m_cache.multidraw_offset_per_stripdraw.data(), m_cache.multidraw_count_buffer.data(),
-        m_cache.multidraw_index_offset_buffer.data(), *tree.draws, m_cache.vis_temp);
+        m_cache.multidraw_index_offset_buffer.data(), *tree.draws, m_cache.vis_temp,
+        m_cache.vis_runs);
   }
 
   prof.add_tri(total_tris);
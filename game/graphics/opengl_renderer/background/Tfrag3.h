@@ -66,6 +66,7 @@ class Tfrag3 {
     const tfrag3::BVH* vis = nullptr;
     const u32* index_data = nullptr;
     SwizzledTimeOfDay tod_cache;
+    CullingTree culling;
     u64 draw_mode = 0;
 
     void reset_stats() {
@@ -90,6 +91,7 @@ class Tfrag3 {
 
   struct Cache {
     std::vector<u8> vis_temp;
+    VisRuns vis_runs;
     std::vector<std::pair<int, int>> draw_idx_temp;
     std::vector<u32> index_temp;
     std::vector<std::pair<int, int>> multidraw_offset_per_stripdraw;
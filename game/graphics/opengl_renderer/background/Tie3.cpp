@@ -107,6 +107,8 @@ void Tie3::load_from_fr3_data(const LevelData* loader_data) {
       lod_tree[l_tree].wind_draws = &tree.instanced_wind_draws;
       // preprocess colors for faster interpolation (TODO: move to loader)
       lod_tree[l_tree].tod_cache = swizzle_time_of_day(tree.colors);
+      // bspheres of the BVH, for faster culling
+      lod_tree[l_tree].culling = make_culling_tree(tree.bvh);
       // OpenGL index buffer (fixed index buffer for multidraw system)
       lod_tree[l_tree].index_buffer = loader_data->tie_data[l_geo][l_tree].index_buffer;
       lod_tree[l_tree].category_draw_indices = tree.category_draw_indices;
@@ -434,16 +436,18 @@ void Tie3::setup_tree(int idx,
     m_color_result.resize(tree.colors->size());
   }
 
-  if (m_use_fast_time_of_day) {
-    interp_time_of_day_fast(settings.itimes, tree.tod_cache, m_color_result.data());
-  } else {
-    interp_time_of_day_slow(settings.itimes, *tree.colors, m_color_result.data());
-  }
-
   glActiveTexture(GL_TEXTURE10);
   glBindTexture(GL_TEXTURE_1D, tree.time_of_day_texture);
-  glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
-                  m_color_result.data());
+  // the texture still has the colors from last time if the time of day hasn't changed.
+  if (time_of_day_needs_update(&tree.tod_cache, settings.itimes)) {
+    if (m_use_fast_time_of_day) {
+      interp_time_of_day_fast(settings.itimes, tree.tod_cache, m_color_result.data());
+    } else {
+      interp_time_of_day_slow(settings.itimes, *tree.colors, m_color_result.data());
+    }
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA,
+                    GL_UNSIGNED_INT_8_8_8_8_REV, m_color_result.data());
+  }
 
   // update proto vis mask
   if (proto_vis_data) {
@@ -452,8 +456,9 @@ void Tie3::setup_tree(int idx,
 
   if (!m_debug_all_visible) {
     // need culling data
-    cull_check_all_slow(settings.planes, tree.vis->vis_nodes, settings.occlusion_culling,
+    cull_check_all_fast(settings.planes, tree.culling, settings.occlusion_culling,
                         tree.vis_temp.data());
+    find_vis_runs(tree.vis_temp.data(), tree.culling.node_count, &tree.vis_runs);
   }
 
   u32 num_tris = 0;
@@ -467,12 +472,12 @@ void Tie3::setup_tree(int idx,
       if (tree.has_proto_visibility) {
         num_tris = make_multidraws_from_vis_and_proto_string(
             tree.multidraw_offset_per_stripdraw.data(), tree.multidraw_count_buffer.data(),
-            tree.multidraw_index_offset_buffer.data(), *tree.draws, tree.vis_temp,
+            tree.multidraw_index_offset_buffer.data(), *tree.draws, tree.vis_temp, tree.vis_runs,
             tree.proto_visibility.vis_flags);
       } else {
         num_tris = make_multidraws_from_vis_string(
             tree.multidraw_offset_per_stripdraw.data(), tree.multidraw_count_buffer.data(),
-            tree.multidraw_index_offset_buffer.data(), *tree.draws, tree.vis_temp);
+            tree.multidraw_index_offset_buffer.data(), *tree.draws, tree.vis_temp, tree.vis_runs);
       }
     }
   } else {
@@ -485,11 +490,11 @@ void Tie3::setup_tree(int idx,
       if (tree.has_proto_visibility) {
         idx_buffer_size = make_index_list_from_vis_and_proto_string(
             tree.draw_idx_temp.data(), tree.index_temp.data(), *tree.draws, tree.vis_temp,
-            tree.proto_visibility.vis_flags, tree.index_data, &num_tris);
+            tree.vis_runs, tree.proto_visibility.vis_flags, tree.index_data, &num_tris);
       } else {
-        idx_buffer_size =
-            make_index_list_from_vis_string(tree.draw_idx_temp.data(), tree.index_temp.data(),
-                                            *tree.draws, tree.vis_temp, tree.index_data, &num_tris);
+        idx_buffer_size = make_index_list_from_vis_string(
+            tree.draw_idx_temp.data(), tree.index_temp.data(), *tree.draws, tree.vis_temp,
+            tree.vis_runs, tree.index_data, &num_tris);
       }
     }
 
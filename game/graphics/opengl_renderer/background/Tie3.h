@@ -119,6 +119,7 @@ class Tie3 : public BucketRenderer {
     const tfrag3::BVH* vis = nullptr;
     const u32* index_data = nullptr;
     SwizzledTimeOfDay tod_cache;
+    CullingTree culling;
     std::vector<std::array<math::Vector4f, 4>> wind_matrix_cache;
     GLuint wind_vertex_index_buffer;
     std::vector<u32> wind_vertex_index_offsets;
@@ -128,6 +129,7 @@ class Tie3 : public BucketRenderer {
     std::vector<std::pair<int, int>> draw_idx_temp;
     std::vector<u32> index_temp;
     std::vector<u8> vis_temp;
+    VisRuns vis_runs;
     std::vector<std::pair<int, int>> multidraw_offset_per_stripdraw;
     std::vector<GLsizei> multidraw_count_buffer;
     std::vector<void*> multidraw_index_offset_buffer;
@@ -2,6 +2,9 @@
 
 #include "background_common.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <immintrin.h>
 
 #include "common/util/os.h"
@@ -274,10 +277,11 @@ SwizzledTimeOfDay swizzle_time_of_day(const std::vector<tfrag3::TimeOfDayColor>&
   return out;
 }
 
-void interp_time_of_day_fast(const math::Vector<s32, 4> itimes[4],
-                             const SwizzledTimeOfDay& swizzled_colors,
-                             math::Vector<u8, 4>* out) {
-  math::Vector<u16, 4> weights[8];
+namespace {
+/*!
+ * Unpack the integer weights for each of the 8 palettes from itimes.
+ */
+void time_of_day_weights(const math::Vector<s32, 4> itimes[4], math::Vector<u16, 4> weights[8]) {
   for (int component = 0; component < 8; component++) {
     int quad_idx = component / 2;
     int word_off = (component % 2 * 2);
@@ -291,6 +295,58 @@ void interp_time_of_day_fast(const math::Vector<s32, 4> itimes[4],
       weights[component][channel] = hw_val;
     }
   }
+}
+
+// saturation value for a single color: alpha is saturated to 128, the rest to 255.
+constexpr u64 TOD_SATURATION = (128ull << 48) | (255ull << 32) | (255ull << 16) | 255ull;
+
+u64 weights_as_u64(const math::Vector<u16, 4>& weights) {
+  u64 result;
+  memcpy(&result, weights.data(), sizeof(u64));
+  return result;
+}
+
+/*!
+ * Interpolate groups of 4 colors with AVX2. Each component of a group is 16 bytes of the swizzled
+ * data (4 colors), which is exactly one 256-bit vector of u16s.
+ */
+TARGET_AVX2 void interp_color_quads_avx2(const SwizzledTimeOfDay& swizzled_colors,
+                                         u32 start_quad,
+                                         u32 end_quad,
+                                         const __m256i weights[8],
+                                         __m256i sat,
+                                         math::Vector<u8, 4>* out) {
+  for (u32 color_quad = start_quad; color_quad < end_quad; color_quad++) {
+    const u8* base = swizzled_colors.data.data() + color_quad * 128;
+    __m256i color[8];
+    for (int i = 0; i < 8; i++) {
+      color[i] = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(base + i * 16)));
+      color[i] = _mm256_mullo_epi16(color[i], weights[i]);
+    }
+
+    // add in the same order as the SSE version, so saturation gives the same result.
+    color[0] = _mm256_adds_epi16(color[0], color[1]);
+    color[2] = _mm256_adds_epi16(color[2], color[3]);
+    color[4] = _mm256_adds_epi16(color[4], color[5]);
+    color[6] = _mm256_adds_epi16(color[6], color[7]);
+    color[0] = _mm256_adds_epi16(color[0], color[2]);
+    color[4] = _mm256_adds_epi16(color[4], color[6]);
+    color[0] = _mm256_adds_epi16(color[0], color[4]);
+
+    color[0] = _mm256_srli_epi16(color[0], 6);
+    color[0] = _mm256_min_epu16(sat, color[0]);
+    auto hi = _mm256_extracti128_si256(color[0], 1);
+    auto result = _mm_packus_epi16(_mm256_castsi256_si128(color[0]), hi);
+    _mm_storeu_si128((__m128i*)(&out[color_quad * 4]), result);
+  }
+}
+}  // namespace
+
+void interp_time_of_day_sse(const math::Vector<s32, 4> itimes[4],
+                            const SwizzledTimeOfDay& swizzled_colors,
+                            math::Vector<u8, 4>* out) {
+  math::Vector<u16, 4> weights[8];
+  time_of_day_weights(itimes, weights);
 
   // weight multipliers
   __m128i weights0 = _mm_setr_epi16(weights[0][0], weights[0][1], weights[0][2], weights[0][3],
@@ -430,6 +486,93 @@ void interp_time_of_day_fast(const math::Vector<s32, 4> itimes[4],
   }
 }
 
+TARGET_AVX2 void interp_time_of_day_avx2(const math::Vector<s32, 4> itimes[4],
+                                         const SwizzledTimeOfDay& swizzled_colors,
+                                         math::Vector<u8, 4>* out) {
+  math::Vector<u16, 4> weights[8];
+  time_of_day_weights(itimes, weights);
+  __m256i weights256[8];
+  for (int i = 0; i < 8; i++) {
+    weights256[i] = _mm256_set1_epi64x(weights_as_u64(weights[i]));
+  }
+  __m256i sat = _mm256_set1_epi64x(TOD_SATURATION);
+
+  interp_color_quads_avx2(swizzled_colors, 0, swizzled_colors.color_count / 4, weights256, sat,
+                          out);
+}
+
+TARGET_AVX512BW void interp_time_of_day_avx512(const math::Vector<s32, 4> itimes[4],
+                                               const SwizzledTimeOfDay& swizzled_colors,
+                                               math::Vector<u8, 4>* out) {
+  math::Vector<u16, 4> weights[8];
+  time_of_day_weights(itimes, weights);
+  __m512i weights512[8];
+  for (int i = 0; i < 8; i++) {
+    weights512[i] = _mm512_set1_epi64(weights_as_u64(weights[i]));
+  }
+  __m512i sat = _mm512_set1_epi64(TOD_SATURATION);
+
+  // two groups of 4 colors per iteration. The groups aren't next to each other in the swizzled
+  // data, so each component is loaded in two halves.
+  u32 quad_count = swizzled_colors.color_count / 4;
+  u32 color_quad = 0;
+  for (; color_quad + 1 < quad_count; color_quad += 2) {
+    const u8* base = swizzled_colors.data.data() + color_quad * 128;
+    __m512i color[8];
+    for (int i = 0; i < 8; i++) {
+      __m256i packed = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(base + i * 16))),
+          _mm_loadu_si128((const __m128i*)(base + 128 + i * 16)), 1);
+      color[i] = _mm512_mullo_epi16(_mm512_cvtepu8_epi16(packed), weights512[i]);
+    }
+
+    color[0] = _mm512_adds_epi16(color[0], color[1]);
+    color[2] = _mm512_adds_epi16(color[2], color[3]);
+    color[4] = _mm512_adds_epi16(color[4], color[5]);
+    color[6] = _mm512_adds_epi16(color[6], color[7]);
+    color[0] = _mm512_adds_epi16(color[0], color[2]);
+    color[4] = _mm512_adds_epi16(color[4], color[6]);
+    color[0] = _mm512_adds_epi16(color[0], color[4]);
+
+    color[0] = _mm512_srli_epi16(color[0], 6);
+    color[0] = _mm512_min_epu16(sat, color[0]);
+    // everything fits in a u8 after saturating, so no need to saturate again here.
+    // (the maskz version, because the unmasked one makes gcc warn about an uninitialized value.)
+    _mm256_storeu_si256((__m256i*)(&out[color_quad * 4]),
+                        _mm512_maskz_cvtepi16_epi8(0xffffffff, color[0]));
+  }
+
+  // odd group at the end.
+  __m256i weights256[8];
+  for (int i = 0; i < 8; i++) {
+    weights256[i] = _mm256_set1_epi64x(weights_as_u64(weights[i]));
+  }
+  interp_color_quads_avx2(swizzled_colors, color_quad, quad_count, weights256,
+                          _mm256_set1_epi64x(TOD_SATURATION), out);
+}
+
+void interp_time_of_day_fast(const math::Vector<s32, 4> itimes[4],
+                             const SwizzledTimeOfDay& swizzled_colors,
+                             math::Vector<u8, 4>* out) {
+  if (get_cpu_info().has_avx512) {
+    interp_time_of_day_avx512(itimes, swizzled_colors, out);
+  } else if (get_cpu_info().has_avx2) {
+    interp_time_of_day_avx2(itimes, swizzled_colors, out);
+  } else {
+    interp_time_of_day_sse(itimes, swizzled_colors, out);
+  }
+}
+
+bool time_of_day_needs_update(SwizzledTimeOfDay* colors, const math::Vector<s32, 4> itimes[4]) {
+  if (colors->has_last_itimes &&
+      memcmp(colors->last_itimes, itimes, sizeof(colors->last_itimes)) == 0) {
+    return false;
+  }
+  memcpy(colors->last_itimes, itimes, sizeof(colors->last_itimes));
+  colors->has_last_itimes = true;
+  return true;
+}
+
 bool sphere_in_view_ref(const math::Vector4f& sphere, const math::Vector4f* planes) {
   math::Vector4f acc =
       planes[0] * sphere.x() + planes[1] * sphere.y() + planes[2] * sphere.z() - planes[3];
@@ -438,7 +581,7 @@ bool sphere_in_view_ref(const math::Vector4f& sphere, const math::Vector4f* plan
          acc.w() > -sphere.w();
 }
 
-// this isn't super efficient, but we spend so little time here it's not worth it to go faster.
+// reference version, checks every node. The renderers use cull_check_all_fast.
 void cull_check_all_slow(const math::Vector4f* planes,
                          const std::vector<tfrag3::VisNode>& nodes,
                          const u8* level_occlusion_string,
@@ -457,6 +600,117 @@ void cull_check_all_slow(const math::Vector4f* planes,
   }
 }
 
+CullingTree make_culling_tree(const tfrag3::BVH& bvh) {
+  CullingTree result;
+  const auto& nodes = bvh.vis_nodes;
+  result.node_count = nodes.size();
+  result.num_roots = bvh.only_children ? 0 : bvh.num_roots;
+  ASSERT(result.num_roots <= nodes.size());
+  size_t padded_size = nodes.size() + 8;
+  result.x.resize(padded_size);
+  result.y.resize(padded_size);
+  result.z.resize(padded_size);
+  result.neg_r.resize(padded_size);
+  result.my_id.resize(nodes.size());
+  result.first_child.resize(nodes.size());
+  result.num_kids.resize(nodes.size());
+  result.has_node_children.resize(nodes.size());
+
+  for (size_t i = 0; i < nodes.size(); i++) {
+    const auto& node = nodes[i];
+    result.x[i] = node.bsphere.x();
+    result.y[i] = node.bsphere.y();
+    result.z[i] = node.bsphere.z();
+    result.neg_r[i] = -node.bsphere.w();
+    result.my_id[i] = node.my_id;
+    result.has_node_children[i] = node.flags != 0;
+    if (node.flags) {
+      result.first_child[i] = node.child_id - bvh.first_root;
+      result.num_kids[i] = node.num_kids;
+      ASSERT(result.first_child[i] + node.num_kids <= nodes.size());
+    }
+  }
+  return result;
+}
+
+namespace {
+
+struct CullPlanes {
+  // the planes, each coefficient broadcast to all 8 lanes.
+  __m256 a[4], b[4], c[4], d[4];
+};
+
+/*!
+ * Check nodes [first, first + count) and their children.
+ */
+void cull_check_group(const CullPlanes& planes,
+                      const CullingTree& tree,
+                      const u8* level_occlusion_string,
+                      u32 first,
+                      u32 count,
+                      u8* out) {
+  for (u32 group = first; group < first + count; group += 8) {
+    u32 lanes = std::min(8u, first + count - group);
+    __m256 x = _mm256_loadu_ps(&tree.x[group]);
+    __m256 y = _mm256_loadu_ps(&tree.y[group]);
+    __m256 z = _mm256_loadu_ps(&tree.z[group]);
+    __m256 neg_r = _mm256_loadu_ps(&tree.neg_r[group]);
+
+    // same operations, in the same order, as sphere_in_view_ref.
+    u32 in_view = (1u << lanes) - 1;
+    for (int i = 0; i < 4; i++) {
+      __m256 acc = _mm256_mul_ps(planes.a[i], x);
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(planes.b[i], y));
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(planes.c[i], z));
+      acc = _mm256_sub_ps(acc, planes.d[i]);
+      in_view &= _mm256_movemask_ps(_mm256_cmp_ps(acc, neg_r, _CMP_GT_OQ));
+    }
+
+    if (!in_view) {
+      // out was cleared, and none of the children can be visible.
+      continue;
+    }
+
+    u32 visible = in_view;
+    if (level_occlusion_string) {
+      for (u32 lane = 0; lane < lanes; lane++) {
+        u16 my_id = tree.my_id[group + lane];
+        bool not_occluded =
+            my_id != 0xffff && level_occlusion_string[my_id / 8] & (1 << (7 - (my_id & 7)));
+        if (!not_occluded) {
+          visible &= ~(1u << lane);
+        }
+      }
+    }
+
+    for (u32 lane = 0; lane < lanes; lane++) {
+      u32 idx = group + lane;
+      out[idx] = (visible >> lane) & 1;
+      // occluded nodes still descend: the slow version checks children on their own.
+      if (((in_view >> lane) & 1) && tree.has_node_children[idx]) {
+        cull_check_group(planes, tree, level_occlusion_string, tree.first_child[idx],
+                         tree.num_kids[idx], out);
+      }
+    }
+  }
+}
+}  // namespace
+
+void cull_check_all_fast(const math::Vector4f* planes,
+                         const CullingTree& tree,
+                         const u8* level_occlusion_string,
+                         u8* out) {
+  memset(out, 0, tree.node_count);
+  CullPlanes splat;
+  for (int i = 0; i < 4; i++) {
+    splat.a[i] = _mm256_set1_ps(planes[0][i]);
+    splat.b[i] = _mm256_set1_ps(planes[1][i]);
+    splat.c[i] = _mm256_set1_ps(planes[2][i]);
+    splat.d[i] = _mm256_set1_ps(planes[3][i]);
+  }
+  cull_check_group(splat, tree, level_occlusion_string, 0, tree.num_roots, out);
+}
+
 void make_all_visible_multidraws(std::pair<int, int>* draw_ptrs_out,
                                  GLsizei* counts_out,
                                  void** index_offsets_out,
@@ -518,11 +772,162 @@ u32 make_all_visible_index_list(std::pair<int, int>* group_out,
   return idx_buffer_ptr;
 }
 
+void find_vis_runs(const u8* vis_data, u32 node_count, VisRuns* out) {
+  out->runs.clear();
+  u32 i = 0;
+  while (i < node_count) {
+    const u8* next_visible = (const u8*)memchr(vis_data + i, 1, node_count - i);
+    if (!next_visible) {
+      break;
+    }
+    u32 first = next_visible - vis_data;
+    const u8* next_hidden = (const u8*)memchr(next_visible, 0, node_count - first);
+    i = next_hidden ? next_hidden - vis_data : node_count;
+    out->runs.emplace_back(first, i);
+  }
+  out->runs.emplace_back(UINT16_MAX, UINT16_MAX + 1);
+}
+
+namespace {
+
+/*!
+ * Should the draw be built from the vis runs? Each run costs two searches, so this is only faster
+ * than checking all the groups when there are a lot more groups than runs.
+ */
+bool use_vis_runs(const tfrag3::StripDraw& draw, const VisRuns& vis_runs) {
+  return !draw.vis_group_starts.empty() && vis_runs.runs.size() * 16 < draw.vis_groups.size();
+}
+
+using VisGroupIter = std::vector<tfrag3::StripDraw::VisGroup>::const_iterator;
+
+/*!
+ * Find the first group at or after it with a vis index >= vis_idx. This searches forward in steps
+ * that double, so it's fast when the group is close, which is the common case for runs.
+ */
+VisGroupIter next_group_at_or_after(VisGroupIter it, VisGroupIter end, u32 vis_idx) {
+  auto vis_less = [](const tfrag3::StripDraw::VisGroup& grp, u32 idx) {
+    return grp.vis_idx_in_pc_bvh < idx;
+  };
+  s64 remaining = end - it;
+  s64 step = 1;
+  while (step < remaining && it[step].vis_idx_in_pc_bvh < vis_idx) {
+    step *= 2;
+  }
+  return std::lower_bound(it + step / 2, it + std::min(step, remaining), vis_idx, vis_less);
+}
+
+/*!
+ * Call fn(first, end, num_tris) for each range of visible indices in draw, relative to the start of
+ * the draw. Ranges next to each other are merged, so this gives the same ranges as checking every
+ * group. If proto_vis_data is set, groups with a hidden proto are also left out.
+ */
+template <typename Func>
+void for_each_visible_index_range(const tfrag3::StripDraw& draw,
+                                  const VisRuns& vis_runs,
+                                  const std::vector<u8>* proto_vis_data,
+                                  Func&& fn) {
+  const auto& starts = draw.vis_group_starts;
+  bool have_range = false;
+  u32 range_start = 0;
+  u32 range_end = 0;
+  u32 range_tris = 0;
+  auto add_groups = [&](u32 first_group, u32 end_group) {
+    u32 first = starts[first_group].first_ind;
+    u32 end = starts[end_group].first_ind;
+    u32 tris = starts[end_group].first_tri - starts[first_group].first_tri;
+    if (have_range && range_end == first) {
+      range_end = end;
+      range_tris += tris;
+    } else {
+      if (have_range) {
+        fn(range_start, range_end, range_tris);
+      }
+      have_range = true;
+      range_start = first;
+      range_end = end;
+      range_tris = tris;
+    }
+  };
+
+  auto groups_begin = draw.vis_groups.begin();
+  auto groups_end = draw.vis_groups.end();
+  auto it = groups_begin;
+  for (const auto& [run_first, run_end] : vis_runs.runs) {
+    it = next_group_at_or_after(it, groups_end, run_first);
+    if (it == groups_end) {
+      break;
+    }
+    auto run_groups_end = next_group_at_or_after(it, groups_end, run_end);
+    u32 first_group = it - groups_begin;
+    u32 end_group = run_groups_end - groups_begin;
+    if (proto_vis_data) {
+      for (u32 grp = first_group; grp < end_group; grp++) {
+        if ((*proto_vis_data)[draw.vis_groups[grp].tie_proto_idx]) {
+          add_groups(grp, grp + 1);
+        }
+      }
+    } else if (first_group != end_group) {
+      add_groups(first_group, end_group);
+    }
+    it = run_groups_end;
+  }
+
+  if (have_range) {
+    fn(range_start, range_end, range_tris);
+  }
+}
+
+/*!
+ * Fast version of the multidraw functions below, for a draw with sorted vis groups.
+ */
+void make_multidraws_from_vis_runs(std::pair<int, int>* draw_ptrs_out,
+                                   GLsizei* counts_out,
+                                   void** index_offsets_out,
+                                   const tfrag3::StripDraw& draw,
+                                   const VisRuns& vis_runs,
+                                   const std::vector<u8>* proto_vis_data,
+                                   u64* md_idx,
+                                   u32* num_tris) {
+  u64 first_idx = draw.unpacked.idx_of_first_idx_in_full_buffer;
+  draw_ptrs_out->first = *md_idx;
+  draw_ptrs_out->second = 0;
+  for_each_visible_index_range(draw, vis_runs, proto_vis_data, [&](u32 first, u32 end, u32 tris) {
+    counts_out[*md_idx] = end - first;
+    index_offsets_out[*md_idx] = (void*)((first_idx + first) * sizeof(u32));
+    draw_ptrs_out->second++;
+    (*md_idx)++;
+    *num_tris += tris;
+  });
+}
+
+/*!
+ * Fast version of the index list functions below, for a draw with sorted vis groups.
+ */
+void make_index_list_from_vis_runs(std::pair<int, int>* group_out,
+                                   u32* idx_out,
+                                   const tfrag3::StripDraw& draw,
+                                   const VisRuns& vis_runs,
+                                   const std::vector<u8>* proto_vis_data,
+                                   const u32* idx_in,
+                                   int* idx_buffer_ptr,
+                                   u32* num_tris) {
+  const u32* draw_idx_in = idx_in + draw.unpacked.idx_of_first_idx_in_full_buffer;
+  group_out->first = *idx_buffer_ptr;
+  for_each_visible_index_range(draw, vis_runs, proto_vis_data, [&](u32 first, u32 end, u32 tris) {
+    memcpy(&idx_out[*idx_buffer_ptr], draw_idx_in + first, (end - first) * sizeof(u32));
+    *idx_buffer_ptr += end - first;
+    *num_tris += tris;
+  });
+  group_out->second = *idx_buffer_ptr - group_out->first;
+}
+}  // namespace
+
 u32 make_multidraws_from_vis_string(std::pair<int, int>* draw_ptrs_out,
                                     GLsizei* counts_out,
                                     void** index_offsets_out,
                                     const std::vector<tfrag3::StripDraw>& draws,
-                                    const std::vector<u8>& vis_data) {
+                                    const std::vector<u8>& vis_data,
+                                    const VisRuns& vis_runs) {
   u64 md_idx = 0;
   u32 num_tris = 0;
   u32 sanity_check = 0;
@@ -530,6 +935,12 @@ u32 make_multidraws_from_vis_string(std::pair<int, int>* draw_ptrs_out,
     const auto& draw = draws[i];
     u64 iidx = draw.unpacked.idx_of_first_idx_in_full_buffer;
     ASSERT(sanity_check == iidx);
+    if (use_vis_runs(draw, vis_runs)) {
+      make_multidraws_from_vis_runs(&draw_ptrs_out[i], counts_out, index_offsets_out, draw,
+                                    vis_runs, nullptr, &md_idx, &num_tris);
+      sanity_check += draw.vis_group_starts.back().first_ind;
+      continue;
+    }
     std::pair<int, int> ds;
     ds.first = md_idx;
     ds.second = 0;
@@ -578,6 +989,7 @@ u32 make_multidraws_from_vis_and_proto_string(std::pair<int, int>* draw_ptrs_out
                                               void** index_offsets_out,
                                               const std::vector<tfrag3::StripDraw>& draws,
                                               const std::vector<u8>& vis_data,
+                                              const VisRuns& vis_runs,
                                               const std::vector<u8>& proto_vis_data) {
   u64 md_idx = 0;
   u32 num_tris = 0;
@@ -586,6 +998,12 @@ u32 make_multidraws_from_vis_and_proto_string(std::pair<int, int>* draw_ptrs_out
     const auto& draw = draws[i];
     u64 iidx = draw.unpacked.idx_of_first_idx_in_full_buffer;
     ASSERT(sanity_check == iidx);
+    if (use_vis_runs(draw, vis_runs)) {
+      make_multidraws_from_vis_runs(&draw_ptrs_out[i], counts_out, index_offsets_out, draw,
+                                    vis_runs, &proto_vis_data, &md_idx, &num_tris);
+      sanity_check += draw.vis_group_starts.back().first_ind;
+      continue;
+    }
     std::pair<int, int> ds;
     ds.first = md_idx;
     ds.second = 0;
@@ -634,12 +1052,18 @@ u32 make_index_list_from_vis_string(std::pair<int, int>* group_out,
                                     u32* idx_out,
                                     const std::vector<tfrag3::StripDraw>& draws,
                                     const std::vector<u8>& vis_data,
+                                    const VisRuns& vis_runs,
                                     const u32* idx_in,
                                     u32* num_tris_out) {
   int idx_buffer_ptr = 0;
   u32 num_tris = 0;
   for (size_t i = 0; i < draws.size(); i++) {
     const auto& draw = draws[i];
+    if (use_vis_runs(draw, vis_runs)) {
+      make_index_list_from_vis_runs(&group_out[i], idx_out, draw, vis_runs, nullptr, idx_in,
+                                    &idx_buffer_ptr, &num_tris);
+      continue;
+    }
     int vtx_idx = 0;
     std::pair<int, int> ds;
     ds.first = idx_buffer_ptr;
@@ -689,6 +1113,7 @@ u32 make_index_list_from_vis_and_proto_string(std::pair<int, int>* group_out,
                                               u32* idx_out,
                                               const std::vector<tfrag3::StripDraw>& draws,
                                               const std::vector<u8>& vis_data,
+                                              const VisRuns& vis_runs,
                                               const std::vector<u8>& proto_vis_data,
                                               const u32* idx_in,
                                               u32* num_tris_out) {
@@ -696,6 +1121,11 @@ u32 make_index_list_from_vis_and_proto_string(std::pair<int, int>* group_out,
   u32 num_tris = 0;
   for (size_t i = 0; i < draws.size(); i++) {
     const auto& draw = draws[i];
+    if (use_vis_runs(draw, vis_runs)) {
+      make_index_list_from_vis_runs(&group_out[i], idx_out, draw, vis_runs, &proto_vis_data,
+                                    idx_in, &idx_buffer_ptr, &num_tris);
+      continue;
+    }
     int vtx_idx = 0;
     std::pair<int, int> ds;
     ds.first = idx_buffer_ptr;
@@ -56,6 +56,10 @@ void interp_time_of_day_slow(const math::Vector<s32, 4> itimes[4],
 struct SwizzledTimeOfDay {
   std::vector<u8> data;
   u32 color_count = 0;
+
+  // itimes from the last time these colors were interpolated.
+  math::Vector<s32, 4> last_itimes[4];
+  bool has_last_itimes = false;
 };
 
 SwizzledTimeOfDay swizzle_time_of_day(const std::vector<tfrag3::TimeOfDayColor>& in);
@@ -64,10 +68,55 @@ void interp_time_of_day_fast(const math::Vector<s32, 4> itimes[4],
                              const SwizzledTimeOfDay& swizzled_colors,
                              math::Vector<u8, 4>* out);
 
+// the kernels used by interp_time_of_day_fast. The AVX2 and AVX-512 versions must only be used if
+// get_cpu_info() says they are supported.
+void interp_time_of_day_sse(const math::Vector<s32, 4> itimes[4],
+                            const SwizzledTimeOfDay& swizzled_colors,
+                            math::Vector<u8, 4>* out);
+void interp_time_of_day_avx2(const math::Vector<s32, 4> itimes[4],
+                             const SwizzledTimeOfDay& swizzled_colors,
+                             math::Vector<u8, 4>* out);
+void interp_time_of_day_avx512(const math::Vector<s32, 4> itimes[4],
+                               const SwizzledTimeOfDay& swizzled_colors,
+                               math::Vector<u8, 4>* out);
+
+/*!
+ * Returns false if these colors were last interpolated with exactly these itimes, meaning the
+ * result would be the same. Otherwise, remembers the itimes and returns true.
+ */
+bool time_of_day_needs_update(SwizzledTimeOfDay* colors, const math::Vector<s32, 4> itimes[4]);
+
 void cull_check_all_slow(const math::Vector4f* planes,
                          const std::vector<tfrag3::VisNode>& nodes,
                          const u8* level_occlusion_string,
                          u8* out);
+
+/*!
+ * The vis nodes of a BVH, stored as structure-of-arrays so 8 bspheres can be checked at once.
+ * Indices are the same as in BVH::vis_nodes, so siblings are still consecutive.
+ */
+struct CullingTree {
+  // bsphere, with the radius negated. Padded by 8 so the last group can be loaded as a whole.
+  std::vector<float> x, y, z, neg_r;
+  std::vector<u16> my_id;
+  std::vector<u16> first_child;  // index of the first child, if has_node_children
+  std::vector<u8> num_kids;
+  std::vector<u8> has_node_children;
+  u32 node_count = 0;
+  u16 num_roots = 0;
+};
+
+CullingTree make_culling_tree(const tfrag3::BVH& bvh);
+
+/*!
+ * Same result as cull_check_all_slow, but checks 8 siblings at once and skips the children of nodes
+ * outside of the frustum. This assumes that a child's bsphere is inside of its parent's, which is
+ * true for the trees in the game.
+ */
+void cull_check_all_fast(const math::Vector4f* planes,
+                         const CullingTree& tree,
+                         const u8* level_occlusion_string,
+                         u8* out);
 bool sphere_in_view_ref(const math::Vector4f& sphere, const math::Vector4f* planes);
 
 void update_render_state_from_pc_settings(SharedRenderState* state, const TfragPcPortData& data);
@@ -82,11 +131,24 @@ u32 make_all_visible_multidraws(std::pair<int, int>* draw_ptrs_out,
                                 void** index_offsets_out,
                                 const std::vector<tfrag3::StripDraw>& draws);
 
+/*!
+ * Runs of consecutive visible vis nodes in a vis string, as [first, end) pairs. The last run is
+ * always the always-visible groups (UINT16_MAX). Draws with sorted vis groups can find the groups
+ * in each run with a binary search, instead of checking every group.
+ */
+struct VisRuns {
+  std::vector<std::pair<u32, u32>> runs;
+};
+
+// vis_data must only have 0's and 1's, like the output of the cull_check functions.
+void find_vis_runs(const u8* vis_data, u32 node_count, VisRuns* out);
+
 u32 make_multidraws_from_vis_string(std::pair<int, int>* draw_ptrs_out,
                                     GLsizei* counts_out,
                                     void** index_offsets_out,
                                     const std::vector<tfrag3::StripDraw>& draws,
-                                    const std::vector<u8>& vis_data);
+                                    const std::vector<u8>& vis_data,
+                                    const VisRuns& vis_runs);
 
 u32 make_all_visible_index_list(std::pair<int, int>* group_out,
                                 u32* idx_out,
@@ -98,6 +160,7 @@ u32 make_index_list_from_vis_string(std::pair<int, int>* group_out,
                                     u32* idx_out,
                                     const std::vector<tfrag3::StripDraw>& draws,
                                     const std::vector<u8>& vis_data,
+                                    const VisRuns& vis_runs,
                                     const u32* idx_in,
                                     u32* num_tris_out);
 
@@ -111,12 +174,14 @@ u32 make_multidraws_from_vis_and_proto_string(std::pair<int, int>* draw_ptrs_out
                                               void** index_offsets_out,
                                               const std::vector<tfrag3::StripDraw>& draws,
                                               const std::vector<u8>& vis_data,
+                                              const VisRuns& vis_runs,
                                               const std::vector<u8>& proto_vis_data);
 
 u32 make_index_list_from_vis_and_proto_string(std::pair<int, int>* group_out,
                                               u32* idx_out,
                                               const std::vector<tfrag3::StripDraw>& draws,
                                               const std::vector<u8>& vis_data,
+                                              const VisRuns& vis_runs,
                                               const std::vector<u8>& proto_vis_data,
                                               const u32* idx_in,
                                               u32* num_tris_out);
\ No newline at end of file
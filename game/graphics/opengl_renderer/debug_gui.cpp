@@ -24,7 +24,7 @@ void FrameTimeRecorder::start_frame() {
   m_fps_timer.start();
 }
 
-void FrameTimeRecorder::draw_window(const DmaStats& /*dma_stats*/) {
+void FrameTimeRecorder::draw_window(const DmaStats& dma_stats) {
   auto* p_open = &m_open;
   ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoDecoration |
                                   ImGuiWindowFlags_AlwaysAutoResize |
@@ -44,9 +44,15 @@ void FrameTimeRecorder::draw_window(const DmaStats& /*dma_stats*/) {
 
   ImGui::SetNextWindowBgAlpha(0.85f);  // Transparent background
   if (ImGui::Begin("Frame Timing", p_open, window_flags)) {
-    //    ImGui::Text("DMA: sync ms %.1f, tc %4d, sz %3d KB, ch %d", dma_stats.sync_time_ms,
-    //                dma_stats.num_tags, (dma_stats.num_data_bytes) / (1 << 10),
-    //                dma_stats.num_chunks);
+    ImGui::Text("DMA: send %.2f ms, sync wait %.2f ms", dma_stats.send_chain_ms,
+                dma_stats.sync_path_wait_ms);
+    ImGui::Text("latency: %.2f ms, %d in flight", dma_stats.frame_latency_ms,
+                dma_stats.frames_in_flight);
+    if (dma_stats.num_tags) {
+      ImGui::Text("copy: %.2f ms, tc %4d, sz %3d KB, ch %d", dma_stats.sync_time_ms,
+                  dma_stats.num_tags, (dma_stats.num_data_bytes) / (1 << 10),
+                  dma_stats.num_chunks);
+    }
     float worst = 0, total = 0;
     for (auto x : m_frame_times) {
       worst = std::max(x, worst);
@@ -102,6 +108,11 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
       ImGui::MenuItem("Profiler", nullptr, &m_draw_profiler);
       ImGui::MenuItem("Small Profiler", nullptr, &small_profiler);
       ImGui::MenuItem("Loader", nullptr, &m_draw_loader);
+      if (ImGui::BeginMenu("DMA")) {
+        ImGui::Checkbox("Copy DMA chain", &copy_dma);
+        ImGui::Checkbox("Verify DMA copy", &verify_dma_copy);
+        ImGui::EndMenu();
+      }
       ImGui::EndMenu();
     }
 
@@ -148,6 +159,7 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
         ImGui::Separator();
         ImGui::Checkbox("Accurate Lag Mode", &Gfx::g_global_settings.experimental_accurate_lag);
         ImGui::Checkbox("Sleep in Frame Limiter", &Gfx::g_global_settings.sleep_in_frame_limiter);
+        ImGui::Checkbox("Pipeline Frames", &Gfx::g_global_settings.pipeline_frames);
         ImGui::EndMenu();
       }
       ImGui::MenuItem("Filters", nullptr, &m_filters_menu);
@@ -64,6 +64,10 @@ class OpenGlDebugGui {
     return false;
   }
 
+  // copy the DMA chain out of game memory before rendering, and optionally check the copy.
+  bool copy_dma = false;
+  bool verify_dma_copy = false;
+
   bool small_profiler = false;
   bool record_events = false;
   bool dump_events = false;
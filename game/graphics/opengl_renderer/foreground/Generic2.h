@@ -4,21 +4,16 @@
 
 class Generic2 {
  public:
-  Generic2(ShaderLibrary& shaders,
-           u32 num_verts = 500000,
-           u32 num_frags = 10000,
-           u32 num_adgif = 10000,
-           u32 num_buckets = 800);
+  Generic2(ShaderLibrary& shaders);
   ~Generic2();
 
   enum class Mode { NORMAL, LIGHTNING, WARP };
 
-  void render_in_mode(DmaFollower& dma,
-                      SharedRenderState* render_state,
-                      ScopedProfilerNode& prof,
-                      Mode mode);
+  class BucketData;
 
-  void draw_debug_window();
+  void submit(const BucketData& data, SharedRenderState* render_state, ScopedProfilerNode& prof);
+
+  void draw_debug_window(const BucketData& data);
 
   struct Vertex {
     math::Vector<float, 3> xyz;
@@ -32,30 +27,25 @@ class Generic2 {
   };
   static_assert(sizeof(Vertex) == 32);
 
+  static constexpr u32 kMaxVerts = 500000;
+  static constexpr u32 kMaxFrags = 10000;
+  static constexpr u32 kMaxAdgifs = 10000;
+  static constexpr u32 kMaxBuckets = 800;
+
  private:
-  void determine_draw_modes(bool enable_at, bool default_fog);
-  void build_index_buffer();
-  void link_adgifs_back_to_frags();
-  void draws_to_buckets();
-  void reset_buffers();
-  void process_matrices();
-  void process_dma_jak1(DmaFollower& dma, u32 next_bucket);
-  void process_dma_lightning(DmaFollower& dma, u32 next_bucket);
-  void process_dma_jak2(DmaFollower& dma, u32 next_bucket);
-  void setup_draws(bool enable_at, bool default_fog);
-  void do_draws(SharedRenderState* render_state, ScopedProfilerNode& prof);
-  void do_draws_for_alpha(SharedRenderState* render_state,
+  void do_draws(const BucketData& data, SharedRenderState* render_state, ScopedProfilerNode& prof);
+  void do_draws_for_alpha(const BucketData& data,
+                          SharedRenderState* render_state,
                           ScopedProfilerNode& prof,
                           DrawMode::AlphaBlend alpha,
                           bool hud);
-  void do_hud_draws(SharedRenderState* render_state, ScopedProfilerNode& prof);
-  bool check_for_end_of_generic_data(DmaFollower& dma, u32 next_bucket);
-  void final_vertex_update();
-  bool handle_bucket_setup_dma(DmaFollower& dma, u32 next_bucket);
+  void do_hud_draws(const BucketData& data,
+                    SharedRenderState* render_state,
+                    ScopedProfilerNode& prof);
 
   void opengl_setup(ShaderLibrary& shaders);
   void opengl_cleanup();
-  void opengl_bind_and_setup_proj(SharedRenderState* render_state);
+  void opengl_bind_and_setup_proj(const BucketData& data, SharedRenderState* render_state);
   void setup_opengl_for_draw_mode(const DrawMode& draw_mode,
                                   u8 fix,
                                   SharedRenderState* render_state);
@@ -67,10 +57,6 @@ class Generic2 {
                         bool clamp_t,
                         SharedRenderState* render_state);
 
-  struct {
-    u32 stcycl;
-  } m_dma_unpack;
-
   struct DrawingConfig {
     bool zmsk = false;
     // horizontal, vertical, depth, fog offsets.
@@ -84,7 +70,7 @@ class Generic2 {
     float hud_mat_23, hud_mat_32, hud_mat_33;
 
     bool uses_hud = false;
-  } m_drawing_config;
+  };
 
   struct GsState {
     DrawMode as_mode;
@@ -99,8 +85,7 @@ class Generic2 {
     void set_tcc_flag(bool value) { vertex_flags ^= (-(u8)value ^ vertex_flags) & 1; }
     void set_decal_flag(bool value) { vertex_flags ^= (-(u8)value ^ vertex_flags) & 2; }
     void set_fog_flag(bool value) { vertex_flags ^= (-(u8)value ^ vertex_flags) & 4; }
-
-  } m_gs;
+  };
 
   static constexpr u32 FRAG_HEADER_SIZE = 16 * 7;
   struct Fragment {
@@ -148,6 +133,46 @@ class Generic2 {
     u32 tri_count;  // just for debug
   };
 
+  static constexpr int ALPHA_MODE_COUNT = 7;
+  bool m_alpha_draw_enable[ALPHA_MODE_COUNT] = {true, true, true, true, true, true, true};
+
+  struct {
+    GLuint vao;
+    GLuint vertex_buffer;
+    GLuint index_buffer;
+    GLuint alpha_reject, color_mult, fog_color, scale, mat_23, mat_32, mat_33, fog_consts,
+        hvdf_offset;
+    GLuint gfx_hack_no_tex;
+    GLuint warp_sample_mode;
+  } m_ogl;
+};
+
+/*!
+ * The vertices and draws that Generic2 builds from the DMA of one bucket. Each bucket renderer has
+ * its own, so buckets can be prepared at the same time, while the OpenGL objects are shared.
+ * The buffers start empty and grow to the most the bucket has used.
+ */
+class Generic2::BucketData {
+ public:
+  void prepare(DmaFollower& dma, u32 next_bucket, GameVersion version, Mode mode);
+
+ private:
+  friend class Generic2;
+
+  void determine_draw_modes(bool enable_at, bool default_fog);
+  void build_index_buffer();
+  void link_adgifs_back_to_frags();
+  void draws_to_buckets();
+  void reset_buffers();
+  void process_matrices();
+  void process_dma_jak1(DmaFollower& dma, u32 next_bucket);
+  void process_dma_lightning(DmaFollower& dma, u32 next_bucket);
+  void process_dma_jak2(DmaFollower& dma, u32 next_bucket);
+  void setup_draws(bool enable_at, bool default_fog);
+  bool check_for_end_of_generic_data(DmaFollower& dma, u32 next_bucket);
+  void final_vertex_update();
+  bool handle_bucket_setup_dma(DmaFollower& dma, u32 next_bucket);
+
   u32 handle_fragments_after_unpack_v4_32(const u8* data,
                                           u32 off,
                                           u32 first_unpack_bytes,
@@ -155,6 +180,13 @@ class Generic2 {
                                           Fragment* frag,
                                           bool loop);
 
+  struct {
+    u32 stcycl;
+  } m_dma_unpack;
+
+  DrawingConfig m_drawing_config;
+  GsState m_gs;
+
   u32 m_next_free_frag = 0;
   std::vector<Fragment> m_fragments;
   u32 m_max_frags_seen = 0;
@@ -176,30 +208,34 @@ class Generic2 {
   u32 m_max_indices_seen = 0;
 
   Fragment& next_frag() {
-    ASSERT(m_next_free_frag < m_fragments.size());
+    ASSERT(m_next_free_frag < kMaxFrags);
+    if (m_next_free_frag == m_fragments.size()) {
+      m_fragments.emplace_back();
+    }
     return m_fragments[m_next_free_frag++];
   }
 
   Adgif& next_adgif() {
-    ASSERT(m_next_free_adgif < m_adgifs.size());
+    ASSERT(m_next_free_adgif < kMaxAdgifs);
+    if (m_next_free_adgif == m_adgifs.size()) {
+      m_adgifs.emplace_back();
+    }
     return m_adgifs[m_next_free_adgif++];
   }
 
   void alloc_vtx(int count) {
     m_next_free_vert += count;
-    ASSERT(m_next_free_vert < m_verts.size());
+    ASSERT(m_next_free_vert < kMaxVerts);
+    if (m_next_free_vert > m_verts.size()) {
+      m_verts.resize(m_next_free_vert);
+    }
   }
 
-  static constexpr int ALPHA_MODE_COUNT = 7;
-  bool m_alpha_draw_enable[ALPHA_MODE_COUNT] = {true, true, true, true, true, true, true};
-
-  struct {
-    GLuint vao;
-    GLuint vertex_buffer;
-    GLuint index_buffer;
-    GLuint alpha_reject, color_mult, fog_color, scale, mat_23, mat_32, mat_33, fog_consts,
-        hvdf_offset;
-    GLuint gfx_hack_no_tex;
-    GLuint warp_sample_mode;
-  } m_ogl;
+  Bucket& alloc_bucket() {
+    ASSERT(m_next_free_bucket < kMaxBuckets);
+    if (m_next_free_bucket == m_buckets.size()) {
+      m_buckets.emplace_back();
+    }
+    return m_buckets[m_next_free_bucket++];
+  }
 };
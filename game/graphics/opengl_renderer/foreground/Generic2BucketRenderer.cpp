@@ -4,22 +4,18 @@ Generic2BucketRenderer::Generic2BucketRenderer(const std::string& name,
                                                int id,
                                                std::shared_ptr<Generic2> renderer,
                                                Generic2::Mode mode)
-    : BucketRenderer(name, id), m_generic(renderer), m_mode(mode) {}
+    : PreparedBucketRenderer(name, id), m_generic(renderer), m_mode(mode) {}
 
 void Generic2BucketRenderer::draw_debug_window() {
-  m_generic->draw_debug_window();
+  m_generic->draw_debug_window(m_data);
 }
 
-void Generic2BucketRenderer::render(DmaFollower& dma,
-                                    SharedRenderState* render_state,
-                                    ScopedProfilerNode& prof) {
-  // if the user has asked to disable the renderer, just advance the dma follower to the next
-  // bucket and return immediately.
-  if (!m_enabled) {
-    while (dma.current_tag_offset() != render_state->next_bucket) {
-      dma.read_and_advance();
-    }
-    return;
-  }
-  m_generic->render_in_mode(dma, render_state, prof, m_mode);
+void Generic2BucketRenderer::prepare_dma(DmaFollower& dma,
+                                         u32 next_bucket,
+                                         const SharedRenderState& render_state) {
+  m_data.prepare(dma, next_bucket, render_state.version, m_mode);
+}
+
+void Generic2BucketRenderer::submit(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+  m_generic->submit(m_data, render_state, prof);
 }
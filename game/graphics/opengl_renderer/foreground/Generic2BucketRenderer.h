@@ -3,16 +3,22 @@
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
 #include "game/graphics/opengl_renderer/foreground/Generic2.h"
 
-class Generic2BucketRenderer : public BucketRenderer {
+class Generic2BucketRenderer : public PreparedBucketRenderer {
  public:
   Generic2BucketRenderer(const std::string& name,
                          int id,
                          std::shared_ptr<Generic2> renderer,
                          Generic2::Mode mode);
-  void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) override;
   void draw_debug_window() override;
 
+ protected:
+  void prepare_dma(DmaFollower& dma,
+                   u32 next_bucket,
+                   const SharedRenderState& render_state) override;
+  void submit(SharedRenderState* render_state, ScopedProfilerNode& prof) override;
+
  private:
   std::shared_ptr<Generic2> m_generic;
   Generic2::Mode m_mode;
+  Generic2::BucketData m_data;
 };
@@ -4,7 +4,7 @@
  * Main function to set up Generic2 draw lists.
  * This function figures out which vertices belong to which draw settings.
  */
-void Generic2::setup_draws(bool enable_at, bool default_fog) {
+void Generic2::BucketData::setup_draws(bool enable_at, bool default_fog) {
   if (m_next_free_frag == 0) {
     return;
   }
@@ -26,7 +26,7 @@ void Generic2::setup_draws(bool enable_at, bool default_fog) {
  * settings, the tbp (texture vram address), and the "vertex flags" that need to be set for each
  * vertex.  This information is used in later steps.
  */
-void Generic2::determine_draw_modes(bool enable_at, bool default_fog) {
+void Generic2::BucketData::determine_draw_modes(bool enable_at, bool default_fog) {
   // initialize draw mode
   DrawMode current_mode;
   current_mode.set_at(enable_at);
@@ -202,7 +202,7 @@ void Generic2::determine_draw_modes(bool enable_at, bool default_fog) {
 /*!
  * For each adgif, figure out the vertices that it belongs to, in the giant vertex buffer.
  */
-void Generic2::link_adgifs_back_to_frags() {
+void Generic2::BucketData::link_adgifs_back_to_frags() {
   for (u32 i = 0; i < m_next_free_frag; i++) {
     auto& frag = m_fragments[i];
     for (u32 j = 0; j < frag.adgif_count; j++) {
@@ -219,7 +219,7 @@ void Generic2::link_adgifs_back_to_frags() {
  * Build linked lists of adgifs that share the same settings.
  * TODO: also determine texture units per bucket here.
  */
-void Generic2::draws_to_buckets() {
+void Generic2::BucketData::draws_to_buckets() {
   std::unordered_map<u64, u32> draw_key_to_bucket;
   for (u32 i = 0; i < m_next_free_adgif; i++) {
     auto& ad = m_adgifs[i];
@@ -227,10 +227,8 @@ void Generic2::draws_to_buckets() {
       // put all hud draws in separate buckets.
       // there's some really weird messed up draws for the orbs that fly up to the corner when
       // breaking a crate on a zoomer.
-      u32 bucket_idx = m_next_free_bucket++;
-      ASSERT(bucket_idx < m_buckets.size());
-      draw_key_to_bucket[ad.key()] = bucket_idx;
-      auto& bucket = m_buckets[bucket_idx];
+      draw_key_to_bucket[ad.key()] = m_next_free_bucket;
+      auto& bucket = alloc_bucket();
       bucket.tbp = ad.tbp;
       bucket.mode = ad.mode;
       bucket.start = i;
@@ -241,10 +239,8 @@ void Generic2::draws_to_buckets() {
       const auto& bucket_it = draw_key_to_bucket.find(key);
       if (bucket_it == draw_key_to_bucket.end()) {
         // new bucket!
-        u32 bucket_idx = m_next_free_bucket++;
-        ASSERT(bucket_idx < m_buckets.size());
-        draw_key_to_bucket[key] = bucket_idx;
-        auto& bucket = m_buckets[bucket_idx];
+        draw_key_to_bucket[key] = m_next_free_bucket;
+        auto& bucket = alloc_bucket();
         bucket.tbp = ad.tbp;
         bucket.mode = ad.mode;
         bucket.start = i;
@@ -265,7 +261,7 @@ void Generic2::draws_to_buckets() {
  * Extract the matrix. They are exactly a perspective projection and they are all the same.
  * I don't think this will hold for TIE...
  */
-void Generic2::process_matrices() {
+void Generic2::BucketData::process_matrices() {
   // first, we need to find the projection matrix.
   // most of the time, it's first. If you have the hud open, there may be a few others.
   bool found_proj_matrix = false;
@@ -325,7 +321,7 @@ void Generic2::process_matrices() {
  * After all bucketing/draw modes have been determined, fill out the flag fields of all vertices.
  * TODO: fill out texture units
  */
-void Generic2::final_vertex_update() {
+void Generic2::BucketData::final_vertex_update() {
   for (u32 i = 0; i < m_next_free_adgif; i++) {
     auto& ad = m_adgifs[i];
     for (u32 j = 0; j < ad.vtx_count; j++) {
@@ -337,7 +333,7 @@ void Generic2::final_vertex_update() {
 /*!
  * Build the index buffer.
  */
-void Generic2::build_index_buffer() {
+void Generic2::BucketData::build_index_buffer() {
   for (u32 bucket_idx = 0; bucket_idx < m_next_free_bucket; bucket_idx++) {
     auto& bucket = m_buckets[bucket_idx];
     bucket.tri_count = 0;
@@ -346,6 +342,11 @@ void Generic2::build_index_buffer() {
     u32 adgif_idx = bucket.start;
     while (adgif_idx != UINT32_MAX) {
       auto& adgif = m_adgifs[adgif_idx];
+      // at most a restart, then a restart and 2 more indices per vertex.
+      u32 max_idx_end = m_next_free_idx + 1 + 3 * adgif.vtx_count;
+      if (max_idx_end > m_indices.size()) {
+        m_indices.resize(max_idx_end);
+      }
       m_indices[m_next_free_idx++] = UINT32_MAX;
       for (u32 vidx = adgif.vtx_idx; vidx < adgif.vtx_idx + adgif.vtx_count; vidx++) {
         auto& vtx = m_verts[vidx];
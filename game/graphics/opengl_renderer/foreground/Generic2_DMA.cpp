@@ -7,7 +7,8 @@
  * The DmaFollower will either point to the start of the next bucket (and the function will return
  * true), or to the beginning of the next non-NOP DMA for this bucket.
  */
-bool Generic2::check_for_end_of_generic_data(DmaFollower& dma, u32 next_bucket) {
+bool Generic2::BucketData::check_for_end_of_generic_data(DmaFollower& dma,
+                                                         u32 next_bucket) {
   while (dma.current_tag().qwc == 0 && dma.current_tag_vifcode0().kind == VifCode::Kind::NOP &&
          dma.current_tag_vifcode1().kind == VifCode::Kind::NOP) {
     // this "CALL" tag is inserted by the engine to reset the GS. It's always inserted at the end of
@@ -32,7 +33,7 @@ bool Generic2::check_for_end_of_generic_data(DmaFollower& dma, u32 next_bucket)
  * Otherwise, populates m_drawing_config which contains the common draw settings for all data being
  * rendered in this bucket.
  */
-bool Generic2::handle_bucket_setup_dma(DmaFollower& dma, u32 next_bucket) {
+bool Generic2::BucketData::handle_bucket_setup_dma(DmaFollower& dma, u32 next_bucket) {
   // if the engine didn't run the generic renderer setup function, this bucket will end here.
   if (check_for_end_of_generic_data(dma, next_bucket)) {
     return true;
@@ -97,7 +98,7 @@ bool Generic2::handle_bucket_setup_dma(DmaFollower& dma, u32 next_bucket) {
   return false;
 }
 
-void Generic2::reset_buffers() {
+void Generic2::BucketData::reset_buffers() {
   m_max_frags_seen = std::max(m_next_free_frag, m_max_frags_seen);
   m_max_verts_seen = std::max(m_next_free_vert, m_max_verts_seen);
   m_max_adgifs_seen = std::max(m_next_free_adgif, m_max_adgifs_seen);
@@ -155,12 +156,12 @@ u32 unpack_vtx_tcs(Generic2::Vertex* vtx, const u8* data, int vtx_count) {
   return vtx_count * 4;
 }
 
-u32 Generic2::handle_fragments_after_unpack_v4_32(const u8* data,
-                                                  u32 off,
-                                                  u32 first_unpack_bytes,
-                                                  u32 end_of_vif,
-                                                  Fragment* frag,
-                                                  bool loop) {
+u32 Generic2::BucketData::handle_fragments_after_unpack_v4_32(const u8* data,
+                                                              u32 off,
+                                                              u32 first_unpack_bytes,
+                                                              u32 end_of_vif,
+                                                              Fragment* frag,
+                                                              bool loop) {
   // note: they rely on _something_ aligning this?
   u32 off_aligned = (off + 15) & ~15;
   // each header should have 7 qw header + at least 5 qw for a single adgif.
@@ -310,7 +311,7 @@ u32 Generic2::handle_fragments_after_unpack_v4_32(const u8* data,
   return off;
 }
 
-void Generic2::process_dma_jak1(DmaFollower& dma, u32 next_bucket) {
+void Generic2::BucketData::process_dma_jak1(DmaFollower& dma, u32 next_bucket) {
   reset_buffers();
 
   // handle the stuff at the beginning.
@@ -394,7 +395,7 @@ bool is_jak2_end(const DmaTransfer& xf) {
          xf.vifcode1().kind == VifCode::Kind::DIRECT;
 }
 
-void Generic2::process_dma_jak2(DmaFollower& dma, u32 next_bucket) {
+void Generic2::BucketData::process_dma_jak2(DmaFollower& dma, u32 next_bucket) {
   reset_buffers();
   auto first_data = dma.read_and_advance();
 
@@ -550,7 +551,7 @@ void unpack_vertex(Generic2::Vertex* out, const u8* in, int count) {
   }
 }
 
-void Generic2::process_dma_lightning(DmaFollower& dma, u32 next_bucket) {
+void Generic2::BucketData::process_dma_lightning(DmaFollower& dma, u32 next_bucket) {
   reset_buffers();
   auto first_data = dma.read_and_advance();
   // if unused, sends 0 nop nop
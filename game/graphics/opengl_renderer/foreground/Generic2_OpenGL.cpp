@@ -11,9 +11,9 @@ void Generic2::opengl_setup(ShaderLibrary& shaders) {
   // set up the vertex array
   glBindVertexArray(m_ogl.vao);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(u32), nullptr, GL_STREAM_DRAW);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, kMaxVerts * 3 * sizeof(u32), nullptr, GL_STREAM_DRAW);
   glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
-  glBufferData(GL_ARRAY_BUFFER, m_verts.size() * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+  glBufferData(GL_ARRAY_BUFFER, kMaxVerts * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
 
   // xyz
   glEnableVertexAttribArray(0);
@@ -81,20 +81,20 @@ void Generic2::opengl_cleanup() {
   glDeleteVertexArrays(1, &m_ogl.vao);
 }
 
-void Generic2::opengl_bind_and_setup_proj(SharedRenderState* render_state) {
+void Generic2::opengl_bind_and_setup_proj(const BucketData& data,
+                                          SharedRenderState* render_state) {
+  const auto& config = data.m_drawing_config;
   render_state->shaders[ShaderId::GENERIC].activate();
   glUniform4f(m_ogl.fog_color, render_state->fog_color[0] / 255.f,
               render_state->fog_color[1] / 255.f, render_state->fog_color[2] / 255.f,
               render_state->fog_intensity / 255);
-  glUniform4f(m_ogl.scale, m_drawing_config.proj_scale[0], m_drawing_config.proj_scale[1],
-              m_drawing_config.proj_scale[2], 0);
-  glUniform1f(m_ogl.mat_23, m_drawing_config.proj_mat_23);
-  glUniform1f(m_ogl.mat_32, m_drawing_config.proj_mat_32);
+  glUniform4f(m_ogl.scale, config.proj_scale[0], config.proj_scale[1], config.proj_scale[2], 0);
+  glUniform1f(m_ogl.mat_23, config.proj_mat_23);
+  glUniform1f(m_ogl.mat_32, config.proj_mat_32);
   glUniform1f(m_ogl.mat_33, 0);
-  glUniform3f(m_ogl.fog_consts, m_drawing_config.pfog0, m_drawing_config.fog_min,
-              m_drawing_config.fog_max);
-  glUniform4f(m_ogl.hvdf_offset, m_drawing_config.hvdf_offset[0], m_drawing_config.hvdf_offset[1],
-              m_drawing_config.hvdf_offset[2], m_drawing_config.hvdf_offset[3]);
+  glUniform3f(m_ogl.fog_consts, config.pfog0, config.fog_min, config.fog_max);
+  glUniform4f(m_ogl.hvdf_offset, config.hvdf_offset[0], config.hvdf_offset[1],
+              config.hvdf_offset[2], config.hvdf_offset[3]);
   glUniform1i(m_ogl.gfx_hack_no_tex, Gfx::g_global_settings.hack_no_tex);
 }
 
@@ -259,13 +259,14 @@ void Generic2::setup_opengl_tex(u16 unit,
   }
 }
 
-void Generic2::do_draws_for_alpha(SharedRenderState* render_state,
+void Generic2::do_draws_for_alpha(const BucketData& data,
+                                  SharedRenderState* render_state,
                                   ScopedProfilerNode& prof,
                                   DrawMode::AlphaBlend alpha,
                                   bool hud) {
-  for (u32 i = 0; i < m_next_free_bucket; i++) {
-    auto& bucket = m_buckets[i];
-    auto& first = m_adgifs[bucket.start];
+  for (u32 i = 0; i < data.m_next_free_bucket; i++) {
+    auto& bucket = data.m_buckets[i];
+    auto& first = data.m_adgifs[bucket.start];
     if (first.mode.get_alpha_blend() == alpha && first.uses_hud == hud) {
       setup_opengl_for_draw_mode(first.mode, first.fix, render_state);
       setup_opengl_tex(0, first.tbp, first.mode.get_filt_enable(), first.mode.get_clamp_s_enable(),
@@ -278,10 +279,12 @@ void Generic2::do_draws_for_alpha(SharedRenderState* render_state,
   }
 }
 
-void Generic2::do_hud_draws(SharedRenderState* render_state, ScopedProfilerNode& prof) {
-  for (u32 i = 0; i < m_next_free_bucket; i++) {
-    auto& bucket = m_buckets[i];
-    auto& first = m_adgifs[bucket.start];
+void Generic2::do_hud_draws(const BucketData& data,
+                            SharedRenderState* render_state,
+                            ScopedProfilerNode& prof) {
+  for (u32 i = 0; i < data.m_next_free_bucket; i++) {
+    auto& bucket = data.m_buckets[i];
+    auto& first = data.m_adgifs[bucket.start];
     if (first.uses_hud) {
       setup_opengl_for_draw_mode(first.mode, first.fix, render_state);
       setup_opengl_tex(0, first.tbp, first.mode.get_filt_enable(), first.mode.get_clamp_s_enable(),
@@ -294,18 +297,21 @@ void Generic2::do_hud_draws(SharedRenderState* render_state, ScopedProfilerNode&
   }
 }
 
-void Generic2::do_draws(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+void Generic2::do_draws(const BucketData& data,
+                        SharedRenderState* render_state,
+                        ScopedProfilerNode& prof) {
   glBindVertexArray(m_ogl.vao);
   glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_next_free_idx * sizeof(u32), m_indices.data(),
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.m_next_free_idx * sizeof(u32), data.m_indices.data(),
+               GL_STREAM_DRAW);
+  glBufferData(GL_ARRAY_BUFFER, data.m_next_free_vert * sizeof(Vertex), data.m_verts.data(),
                GL_STREAM_DRAW);
-  glBufferData(GL_ARRAY_BUFFER, m_next_free_vert * sizeof(Vertex), m_verts.data(), GL_STREAM_DRAW);
 
   glEnable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
 
-  opengl_bind_and_setup_proj(render_state);
+  opengl_bind_and_setup_proj(data, render_state);
   constexpr DrawMode::AlphaBlend alpha_order[ALPHA_MODE_COUNT] = {
       DrawMode::AlphaBlend::SRC_0_FIX_DST,    DrawMode::AlphaBlend::SRC_SRC_SRC_SRC,
       DrawMode::AlphaBlend::SRC_DST_SRC_DST,  DrawMode::AlphaBlend::SRC_0_SRC_DST,
@@ -315,18 +321,18 @@ void Generic2::do_draws(SharedRenderState* render_state, ScopedProfilerNode& pro
 
   for (int i = 0; i < ALPHA_MODE_COUNT; i++) {
     if (m_alpha_draw_enable[i]) {
-      do_draws_for_alpha(render_state, prof, alpha_order[i], false);
+      do_draws_for_alpha(data, render_state, prof, alpha_order[i], false);
     }
   }
 
-  if (m_drawing_config.uses_hud) {
-    glUniform4f(m_ogl.scale, m_drawing_config.hud_scale[0], m_drawing_config.hud_scale[1],
-                m_drawing_config.hud_scale[2], 0);
-    glUniform1f(m_ogl.mat_23, m_drawing_config.hud_mat_23);
-    glUniform1f(m_ogl.mat_32, m_drawing_config.hud_mat_32);
-    glUniform1f(m_ogl.mat_33, m_drawing_config.hud_mat_33);
+  const auto& config = data.m_drawing_config;
+  if (config.uses_hud) {
+    glUniform4f(m_ogl.scale, config.hud_scale[0], config.hud_scale[1], config.hud_scale[2], 0);
+    glUniform1f(m_ogl.mat_23, config.hud_mat_23);
+    glUniform1f(m_ogl.mat_32, config.hud_mat_32);
+    glUniform1f(m_ogl.mat_33, config.hud_mat_33);
     glUniform1i(m_ogl.gfx_hack_no_tex, false);
 
-    do_hud_draws(render_state, prof);
+    do_hud_draws(data, render_state, prof);
   }
 }
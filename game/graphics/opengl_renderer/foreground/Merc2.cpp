@@ -80,16 +80,6 @@ Merc2::Merc2(ShaderLibrary& shaders) {
     }
   }
 
-  // initialize draw buffers, these will store lists of draws to flush.
-  for (int i = 0; i < MAX_LEVELS; i++) {
-    auto& draws = m_level_draw_buckets.emplace_back();
-    draws.draws.resize(MAX_DRAWS_PER_LEVEL);
-    draws.envmap_draws.resize(MAX_ENVMAP_DRAWS_PER_LEVEL);
-  }
-
-  m_mod_vtx_temp.resize(MAX_MOD_VTX);
-  m_mod_vtx_unpack_temp.resize(MAX_MOD_VTX * 2);
-
   for (auto& x : m_effect_debug_mask) {
     x = true;
   }
@@ -164,9 +154,10 @@ float blerc_multiplier = 1.f;
 void Merc2::model_mod_blerc_draws(int num_effects,
                                   const tfrag3::MercModel* model,
                                   const LevelData* lev,
-                                  ModBuffers* mod_opengl_buffers,
+                                  DrawBatch* batch,
+                                  u32* mod_uploads,
                                   const float* blerc_weights,
-                                  MercDebugStats* stats) {
+                                  MercDebugStats* stats) const {
   // loop over effects.
   for (int ei = 0; ei < num_effects; ei++) {
     const auto& effect = model->effects[ei];
@@ -175,10 +166,6 @@ void Merc2::model_mod_blerc_draws(int num_effects,
       continue;
     }
 
-    // grab opengl buffer
-    auto opengl_buffers = alloc_mod_vtx_buffer(lev);
-    mod_opengl_buffers[ei] = opengl_buffers;
-
     // check that we have enough room for the finished thing.
     if (effect.mod.vertices.size() > MAX_MOD_VTX) {
       fmt::print("More mod vertices than MAX_MOD_VTX. {} > {}\n", effect.mod.vertices.size(),
@@ -186,24 +173,21 @@ void Merc2::model_mod_blerc_draws(int num_effects,
       ASSERT_NOT_REACHED();
     }
 
+    // grab space for the vertices, these are uploaded to the GPU when the batch is drawn.
+    auto* mod_vtx = alloc_mod_vertices(batch, lev, effect.mod.vertices.size(), &mod_uploads[ei]);
+
     // start with the correct vertices from the model data:
-    memcpy(m_mod_vtx_temp.data(), effect.mod.vertices.data(),
+    memcpy(mod_vtx, effect.mod.vertices.data(),
            sizeof(tfrag3::MercVertex) * effect.mod.vertices.size());
 
     // do blerc math
     const auto* f_data = effect.mod.blerc.float_data.data();
     const u32* i_data = effect.mod.blerc.int_data.data();
     const u32* i_data_end = i_data + effect.mod.blerc.int_data.size();
-    blerc_avx(i_data, i_data_end, f_data, blerc_weights, m_mod_vtx_temp.data(), blerc_multiplier);
+    blerc_avx(i_data, i_data_end, f_data, blerc_weights, mod_vtx, blerc_multiplier);
 
-    // and upload to GPU
     stats->num_uploads++;
     stats->num_upload_bytes += effect.mod.vertices.size() * sizeof(tfrag3::MercVertex);
-    {
-      glBindBuffer(GL_ARRAY_BUFFER, opengl_buffers.vertex);
-      glBufferData(GL_ARRAY_BUFFER, effect.mod.vertices.size() * sizeof(tfrag3::MercVertex),
-                   m_mod_vtx_temp.data(), GL_DYNAMIC_DRAW);
-    }
   }
 }
 
@@ -217,8 +201,9 @@ void Merc2::model_mod_draws(int num_effects,
                             const LevelData* lev,
                             const u8* input_data,
                             const DmaTransfer& setup,
-                            ModBuffers* mod_opengl_buffers,
-                            MercDebugStats* stats) {
+                            BucketData* data,
+                            u32* mod_uploads,
+                            MercDebugStats* stats) const {
   auto p = scoped_prof("update-verts");
 
   // loop over effects. Mod vertices are done per effect (possibly a bad idea?)
@@ -230,10 +215,6 @@ void Merc2::model_mod_draws(int num_effects,
     }
 
     prof().begin_event("start1");
-    // grab opengl buffer
-    auto opengl_buffers = alloc_mod_vtx_buffer(lev);
-    mod_opengl_buffers[ei] = opengl_buffers;
-
     // check that we have enough room for the finished thing.
     if (effect.mod.vertices.size() > MAX_MOD_VTX) {
       fmt::print("More mod vertices than MAX_MOD_VTX. {} > {}\n", effect.mod.vertices.size(),
@@ -248,8 +229,17 @@ void Merc2::model_mod_draws(int num_effects,
       ASSERT_NOT_REACHED();
     }
 
+    if (data->mod_vtx_unpack_temp.size() < effect.mod.expect_vidx_end) {
+      data->mod_vtx_unpack_temp.resize(effect.mod.expect_vidx_end);
+    }
+    auto& unpack_temp = data->mod_vtx_unpack_temp;
+
+    // grab space for the vertices, these are uploaded to the GPU when the batch is drawn.
+    auto* mod_vtx =
+        alloc_mod_vertices(&data->batch(), lev, effect.mod.vertices.size(), &mod_uploads[ei]);
+
     // start with the "correct" vertices from the model data:
-    memcpy(m_mod_vtx_temp.data(), effect.mod.vertices.data(),
+    memcpy(mod_vtx, effect.mod.vertices.data(),
            sizeof(tfrag3::MercVertex) * effect.mod.vertices.size());
 
     // get pointers to the fragment and fragment control data
@@ -302,6 +292,7 @@ void Merc2::model_mod_draws(int num_effects,
 
           // loop over vertices in the fragment and unpack
           for (u32 w = my_u4_count / 4; w < (my_l4_count / 4) - 2; w += 3) {
+            ASSERT(vidx < unpack_temp.size());
             // positions
             u32 q0w = 0x4b010000 + frag[w * 4 + (0 * 4) + 3];
             u32 q1w = 0x4b010000 + frag[w * 4 + (1 * 4) + 3];
@@ -316,7 +307,7 @@ void Merc2::model_mod_draws(int num_effects,
             u32 q2x = model->st_vif_add + frag[w * 4 + (2 * 4) + 0];
             u32 q2y = model->st_vif_add + frag[w * 4 + (2 * 4) + 1];
 
-            auto* pos_array = m_mod_vtx_unpack_temp[vidx].pos;
+            auto* pos_array = unpack_temp[vidx].pos;
             memcpy(&pos_array[0], &q0w, 4);
             memcpy(&pos_array[1], &q1w, 4);
             memcpy(&pos_array[2], &q2w, 4);
@@ -327,7 +318,7 @@ void Merc2::model_mod_draws(int num_effects,
             pos_array[1] *= xyz_scale;
             pos_array[2] *= xyz_scale;
 
-            auto* nrm_array = m_mod_vtx_unpack_temp[vidx].nrm;
+            auto* nrm_array = unpack_temp[vidx].nrm;
             memcpy(&nrm_array[0], &q0z, 4);
             memcpy(&nrm_array[1], &q1z, 4);
             memcpy(&nrm_array[2], &q2z, 4);
@@ -335,7 +326,7 @@ void Merc2::model_mod_draws(int num_effects,
             nrm_array[1] += -65537;
             nrm_array[2] += -65537;
 
-            auto* uv_array = m_mod_vtx_unpack_temp[vidx].uv;
+            auto* uv_array = unpack_temp[vidx].uv;
             memcpy(&uv_array[0], &q2x, 4);
             memcpy(&uv_array[1], &q2y, 4);
             uv_array[0] += model->st_magic;
@@ -366,22 +357,15 @@ void Merc2::model_mod_draws(int num_effects,
       for (u32 vi = 0; vi < effect.mod.vertices.size(); vi++) {
         u32 addr = effect.mod.vertex_lump4_addr[vi];
         if (addr < vidx) {
-          memcpy(&m_mod_vtx_temp[vi], &m_mod_vtx_unpack_temp[addr], 32);
-          m_mod_vtx_temp[vi].st[0] = m_mod_vtx_unpack_temp[addr].uv[0];
-          m_mod_vtx_temp[vi].st[1] = m_mod_vtx_unpack_temp[addr].uv[1];
+          memcpy(&mod_vtx[vi], &unpack_temp[addr], 32);
+          mod_vtx[vi].st[0] = unpack_temp[addr].uv[0];
+          mod_vtx[vi].st[1] = unpack_temp[addr].uv[1];
         }
       }
     }
 
-    // and upload to GPU
     stats->num_uploads++;
     stats->num_upload_bytes += effect.mod.vertices.size() * sizeof(tfrag3::MercVertex);
-    {
-      auto pp = scoped_prof("update-verts-upload");
-      glBindBuffer(GL_ARRAY_BUFFER, opengl_buffers.vertex);
-      glBufferData(GL_ARRAY_BUFFER, effect.mod.vertices.size() * sizeof(tfrag3::MercVertex),
-                   m_mod_vtx_temp.data(), GL_DYNAMIC_DRAW);
-    }
   }
 }
 
@@ -389,9 +373,9 @@ void Merc2::model_mod_draws(int num_effects,
  * Setup draws for a model, given the DMA data generated by the GOAL code.
  */
 void Merc2::handle_pc_model(const DmaTransfer& setup,
-                            SharedRenderState* render_state,
-                            ScopedProfilerNode& proff,
-                            MercDebugStats* stats) {
+                            const SharedRenderState& render_state,
+                            BucketData* data,
+                            MercDebugStats* stats) const {
   auto p = scoped_prof("init-pc");
 
   // the format of the data is:
@@ -413,7 +397,7 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
   // Look up the model by name in the loader.
   // This will return a reference to this model's data, plus a reference to the level's data
   // for stuff shared between models of the same level
-  auto model_ref = render_state->loader->get_merc_model(name);
+  auto model_ref = render_state.loader->get_merc_model(name);
   if (!model_ref) {
     // it can fail, if the game is faster than the loader. In this case, we just don't draw.
     stats->num_missing_models++;
@@ -424,68 +408,73 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
   const LevelData* lev = model_ref->level;
   const tfrag3::MercModel* model = model_ref->model;
 
-  // each model uses only 1 light.
-  if (m_next_free_light >= MAX_LIGHTS) {
-    fmt::print("MERC2 out of lights, consider increasing MAX_LIGHTS\n");
-    flush_draw_buckets(render_state, proff, stats);
-  }
-
-  // models use many bones. First check if we need to flush:
+  // models use many bones. Sanity check that we have enough to draw the model
   int bone_count = model->max_bones + 1;
-  if (m_next_free_bone_vector + m_opengl_buffer_alignment + bone_count * 8 >
-      MAX_SHADER_BONE_VECTORS) {
-    fmt::print("MERC2 out of bones, consider increasing MAX_SHADER_BONE_VECTORS\n");
-    flush_draw_buckets(render_state, proff, stats);
-  }
-
-  // also sanity check that we have enough to draw the model
   if (m_opengl_buffer_alignment + bone_count * 8 > MAX_SHADER_BONE_VECTORS) {
     fmt::print(
         "MERC2 doesn't have enough bones to draw a model, increase MAX_SHADER_BONE_VECTORS\n");
     ASSERT_NOT_REACHED();
   }
+  if (model->max_draws >= MAX_DRAWS_PER_LEVEL) {
+    ASSERT_NOT_REACHED_MSG("MERC2 draw buffer not big enough");
+  }
+  if (model->max_draws >= MAX_ENVMAP_DRAWS_PER_LEVEL) {
+    ASSERT_NOT_REACHED_MSG("MERC2 envmap draw buffer not big enough");
+  }
 
   // next, we need to find a bucket that holds draws for this level (will have the right buffers
   // bound for drawing)
+  auto* batch = &data->batch();
   LevelDrawBucket* lev_bucket = nullptr;
-  for (u32 i = 0; i < m_next_free_level_bucket; i++) {
-    if (m_level_draw_buckets[i].level == lev) {
-      lev_bucket = &m_level_draw_buckets[i];
+  for (u32 i = 0; i < batch->next_free_level_bucket; i++) {
+    if (batch->level_draw_buckets[i].level == lev) {
+      lev_bucket = &batch->level_draw_buckets[i];
       break;
     }
   }
 
-  if (!lev_bucket) {
-    // no existing bucket, allocate a new one.
-    if (m_next_free_level_bucket >= m_level_draw_buckets.size()) {
-      // out of room, flush
-      // fmt::print("MERC2 out of levels, consider increasing MAX_LEVELS\n");
-      flush_draw_buckets(render_state, proff, stats);
-    }
-    // alloc a new one
-    lev_bucket = &m_level_draw_buckets[m_next_free_level_bucket++];
-    lev_bucket->reset();
-    lev_bucket->level = lev;
+  // check if this model fits in the current batch. If not, start a new one, which is flushed
+  // separately.
+  bool batch_full = false;
+
+  // each model uses only 1 light.
+  if (batch->next_free_light >= MAX_LIGHTS) {
+    fmt::print("MERC2 out of lights, consider increasing MAX_LIGHTS\n");
+    batch_full = true;
   }
 
-  // next check draws:
-  if (lev_bucket->next_free_draw + model->max_draws >= lev_bucket->draws.size()) {
-    // out of room, flush
+  if (batch->next_free_bone_vector + m_opengl_buffer_alignment + bone_count * 8 >
+      MAX_SHADER_BONE_VECTORS) {
+    fmt::print("MERC2 out of bones, consider increasing MAX_SHADER_BONE_VECTORS\n");
+    batch_full = true;
+  }
+
+  if (!lev_bucket && batch->next_free_level_bucket >= MAX_LEVELS) {
+    // fmt::print("MERC2 out of levels, consider increasing MAX_LEVELS\n");
+    batch_full = true;
+  }
+
+  if (lev_bucket && lev_bucket->next_free_draw + model->max_draws >= MAX_DRAWS_PER_LEVEL) {
     fmt::print("MERC2 out of draws, consider increasing MAX_DRAWS_PER_LEVEL\n");
-    flush_draw_buckets(render_state, proff, stats);
-    if (model->max_draws >= lev_bucket->draws.size()) {
-      ASSERT_NOT_REACHED_MSG("MERC2 draw buffer not big enough");
-    }
+    batch_full = true;
   }
 
-  // same for envmap draws
-  if (lev_bucket->next_free_envmap_draw + model->max_draws >= lev_bucket->envmap_draws.size()) {
-    // out of room, flush
+  if (lev_bucket &&
+      lev_bucket->next_free_envmap_draw + model->max_draws >= MAX_ENVMAP_DRAWS_PER_LEVEL) {
     fmt::print("MERC2 out of envmap draws, consider increasing MAX_ENVMAP_DRAWS_PER_LEVEL\n");
-    flush_draw_buckets(render_state, proff, stats);
-    if (model->max_draws >= lev_bucket->envmap_draws.size()) {
-      ASSERT_NOT_REACHED_MSG("MERC2 envmap draw buffer not big enough");
-    }
+    batch_full = true;
+  }
+
+  if (batch_full) {
+    batch = &data->next_batch();
+    lev_bucket = nullptr;
+  }
+
+  if (!lev_bucket) {
+    // no existing bucket, allocate a new one.
+    lev_bucket = &batch->level_draw_buckets[batch->next_free_level_bucket++];
+    lev_bucket->reset();
+    lev_bucket->level = lev;
   }
 
   // Next part of input data is the lights
@@ -494,7 +483,7 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
   input_data += sizeof(VuLights);
 
   u64 uses_water = 0;
-  if (render_state->version == GameVersion::Jak1) {
+  if (render_state.version == GameVersion::Jak1) {
     // jak 1 figures out water at runtime sadly
     memcpy(&uses_water, input_data, 8);
     input_data += 16;
@@ -554,12 +543,12 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
 
   // Next is pointers to merc data, needed so we can update vertices
 
-  // will hold opengl buffers for the updated vertices
-  ModBuffers mod_opengl_buffers[kMaxEffect];
+  // will hold the index of the upload for the updated vertices of each effect
+  u32 mod_uploads[kMaxEffect];
   if (model_uses_pc_blerc) {
-    model_mod_blerc_draws(num_effects, model, lev, mod_opengl_buffers, blerc_weights, stats);
+    model_mod_blerc_draws(num_effects, model, lev, batch, mod_uploads, blerc_weights, stats);
   } else if (model_uses_mod) {  // only if we've enabled, this path is slow.
-    model_mod_draws(num_effects, model, lev, input_data, setup, mod_opengl_buffers, stats);
+    model_mod_draws(num_effects, model, lev, input_data, setup, data, mod_uploads, stats);
   }
 
   // stats
@@ -597,10 +586,10 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
   }
 
   // allocate bones in shared bone buffer to be sent to GPU at flush-time
-  u32 first_bone = alloc_bones(bone_count, skel_matrix_buffer);
+  u32 first_bone = alloc_bones(batch, bone_count, skel_matrix_buffer);
 
   // allocate lights
-  u32 lights = alloc_lights(current_lights);
+  u32 lights = alloc_lights(batch, current_lights);
   stats->num_lights++;
 
   // loop over effects, creating draws for each
@@ -640,14 +629,14 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
                                    model_disables_fog);
         // modify the draw, set the mod flag and point it to the opengl buffer
         n->flags |= MOD_VTX;
-        n->mod_vtx_buffer = mod_opengl_buffers[ei];
+        n->mod_vtx_upload = mod_uploads[ei];
         if (should_envmap) {
           auto e =
               try_alloc_envmap_draw(mdraw, effect.envmap_mode, effect.envmap_texture, lev_bucket,
                                     fade_buffer + 4 * ei, first_bone, lights, uses_water);
           if (e) {
             e->flags |= MOD_VTX;
-            e->mod_vtx_buffer = mod_opengl_buffers[ei];
+            e->mod_vtx_upload = mod_uploads[ei];
           }
         }
       }
@@ -749,36 +738,52 @@ void Merc2::switch_to_emerc(SharedRenderState* render_state) {
 }
 
 /*!
- * Main merc2 rendering.
+ * Build the draws for a merc bucket. This doesn't use OpenGL, so it can run on any thread, as long
+ * as each bucket has its own data.
  */
-void Merc2::render(DmaFollower& dma,
-                   SharedRenderState* render_state,
-                   ScopedProfilerNode& prof,
-                   MercDebugStats* stats) {
+void Merc2::prepare(DmaFollower& dma,
+                    u32 next_bucket,
+                    const SharedRenderState& render_state,
+                    BucketData* data,
+                    MercDebugStats* stats) const {
   *stats = {};
   if (stats->collect_debug_model_list) {
     stats->model_list.clear();
   }
 
-  switch_to_merc2(render_state);
+  auto pp = scoped_prof("handle-all-dma");
+  data->reset();
+  // iterate through the dma chain, filling buckets
+  handle_all_dma(dma, next_bucket, render_state, data, stats);
+}
 
-  {
-    auto pp = scoped_prof("handle-all-dma");
-    // iterate through the dma chain, filling buckets
-    handle_all_dma(dma, render_state, prof, stats);
+/*!
+ * Draw a merc bucket built by prepare.
+ */
+void Merc2::submit(const BucketData& data,
+                   SharedRenderState* render_state,
+                   ScopedProfilerNode& prof,
+                   MercDebugStats* stats) {
+  switch_to_merc2(render_state);
+  if (data.has_low_memory) {
+    set_low_memory_uniforms(data.low_memory, render_state);
   }
 
-  {
-    auto pp = scoped_prof("flush-buckets");
-    // flush buckets to draws
-    flush_draw_buckets(render_state, prof, stats);
+  auto pp = scoped_prof("flush-buckets");
+  // flush buckets to draws
+  for (u32 i = 0; i < data.num_batches; i++) {
+    flush_draw_buckets(data.batches[i], render_state, prof, stats);
   }
 }
 
-u32 Merc2::alloc_lights(const VuLights& lights) {
-  ASSERT(m_next_free_light < MAX_LIGHTS);
-  u32 light_idx = m_next_free_light;
-  m_lights_buffer[m_next_free_light++] = lights;
+u32 Merc2::alloc_lights(DrawBatch* batch, const VuLights& lights) const {
+  ASSERT(batch->next_free_light < MAX_LIGHTS);
+  u32 light_idx = batch->next_free_light++;
+  if (light_idx == batch->lights.size()) {
+    batch->lights.push_back(lights);
+  } else {
+    batch->lights[light_idx] = lights;
+  }
   static_assert(sizeof(VuLights) == 7 * 16);
   return light_idx;
 }
@@ -793,9 +798,10 @@ std::string Merc2::ShaderMercMat::to_string() const {
  * Main MERC2 function to handle DMA
  */
 void Merc2::handle_all_dma(DmaFollower& dma,
-                           SharedRenderState* render_state,
-                           ScopedProfilerNode& prof,
-                           MercDebugStats* stats) {
+                           u32 next_bucket,
+                           const SharedRenderState& render_state,
+                           BucketData* data,
+                           MercDebugStats* stats) const {
   // process the first tag. this is just jumping to the merc-specific dma.
   auto data0 = dma.read_and_advance();
   ASSERT(data0.vif1() == 0 || data0.vifcode1().kind == VifCode::Kind::NOP);
@@ -807,22 +813,22 @@ void Merc2::handle_all_dma(DmaFollower& dma,
     for (int i = 0; i < 4; i++) {
       dma.read_and_advance();
     }
-    ASSERT(dma.current_tag_offset() == render_state->next_bucket);
+    ASSERT(dma.current_tag_offset() == next_bucket);
     return;
   }
 
-  if (dma.current_tag_offset() == render_state->next_bucket) {
+  if (dma.current_tag_offset() == next_bucket) {
     return;
   }
   // if we reach here, there's stuff to draw
   // this handles merc-specific setup DMA
-  handle_setup_dma(dma, render_state);
+  handle_setup_dma(dma, render_state, data);
 
   // handle each merc transfer
-  while (dma.current_tag_offset() != render_state->next_bucket) {
-    handle_merc_chain(dma, render_state, prof, stats);
+  while (dma.current_tag_offset() != next_bucket) {
+    handle_merc_chain(dma, next_bucket, render_state, data, stats);
   }
-  ASSERT(dma.current_tag_offset() == render_state->next_bucket);
+  ASSERT(dma.current_tag_offset() == next_bucket);
 }
 
 namespace {
@@ -834,7 +840,9 @@ void set_uniform(GLuint uniform, const math::Vector4f& val) {
 }
 }  // namespace
 
-void Merc2::handle_setup_dma(DmaFollower& dma, SharedRenderState* render_state) {
+void Merc2::handle_setup_dma(DmaFollower& dma,
+                             const SharedRenderState& render_state,
+                             BucketData* data) const {
   auto first = dma.read_and_advance();
 
   // 10 quadword setup packet
@@ -874,18 +882,9 @@ void Merc2::handle_setup_dma(DmaFollower& dma, SharedRenderState* render_state)
   }
 
   // 8 qw's of low memory data
-  memcpy(&m_low_memory, first.data + 16, sizeof(LowMemory));
-
-  switch_to_merc2(render_state);
-  set_uniform(m_merc_uniforms.hvdf_offset, m_low_memory.hvdf_offset);
-  set_uniform(m_merc_uniforms.fog, m_low_memory.fog);
-  glUniformMatrix4fv(m_merc_uniforms.perspective_matrix, 1, GL_FALSE,
-                     &m_low_memory.perspective[0].x());
-  switch_to_emerc(render_state);
-  set_uniform(m_emerc_uniforms.hvdf_offset, m_low_memory.hvdf_offset);
-  set_uniform(m_emerc_uniforms.fog, m_low_memory.fog);
-  glUniformMatrix4fv(m_emerc_uniforms.perspective_matrix, 1, GL_FALSE,
-                     &m_low_memory.perspective[0].x());
+  // these are sent to the shaders in submit.
+  memcpy(&data->low_memory, first.data + 16, sizeof(LowMemory));
+  data->has_low_memory = true;
 
   // 1 qw with another 4 vifcodes.
   u32 vifcode_final_data[4];
@@ -901,7 +900,7 @@ void Merc2::handle_setup_dma(DmaFollower& dma, SharedRenderState* render_state)
 
   // TODO: process low memory initialization
 
-  if (render_state->version == GameVersion::Jak1) {
+  if (render_state.version == GameVersion::Jak1) {
     auto second = dma.read_and_advance();
     ASSERT(second.size_bytes == 32);  // setting up test register.
     auto nothing = dma.read_and_advance();
@@ -919,6 +918,19 @@ void Merc2::handle_setup_dma(DmaFollower& dma, SharedRenderState* render_state)
   }
 }
 
+void Merc2::set_low_memory_uniforms(const LowMemory& low_memory, SharedRenderState* render_state) {
+  switch_to_merc2(render_state);
+  set_uniform(m_merc_uniforms.hvdf_offset, low_memory.hvdf_offset);
+  set_uniform(m_merc_uniforms.fog, low_memory.fog);
+  glUniformMatrix4fv(m_merc_uniforms.perspective_matrix, 1, GL_FALSE,
+                     &low_memory.perspective[0].x());
+  switch_to_emerc(render_state);
+  set_uniform(m_emerc_uniforms.hvdf_offset, low_memory.hvdf_offset);
+  set_uniform(m_emerc_uniforms.fog, low_memory.fog);
+  glUniformMatrix4fv(m_emerc_uniforms.perspective_matrix, 1, GL_FALSE,
+                     &low_memory.perspective[0].x());
+}
+
 namespace {
 bool tag_is_nothing_next(const DmaFollower& dma) {
   return dma.current_tag().kind == DmaTag::Kind::NEXT && dma.current_tag().qwc == 0 &&
@@ -927,9 +939,10 @@ bool tag_is_nothing_next(const DmaFollower& dma) {
 }  // namespace
 
 void Merc2::handle_merc_chain(DmaFollower& dma,
-                              SharedRenderState* render_state,
-                              ScopedProfilerNode& prof,
-                              MercDebugStats* stats) {
+                              u32 next_bucket,
+                              const SharedRenderState& render_state,
+                              BucketData* data,
+                              MercDebugStats* stats) const {
   while (tag_is_nothing_next(dma)) {
     auto nothing = dma.read_and_advance();
     ASSERT(nothing.size_bytes == 0);
@@ -943,13 +956,13 @@ void Merc2::handle_merc_chain(DmaFollower& dma,
 
   auto init = dma.read_and_advance();
   int skip_count = 2;
-  if (render_state->version == GameVersion::Jak2) {
+  if (render_state.version == GameVersion::Jak2) {
     skip_count = 1;
   }
 
   while (init.vifcode1().kind == VifCode::Kind::PC_PORT) {
     // flush_pending_model(render_state, prof);
-    handle_pc_model(init, render_state, prof, stats);
+    handle_pc_model(init, render_state, data, stats);
     for (int i = 0; i < skip_count; i++) {
       auto link = dma.read_and_advance();
       ASSERT(link.vifcode0().kind == VifCode::Kind::NOP);
@@ -961,7 +974,7 @@ void Merc2::handle_merc_chain(DmaFollower& dma,
 
   if (init.vifcode0().kind == VifCode::Kind::FLUSHA) {
     int num_skipped = 0;
-    while (dma.current_tag_offset() != render_state->next_bucket) {
+    while (dma.current_tag_offset() != next_bucket) {
       dma.read_and_advance();
       num_skipped++;
     }
@@ -974,17 +987,23 @@ void Merc2::handle_merc_chain(DmaFollower& dma,
  * Queue up some bones to be included in the bone buffer.
  * Returns the index of the first bone vector.
  */
-u32 Merc2::alloc_bones(int count, ShaderMercMat* data) {
-  u32 first_bone_vector = m_next_free_bone_vector;
+u32 Merc2::alloc_bones(DrawBatch* batch, int count, ShaderMercMat* data) const {
+  u32 first_bone_vector = batch->next_free_bone_vector;
   ASSERT(count * 8 + first_bone_vector <= MAX_SHADER_BONE_VECTORS);
 
   // model should have under 128 bones.
   ASSERT(count <= MAX_SKEL_BONES);
 
+  // grow the bone buffer to fit this model, plus the padding after it.
+  u32 end = first_bone_vector + count * 8 + m_opengl_buffer_alignment;
+  if (batch->bone_vectors.size() < end) {
+    batch->bone_vectors.resize(end);
+  }
+
   // iterate over each bone we need
   for (int i = 0; i < count; i++) {
     auto& skel_mat = data[i];
-    auto* shader_mat = &m_shader_bone_vector_buffer[m_next_free_bone_vector];
+    auto* shader_mat = &batch->bone_vectors[batch->next_free_bone_vector];
     int bv = 0;
 
     // and copy to the large bone buffer.
@@ -996,15 +1015,15 @@ u32 Merc2::alloc_bones(int count, ShaderMercMat* data) {
       shader_mat[bv++] = skel_mat.nmat[j];
     }
 
-    m_next_free_bone_vector += 8;
+    batch->next_free_bone_vector += 8;
   }
 
-  auto b0 = m_next_free_bone_vector;
-  m_next_free_bone_vector += m_opengl_buffer_alignment - 1;
-  m_next_free_bone_vector /= m_opengl_buffer_alignment;
-  m_next_free_bone_vector *= m_opengl_buffer_alignment;
-  ASSERT(b0 <= m_next_free_bone_vector);
-  ASSERT(first_bone_vector + count * 8 <= m_next_free_bone_vector);
+  auto b0 = batch->next_free_bone_vector;
+  batch->next_free_bone_vector += m_opengl_buffer_alignment - 1;
+  batch->next_free_bone_vector /= m_opengl_buffer_alignment;
+  batch->next_free_bone_vector *= m_opengl_buffer_alignment;
+  ASSERT(b0 <= batch->next_free_bone_vector);
+  ASSERT(first_bone_vector + count * 8 <= batch->next_free_bone_vector);
   return first_bone_vector;
 }
 
@@ -1023,6 +1042,24 @@ Merc2::ModBuffers Merc2::alloc_mod_vtx_buffer(const LevelData* lev) {
   return m_mod_vtx_buffers[m_next_mod_vtx_buffer++];
 }
 
+/*!
+ * Get space in the batch for the updated vertices of an effect. They are uploaded to their own
+ * buffer when the batch is drawn. Returns the index of the upload.
+ */
+tfrag3::MercVertex* Merc2::alloc_mod_vertices(DrawBatch* batch,
+                                              const LevelData* lev,
+                                              u32 count,
+                                              u32* upload_idx) const {
+  u32 first = batch->next_free_mod_vertex;
+  batch->next_free_mod_vertex += count;
+  if (batch->mod_vertices.size() < batch->next_free_mod_vertex) {
+    batch->mod_vertices.resize(batch->next_free_mod_vertex);
+  }
+  *upload_idx = batch->mod_uploads.size();
+  batch->mod_uploads.push_back({lev, first, count});
+  return &batch->mod_vertices[first];
+}
+
 Merc2::Draw* Merc2::try_alloc_envmap_draw(const tfrag3::MercDraw& mdraw,
                                           const DrawMode& envmap_mode,
                                           u32 envmap_texture,
@@ -1030,7 +1067,7 @@ Merc2::Draw* Merc2::try_alloc_envmap_draw(const tfrag3::MercDraw& mdraw,
                                           const u8* fade,
                                           u32 first_bone,
                                           u32 lights,
-                                          bool jak1_water_mode) {
+                                          bool jak1_water_mode) const {
   bool nonzero_fade = false;
   for (int i = 0; i < 4; i++) {
     if (fade[i]) {
@@ -1042,6 +1079,9 @@ Merc2::Draw* Merc2::try_alloc_envmap_draw(const tfrag3::MercDraw& mdraw,
     return nullptr;
   }
 
+  if (lev_bucket->next_free_envmap_draw == lev_bucket->envmap_draws.size()) {
+    lev_bucket->envmap_draws.emplace_back();
+  }
   Draw* draw = &lev_bucket->envmap_draws[lev_bucket->next_free_envmap_draw++];
   draw->flags = 0;
   draw->first_index = mdraw.first_index;
@@ -1067,7 +1107,10 @@ Merc2::Draw* Merc2::alloc_normal_draw(const tfrag3::MercDraw& mdraw,
                                       u32 first_bone,
                                       u32 lights,
                                       bool jak1_water_mode,
-                                      bool disable_fog) {
+                                      bool disable_fog) const {
+  if (lev_bucket->next_free_draw == lev_bucket->draws.size()) {
+    lev_bucket->draws.emplace_back();
+  }
   Draw* draw = &lev_bucket->draws[lev_bucket->next_free_draw++];
   draw->flags = 0;
   draw->first_index = mdraw.first_index;
@@ -1156,41 +1199,51 @@ void Merc2::setup_merc_vao() {
   );
 }
 
-void Merc2::flush_draw_buckets(SharedRenderState* render_state,
+void Merc2::flush_draw_buckets(const DrawBatch& batch,
+                               SharedRenderState* render_state,
                                ScopedProfilerNode& prof,
                                MercDebugStats* stats) {
   stats->num_draw_flush++;
-  for (u32 li = 0; li < m_next_free_level_bucket; li++) {
-    const auto& lev_bucket = m_level_draw_buckets[li];
+
+  // upload the vertices that the game modified
+  m_batch_mod_buffers.clear();
+  for (const auto& upload : batch.mod_uploads) {
+    auto buffers = alloc_mod_vtx_buffer(upload.level);
+    m_batch_mod_buffers.push_back(buffers);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers.vertex);
+    glBufferData(GL_ARRAY_BUFFER, upload.vertex_count * sizeof(tfrag3::MercVertex),
+                 &batch.mod_vertices[upload.first_vertex], GL_DYNAMIC_DRAW);
+  }
+
+  for (u32 li = 0; li < batch.next_free_level_bucket; li++) {
+    const auto& lev_bucket = batch.level_draw_buckets[li];
     const auto* lev = lev_bucket.level;
     glBindVertexArray(m_vao);
     glBindBuffer(GL_ARRAY_BUFFER, lev->merc_vertices);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lev->merc_indices);
     setup_merc_vao();
-    stats->num_bones_uploaded += m_next_free_bone_vector;
+    stats->num_bones_uploaded += batch.next_free_bone_vector;
 
     glBindBuffer(GL_UNIFORM_BUFFER, m_bones_buffer);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, m_next_free_bone_vector * sizeof(math::Vector4f),
-                    m_shader_bone_vector_buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, batch.next_free_bone_vector * sizeof(math::Vector4f),
+                    batch.bone_vectors.data());
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
     switch_to_merc2(render_state);
-    do_draws(lev_bucket.draws.data(), lev, lev_bucket.next_free_draw, m_merc_uniforms, prof, false,
-             render_state);
+    do_draws(lev_bucket.draws.data(), batch, lev, lev_bucket.next_free_draw, m_merc_uniforms,
+             prof, false, render_state);
     if (lev_bucket.next_free_envmap_draw) {
       switch_to_emerc(render_state);
-      do_draws(lev_bucket.envmap_draws.data(), lev, lev_bucket.next_free_envmap_draw,
+      do_draws(lev_bucket.envmap_draws.data(), batch, lev, lev_bucket.next_free_envmap_draw,
                m_emerc_uniforms, prof, true, render_state);
     }
   }
 
-  m_next_free_light = 0;
-  m_next_free_bone_vector = 0;
-  m_next_free_level_bucket = 0;
   m_next_mod_vtx_buffer = 0;
 }
 
 void Merc2::do_draws(const Draw* draw_array,
+                     const DrawBatch& batch,
                      const LevelData* lev,
                      u32 num_draws,
                      const Uniforms& uniforms,
@@ -1207,7 +1260,7 @@ void Merc2::do_draws(const Draw* draw_array,
   for (u32 di = 0; di < num_draws; di++) {
     auto& draw = draw_array[di];
     if (draw.flags & MOD_VTX) {
-      glBindVertexArray(draw.mod_vtx_buffer.vao);
+      glBindVertexArray(m_batch_mod_buffers[draw.mod_vtx_upload].vao);
       glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lev->merc_indices);
       glBindBuffer(GL_ARRAY_BUFFER, lev->merc_vertices);
       normal_vtx_buffer_bound = false;
@@ -1249,13 +1302,14 @@ void Merc2::do_draws(const Draw* draw_array,
     }
 
     if ((int)draw.light_idx != last_light && !set_fade) {
-      set_uniform(uniforms.light_direction[0], m_lights_buffer[draw.light_idx].direction0);
-      set_uniform(uniforms.light_direction[1], m_lights_buffer[draw.light_idx].direction1);
-      set_uniform(uniforms.light_direction[2], m_lights_buffer[draw.light_idx].direction2);
-      set_uniform(uniforms.light_color[0], m_lights_buffer[draw.light_idx].color0);
-      set_uniform(uniforms.light_color[1], m_lights_buffer[draw.light_idx].color1);
-      set_uniform(uniforms.light_color[2], m_lights_buffer[draw.light_idx].color2);
-      set_uniform(uniforms.light_ambient, m_lights_buffer[draw.light_idx].ambient);
+      const auto& lights = batch.lights[draw.light_idx];
+      set_uniform(uniforms.light_direction[0], lights.direction0);
+      set_uniform(uniforms.light_direction[1], lights.direction1);
+      set_uniform(uniforms.light_direction[2], lights.direction2);
+      set_uniform(uniforms.light_color[0], lights.color0);
+      set_uniform(uniforms.light_color[1], lights.color1);
+      set_uniform(uniforms.light_color[2], lights.color2);
+      set_uniform(uniforms.light_ambient, lights.ambient);
       last_light = draw.light_idx;
     }
     setup_opengl_from_draw_mode(draw.mode, GL_TEXTURE0, use_mipmaps_for_filtering);
@@ -43,7 +43,15 @@ class Merc2 {
   Merc2(ShaderLibrary& shaders);
   ~Merc2();
   void draw_debug_window(MercDebugStats* stats);
-  void render(DmaFollower& dma,
+
+  struct BucketData;
+
+  void prepare(DmaFollower& dma,
+               u32 next_bucket,
+               const SharedRenderState& render_state,
+               BucketData* data,
+               MercDebugStats* stats) const;
+  void submit(const BucketData& data,
               SharedRenderState* render_state,
               ScopedProfilerNode& prof,
               MercDebugStats* stats);
@@ -63,7 +71,7 @@ class Merc2 {
     math::Vector4f hvdf_offset;
     math::Vector4f perspective[4];
     math::Vector4f fog;
-  } m_low_memory;
+  };
   static_assert(sizeof(LowMemory) == 0x80);
 
   struct VuLights {
@@ -79,11 +87,13 @@ class Merc2 {
     math::Vector4f ambient;
   };
 
+  struct DrawBatch;
+
   void handle_pc_model(const DmaTransfer& setup,
-                       SharedRenderState* render_state,
-                       ScopedProfilerNode& prof,
-                       MercDebugStats* stats);
-  u32 alloc_lights(const VuLights& lights);
+                       const SharedRenderState& render_state,
+                       BucketData* data,
+                       MercDebugStats* stats) const;
+  u32 alloc_lights(DrawBatch* batch, const VuLights& lights) const;
 
   struct ModBuffers {
     GLuint vao, vertex;
@@ -103,7 +113,7 @@ class Merc2 {
     math::Vector4f pad;
     std::string to_string() const;
   };
-  u32 alloc_bones(int count, ShaderMercMat* data);
+  u32 alloc_bones(DrawBatch* batch, int count, ShaderMercMat* data) const;
   static constexpr int MAX_SKEL_BONES = 128;
   static constexpr int BONE_VECTORS_PER_BONE = 7;
   static constexpr int MAX_SHADER_BONE_VECTORS = 1024 * 32;  // ??
@@ -112,8 +122,6 @@ class Merc2 {
   static constexpr int MAX_DRAWS_PER_LEVEL = 2048 * 2;
   static constexpr int MAX_ENVMAP_DRAWS_PER_LEVEL = MAX_DRAWS_PER_LEVEL;
 
-  math::Vector4f m_shader_bone_vector_buffer[MAX_SHADER_BONE_VECTORS];
-
   struct Uniforms {
     GLuint light_direction[3];
     GLuint light_color[3];
@@ -139,15 +147,20 @@ class Merc2 {
   Uniforms m_merc_uniforms, m_emerc_uniforms;
 
   void init_shader_common(Shader& shader, Uniforms* uniforms, bool include_lights);
-  void handle_setup_dma(DmaFollower& dma, SharedRenderState* render_state);
+  void handle_setup_dma(DmaFollower& dma,
+                        const SharedRenderState& render_state,
+                        BucketData* data) const;
   void handle_all_dma(DmaFollower& dma,
-                      SharedRenderState* render_state,
-                      ScopedProfilerNode& prof,
-                      MercDebugStats* stats);
+                      u32 next_bucket,
+                      const SharedRenderState& render_state,
+                      BucketData* data,
+                      MercDebugStats* stats) const;
   void handle_merc_chain(DmaFollower& dma,
-                         SharedRenderState* render_state,
-                         ScopedProfilerNode& prof,
-                         MercDebugStats* stats);
+                         u32 next_bucket,
+                         const SharedRenderState& render_state,
+                         BucketData* data,
+                         MercDebugStats* stats) const;
+  void set_low_memory_uniforms(const LowMemory& low_memory, SharedRenderState* render_state);
 
   void switch_to_merc2(SharedRenderState* render_state);
   void switch_to_emerc(SharedRenderState* render_state);
@@ -158,18 +171,22 @@ class Merc2 {
 
   std::vector<ModBuffers> m_mod_vtx_buffers;
   u32 m_next_mod_vtx_buffer = 0;
+  // the buffers for the mod vertices of the batch being drawn.
+  std::vector<ModBuffers> m_batch_mod_buffers;
 
   static constexpr int MAX_MOD_VTX = UINT16_MAX;
-  std::vector<tfrag3::MercVertex> m_mod_vtx_temp;
 
   struct UnpackTempVtx {
     float pos[4];
     float nrm[4];
     float uv[2];
   };
-  std::vector<UnpackTempVtx> m_mod_vtx_unpack_temp;
 
   ModBuffers alloc_mod_vtx_buffer(const LevelData* lev);
+  tfrag3::MercVertex* alloc_mod_vertices(DrawBatch* batch,
+                                         const LevelData* lev,
+                                         u32 count,
+                                         u32* upload_idx) const;
 
   GLuint m_bones_buffer;
 
@@ -187,7 +204,7 @@ class Merc2 {
     u16 first_bone;
     u16 light_idx;
     u8 flags;
-    ModBuffers mod_vtx_buffer;
+    u32 mod_vtx_upload;  // index in the batch's mod_uploads
     u8 fade[4];
   };
 
@@ -210,7 +227,7 @@ class Merc2 {
                           u32 first_bone,
                           u32 lights,
                           bool jak1_water_mode,
-                          bool disable_fog);
+                          bool disable_fog) const;
 
   Draw* try_alloc_envmap_draw(const tfrag3::MercDraw& mdraw,
                               const DrawMode& envmap_mode,
@@ -219,9 +236,10 @@ class Merc2 {
                               const u8* fade,
                               u32 first_bone,
                               u32 lights,
-                              bool jak1_water_mode);
+                              bool jak1_water_mode) const;
 
   void do_draws(const Draw* draw_array,
+                const DrawBatch& batch,
                 const LevelData* lev,
                 u32 num_draws,
                 const Uniforms& uniforms,
@@ -230,15 +248,39 @@ class Merc2 {
                 SharedRenderState* render_state);
 
   static constexpr int MAX_LIGHTS = 1024;
-  VuLights m_lights_buffer[MAX_LIGHTS];
-  u32 m_next_free_light = 0;
-
-  std::vector<LevelDrawBucket> m_level_draw_buckets;
-  u32 m_next_free_level_bucket = 0;
-  u32 m_next_free_bone_vector = 0;
   size_t m_opengl_buffer_alignment = 0;
 
-  void flush_draw_buckets(SharedRenderState* render_state,
+  // mod vertices that are uploaded to their own buffer when the batch is drawn.
+  struct ModUpload {
+    const LevelData* level;
+    u32 first_vertex;
+    u32 vertex_count;
+  };
+
+  // draws that are flushed together, sharing one upload of bones. If a bucket has more than fits,
+  // it's split into several batches. The buffers grow to the most this batch has used.
+  struct DrawBatch {
+    std::vector<LevelDrawBucket> level_draw_buckets;
+    u32 next_free_level_bucket = 0;
+    std::vector<VuLights> lights;
+    u32 next_free_light = 0;
+    std::vector<math::Vector4f> bone_vectors;
+    u32 next_free_bone_vector = 0;
+    std::vector<tfrag3::MercVertex> mod_vertices;
+    u32 next_free_mod_vertex = 0;
+    std::vector<ModUpload> mod_uploads;
+
+    void reset() {
+      next_free_level_bucket = 0;
+      next_free_light = 0;
+      next_free_bone_vector = 0;
+      next_free_mod_vertex = 0;
+      mod_uploads.clear();
+    }
+  };
+
+  void flush_draw_buckets(const DrawBatch& batch,
+                          SharedRenderState* render_state,
                           ScopedProfilerNode& prof,
                           MercDebugStats* stats);
   void model_mod_draws(int num_effects,
@@ -246,12 +288,45 @@ class Merc2 {
                        const LevelData* lev,
                        const u8* input_data,
                        const DmaTransfer& setup,
-                       ModBuffers* mod_opengl_buffers,
-                       MercDebugStats* stats);
+                       BucketData* data,
+                       u32* mod_uploads,
+                       MercDebugStats* stats) const;
   void model_mod_blerc_draws(int num_effects,
                              const tfrag3::MercModel* model,
                              const LevelData* lev,
-                             ModBuffers* mod_opengl_buffers,
+                             DrawBatch* batch,
+                             u32* mod_uploads,
                              const float* blerc_weights,
-                             MercDebugStats* stats);
+                             MercDebugStats* stats) const;
+};
+
+/*!
+ * The draws that Merc2 builds from the DMA of one bucket. Each bucket renderer has its own, so
+ * buckets can be prepared at the same time, while the OpenGL objects are shared.
+ */
+struct Merc2::BucketData {
+  LowMemory low_memory;
+  bool has_low_memory = false;
+
+  std::vector<DrawBatch> batches;
+  u32 num_batches = 0;
+
+  std::vector<UnpackTempVtx> mod_vtx_unpack_temp;
+
+  DrawBatch& batch() { return batches[num_batches - 1]; }
+
+  DrawBatch& next_batch() {
+    if (num_batches == batches.size()) {
+      batches.emplace_back().level_draw_buckets.resize(MAX_LEVELS);
+    }
+    auto& result = batches[num_batches++];
+    result.reset();
+    return result;
+  }
+
+  void reset() {
+    has_low_memory = false;
+    num_batches = 0;
+    next_batch();
+  }
 };
@@ -3,20 +3,16 @@
 Merc2BucketRenderer::Merc2BucketRenderer(const std::string& name,
                                          int my_id,
                                          std::shared_ptr<Merc2> merc)
-    : BucketRenderer(name, my_id), m_renderer(merc) {}
+    : PreparedBucketRenderer(name, my_id), m_renderer(merc) {}
 
-void Merc2BucketRenderer::render(DmaFollower& dma,
-                                 SharedRenderState* render_state,
-                                 ScopedProfilerNode& prof) {
-  // skip if disabled
-  if (!m_enabled) {
-    while (dma.current_tag_offset() != render_state->next_bucket) {
-      dma.read_and_advance();
-    }
-    return;
-  }
+void Merc2BucketRenderer::prepare_dma(DmaFollower& dma,
+                                      u32 next_bucket,
+                                      const SharedRenderState& render_state) {
+  m_renderer->prepare(dma, next_bucket, render_state, &m_data, &m_debug_stats);
+}
 
-  m_renderer->render(dma, render_state, prof, &m_debug_stats);
+void Merc2BucketRenderer::submit(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+  m_renderer->submit(m_data, render_state, prof, &m_debug_stats);
 }
 
 void Merc2BucketRenderer::draw_debug_window() {
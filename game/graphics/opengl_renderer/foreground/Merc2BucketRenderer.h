@@ -3,13 +3,19 @@
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
 #include "game/graphics/opengl_renderer/foreground/Merc2.h"
 
-class Merc2BucketRenderer : public BucketRenderer {
+class Merc2BucketRenderer : public PreparedBucketRenderer {
  public:
   Merc2BucketRenderer(const std::string& name, int my_id, std::shared_ptr<Merc2> merc);
   void draw_debug_window() override;
-  void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) override;
+
+ protected:
+  void prepare_dma(DmaFollower& dma,
+                   u32 next_bucket,
+                   const SharedRenderState& render_state) override;
+  void submit(SharedRenderState* render_state, ScopedProfilerNode& prof) override;
 
  private:
   std::shared_ptr<Merc2> m_renderer;
+  Merc2::BucketData m_data;
   MercDebugStats m_debug_stats;
 };
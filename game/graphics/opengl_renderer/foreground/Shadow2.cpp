@@ -2,7 +2,7 @@
 
 #include "third-party/imgui/imgui.h"
 
-Shadow2::Shadow2(const std::string& name, int my_id) : BucketRenderer(name, my_id) {
+Shadow2::Shadow2(const std::string& name, int my_id) : PreparedBucketRenderer(name, my_id) {
   m_vertex_buffer.resize(kMaxVerts);
   m_front_index_buffer.resize(kMaxInds);
   m_back_index_buffer.resize(kMaxInds);
@@ -62,11 +62,19 @@ void Shadow2::reset_buffers() {
   m_vertex_buffer_used = 0;
 }
 
-void Shadow2::render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) {
+/*!
+ * Read the DMA for this bucket and run the shadow VU programs to fill the vertex and index buffers.
+ * Doesn't use OpenGL, so this can run on a worker thread.
+ */
+void Shadow2::prepare_dma(DmaFollower& dma,
+                          u32 next_bucket,
+                          const SharedRenderState& /*render_state*/) {
+  reset_buffers();
+
   // jump to bucket
   dma.read_and_advance();
 
-  if (dma.current_tag_offset() == render_state->next_bucket) {
+  if (dma.current_tag_offset() == next_bucket) {
     // nothing
     return;
   }
@@ -78,11 +86,9 @@ void Shadow2::render(DmaFollower& dma, SharedRenderState* render_state, ScopedPr
     return;
   }
 
-  reset_buffers();
-
   // shadow-vu1-constants
   ASSERT(maybe_constants.size_bytes >= sizeof(ShadowVu1Constants));
-  FrameConstants frame_constants;
+  auto& frame_constants = m_frame_constants;
   memcpy(&frame_constants.constants, maybe_constants.data, sizeof(ShadowVu1Constants));
 
   // ?? no idea what this is.
@@ -126,7 +132,7 @@ void Shadow2::render(DmaFollower& dma, SharedRenderState* render_state, ScopedPr
   InputData current_input;
   bool have_color = false;
   while (true) {
-    if (dma.current_tag_offset() == render_state->next_bucket) {
+    if (dma.current_tag_offset() == next_bucket) {
       break;
     }
     auto transfer = dma.read_and_advance();
@@ -209,9 +215,10 @@ void Shadow2::render(DmaFollower& dma, SharedRenderState* render_state, ScopedPr
   }
 
   ASSERT(have_color);
-  draw_buffers(render_state, prof, frame_constants);
+  // the color can be changed after the draw, so remember the one to draw with.
+  memcpy(m_draw_color, m_color, 4);
   auto transfers = 0;
-  while (dma.current_tag_offset() != render_state->next_bucket) {
+  while (dma.current_tag_offset() != next_bucket) {
     auto data = dma.read_and_advance();
     if (data.size_bytes == 560) {
       memcpy(m_color, data.data + 8 * 3, 4);
@@ -221,6 +228,10 @@ void Shadow2::render(DmaFollower& dma, SharedRenderState* render_state, ScopedPr
   ASSERT(transfers < 7);
 }
 
+void Shadow2::submit(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+  draw_buffers(render_state, prof, m_frame_constants);
+}
+
 void Shadow2::buffer_from_mscal2(const InputData& in) {
   // draw top caps.
   add_cap_tris(in.cap_index_data, in.top_vertex_data, false);
@@ -540,10 +551,10 @@ void Shadow2::draw_buffers(SharedRenderState* render_state,
   bool lighten_channel[3] = {false, false, false};
   bool darken_channel[3] = {false, false, false};
   for (int i = 0; i < 3; i++) {
-    if (m_color[i] > 128) {
+    if (m_draw_color[i] > 128) {
       have_lighten = true;
       lighten_channel[i] = true;
-    } else if (m_color[i] < 128) {
+    } else if (m_draw_color[i] < 128) {
       have_darken = true;
       darken_channel[i] = true;
     }
@@ -551,8 +562,8 @@ void Shadow2::draw_buffers(SharedRenderState* render_state,
 
   if (have_darken) {
     glColorMask(darken_channel[0], darken_channel[1], darken_channel[2], false);
-    glUniform4f(m_ogl.uniforms.color, (128 - m_color[0]) / 256.f, (128 - m_color[1]) / 256.f,
-                (128 - m_color[2]) / 256.f, 0);
+    glUniform4f(m_ogl.uniforms.color, (128 - m_draw_color[0]) / 256.f,
+                (128 - m_draw_color[1]) / 256.f, (128 - m_draw_color[2]) / 256.f, 0);
     glBlendEquation(GL_FUNC_REVERSE_SUBTRACT);
     glDrawElements(GL_TRIANGLE_STRIP, 6, GL_UNSIGNED_INT,
                    (void*)(sizeof(u32) * (m_front_index_buffer_used - 6)));
@@ -560,8 +571,8 @@ void Shadow2::draw_buffers(SharedRenderState* render_state,
 
   if (have_lighten) {
     glColorMask(lighten_channel[0], lighten_channel[1], lighten_channel[2], false);
-    glUniform4f(m_ogl.uniforms.color, (m_color[0] - 128) / 256.f, (m_color[1] - 128) / 256.f,
-                (m_color[2] - 128) / 256.f, 0);
+    glUniform4f(m_ogl.uniforms.color, (m_draw_color[0] - 128) / 256.f,
+                (m_draw_color[1] - 128) / 256.f, (m_draw_color[2] - 128) / 256.f, 0);
     glBlendEquation(GL_FUNC_ADD);
     glDrawElements(GL_TRIANGLE_STRIP, 6, GL_UNSIGNED_INT,
                    (void*)(sizeof(u32) * (m_front_index_buffer_used - 6)));
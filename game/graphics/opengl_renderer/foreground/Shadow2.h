@@ -4,16 +4,21 @@
 
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
 
-class Shadow2 : public BucketRenderer {
+class Shadow2 : public PreparedBucketRenderer {
  public:
   static constexpr int kMaxVerts = 8192 * 3 * 2;
   static constexpr int kMaxInds = kMaxVerts;
   Shadow2(const std::string& name, int my_id);
   ~Shadow2();
-  void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) override;
   void draw_debug_window() override;
   void init_shaders(ShaderLibrary& shaders) override;
 
+ protected:
+  void prepare_dma(DmaFollower& dma,
+                   u32 next_bucket,
+                   const SharedRenderState& render_state) override;
+  void submit(SharedRenderState* render_state, ScopedProfilerNode& prof) override;
+
  private:
   struct ShadowVu1Constants {
     math::Vector4f hmgescale;
@@ -94,4 +99,8 @@ class Shadow2 : public BucketRenderer {
                     ScopedProfilerNode& prof,
                     const FrameConstants& constants);
   u8 m_color[4] = {0, 0, 0, 0};
+
+  // set by prepare_dma, for submit.
+  FrameConstants m_frame_constants;
+  u8 m_draw_color[4] = {0, 0, 0, 0};
 };
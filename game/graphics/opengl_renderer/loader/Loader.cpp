@@ -1,9 +1,11 @@
 #include "Loader.h"
 
+#include <algorithm>
+
+#include "common/custom_data/Fr3File.h"
 #include "common/global_profiler/GlobalProfiler.h"
 #include "common/util/FileUtil.h"
 #include "common/util/Timer.h"
-#include "common/util/compress.h"
 
 #include "game/graphics/opengl_renderer/loader/LoaderStages.h"
 
@@ -17,10 +19,65 @@ std::string uppercase_string(const std::string& s) {
   }
   return result;
 }
+
+/*!
+ * Unpack a tree that was just loaded from a chunked fr3 file.
+ */
+void unpack_section(const tfrag3::Fr3Section& section, tfrag3::Level* level) {
+  switch (section.kind) {
+    case tfrag3::Fr3SectionKind::TFRAG_TREE:
+      level->tfrag_trees.at(section.geom).at(section.index).unpack();
+      break;
+    case tfrag3::Fr3SectionKind::TIE_TREE:
+      level->tie_trees.at(section.geom).at(section.index).unpack();
+      break;
+    case tfrag3::Fr3SectionKind::SHRUB_TREE:
+      level->shrub_trees.at(section.index).unpack();
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+ * CPU memory used by a level after it has been unpacked.
+ */
+u64 level_cpu_bytes(const tfrag3::Level& level) {
+  tfrag3::MemoryUsageTracker tracker;
+  level.memory_usage(&tracker);
+  u64 result = 0;
+  for (auto x : tracker.data) {
+    result += x;
+  }
+
+  // the unpacked data isn't part of the memory usage tracker, which is for the packed file.
+  for (auto& trees : level.tfrag_trees) {
+    for (auto& tree : trees) {
+      result += tree.unpacked.vertices.size() * sizeof(tree.unpacked.vertices[0]);
+    }
+  }
+  for (auto& trees : level.tie_trees) {
+    for (auto& tree : trees) {
+      result += tree.unpacked.vertices.size() * sizeof(tree.unpacked.vertices[0]);
+      result += tree.unpacked.indices.size() * sizeof(tree.unpacked.indices[0]);
+    }
+  }
+  for (auto& tree : level.shrub_trees) {
+    result += tree.unpacked.vertices.size() * sizeof(tree.unpacked.vertices[0]);
+  }
+  return result;
+}
+
+constexpr double MB = 1024 * 1024;
+
+int unpack_thread_count() {
+  // leave most of the cores for the game and the renderer.
+  return std::clamp((int)std::thread::hardware_concurrency() / 2, 1, 4);
+}
 }  // namespace
 
 Loader::Loader(const fs::path& base_path, int max_levels)
-    : m_base_path(base_path), m_max_levels(max_levels) {
+    : m_unpack_pool(unpack_thread_count()), m_base_path(base_path), m_max_levels(max_levels) {
   m_loader_thread = std::thread(&Loader::loader_thread, this);
   m_loader_stages = make_loader_stages();
 }
@@ -54,32 +111,103 @@ const LevelData* Loader::get_tfrag3_level(const std::string& level_name) {
 
 /*!
  * The game calls this to give the loader a hint on which levels we want.
- * If the loader is not busy, it will begin loading the level.
+ * Levels that aren't loaded are queued for loading, up to MAX_LEVELS_IN_FLIGHT at a time.
  * This should be called on every frame.
  */
 void Loader::set_want_levels(const std::vector<std::string>& levels) {
   std::unique_lock<std::mutex> lk(m_loader_mutex);
   m_desired_levels = levels;
-  if (!m_level_to_load.empty()) {
-    // can't do anything, we're loading a level right now
-    return;
+
+  // forget about levels that are no longer wanted, if we haven't started reading them.
+  for (auto it = m_levels_to_read.begin(); it != m_levels_to_read.end();) {
+    if (std::find(levels.begin(), levels.end(), *it) == levels.end()) {
+      m_loading_levels.erase(*it);
+      it = m_levels_to_read.erase(it);
+    } else {
+      it++;
+    }
   }
 
-  if (!m_initializing_tfrag3_levels.empty()) {
-    // can't do anything, we're initializing a level right now
-    return;
+  bool added = false;
+  for (auto& lev : levels) {
+    // if it was prefetched, it can skip the file loading completely.
+    auto prefetched = m_prefetched_levels.find(lev);
+    if (prefetched != m_prefetched_levels.end()) {
+      auto& init = m_initializing_tfrag3_levels[lev];
+      init = std::make_unique<LevelData>();
+      init->level = std::move(prefetched->second.level);
+      init->cpu_bytes = prefetched->second.cpu_bytes;
+      m_prefetched_levels.erase(prefetched);
+      continue;
+    }
+
+    // unread prefetches don't count, wanted levels will be read before them.
+    if ((int)(m_loading_levels.size() - m_prefetch_to_read.size() +
+              m_initializing_tfrag3_levels.size()) >= MAX_LEVELS_IN_FLIGHT) {
+      break;
+    }
+    if (m_loaded_tfrag3_levels.count(lev) || m_initializing_tfrag3_levels.count(lev)) {
+      continue;
+    }
+    if (m_loading_levels.count(lev)) {
+      // if this was going to be prefetched, bump it up to the normal queue.
+      auto it = std::find(m_prefetch_to_read.begin(), m_prefetch_to_read.end(), lev);
+      if (it != m_prefetch_to_read.end()) {
+        m_prefetch_to_read.erase(it);
+        m_levels_to_read.push_back(lev);
+        added = true;
+      }
+      continue;
+    }
+    // we haven't loaded it yet. Request this level to load and wake up the thread.
+    m_levels_to_read.push_back(lev);
+    m_loading_levels.insert(lev);
+    added = true;
+  }
+
+  if (added) {
+    lk.unlock();
+    m_loader_cv.notify_all();
+  }
+}
+
+/*!
+ * The game calls this with levels that it will probably want soon. When the loader has nothing
+ * else to do, it reads and unpacks these, and keeps them in memory (but not on the GPU) until they
+ * are wanted, or until they are evicted to stay under the memory budget.
+ */
+void Loader::set_prefetch_levels(const std::vector<std::string>& levels) {
+  std::unique_lock<std::mutex> lk(m_loader_mutex);
+
+  // forget about old hints that we haven't started reading.
+  for (auto it = m_prefetch_to_read.begin(); it != m_prefetch_to_read.end();) {
+    if (std::find(levels.begin(), levels.end(), *it) == levels.end()) {
+      m_loading_levels.erase(*it);
+      it = m_prefetch_to_read.erase(it);
+    } else {
+      it++;
+    }
   }
 
-  // loader isn't busy, try to load one of the requested levels.
+  bool added = false;
   for (auto& lev : levels) {
-    auto it = m_loaded_tfrag3_levels.find(lev);
-    if (it == m_loaded_tfrag3_levels.end()) {
-      // we haven't loaded it yet. Request this level to load and wake up the thread.
-      m_level_to_load = lev;
-      lk.unlock();
-      m_loader_cv.notify_all();
-      return;
+    if ((int)(m_loading_levels.size() + m_initializing_tfrag3_levels.size()) >=
+            MAX_LEVELS_IN_FLIGHT ||
+        (int)m_prefetched_levels.size() >= MAX_PREFETCHED_LEVELS) {
+      break;
+    }
+    if (m_loaded_tfrag3_levels.count(lev) || m_initializing_tfrag3_levels.count(lev) ||
+        m_loading_levels.count(lev) || m_prefetched_levels.count(lev)) {
+      continue;
     }
+    m_prefetch_to_read.push_back(lev);
+    m_loading_levels.insert(lev);
+    added = true;
+  }
+
+  if (added) {
+    lk.unlock();
+    m_loader_cv.notify_all();
   }
 }
 
@@ -132,6 +260,15 @@ void Loader::draw_debug_window() {
     ImGui::Separator();
   }
 
+  if (!m_prefetched_levels.empty()) {
+    ImGui::Text("prefetched levels");
+    for (auto& [name, lev] : m_prefetched_levels) {
+      ImGui::Text("%20s : %.1f MB CPU", name.c_str(), lev.cpu_bytes / MB);
+    }
+    ImGui::NewLine();
+    ImGui::Separator();
+  }
+
   if (!m_loaded_tfrag3_levels.empty()) {
     ImGui::Text("loaded levels");
     for (auto& lev : m_loaded_tfrag3_levels) {
@@ -146,103 +283,174 @@ void Loader::draw_debug_window() {
                          lev.second->frames_since_last_used);
       ImGui::Text("  %d textures", (int)lev.second->textures.size());
       ImGui::Text("  %d merc", (int)lev.second->merc_model_lookup.size());
+      ImGui::Text("  %.1f MB CPU, %.1f MB GPU", lev.second->cpu_bytes / MB,
+                  lev.second->gpu_bytes / MB);
     }
     ImGui::NewLine();
     ImGui::Separator();
   }
 
+  u64 total = loaded_bytes() + prefetched_bytes();
+  ImGui::TextColored(total > m_memory_budget ? red : green, "memory: %.1f / %.1f MB", total / MB,
+                     m_memory_budget / MB);
+  int budget_mb = m_memory_budget / MB;
+  if (ImGui::SliderInt("budget (MB)", &budget_mb, 128, 8192)) {
+    m_memory_budget = (u64)budget_mb * 1024 * 1024;
+  }
+  ImGui::Separator();
+  m_upload_scheduler.draw_debug_window();
+
   ImGui::End();
 }
 
 /*!
  * Loader function that runs in a completely separate thread.
- * This is used for file I/O and unpacking.
+ * This only does file I/O, and hands the file data off to the unpack pool, so the next level can
+ * be read while the previous one is still being decompressed and unpacked.
  */
 void Loader::loader_thread() {
+  TaskGroup unpack_tasks(m_unpack_pool);
   try {
     while (!m_want_shutdown) {
       prof().root_event();
       std::unique_lock<std::mutex> lk(m_loader_mutex);
 
       // this will keep us asleep until we've got a level to load.
-      m_loader_cv.wait(lk, [&] { return !m_level_to_load.empty() || m_want_shutdown; });
+      m_loader_cv.wait(lk, [&] {
+        return !m_levels_to_read.empty() || !m_prefetch_to_read.empty() || m_want_shutdown;
+      });
       if (m_want_shutdown) {
-        return;
+        break;
       }
-      std::string lev = m_level_to_load;
+      // wanted levels first, then prefetches.
+      bool prefetch = m_levels_to_read.empty();
+      auto& queue = prefetch ? m_prefetch_to_read : m_levels_to_read;
+      std::string lev = queue.front();
+      queue.erase(queue.begin());
       // don't hold the lock while reading the file.
       lk.unlock();
 
+      auto path = m_base_path / fmt::format("{}.fr3", uppercase_string(lev));
+      if (prefetch && !fs::exists(path)) {
+        // just a hint, it's not an error if it's missing.
+        lk.lock();
+        m_loading_levels.erase(lev);
+        continue;
+      }
+
       // simulate slower hard drive (so that the loader thread can lose to the game loads)
       // std::this_thread::sleep_for(std::chrono::milliseconds(1500));
 
-      // load the fr3 file
+      // map the fr3 file, and touch every page so the disk reads happen here and not on the
+      // unpack pool.
       prof().begin_event("read-file");
       Timer disk_timer;
-      auto data =
-          file_util::read_binary_file(m_base_path / fmt::format("{}.fr3", uppercase_string(lev)));
+      auto file = std::make_shared<file_util::MappedFile>(path);
+      u8 page_sum = 0;
+      for (size_t i = 0; i < file->size(); i += 4096) {
+        page_sum += file->data()[i];
+      }
+      volatile u8 sink = page_sum;
+      (void)sink;
       double disk_load_time = disk_timer.getSeconds();
       prof().end_event();
 
-      // the FR3 files are compressed
-      prof().begin_event("decompress-file");
-      Timer decomp_timer;
-      auto decomp_data = compression::decompress_zstd(data.data(), data.size());
-      double decomp_time = decomp_timer.getSeconds();
-      prof().end_event();
-
-      // Read back into the tfrag3::Level structure
-      prof().begin_event("deserialize");
-      Timer import_timer;
-      auto result = std::make_unique<tfrag3::Level>();
-      Serializer ser(decomp_data.data(), decomp_data.size());
-      result->serialize(ser);
-      double import_time = import_timer.getSeconds();
-      prof().end_event();
+      unpack_tasks.run([this, lev, file, disk_load_time, prefetch]() {
+        unpack_level(lev, file, disk_load_time, prefetch);
+      });
+    }
+    unpack_tasks.wait();
+  } catch (std::exception& e) {
+    ASSERT_MSG(false, fmt::format("Exception {} encountered in loader_thread", e.what()));
+  }
+}
 
-      // and finally "unpack", which creates the vertex data we'll upload to the GPU
+/*!
+ * Decompress, deserialize and unpack a level, then move it to the "initializing" state.
+ * Prefetched levels that aren't wanted yet are kept in m_prefetched_levels instead.
+ * Runs on the unpack pool.
+ */
+void Loader::unpack_level(const std::string& name,
+                          std::shared_ptr<file_util::MappedFile> file,
+                          double disk_load_time,
+                          bool prefetch) {
+  prof().root_event();
+  auto result = std::make_unique<tfrag3::Level>();
+  tfrag3::Fr3Reader reader(file->data(), file->size());
+  Timer import_timer;
+  TaskGroup tasks(m_unpack_pool);
+
+  if (reader.is_chunked()) {
+    // each section is compressed on its own, so they can all be decompressed, deserialized, and
+    // unpacked at the same time.
+    reader.read_info(result.get());
+    auto* level = result.get();
+    for (const auto& section : reader.data_sections()) {
+      tasks.run([&reader, section, level]() {
+        auto p = scoped_prof("load-section");
+        reader.read_section(section, level);
+        unpack_section(section, level);
+      });
+    }
+    tasks.wait();
+  } else {
+    // old format: decompress and deserialize everything at once.
+    {
+      auto p = scoped_prof("read-v1");
+      reader.read_all(result.get());
+    }
 
-      Timer unpack_timer;
-      {
-        auto p = scoped_prof("tie-unpack");
-        for (auto& tie_tree : result->tie_trees) {
-          for (auto& tree : tie_tree) {
-            tree.unpack();
-          }
-        }
+    // and finally "unpack", which creates the vertex data we'll upload to the GPU.
+    // each tree is independent, so they can all be unpacked at once.
+    for (auto& tie_tree : result->tie_trees) {
+      for (auto& tree : tie_tree) {
+        tasks.run([&tree]() {
+          auto p = scoped_prof("tie-unpack");
+          tree.unpack();
+        });
       }
+    }
 
-      {
-        auto p = scoped_prof("tfrag-unpack");
-        for (auto& t_tree : result->tfrag_trees) {
-          for (auto& tree : t_tree) {
-            tree.unpack();
-          }
-        }
+    for (auto& t_tree : result->tfrag_trees) {
+      for (auto& tree : t_tree) {
+        tasks.run([&tree]() {
+          auto p = scoped_prof("tfrag-unpack");
+          tree.unpack();
+        });
       }
+    }
 
-      {
+    for (auto& shrub_tree : result->shrub_trees) {
+      tasks.run([&shrub_tree]() {
         auto p = scoped_prof("shrub-unpack");
-        for (auto& shrub_tree : result->shrub_trees) {
-          shrub_tree.unpack();
-        }
-      }
+        shrub_tree.unpack();
+      });
+    }
+    tasks.wait();
+  }
+  file.reset();
 
-      fmt::print(
-          "------------> Load from file: {:.3f}s, import {:.3f}s, decomp {:.3f}s unpack {:.3f}s\n",
-          disk_load_time, import_time, decomp_time, unpack_timer.getSeconds());
+  fmt::print("------------> Load {} from file: {:.3f}s, import {:.3f}s ({})\n", name,
+             disk_load_time, import_timer.getSeconds(), reader.is_chunked() ? "v2" : "v1");
 
-      // grab the lock again
-      lk.lock();
-      // move this level to "initializing" state.
-      m_initializing_tfrag3_levels[lev] = std::make_unique<LevelData>();  // reset load state
-      m_initializing_tfrag3_levels[lev]->level = std::move(result);
-      m_level_to_load = "";
-      m_file_load_done_cv.notify_all();
-    }
-  } catch (std::exception& e) {
-    ASSERT_MSG(false, fmt::format("Exception {} encountered in loader_thread", e.what()));
+  u64 cpu_bytes = level_cpu_bytes(*result);
+
+  std::unique_lock<std::mutex> lk(m_loader_mutex);
+  m_loading_levels.erase(name);
+  if (prefetch && std::find(m_desired_levels.begin(), m_desired_levels.end(), name) ==
+                      m_desired_levels.end()) {
+    auto& entry = m_prefetched_levels[name];
+    entry.level = std::move(result);
+    entry.cpu_bytes = cpu_bytes;
+    entry.order = m_prefetch_count++;
+    return;
   }
+
+  // move this level to "initializing" state.
+  m_initializing_tfrag3_levels[name] = std::make_unique<LevelData>();  // reset load state
+  m_initializing_tfrag3_levels[name]->level = std::move(result);
+  m_initializing_tfrag3_levels[name]->cpu_bytes = cpu_bytes;
+  m_file_load_done_cv.notify_all();
 }
 
 /*!
@@ -250,17 +458,14 @@ void Loader::loader_thread() {
  * This should be called during initialization, before any threaded loading goes on.
  */
 void Loader::load_common(TexturePool& tex_pool, const std::string& name) {
-  auto data = file_util::read_binary_file(m_base_path / fmt::format("{}.fr3", name));
-
-  auto decomp_data = compression::decompress_zstd(data.data(), data.size());
-  Serializer ser(decomp_data.data(), decomp_data.size());
+  file_util::MappedFile file(m_base_path / fmt::format("{}.fr3", name));
   m_common_level.level = std::make_unique<tfrag3::Level>();
-  m_common_level.level->serialize(ser);
+  tfrag3::Fr3Reader(file.data(), file.size()).read_all(m_common_level.level.get());
   for (auto& tex : m_common_level.level->textures) {
     m_common_level.textures.push_back(add_texture(tex_pool, tex, true));
   }
 
-  Timer tim;
+  UploadBudget budget(UploadScheduler::MAX_UPLOAD_MS);
   MercLoaderStage mls;
   LoaderInput input;
   input.tex_pool = &tex_pool;
@@ -268,34 +473,8 @@ void Loader::load_common(TexturePool& tex_pool, const std::string& name) {
   input.lev_data = &m_common_level;
   bool done = false;
   while (!done) {
-    done = mls.run(tim, input);
-  }
-}
-
-bool Loader::upload_textures(Timer& timer, LevelData& data, TexturePool& texture_pool) {
-  // try to move level from initializing to initialized:
-
-  auto evt = scoped_prof("upload-textures");
-  constexpr int MAX_TEX_BYTES_PER_FRAME = 1024 * 128;
-
-  int bytes_this_run = 0;
-  int tex_this_run = 0;
-  if (data.textures.size() < data.level->textures.size()) {
-    std::unique_lock<std::mutex> tpool_lock(texture_pool.mutex());
-    while (data.textures.size() < data.level->textures.size()) {
-      auto& tex = data.level->textures[data.textures.size()];
-      data.textures.push_back(add_texture(texture_pool, tex, false));
-      bytes_this_run += tex.w * tex.h * 4;
-      tex_this_run++;
-      if (tex_this_run > 20) {
-        break;
-      }
-      if (bytes_this_run > MAX_TEX_BYTES_PER_FRAME || timer.getMs() > SHARED_TEXTURE_LOAD_BUDGET) {
-        break;
-      }
-    }
+    done = mls.run(budget, input);
   }
-  return data.textures.size() == data.level->textures.size();
 }
 
 void Loader::update_blocking(TexturePool& tex_pool) {
@@ -309,8 +488,8 @@ void Loader::update_blocking(TexturePool& tex_pool) {
       needs_run = false;
       {
         std::unique_lock<std::mutex> lk(m_loader_mutex);
-        if (!m_level_to_load.empty()) {
-          m_file_load_done_cv.wait(lk, [&]() { return m_level_to_load.empty(); });
+        if (loading_wanted_level()) {
+          m_file_load_done_cv.wait(lk, [&]() { return !loading_wanted_level(); });
         }
       }
     }
@@ -327,7 +506,8 @@ void Loader::update_blocking(TexturePool& tex_pool) {
       }
 
       if (needs_run) {
-        update(tex_pool);
+        // we don't care about frame rate here, so use the biggest budget we can.
+        update(tex_pool, {});
       }
     }
 
@@ -354,25 +534,126 @@ void Loader::update_blocking(TexturePool& tex_pool) {
   }
 }
 
-const std::string* Loader::get_most_unloadable_level() {
+/*!
+ * Total memory used by loaded levels.
+ */
+u64 Loader::loaded_bytes() const {
+  u64 result = 0;
   for (const auto& [name, lev] : m_loaded_tfrag3_levels) {
-    if (lev->frames_since_last_used > 180 &&
-        std::find(m_desired_levels.begin(), m_desired_levels.end(), name) ==
-            m_desired_levels.end()) {
-      return &name;
+    result += lev->cpu_bytes + lev->gpu_bytes;
+  }
+  return result;
+}
+
+/*!
+ * Total memory used by prefetched levels that aren't wanted yet.
+ */
+u64 Loader::prefetched_bytes() const {
+  u64 result = 0;
+  for (const auto& [name, lev] : m_prefetched_levels) {
+    result += lev.cpu_bytes;
+  }
+  return result;
+}
+
+/*!
+ * Are we reading or unpacking a level that the game wants? Must hold the loader mutex.
+ */
+bool Loader::loading_wanted_level() const {
+  for (auto& lev : m_desired_levels) {
+    if (m_loading_levels.count(lev)) {
+      return true;
     }
   }
+  return false;
+}
+
+/*!
+ * Free prefetched levels, oldest first, until everything fits in the memory budget.
+ * These are only a guess, so they go before any level that is actually loaded.
+ */
+void Loader::evict_prefetched_levels() {
+  std::vector<std::unique_ptr<tfrag3::Level>> to_free;
+  {
+    std::unique_lock<std::mutex> lk(m_loader_mutex);
+    u64 total = loaded_bytes() + prefetched_bytes();
+    while (total > m_memory_budget && !m_prefetched_levels.empty()) {
+      auto oldest = m_prefetched_levels.begin();
+      for (auto it = m_prefetched_levels.begin(); it != m_prefetched_levels.end(); it++) {
+        if (it->second.order < oldest->second.order) {
+          oldest = it;
+        }
+      }
+      fmt::print("dropping prefetched level {}\n", oldest->first);
+      total -= oldest->second.cpu_bytes;
+      to_free.push_back(std::move(oldest->second.level));
+      m_prefetched_levels.erase(oldest);
+    }
+  }
+  // to_free is destroyed here, so we don't hold the lock while freeing big levels.
+}
+
+/*!
+ * Pick a level to unload, or nullptr if nothing should be unloaded.
+ * We unload when there are too many levels, or when they use more memory than the budget.
+ * Levels that haven't been used for a while are candidates, and the least recently used one is
+ * picked. Levels the game still wants are only unloaded if there are too many levels.
+ */
+const std::string* Loader::get_most_unloadable_level() {
+  bool too_many = (int)m_loaded_tfrag3_levels.size() >= m_max_levels;
+  bool over_budget = loaded_bytes() > m_memory_budget;
+  if (!too_many && !over_budget) {
+    return nullptr;
+  }
 
+  const std::string* best = nullptr;
+  bool best_desired = false;
+  int best_frames = 0;
   for (const auto& [name, lev] : m_loaded_tfrag3_levels) {
-    if (lev->frames_since_last_used > 180) {
-      return &name;
+    if (lev->frames_since_last_used <= UNLOAD_AFTER_FRAMES) {
+      continue;
+    }
+    bool desired = std::find(m_desired_levels.begin(), m_desired_levels.end(), name) !=
+                   m_desired_levels.end();
+    if (desired && !too_many) {
+      continue;
+    }
+
+    // prefer levels that aren't wanted, then the least recently used.
+    if (!best || (best_desired && !desired) ||
+        (best_desired == desired && lev->frames_since_last_used > best_frames)) {
+      best = &name;
+      best_desired = desired;
+      best_frames = lev->frames_since_last_used;
     }
   }
-  return nullptr;
+  return best;
 }
 
-void Loader::update(TexturePool& texture_pool) {
+/*!
+ * Get memory used by each loaded level. This doesn't need the debug window, so it can be used to
+ * monitor memory when running headless.
+ */
+Loader::MemoryStats Loader::memory_stats() {
+  MemoryStats result;
+  std::unique_lock<std::mutex> lk(m_loader_mutex);
+  result.budget = m_memory_budget;
+  result.prefetched_bytes = prefetched_bytes();
+  for (const auto& [name, lev] : m_loaded_tfrag3_levels) {
+    auto& entry = result.levels.emplace_back();
+    entry.name = name;
+    entry.cpu_bytes = lev->cpu_bytes;
+    entry.gpu_bytes = lev->gpu_bytes;
+    entry.frames_since_last_used = lev->frames_since_last_used;
+    result.cpu_bytes += lev->cpu_bytes;
+    result.gpu_bytes += lev->gpu_bytes;
+  }
+  return result;
+}
+
+void Loader::update(TexturePool& texture_pool, const UploadScheduler::FrameTiming& timing) {
   Timer loader_timer;
+  m_upload_scheduler.begin_frame(timing);
 
   // only main thread can touch this.
   for (auto& lev : m_loaded_tfrag3_levels) {
@@ -385,9 +666,14 @@ void Loader::update(TexturePool& texture_pool) {
   {
     // accessing initializing, should lock
     std::unique_lock<std::mutex> lk(m_loader_mutex);
-    // grab the first initializing level:
-    const auto& it = m_initializing_tfrag3_levels.begin();
+    // stick with the level the stages are working on, or grab the first initializing level.
+    // other levels may be added in the meantime, so we can't just use begin() every time.
+    auto it = m_initializing_tfrag3_levels.find(m_current_init_level);
+    if (it == m_initializing_tfrag3_levels.end()) {
+      it = m_initializing_tfrag3_levels.begin();
+    }
     if (it != m_initializing_tfrag3_levels.end()) {
+      m_current_init_level = it->first;
       did_gpu_stuff = true;
       std::string name = it->first;
       auto& lev = it->second;
@@ -405,10 +691,11 @@ void Loader::update(TexturePool& texture_pool) {
 
       for (auto& stage : m_loader_stages) {
         auto evt = scoped_prof(fmt::format("stage-{}", stage->name()).c_str());
-        Timer stage_timer;
-        done = stage->run(loader_timer, loader_input);
-        if (stage_timer.getMs() > 5.f) {
-          fmt::print("stage {} took {:.2f} ms\n", stage->name(), stage_timer.getMs());
+        auto budget = m_upload_scheduler.start_stage();
+        done = stage->run(budget, loader_input);
+        m_upload_scheduler.finish_stage(stage->name(), budget);
+        if (budget.elapsed_ms() > 5.f) {
+          fmt::print("stage {} took {:.2f} ms\n", stage->name(), budget.elapsed_ms());
         }
         if (!done) {
           break;
@@ -418,8 +705,11 @@ void Loader::update(TexturePool& texture_pool) {
       if (done) {
         auto evt = scoped_prof("finish-stages");
         lk.lock();
+        fmt::print("level {} uses {:.1f} MB CPU, {:.1f} MB GPU\n", name, lev->cpu_bytes / MB,
+                   lev->gpu_bytes / MB);
         m_loaded_tfrag3_levels[name] = std::move(lev);
-        m_initializing_tfrag3_levels.erase(it);
+        m_initializing_tfrag3_levels.erase(name);
+        m_current_init_level.clear();
 
         for (auto& stage : m_loader_stages) {
           stage->reset();
@@ -430,13 +720,15 @@ void Loader::update(TexturePool& texture_pool) {
 
   if (!did_gpu_stuff) {
     auto evt = scoped_prof("gpu-unload");
-    // try to remove levels.
     Timer unload_timer;
-    if ((int)m_loaded_tfrag3_levels.size() >= m_max_levels) {
+    evict_prefetched_levels();
+
+    // try to remove levels.
+    {
       auto to_unload = get_most_unloadable_level();
       if (to_unload) {
         auto& lev = m_loaded_tfrag3_levels.at(*to_unload);
-        std::unique_lock<std::mutex> lk(texture_pool.mutex());
+        auto lk = texture_pool.lock();
         fmt::print("------------------------- PC unloading {}\n", *to_unload);
         for (size_t i = 0; i < lev->level->textures.size(); i++) {
           auto& tex = lev->level->textures[i];
@@ -490,6 +782,8 @@ void Loader::update(TexturePool& texture_pool) {
         }
 
         m_loaded_tfrag3_levels.erase(*to_unload);
+        fmt::print("loaded levels now use {:.1f} MB, budget is {:.1f} MB\n", loaded_bytes() / MB,
+                   m_memory_budget / MB);
       }
     }
 
@@ -3,43 +3,95 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <unordered_set>
 
 #include "common/custom_data/Tfrag3Data.h"
 #include "common/util/FileUtil.h"
 #include "common/util/Timer.h"
+#include "common/util/WorkStealingPool.h"
 
+#include "game/graphics/opengl_renderer/loader/UploadScheduler.h"
 #include "game/graphics/opengl_renderer/loader/common.h"
 #include "game/graphics/pipelines/opengl.h"
 #include "game/graphics/texture/TexturePool.h"
 
 class Loader {
  public:
-  static constexpr float TIE_LOAD_BUDGET = 1.5f;
-  static constexpr float SHARED_TEXTURE_LOAD_BUDGET = 3.f;
+  // levels that can be somewhere between "requested" and "initialized" at the same time.
+  static constexpr int MAX_LEVELS_IN_FLIGHT = 3;
+  // levels that can be kept unpacked in memory after a prefetch hint, but not uploaded to the GPU
+  static constexpr int MAX_PREFETCHED_LEVELS = 2;
+  static constexpr u64 DEFAULT_MEMORY_BUDGET = 2048ull * 1024 * 1024;
+  // levels that haven't been drawn for this many frames may be unloaded.
+  static constexpr int UNLOAD_AFTER_FRAMES = 180;
+
+  struct LevelMemory {
+    std::string name;
+    u64 cpu_bytes = 0;
+    u64 gpu_bytes = 0;
+    int frames_since_last_used = 0;
+  };
+
+  struct MemoryStats {
+    u64 cpu_bytes = 0;
+    u64 gpu_bytes = 0;
+    u64 prefetched_bytes = 0;  // CPU only, prefetched levels aren't on the GPU
+    u64 budget = 0;
+    std::vector<LevelMemory> levels;  // loaded levels only
+  };
   Loader(const fs::path& base_path, int max_levels);
   ~Loader();
-  void update(TexturePool& tex_pool);
+  void update(TexturePool& tex_pool, const UploadScheduler::FrameTiming& timing);
   void update_blocking(TexturePool& tex_pool);
   const LevelData* get_tfrag3_level(const std::string& level_name);
   std::optional<MercRef> get_merc_model(const char* model_name);
   void load_common(TexturePool& tex_pool, const std::string& name);
   void set_want_levels(const std::vector<std::string>& levels);
+  void set_prefetch_levels(const std::vector<std::string>& levels);
   std::vector<LevelData*> get_in_use_levels();
   void draw_debug_window();
+  void set_memory_budget(u64 bytes) { m_memory_budget = bytes; }
+  MemoryStats memory_stats();
+  const UploadScheduler& upload_scheduler() const { return m_upload_scheduler; }
 
  private:
   void loader_thread();
-  bool upload_textures(Timer& timer, LevelData& data, TexturePool& texture_pool);
+  void unpack_level(const std::string& name,
+                    std::shared_ptr<file_util::MappedFile> file,
+                    double disk_load_time,
+                    bool prefetch);
 
   const std::string* get_most_unloadable_level();
+  u64 loaded_bytes() const;
+  u64 prefetched_bytes() const;
+  bool loading_wanted_level() const;
+  void evict_prefetched_levels();
 
   // used by game and loader thread
   std::unordered_map<std::string, std::unique_ptr<LevelData>> m_initializing_tfrag3_levels;
 
   LevelData m_common_level;
 
-  std::string m_level_to_load;
+  // levels requested but not yet read from disk, in the order they should be read
+  std::vector<std::string> m_levels_to_read;
+  // levels hinted by the game as likely to be wanted soon. These are only read when there's no
+  // wanted level to read.
+  std::vector<std::string> m_prefetch_to_read;
+  // all levels between being requested (or hinted) and entering m_initializing_tfrag3_levels
+  std::unordered_set<std::string> m_loading_levels;
+
+  // levels that were prefetched, but not wanted yet. They are unpacked, but not on the GPU, and are
+  // moved to m_initializing_tfrag3_levels as soon as they are wanted.
+  struct PrefetchedLevel {
+    std::unique_ptr<tfrag3::Level> level;
+    u64 cpu_bytes = 0;
+    u64 order = 0;  // to evict the oldest first
+  };
+  std::unordered_map<std::string, PrefetchedLevel> m_prefetched_levels;
+  u64 m_prefetch_count = 0;
 
+  // the loader thread only reads files, decompression and unpacking runs on this pool.
+  WorkStealingPool m_unpack_pool;
   std::thread m_loader_thread;
   std::mutex m_loader_mutex;
   std::condition_variable m_loader_cv;
@@ -54,7 +106,11 @@ class Loader {
 
   std::vector<std::string> m_desired_levels;
   std::vector<std::unique_ptr<LoaderStage>> m_loader_stages;
+  // the initializing level that the loader stages are currently working on.
+  std::string m_current_init_level;
+  UploadScheduler m_upload_scheduler;
 
   fs::path m_base_path;
   int m_max_levels = 0;
+  u64 m_memory_budget = DEFAULT_MEMORY_BUDGET;
 };
@@ -4,8 +4,6 @@
 
 #include "common/global_profiler/GlobalProfiler.h"
 
-constexpr float LOAD_BUDGET = 2.5f;
-
 /*!
  * Upload a texture to the GPU, and give it to the pool.
  */
@@ -38,25 +36,33 @@ u64 add_texture(TexturePool& pool, const tfrag3::Texture& tex, bool is_common) {
   return gl_tex;
 }
 
+u64 texture_gpu_bytes(const tfrag3::Texture& tex) {
+  // RGBA8, plus about a third more for mipmaps.
+  return (u64)tex.w * tex.h * 4 * 4 / 3;
+}
+
+namespace {
+/*!
+ * Allocate storage for the bound buffer, and count it toward the level's GPU memory.
+ */
+void alloc_buffer(LevelData* lev, GLenum target, size_t size, const void* data) {
+  glBufferData(target, size, data, GL_STATIC_DRAW);
+  lev->gpu_bytes += size;
+}
+}  // namespace
+
 class TextureLoaderStage : public LoaderStage {
  public:
   TextureLoaderStage() : LoaderStage("texture") {}
-  bool run(Timer& timer, LoaderInput& data) override {
-    constexpr int MAX_TEX_BYTES_PER_FRAME = 1024 * 512;
-
-    int bytes_this_run = 0;
-    int tex_this_run = 0;
+  bool run(UploadBudget& budget, LoaderInput& data) override {
     if (data.lev_data->textures.size() < data.lev_data->level->textures.size()) {
-      std::unique_lock<std::mutex> tpool_lock(data.tex_pool->mutex());
+      auto tpool_lock = data.tex_pool->lock();
       while (data.lev_data->textures.size() < data.lev_data->level->textures.size()) {
         auto& tex = data.lev_data->level->textures[data.lev_data->textures.size()];
         data.lev_data->textures.push_back(add_texture(*data.tex_pool, tex, false));
-        bytes_this_run += tex.w * tex.h * 4;
-        tex_this_run++;
-        if (tex_this_run > 20) {
-          break;
-        }
-        if (bytes_this_run > MAX_TEX_BYTES_PER_FRAME || timer.getMs() > LOAD_BUDGET) {
+        data.lev_data->gpu_bytes += texture_gpu_bytes(tex);
+        budget.add_bytes(tex.w * tex.h * 4);
+        if (budget.exhausted()) {
           break;
         }
       }
@@ -69,7 +75,7 @@ class TextureLoaderStage : public LoaderStage {
 class TfragLoadStage : public LoaderStage {
  public:
   TfragLoadStage() : LoaderStage("tfrag") {}
-  bool run(Timer& timer, LoaderInput& data) override {
+  bool run(UploadBudget& budget, LoaderInput& data) override {
     if (m_done) {
       return true;
     }
@@ -87,9 +93,8 @@ class TfragLoadStage : public LoaderStage {
           glGenBuffers(1, &tree_out);
           glBindBuffer(GL_ARRAY_BUFFER, tree_out);
 
-          glBufferData(GL_ARRAY_BUFFER,
-                       in_tree.unpacked.vertices.size() * sizeof(tfrag3::PreloadedVertex), nullptr,
-                       GL_STATIC_DRAW);
+          alloc_buffer(data.lev_data, GL_ARRAY_BUFFER,
+                       in_tree.unpacked.vertices.size() * sizeof(tfrag3::PreloadedVertex), nullptr);
         }
       }
       m_opengl_created = true;
@@ -97,7 +102,6 @@ class TfragLoadStage : public LoaderStage {
     }
 
     constexpr u32 CHUNK_SIZE = 32768;
-    u32 uploaded_bytes = 0;
     u32 unique_buffers = 0;
 
     while (true) {
@@ -131,7 +135,7 @@ class TfragLoadStage : public LoaderStage {
             (end_vert_for_chunk - start_vert_for_chunk) * sizeof(tfrag3::PreloadedVertex);
         glBufferSubData(GL_ARRAY_BUFFER, start_vert_for_chunk * sizeof(tfrag3::PreloadedVertex),
                         upload_size, tree.unpacked.vertices.data() + start_vert_for_chunk);
-        uploaded_bytes += upload_size;
+        budget.add_bytes(upload_size);
       }
 
       if (complete_tree) {
@@ -155,7 +159,7 @@ class TfragLoadStage : public LoaderStage {
         return false;
       }
 
-      if (timer.getMs() > LOAD_BUDGET || (uploaded_bytes / 1024) > 2048) {
+      if (budget.exhausted()) {
         return false;
       }
     }
@@ -180,7 +184,7 @@ class TfragLoadStage : public LoaderStage {
 class ShrubLoadStage : public LoaderStage {
  public:
   ShrubLoadStage() : LoaderStage("shrub") {}
-  bool run(Timer& timer, LoaderInput& data) override {
+  bool run(UploadBudget& budget, LoaderInput& data) override {
     if (m_done) {
       return true;
     }
@@ -195,16 +199,14 @@ class ShrubLoadStage : public LoaderStage {
         GLuint& tree_out = data.lev_data->shrub_vertex_data.emplace_back();
         glGenBuffers(1, &tree_out);
         glBindBuffer(GL_ARRAY_BUFFER, tree_out);
-        glBufferData(GL_ARRAY_BUFFER,
-                     in_tree.unpacked.vertices.size() * sizeof(tfrag3::ShrubGpuVertex), nullptr,
-                     GL_STATIC_DRAW);
+        alloc_buffer(data.lev_data, GL_ARRAY_BUFFER,
+                     in_tree.unpacked.vertices.size() * sizeof(tfrag3::ShrubGpuVertex), nullptr);
       }
       m_opengl_created = true;
       return false;
     }
 
     constexpr u32 CHUNK_SIZE = 32768;
-    u32 uploaded_bytes = 0;
 
     while (true) {
       const auto& tree = data.lev_data->level->shrub_trees[m_next_tree];
@@ -234,7 +236,7 @@ class ShrubLoadStage : public LoaderStage {
           (end_vert_for_chunk - start_vert_for_chunk) * sizeof(tfrag3::ShrubGpuVertex);
       glBufferSubData(GL_ARRAY_BUFFER, start_vert_for_chunk * sizeof(tfrag3::ShrubGpuVertex),
                       upload_size, tree.unpacked.vertices.data() + start_vert_for_chunk);
-      uploaded_bytes += upload_size;
+      budget.add_bytes(upload_size);
 
       if (complete_tree) {
         // and move on to next tree
@@ -246,7 +248,7 @@ class ShrubLoadStage : public LoaderStage {
         }
       }
 
-      if (timer.getMs() > LOAD_BUDGET || (uploaded_bytes / 128) > 2048) {
+      if (budget.exhausted()) {
         return false;
       }
     }
@@ -269,7 +271,7 @@ class ShrubLoadStage : public LoaderStage {
 class TieLoadStage : public LoaderStage {
  public:
   TieLoadStage() : LoaderStage("tie") {}
-  bool run(Timer& timer, LoaderInput& data) override {
+  bool run(UploadBudget& budget, LoaderInput& data) override {
     if (m_done) {
       return true;
     }
@@ -287,14 +289,13 @@ class TieLoadStage : public LoaderStage {
           LevelData::TieOpenGL& tree_out = data.lev_data->tie_data[geo].emplace_back();
           glGenBuffers(1, &tree_out.vertex_buffer);
           glBindBuffer(GL_ARRAY_BUFFER, tree_out.vertex_buffer);
-          glBufferData(GL_ARRAY_BUFFER,
-                       in_tree.unpacked.vertices.size() * sizeof(tfrag3::PreloadedVertex), nullptr,
-                       GL_STATIC_DRAW);
+          alloc_buffer(data.lev_data, GL_ARRAY_BUFFER,
+                       in_tree.unpacked.vertices.size() * sizeof(tfrag3::PreloadedVertex), nullptr);
 
           glGenBuffers(1, &tree_out.index_buffer);
           glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tree_out.index_buffer);
-          glBufferData(GL_ELEMENT_ARRAY_BUFFER, in_tree.unpacked.indices.size() * sizeof(u32),
-                       nullptr, GL_STATIC_DRAW);
+          alloc_buffer(data.lev_data, GL_ELEMENT_ARRAY_BUFFER,
+                       in_tree.unpacked.indices.size() * sizeof(u32), nullptr);
         }
       }
       m_opengl_created = true;
@@ -304,7 +305,6 @@ class TieLoadStage : public LoaderStage {
     if (!m_verts_done) {
       auto evt = scoped_prof("tie-verts");
       constexpr u32 CHUNK_SIZE = 32768;
-      u32 uploaded_bytes = 0;
 
       while (true) {
         const auto& tree = data.lev_data->level->tie_trees[m_next_geo][m_next_tree];
@@ -339,7 +339,7 @@ class TieLoadStage : public LoaderStage {
                           upload_size, tree.unpacked.vertices.data() + start_vert_for_chunk);
         }
 
-        uploaded_bytes += upload_size;
+        budget.add_bytes(upload_size);
 
         if (complete_tree) {
           // and move on to next tree
@@ -358,7 +358,7 @@ class TieLoadStage : public LoaderStage {
           }
         }
 
-        if (timer.getMs() > LOAD_BUDGET || (uploaded_bytes / 1024) > 2048) {
+        if (budget.exhausted()) {
           return false;
         }
       }
@@ -392,8 +392,9 @@ class TieLoadStage : public LoaderStage {
               off += draw.vertex_index_stream.size();
             }
 
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, wind_idx_buffer_len * sizeof(u32), temp.data(),
-                         GL_STATIC_DRAW);
+            alloc_buffer(data.lev_data, GL_ELEMENT_ARRAY_BUFFER, wind_idx_buffer_len * sizeof(u32),
+                         temp.data());
+            budget.add_bytes(wind_idx_buffer_len * sizeof(u32));
             abort = true;
           }
         }
@@ -405,7 +406,7 @@ class TieLoadStage : public LoaderStage {
       m_next_vert = 0;
       m_next_tree = 0;
 
-      if (timer.getMs() > LOAD_BUDGET) {
+      if (budget.exhausted()) {
         return false;
       }
     }
@@ -413,7 +414,6 @@ class TieLoadStage : public LoaderStage {
     if (!m_indices_done) {
       auto evt = scoped_prof("tie-ind");
       constexpr u32 CHUNK_SIZE = 32768 * 8;
-      u32 uploaded_bytes = 0;
 
       while (true) {
         const auto& tree = data.lev_data->level->tie_trees[m_next_geo][m_next_tree];
@@ -443,7 +443,7 @@ class TieLoadStage : public LoaderStage {
         u32 upload_size = (end_ind_for_chunk - start_ind_for_chunk) * sizeof(u32);
         glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, start_ind_for_chunk * sizeof(u32), upload_size,
                         tree.unpacked.indices.data() + start_ind_for_chunk);
-        uploaded_bytes += upload_size;
+        budget.add_bytes(upload_size);
 
         if (complete_tree) {
           // and move on to next tree
@@ -463,7 +463,7 @@ class TieLoadStage : public LoaderStage {
           }
         }
 
-        if (timer.getMs() > LOAD_BUDGET || (uploaded_bytes / 1024) > 2048) {
+        if (budget.exhausted()) {
           return false;
         }
       }
@@ -497,35 +497,39 @@ class TieLoadStage : public LoaderStage {
 class CollideLoaderStage : public LoaderStage {
  public:
   CollideLoaderStage() : LoaderStage("collide") {}
-  bool run(Timer& /*timer*/, LoaderInput& data) override {
+  bool run(UploadBudget& budget, LoaderInput& data) override {
     if (m_done) {
       return true;
     }
     if (!m_opengl_created) {
       glGenBuffers(1, &data.lev_data->collide_vertices);
       glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->collide_vertices);
-      glBufferData(
-          GL_ARRAY_BUFFER,
+      alloc_buffer(
+          data.lev_data, GL_ARRAY_BUFFER,
           data.lev_data->level->collision.vertices.size() * sizeof(tfrag3::CollisionMesh::Vertex),
-          nullptr, GL_STATIC_DRAW);
+          nullptr);
       m_opengl_created = true;
       return false;
     }
 
-    u32 start = m_vtx;
-    u32 end = std::min((u32)data.lev_data->level->collision.vertices.size(), start + 32768);
+    // upload chunks until the level is done or we run out of time for this frame.
+    constexpr u32 CHUNK_SIZE = 32768;
+    const auto& verts = data.lev_data->level->collision.vertices;
     glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->collide_vertices);
-    glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(tfrag3::CollisionMesh::Vertex),
-                    (end - start) * sizeof(tfrag3::CollisionMesh::Vertex),
-                    data.lev_data->level->collision.vertices.data() + start);
-    m_vtx = end;
-
-    if (m_vtx == data.lev_data->level->collision.vertices.size()) {
-      m_done = true;
-      return true;
-    } else {
-      return false;
+    while (!budget.exhausted()) {
+      u32 start = m_vtx;
+      u32 end = std::min((u32)verts.size(), start + CHUNK_SIZE);
+      glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(tfrag3::CollisionMesh::Vertex),
+                      (end - start) * sizeof(tfrag3::CollisionMesh::Vertex), verts.data() + start);
+      m_vtx = end;
+      budget.add_bytes((end - start) * sizeof(tfrag3::CollisionMesh::Vertex));
+
+      if (m_vtx == verts.size()) {
+        m_done = true;
+        return true;
+      }
     }
+    return false;
   }
   void reset() override {
     m_opengl_created = false;
@@ -542,7 +546,7 @@ class CollideLoaderStage : public LoaderStage {
 class StallLoaderStage : public LoaderStage {
  public:
   StallLoaderStage() : LoaderStage("stall") {}
-  bool run(Timer&, LoaderInput& /*data*/) override {
+  bool run(UploadBudget&, LoaderInput& /*data*/) override {
     m_count++;
     if (m_count > 10) {
       return true;
@@ -564,7 +568,7 @@ void MercLoaderStage::reset() {
   m_idx = 0;
 }
 
-bool MercLoaderStage::run(Timer& /*timer*/, LoaderInput& data) {
+bool MercLoaderStage::run(UploadBudget& budget, LoaderInput& data) {
   if (m_done) {
     return true;
   }
@@ -572,48 +576,52 @@ bool MercLoaderStage::run(Timer& /*timer*/, LoaderInput& data) {
   if (!m_opengl) {
     glGenBuffers(1, &data.lev_data->merc_indices);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.lev_data->merc_indices);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 data.lev_data->level->merc_data.indices.size() * sizeof(u32), nullptr,
-                 GL_STATIC_DRAW);
+    alloc_buffer(data.lev_data, GL_ELEMENT_ARRAY_BUFFER,
+                 data.lev_data->level->merc_data.indices.size() * sizeof(u32), nullptr);
 
     glGenBuffers(1, &data.lev_data->merc_vertices);
     glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->merc_vertices);
-    glBufferData(GL_ARRAY_BUFFER,
+    alloc_buffer(data.lev_data, GL_ARRAY_BUFFER,
                  data.lev_data->level->merc_data.vertices.size() * sizeof(tfrag3::MercVertex),
-                 nullptr, GL_STATIC_DRAW);
+                 nullptr);
     m_opengl = true;
   }
 
-  if (!m_vtx_uploaded) {
+  // upload chunks until the level is done or we run out of time for this frame.
+  constexpr u32 CHUNK_SIZE = 32768;
+  const auto& merc = data.lev_data->level->merc_data;
+  while (!m_vtx_uploaded) {
+    if (budget.exhausted()) {
+      return false;
+    }
     u32 start = m_idx;
-    m_idx = std::min(start + 32768, (u32)data.lev_data->level->merc_data.indices.size());
+    m_idx = std::min(start + CHUNK_SIZE, (u32)merc.indices.size());
     glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->merc_indices);
     glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(u32), (m_idx - start) * sizeof(u32),
-                    data.lev_data->level->merc_data.indices.data() + start);
-    if (m_idx != data.lev_data->level->merc_data.indices.size()) {
-      return false;
-    } else {
+                    merc.indices.data() + start);
+    budget.add_bytes((m_idx - start) * sizeof(u32));
+    if (m_idx == merc.indices.size()) {
       m_idx = 0;
       m_vtx_uploaded = true;
     }
   }
 
-  u32 start = m_idx;
-  m_idx = std::min(start + 32768, (u32)data.lev_data->level->merc_data.vertices.size());
-  glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->merc_vertices);
-  glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(tfrag3::MercVertex),
-                  (m_idx - start) * sizeof(tfrag3::MercVertex),
-                  data.lev_data->level->merc_data.vertices.data() + start);
-
-  if (m_idx != data.lev_data->level->merc_data.vertices.size()) {
-    return false;
-  } else {
-    m_done = true;
-    for (auto& model : data.lev_data->level->merc_data.models) {
-      data.lev_data->merc_model_lookup[model.name] = &model;
-      (*data.mercs)[model.name].push_back({&model, data.lev_data->load_id, data.lev_data});
+  while (m_idx != merc.vertices.size()) {
+    if (budget.exhausted()) {
+      return false;
     }
-    return true;
+    u32 start = m_idx;
+    m_idx = std::min(start + CHUNK_SIZE, (u32)merc.vertices.size());
+    glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->merc_vertices);
+    glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(tfrag3::MercVertex),
+                    (m_idx - start) * sizeof(tfrag3::MercVertex), merc.vertices.data() + start);
+    budget.add_bytes((m_idx - start) * sizeof(tfrag3::MercVertex));
+  }
+
+  m_done = true;
+  for (auto& model : data.lev_data->level->merc_data.models) {
+    data.lev_data->merc_model_lookup[model.name] = &model;
+    (*data.mercs)[model.name].push_back({&model, data.lev_data->load_id, data.lev_data});
   }
   return true;
 }
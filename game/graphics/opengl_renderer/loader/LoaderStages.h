@@ -4,11 +4,12 @@
 
 std::vector<std::unique_ptr<LoaderStage>> make_loader_stages();
 u64 add_texture(TexturePool& pool, const tfrag3::Texture& tex, bool is_common);
+u64 texture_gpu_bytes(const tfrag3::Texture& tex);
 
 class MercLoaderStage : public LoaderStage {
  public:
   MercLoaderStage();
-  bool run(Timer& timer, LoaderInput& data) override;
+  bool run(UploadBudget& budget, LoaderInput& data) override;
   void reset() override;
 
  private:
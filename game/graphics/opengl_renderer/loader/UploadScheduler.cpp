@@ -0,0 +1,72 @@
+#include "UploadScheduler.h"
+
+#include <algorithm>
+
+#include "common/global_profiler/GlobalProfiler.h"
+
+#include "third-party/fmt/core.h"
+#include "third-party/imgui/imgui.h"
+
+namespace {
+float to_mb_per_s(float bytes_per_ms) {
+  return bytes_per_ms * 1000.f / (1024.f * 1024.f);
+}
+}  // namespace
+
+void UploadScheduler::begin_frame(const FrameTiming& timing) {
+  float remaining = timing.target_ms - timing.elapsed_ms - timing.render_ms - SAFETY_MARGIN_MS;
+  m_frame_budget_ms = std::clamp(remaining, MIN_UPLOAD_MS, MAX_UPLOAD_MS);
+  m_used_ms = 0;
+}
+
+/*!
+ * Budget for the next stage to run: everything the previous stages didn't use.
+ */
+UploadBudget UploadScheduler::start_stage() const {
+  return UploadBudget(std::max(0.f, m_frame_budget_ms - m_used_ms));
+}
+
+void UploadScheduler::finish_stage(const std::string& name, const UploadBudget& budget) {
+  float ms = budget.elapsed_ms();
+  m_used_ms += ms;
+
+  auto& stats = stats_for(name);
+  stats.total_bytes += budget.bytes();
+  stats.total_ms += ms;
+  // ignore runs that only created buffers or checked if they were done.
+  if (budget.bytes() > 0 && ms > 0.01f) {
+    float rate = budget.bytes() / ms;
+    stats.bytes_per_ms =
+        stats.bytes_per_ms == 0 ? rate : (0.9f * stats.bytes_per_ms) + (0.1f * rate);
+    prof().instant_event(
+        fmt::format("stage-{}: {} KB, {:.1f} MB/s", name, budget.bytes() / 1024, to_mb_per_s(rate))
+            .c_str());
+  }
+}
+
+UploadScheduler::StageStats& UploadScheduler::stats_for(const std::string& name) {
+  for (auto& stats : m_stage_stats) {
+    if (stats.name == name) {
+      return stats;
+    }
+  }
+  auto& stats = m_stage_stats.emplace_back();
+  stats.name = name;
+  return stats;
+}
+
+u64 UploadScheduler::total_bytes() const {
+  u64 result = 0;
+  for (auto& stats : m_stage_stats) {
+    result += stats.total_bytes;
+  }
+  return result;
+}
+
+void UploadScheduler::draw_debug_window() {
+  ImGui::Text("upload budget: %.2f ms, used %.2f ms", m_frame_budget_ms, m_used_ms);
+  for (auto& stats : m_stage_stats) {
+    ImGui::Text("  %10s : %8.1f MB/s  %8.1f MB total", stats.name.c_str(),
+                to_mb_per_s(stats.bytes_per_ms), stats.total_bytes / (1024.f * 1024.f));
+  }
+}
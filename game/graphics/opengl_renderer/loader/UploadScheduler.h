@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+
+#include "game/graphics/opengl_renderer/loader/common.h"
+
+/*!
+ * Decides how much of each frame the loader can spend uploading to the GPU.
+ *
+ * The budget is whatever is left of the target frame time after the time already spent on this
+ * frame and the time the rest of the renderer is expected to take. The loader stages get this
+ * budget in priority order (the order of make_loader_stages): each stage may use everything that
+ * the stages before it left over.
+ */
+class UploadScheduler {
+ public:
+  // always make some progress, even if the frame is already late.
+  static constexpr float MIN_UPLOAD_MS = 0.5f;
+  // don't take the whole frame, even if the renderer has nothing else to do.
+  static constexpr float MAX_UPLOAD_MS = 8.f;
+  // leave room for imgui, swapping buffers, and noise in the estimate.
+  static constexpr float SAFETY_MARGIN_MS = 1.5f;
+
+  struct FrameTiming {
+    float target_ms = 1000.f / 60.f;  // from the frame limiter
+    float elapsed_ms = 0.f;           // time spent on this frame before the loader ran
+    float render_ms = 0.f;            // time the renderer took after the loader last frame
+  };
+
+  struct StageStats {
+    std::string name;
+    u64 total_bytes = 0;
+    double total_ms = 0;
+    float bytes_per_ms = 0;  // smoothed throughput, 0 if not measured yet
+  };
+
+  void begin_frame(const FrameTiming& timing);
+  UploadBudget start_stage() const;
+  void finish_stage(const std::string& name, const UploadBudget& budget);
+
+  float frame_budget_ms() const { return m_frame_budget_ms; }
+  float used_ms() const { return m_used_ms; }
+  const std::vector<StageStats>& stage_stats() const { return m_stage_stats; }
+  // all stages, since startup.
+  u64 total_bytes() const;
+  void draw_debug_window();
+
+ private:
+  StageStats& stats_for(const std::string& name);
+
+  float m_frame_budget_ms = MIN_UPLOAD_MS;
+  float m_used_ms = 0;
+  std::vector<StageStats> m_stage_stats;
+};
@@ -29,6 +29,11 @@ struct LevelData {
   std::unordered_map<std::string, const tfrag3::MercModel*> merc_model_lookup;
 
   int frames_since_last_used = 0;
+
+  // memory used by this level. The CPU side is set when the level is unpacked, and the GPU side is
+  // added to as the loader stages upload it.
+  u64 cpu_bytes = 0;
+  u64 gpu_bytes = 0;
 };
 
 struct MercRef {
@@ -46,10 +51,28 @@ struct LoaderInput {
   std::unordered_map<std::string, std::vector<MercRef>>* mercs;
 };
 
+/*!
+ * The time a loader stage may spend in one run. Stages should upload in chunks, report the bytes
+ * they uploaded, and return once the budget is exhausted.
+ */
+class UploadBudget {
+ public:
+  explicit UploadBudget(float ms) : m_ms(ms) {}
+  bool exhausted() const { return m_timer.getMs() > m_ms; }
+  void add_bytes(u64 bytes) { m_bytes += bytes; }
+  u64 bytes() const { return m_bytes; }
+  double elapsed_ms() const { return m_timer.getMs(); }
+
+ private:
+  Timer m_timer;
+  float m_ms = 0;
+  u64 m_bytes = 0;
+};
+
 class LoaderStage {
  public:
   LoaderStage(const std::string& name) : m_name(name) {}
-  virtual bool run(Timer& timer, LoaderInput& data) = 0;
+  virtual bool run(UploadBudget& budget, LoaderInput& data) = 0;
   virtual void reset() = 0;
   virtual ~LoaderStage() = default;
   const std::string& name() const { return m_name; }
@@ -1,33 +1,6 @@
 #include "OceanMid.h"
 
 namespace {
-u32 clip(const Vf& vector, float val, u32 old_clip) {
-  u32 result = (old_clip << 6);
-  float plus = std::abs(val);
-  float minus = -plus;
-
-  if (vector.x() > plus) {
-    result |= 0b1;
-  }
-  if (vector.x() < minus) {
-    result |= 0b10;
-  }
-
-  if (vector.y() > plus) {
-    result |= 0b100;
-  }
-  if (vector.y() < minus) {
-    result |= 0b1000;
-  }
-
-  if (vector.z() > plus) {
-    result |= 0b10000;
-  }
-  if (vector.z() < minus) {
-    result |= 0b100000;
-  }
-  return result & 0xffffff;  // only 24 bits
-}
 void fcand(u16& dest, u32 imm, u32 cf) {
   // dest = (cf & imm) ? 1 : 0;
   if ((cf & 0xFFFFFF) & (imm & 0xFFFFFF))
@@ -1958,7 +1931,7 @@ void OceanMid::run_L26_vu2c() {
   // nop                        |  maddw.xyzw vf16, vf02, vf00    408
   vu.acc.madd(Mask::xyzw, vu.vf16, vu.vf02, vu.vf00.w());
   // nop                        |  clipw.xyz vf18, vf18           409
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   // nop                        |  mul.xyzw vf19, vf31, vf01      410
   vu.vf19.mul(Mask::xyzw, vu.vf31, vu.vf01);
   // div Q, vf03.x, vf31.w      |  mul.xyzw vf20, vf20, Q         411
@@ -1969,7 +1942,7 @@ void OceanMid::run_L26_vu2c() {
   // nop                        |  madday.xyzw ACC, vf13, vf28    413
   vu.acc.madda(Mask::xyzw, vu.vf13, vu.vf28.y());
   // iaddi vi13, vi00, 0x0      |  clipw.xyz vf19, vf19           414
-  cf = clip(vu.vf19, vu.vf19.w(), cf);
+  cf = vu_clip(vu.vf19, vu.vf19.w(), cf);
   vu.vi13 = 0;
   // iaddi vi12, vi00, 0x1      |  maxy.w vf16, vf16, vf03        415
   vu.vf16.max(Mask::w, vu.vf16, vu.vf03.y());
@@ -2030,7 +2003,7 @@ L28:
   vu.acc.madda(Mask::xyzw, vu.vf13, vu.vf28.y());
   sq_buffer(Mask::xyzw, vu.vf23, vu.vi08 + 4);
   // sq.xyzw vf17, 5(vi08)      |  clipw.xyz vf19, vf19           431
-  cf = clip(vu.vf19, vu.vf19.w(), cf);
+  cf = vu_clip(vu.vf19, vu.vf19.w(), cf);
   sq_buffer(Mask::xyzw, vu.vf17, vu.vi08 + 5);
   // lq.xyzw vf29, 245(vi05)    |  miniz.w vf16, vf16, vf03       432
   vu.vf16.mini(Mask::w, vu.vf16, vu.vf03.z());
@@ -2081,7 +2054,7 @@ L30:
   vu.acc.madda(Mask::xyzw, vu.vf13, vu.vf29.y());
   sq_buffer(Mask::xyzw, vu.vf22, vu.vi08 + 1);
   // sq.xyzw vf16, 2(vi08)      |  clipw.xyz vf18, vf18           446
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   sq_buffer(Mask::xyzw, vu.vf16, vu.vi08 + 2);
   // lq.xyzw vf28, 236(vi05)    |  miniz.w vf17, vf17, vf03       447
   vu.vf17.mini(Mask::w, vu.vf17, vu.vf03.z());
@@ -2230,9 +2203,9 @@ void OceanMid::run_L32_vu2c() {
   // nop                        |  maddw.xyzw vf26, vf11, vf00    499
   vu.acc.madd(Mask::xyzw, vu.vf26, vu.vf11, vu.vf00.w());
   // nop                        |  clipw.xyz vf18, vf18           500
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   // waitp                      |  clipw.xyz vf19, vf19           501
-  cf = clip(vu.vf19, vu.vf19.w(), cf);
+  cf = vu_clip(vu.vf19, vu.vf19.w(), cf);
   // BRANCH!
   // b L35                      |  mula.xyzw ACC, vf24, vf05      502
   vu.acc.mula(Mask::xyzw, vu.vf24, vu.vf05);
@@ -2354,7 +2327,7 @@ L34:
   vu.vf16.max(Mask::w, vu.vf16, vu.vf03.y());
   vu.vf26.mfp(Mask::w, vu.P);
   // erleng.xyz P, vf27         |  clipw.xyz vf19, vf19           531
-  cf = clip(vu.vf19, vu.vf19.w(), cf);
+  cf = vu_clip(vu.vf19, vu.vf19.w(), cf);
   vu.P = erleng(vu.vf27);
   // iand vi13, vi10, vi12      |  addz.y vf27, vf00, vf27        532
   vu.vf27.add(Mask::y, vu.vf00, vu.vf27.z());
@@ -2498,7 +2471,7 @@ L36:
   vu.vf17.max(Mask::w, vu.vf17, vu.vf03.y());
   vu.vf27.mfp(Mask::w, vu.P);
   // erleng.xyz P, vf26         |  clipw.xyz vf18, vf18           571
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   vu.P = erleng(vu.vf26);
   // nop                        |  addz.y vf26, vf00, vf26        572
   vu.vf26.add(Mask::y, vu.vf00, vu.vf26.z());
@@ -2746,9 +2719,9 @@ void OceanMid::run_L32_vu2c_jak2() {
   // nop                        |  maddw.xyzw vf26, vf11, vf00    498
   vu.acc.madd(Mask::xyzw, vu.vf26, vu.vf11, vu.vf00.w());
   // nop                        |  clipw.xyz vf18, vf18           499
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   // waitp                      |  clipw.xyz vf19, vf19           500
-  cf = clip(vu.vf19, vu.vf19.w(), cf);
+  cf = vu_clip(vu.vf19, vu.vf19.w(), cf);
   // BRANCH!
   // b L35                      |  mula.xyzw ACC, vf24, vf05      501
   vu.acc.mula(Mask::xyzw, vu.vf24, vu.vf05);
@@ -2870,7 +2843,7 @@ L34:
   vu.vf16.max(Mask::w, vu.vf16, vu.vf03.y());
   vu.vf26.mfp(Mask::w, vu.P);
   // erleng.xyz P, vf27         |  clipw.xyz vf19, vf19           531
-  cf = clip(vu.vf19, vu.vf19.w(), cf);
+  cf = vu_clip(vu.vf19, vu.vf19.w(), cf);
   vu.P = erleng(vu.vf27);
   // sq.xyzw vf21, 3(vi08)      |  mulz.xyzw vf25, vf25, vf21     533
   vu.vf25.z() = 1;  // TODO hack
@@ -3012,7 +2985,7 @@ L36:
   vu.vf17.max(Mask::w, vu.vf17, vu.vf03.y());
   vu.vf27.mfp(Mask::w, vu.P);
   // erleng.xyz P, vf26         |  clipw.xyz vf18, vf18           571
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   vu.P = erleng(vu.vf26);
   // sq.xyzw vf20, 0(vi08)      |  mulz.xyzw vf24, vf24, vf20     573
   // todo hack
@@ -3950,7 +3923,7 @@ void OceanMid::run_L45_vu2c() {
   // lq.xyzw vf27, 1(vi03)      |  nop                            797
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           798
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L46:
   // lq.xyzw vf22, 2(vi03)      |  nop                            799
@@ -3962,7 +3935,7 @@ L46:
   // iaddi vi03, vi03, 0x3      |  nop                            802
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           803
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            804
 
   // nop                        |  nop                            805
@@ -4057,7 +4030,7 @@ L47:
   // lq.xyzw vf27, 1(vi03)      |  nop                            835
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           836
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L48:
   // lq.xyzw vf22, 2(vi03)      |  nop                            837
@@ -4069,7 +4042,7 @@ L48:
   // iaddi vi03, vi03, 0x3      |  nop                            840
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           841
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            842
 
   // nop                        |  nop                            843
@@ -4164,7 +4137,7 @@ L49:
   // lq.xyzw vf27, 1(vi03)      |  nop                            873
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           874
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L50:
   // lq.xyzw vf22, 2(vi03)      |  nop                            875
@@ -4176,7 +4149,7 @@ L50:
   // iaddi vi03, vi03, 0x3      |  nop                            878
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           879
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            880
 
   // nop                        |  nop                            881
@@ -4271,7 +4244,7 @@ L51:
   // lq.xyzw vf27, 1(vi03)      |  nop                            911
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           912
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L52:
   // lq.xyzw vf22, 2(vi03)      |  nop                            913
@@ -4283,7 +4256,7 @@ L52:
   // iaddi vi03, vi03, 0x3      |  nop                            916
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           917
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            918
 
   // nop                        |  nop                            919
@@ -4378,7 +4351,7 @@ L53:
   // lq.xyzw vf27, 1(vi03)      |  nop                            949
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           950
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L54:
   // lq.xyzw vf22, 2(vi03)      |  nop                            951
@@ -4390,7 +4363,7 @@ L54:
   // iaddi vi03, vi03, 0x3      |  nop                            954
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           955
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            956
 
   // nop                        |  nop                            957
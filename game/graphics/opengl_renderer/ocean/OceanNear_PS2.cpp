@@ -1120,34 +1120,6 @@ static inline REALLY_INLINE float eleng(const Vf& in) {
 }
 
 namespace {
-u32 clip(const Vf& vector, float val, u32 old_clip) {
-  u32 result = (old_clip << 6);
-  float plus = std::abs(val);
-  float minus = -plus;
-
-  if (vector.x() > plus) {
-    result |= 0b1;
-  }
-  if (vector.x() < minus) {
-    result |= 0b10;
-  }
-
-  if (vector.y() > plus) {
-    result |= 0b100;
-  }
-  if (vector.y() < minus) {
-    result |= 0b1000;
-  }
-
-  if (vector.z() > plus) {
-    result |= 0b10000;
-  }
-  if (vector.z() < minus) {
-    result |= 0b100000;
-  }
-  return result & 0xffffff;  // only 24 bits
-}
-
 void fcand(u16& dest, u32 imm, u32 cf) {
   // dest = (cf & imm) ? 1 : 0;
   if ((cf & 0xFFFFFF) & (imm & 0xFFFFFF))
@@ -1280,7 +1252,7 @@ void OceanNear::run_L15_vu2c() {
   // eleng.xyz P, vf26          |  nop                            252
   vu.P = eleng(vu.vf26);
   // nop                        |  clipw.xyz vf18, vf18           253
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   // nop                        |  mulaw.w ACC, vf30, vf00        254
   vu.acc.mula(Mask::w, vu.vf30, vu.vf00.w());
   // lq.xyzw vf29, 314(vi05)    |  mulw.w vf23, vf21, vf05        255
@@ -1450,7 +1422,7 @@ L17:
   vu.vf22.mul(Mask::xyz, vu.vf22, vu.vf07.w());
   vu.P = eleng(vu.vf26);
   // iaddi vi08, vi08, 0x6      |  clipw.xyz vf18, vf18           305
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   vu.vi08 = vu.vi08 + 6;
   // nop                        |  mulaw.w ACC, vf30, vf00        306
   vu.acc.mula(Mask::w, vu.vf30, vu.vf00.w());
@@ -1613,7 +1585,7 @@ L19:
   vu.vf23.mul(Mask::xyz, vu.vf23, vu.vf07.w());
   vu.P = eleng(vu.vf27);
   // nop                        |  clipw.xyz vf19, vf19           356
-  cf = clip(vu.vf19, vu.vf19.w(), cf);
+  cf = vu_clip(vu.vf19, vu.vf19.w(), cf);
   // nop                        |  mulaw.w ACC, vf31, vf00        357
   vu.acc.mula(Mask::w, vu.vf31, vu.vf00.w());
   // nop                        |  mulw.w vf22, vf20, vf05        358
@@ -1861,7 +1833,7 @@ void OceanNear::run_L15_vu2c_jak2() {
   // eleng.xyz P, vf26          |  nop                            252
   vu.P = eleng(vu.vf26);
   // nop                        |  clipw.xyz vf18, vf18           253
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   // nop                        |  mulaw.w ACC, vf30, vf00        254
   vu.acc.mula(Mask::w, vu.vf30, vu.vf00.w());
   // lq.xyzw vf29, 314(vi05)    |  mulw.w vf23, vf21, vf05        255
@@ -2031,7 +2003,7 @@ L17:
   vu.vf22.mul(Mask::xyz, vu.vf22, vu.vf07.w());
   vu.P = eleng(vu.vf26);
   // iaddi vi08, vi08, 0x6      |  clipw.xyz vf18, vf18           305
-  cf = clip(vu.vf18, vu.vf18.w(), cf);
+  cf = vu_clip(vu.vf18, vu.vf18.w(), cf);
   vu.vi08 = vu.vi08 + 6;
   // nop                        |  mulaw.w ACC, vf30, vf00        306
   vu.acc.mula(Mask::w, vu.vf30, vu.vf00.w());
@@ -2194,7 +2166,7 @@ L19:
   vu.vf23.mul(Mask::xyz, vu.vf23, vu.vf07.w());
   vu.P = eleng(vu.vf27);
   // nop                        |  clipw.xyz vf19, vf19           356
-  cf = clip(vu.vf19, vu.vf19.w(), cf);
+  cf = vu_clip(vu.vf19, vu.vf19.w(), cf);
   // nop                        |  mulaw.w ACC, vf31, vf00        357
   vu.acc.mula(Mask::w, vu.vf31, vu.vf00.w());
   // nop                        |  mulw.w vf22, vf20, vf05        358
@@ -3191,7 +3163,7 @@ void OceanNear::run_L32_vu2c() {
   // lq.xyzw vf27, 1(vi03)      |  nop                            610
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           611
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L33:
   // lq.xyzw vf22, 2(vi03)      |  nop                            612
@@ -3203,7 +3175,7 @@ L33:
   // iaddi vi03, vi03, 0x3      |  nop                            615
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           616
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            617
 
   // nop                        |  nop                            618
@@ -3298,7 +3270,7 @@ L34:
   // lq.xyzw vf27, 1(vi03)      |  nop                            648
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           649
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L35:
   // lq.xyzw vf22, 2(vi03)      |  nop                            650
@@ -3310,7 +3282,7 @@ L35:
   // iaddi vi03, vi03, 0x3      |  nop                            653
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           654
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            655
 
   // nop                        |  nop                            656
@@ -3405,7 +3377,7 @@ L36:
   // lq.xyzw vf27, 1(vi03)      |  nop                            686
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           687
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L37:
   // lq.xyzw vf22, 2(vi03)      |  nop                            688
@@ -3417,7 +3389,7 @@ L37:
   // iaddi vi03, vi03, 0x3      |  nop                            691
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           692
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            693
 
   // nop                        |  nop                            694
@@ -3512,7 +3484,7 @@ L38:
   // lq.xyzw vf27, 1(vi03)      |  nop                            724
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           725
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L39:
   // lq.xyzw vf22, 2(vi03)      |  nop                            726
@@ -3524,7 +3496,7 @@ L39:
   // iaddi vi03, vi03, 0x3      |  nop                            729
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           730
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            731
 
   // nop                        |  nop                            732
@@ -3619,7 +3591,7 @@ L40:
   // lq.xyzw vf27, 1(vi03)      |  nop                            762
   lq_buffer(Mask::xyzw, vu.vf27, vu.vi03 + 1);
   // iaddi vi03, vi03, 0x3      |  clipw.xyz vf21, vf21           763
-  cf = clip(vu.vf21, vu.vf21.w(), cf);
+  cf = vu_clip(vu.vf21, vu.vf21.w(), cf);
   vu.vi03 = vu.vi03 + 3;
 L41:
   // lq.xyzw vf22, 2(vi03)      |  nop                            764
@@ -3631,7 +3603,7 @@ L41:
   // iaddi vi03, vi03, 0x3      |  nop                            767
   vu.vi03 = vu.vi03 + 3;
   // nop                        |  clipw.xyz vf22, vf22           768
-  cf = clip(vu.vf22, vu.vf22.w(), cf);
+  cf = vu_clip(vu.vf22, vu.vf22.w(), cf);
   // nop                        |  nop                            769
 
   // nop                        |  nop                            770
@@ -0,0 +1,337 @@
+/*!
+ * @file null.cpp
+ * Renderer with no GPU or display, for benchmarking the runtime on headless machines.
+ *
+ * This runs the real OpenGLRenderer and its bucket renderers, so all of their CPU work (DMA
+ * processing, merc/generic/sprite prep, VU emulation, time of day, culling, the loader) is done
+ * like normal. OpenGL functions are replaced with stubs that do nothing, so no context is needed.
+ * The time is recorded per bucket, and with no GPU work, it's all CPU time.
+ *
+ * The chain is rendered on the game thread, inside of send_chain, and vsync doesn't wait, so the
+ * game runs as fast as it can.
+ */
+
+#include "null.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/goal_constants.h"
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+
+#include "game/graphics/opengl_renderer/OpenGLRenderer.h"
+#include "game/graphics/opengl_renderer/loader/Loader.h"
+#include "game/graphics/texture/TexturePool.h"
+#include "game/runtime.h"
+
+#include "third-party/glad/include/glad/glad.h"
+
+namespace {
+
+// how often to log the slowest buckets.
+constexpr int REPORT_INTERVAL_FRAMES = 600;
+constexpr int REPORT_BUCKET_COUNT = 10;
+
+// the resolution the renderer thinks it's drawing at. Only changes the size of the fake buffers.
+constexpr int NULL_RES_W = 640;
+constexpr int NULL_RES_H = 480;
+
+constexpr PerGameVersion<int> fr3_level_count(jak1::LEVEL_TOTAL, jak2::LEVEL_TOTAL);
+
+////////////////////
+// OpenGL stubs
+////////////////////
+
+// Functions that return something the renderers use. Everything else goes to null_gl_noop.
+
+std::atomic<GLuint> g_next_gl_name = 1;
+
+void APIENTRY null_gl_gen_names(GLsizei n, GLuint* names) {
+  for (GLsizei i = 0; i < n; i++) {
+    names[i] = g_next_gl_name++;
+  }
+}
+
+GLuint APIENTRY null_gl_create() {
+  return g_next_gl_name++;
+}
+
+void APIENTRY null_gl_get_integerv(GLenum pname, GLint* data) {
+  switch (pname) {
+    case GL_VIEWPORT:
+      data[0] = 0;
+      data[1] = 0;
+      data[2] = NULL_RES_W;
+      data[3] = NULL_RES_H;
+      break;
+    case GL_NUM_EXTENSIONS:
+      data[0] = 1;
+      break;
+    case GL_MAX_SAMPLES:
+      data[0] = 16;
+      break;
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+      data[0] = 256;
+      break;
+    default:
+      data[0] = 0;
+      break;
+  }
+}
+
+void APIENTRY null_gl_get_floatv(GLenum /*pname*/, GLfloat* data) {
+  data[0] = 16.f;  // only used for max anisotropy.
+}
+
+// compile and link status
+void APIENTRY null_gl_get_object_iv(GLuint /*obj*/, GLenum /*pname*/, GLint* data) {
+  data[0] = GL_TRUE;
+}
+
+const GLubyte* APIENTRY null_gl_get_string(GLenum name) {
+  return (const GLubyte*)(name == GL_VERSION ? "4.3 null" : "null");
+}
+
+const GLubyte* APIENTRY null_gl_get_stringi(GLenum /*name*/, GLuint /*index*/) {
+  return (const GLubyte*)"GL_null_renderer";
+}
+
+GLenum APIENTRY null_gl_check_framebuffer_status(GLenum /*target*/) {
+  return GL_FRAMEBUFFER_COMPLETE;
+}
+
+/*!
+ * Used for every other function. Arguments are ignored, and returns 0 for functions that return
+ * something. Calling this through a pointer to a function with arguments is fine with the
+ * caller-cleanup calling conventions on all the 64-bit platforms we support.
+ */
+GLint64 APIENTRY null_gl_noop() {
+  return 0;
+}
+
+void* null_gl_get_proc(const char* name) {
+  static const std::unordered_map<std::string, void*> special = {
+      {"glGenBuffers", (void*)null_gl_gen_names},
+      {"glGenVertexArrays", (void*)null_gl_gen_names},
+      {"glGenTextures", (void*)null_gl_gen_names},
+      {"glGenFramebuffers", (void*)null_gl_gen_names},
+      {"glGenRenderbuffers", (void*)null_gl_gen_names},
+      {"glCreateShader", (void*)null_gl_create},
+      {"glCreateProgram", (void*)null_gl_create},
+      {"glGetIntegerv", (void*)null_gl_get_integerv},
+      {"glGetFloatv", (void*)null_gl_get_floatv},
+      {"glGetShaderiv", (void*)null_gl_get_object_iv},
+      {"glGetProgramiv", (void*)null_gl_get_object_iv},
+      {"glGetString", (void*)null_gl_get_string},
+      {"glGetStringi", (void*)null_gl_get_stringi},
+      {"glCheckFramebufferStatus", (void*)null_gl_check_framebuffer_status},
+  };
+  auto it = special.find(name);
+  return it == special.end() ? (void*)null_gl_noop : it->second;
+}
+
+////////////////////
+// Renderer
+////////////////////
+
+struct NullGraphicsData {
+  u64 frame_idx = 0;
+  std::shared_ptr<TexturePool> texture_pool;
+  std::shared_ptr<Loader> loader;
+  OpenGLRenderer ogl_renderer;
+  float pmode_alp = 0.f;
+
+  // bucket times since the last report, and for the whole run.
+  std::vector<std::string> bucket_names;
+  std::vector<double> interval_bucket_ms;
+  std::vector<double> total_bucket_ms;
+  double interval_render_ms = 0;
+  double total_render_ms = 0;
+  int interval_frames = 0;
+  u64 total_frames = 0;
+
+  explicit NullGraphicsData(GameVersion game_version)
+      : texture_pool(std::make_shared<TexturePool>(game_version)),
+        loader(std::make_shared<Loader>(
+            file_util::get_jak_project_dir() / "out" / game_version_names[game_version] / "fr3",
+            fr3_level_count[game_version])),
+        ogl_renderer(texture_pool, loader, game_version),
+        bucket_names(ogl_renderer.bucket_names()),
+        interval_bucket_ms(bucket_names.size()),
+        total_bucket_ms(bucket_names.size()) {}
+};
+
+std::unique_ptr<NullGraphicsData> g_null_data;
+
+/*!
+ * Log the buckets that took the most time, averaged over the given number of frames.
+ */
+void report_bucket_stats(const std::vector<double>& bucket_ms, double render_ms, u64 frames) {
+  if (!frames) {
+    return;
+  }
+  const auto& names = g_null_data->bucket_names;
+  std::vector<int> order;
+  for (size_t i = 0; i < bucket_ms.size(); i++) {
+    if (bucket_ms[i] > 0) {
+      order.push_back(i);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&](int a, int b) { return bucket_ms[a] > bucket_ms[b]; });
+
+  lg::info("[null renderer] {} frames, {:.3f} ms/frame rendering", frames, render_ms / frames);
+  for (size_t i = 0; i < order.size() && i < REPORT_BUCKET_COUNT; i++) {
+    lg::info("  {:<32} {:8.3f} ms/frame", names[order[i]], bucket_ms[order[i]] / frames);
+  }
+}
+
+/*!
+ * Add the stats from the last interval to the totals, and log them.
+ */
+void flush_interval_stats() {
+  auto& data = *g_null_data;
+  report_bucket_stats(data.interval_bucket_ms, data.interval_render_ms, data.interval_frames);
+  for (size_t i = 0; i < data.interval_bucket_ms.size(); i++) {
+    data.total_bucket_ms[i] += data.interval_bucket_ms[i];
+    data.interval_bucket_ms[i] = 0;
+  }
+  data.total_render_ms += data.interval_render_ms;
+  data.interval_render_ms = 0;
+  data.total_frames += data.interval_frames;
+  data.interval_frames = 0;
+}
+
+int null_init(GfxGlobalSettings& /*settings*/) {
+  lg::info("Using the null renderer. Nothing will be drawn.");
+  if (!load_null_gl_functions()) {
+    lg::error("Failed to set up the null OpenGL functions");
+    return 1;
+  }
+  g_null_data = std::make_unique<NullGraphicsData>(g_game_version);
+  return 0;
+}
+
+std::shared_ptr<GfxDisplay> null_make_display(int /*width*/,
+                                              int /*height*/,
+                                              const char* /*title*/,
+                                              GfxGlobalSettings& /*settings*/,
+                                              GameVersion /*version*/,
+                                              bool /*is_main*/) {
+  return nullptr;
+}
+
+void null_exit() {
+  if (g_null_data) {
+    flush_interval_stats();
+    lg::info("[null renderer] totals for the whole run:");
+    report_bucket_stats(g_null_data->total_bucket_ms, g_null_data->total_render_ms,
+                        g_null_data->total_frames);
+    g_null_data.reset();
+  }
+}
+
+/*!
+ * There's no display to wait for, so frames finish as soon as the chain is rendered.
+ * Returns 0 or 1 depending on if frame is even or odd.
+ */
+u32 null_vsync() {
+  if (!g_null_data) {
+    return 0;
+  }
+  return g_null_data->frame_idx++ & 1;
+}
+
+u32 null_sync_path() {
+  return 0;
+}
+
+/*!
+ * Render the DMA chain from the game. Unlike the OpenGL renderer, this finishes before returning.
+ * Called from the game thread, on a GOAL stack.
+ */
+void null_send_chain(const void* data, u32 offset) {
+  if (!g_null_data) {
+    return;
+  }
+  auto& null_data = *g_null_data;
+  RenderOptions options;
+  options.game_res_w = NULL_RES_W;
+  options.game_res_h = NULL_RES_H;
+  options.window_framebuffer_width = NULL_RES_W;
+  options.window_framebuffer_height = NULL_RES_H;
+  options.draw_region_width = NULL_RES_W;
+  options.draw_region_height = NULL_RES_H;
+  options.pmode_alp_register = null_data.pmode_alp;
+  // give the loader the same upload budget as a 60 fps frame.
+  options.target_frame_time_ms = 1000.f / 60.f;
+  options.frame_time_so_far_ms = 0;
+  null_data.ogl_renderer.render(DmaFollower(data, offset), options);
+
+  const auto& bucket_ms = null_data.ogl_renderer.bucket_times_ms();
+  for (size_t i = 0; i < bucket_ms.size(); i++) {
+    null_data.interval_bucket_ms[i] += bucket_ms[i];
+  }
+  null_data.interval_render_ms += null_data.ogl_renderer.last_frame_stats().render_ms;
+  if (++null_data.interval_frames == REPORT_INTERVAL_FRAMES) {
+    flush_interval_stats();
+  }
+}
+
+void null_texture_upload_now(const u8* tpage, int mode, u32 s7_ptr) {
+  if (g_null_data) {
+    g_null_data->texture_pool->handle_upload_now(tpage, mode, g_ee_main_mem, s7_ptr);
+  }
+}
+
+void null_texture_relocate(u32 destination, u32 source, u32 format) {
+  if (g_null_data) {
+    g_null_data->texture_pool->relocate(destination, source, format);
+  }
+}
+
+void null_set_levels(const std::vector<std::string>& levels) {
+  g_null_data->loader->set_want_levels(levels);
+}
+
+void null_set_prefetch_levels(const std::vector<std::string>& levels) {
+  g_null_data->loader->set_prefetch_levels(levels);
+}
+
+void null_set_pmode_alp(float val) {
+  g_null_data->pmode_alp = val;
+}
+
+std::vector<float> null_bucket_times_ms() {
+  if (!g_null_data) {
+    return {};
+  }
+  return g_null_data->ogl_renderer.bucket_times_ms();
+}
+
+}  // namespace
+
+bool load_null_gl_functions() {
+  return gladLoadGLLoader(null_gl_get_proc);
+}
+
+const GfxRendererModule gRendererNull = {
+    null_init,                 // init
+    null_make_display,         // make_display
+    null_exit,                 // exit
+    null_vsync,                // vsync
+    null_sync_path,            // sync_path
+    null_send_chain,           // send_chain
+    null_texture_upload_now,   // texture_upload_now
+    null_texture_relocate,     // texture_relocate
+    null_set_levels,           // set_levels
+    null_set_prefetch_levels,  // set_prefetch_levels
+    null_set_pmode_alp,        // set_pmode_alp
+    null_bucket_times_ms,      // bucket_times_ms
+    GfxPipeline::Null,         // pipeline
+    "Null"                     // name
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+/*!
+ * @file null.h
+ * Headless renderer. Runs the OpenGL renderer with stubbed out OpenGL functions, without a GPU or
+ * window, and reports the CPU time spent in each bucket.
+ */
+
+#include "game/graphics/gfx.h"
+
+extern const GfxRendererModule gRendererNull;
+
+/*!
+ * Point the OpenGL functions at stubs that do nothing, so renderers can run without a context.
+ * Used by the null renderer, and by tests that run bucket renderers.
+ */
+bool load_null_gl_functions();
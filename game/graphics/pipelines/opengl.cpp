@@ -21,6 +21,7 @@
 
 #include "game/graphics/display.h"
 #include "game/graphics/gfx.h"
+#include "game/graphics/opengl_renderer/FrameTelemetry.h"
 #include "game/graphics/opengl_renderer/OpenGLRenderer.h"
 #include "game/graphics/opengl_renderer/debug_gui.h"
 #include "game/graphics/texture/TexturePool.h"
@@ -41,8 +42,6 @@
 
 #include "third-party/stb_image/stb_image.h"
 
-constexpr bool run_dma_copy = false;
-
 constexpr PerGameVersion<int> fr3_level_count(jak1::LEVEL_TOTAL, jak2::LEVEL_TOTAL);
 
 struct GraphicsData {
@@ -57,6 +56,20 @@ struct GraphicsData {
   u64 frame_idx_of_input_data = 0;
   bool has_data_to_render = false;
   FixedChunkDmaCopier dma_copier;
+  // if the chain for this frame was copied. Otherwise, the renderer reads it from game memory.
+  bool dma_was_copied = false;
+  // the game thread's time in send_chain and sync_path, protected by dma_mutex.
+  DmaStats dma_stats;
+  // chains sent by the game, and chains that made it to the screen. The difference is the number of
+  // frames in flight. Also protected by dma_mutex.
+  u64 chains_sent = 0;
+  u64 chains_presented = 0;
+  Timer chain_send_timer;    // started when the last chain was sent
+  Timer render_chain_timer;   // copy of chain_send_timer for the chain rendered this frame
+  bool rendered_chain = false;
+  double frame_latency_ms = 0;  // from send_chain to the end of the swap, for the last chain
+  // the frame_idx when vsync last returned, only used when pipelining frames.
+  u64 frame_idx_of_last_vsync = 0;
 
   // texture pool
   std::shared_ptr<TexturePool> texture_pool;
@@ -69,10 +82,17 @@ struct GraphicsData {
   OpenGlDebugGui debug_gui;
 
   FrameLimiter frame_limiter;
+  Timer frame_timer;  // time since the start of the current frame
   Timer engine_timer;
   double last_engine_time = 1. / 60.;
   float pmode_alp = 0.f;
 
+  // per-frame metrics, only if enabled with --telemetry. The totals are from the last frame, to
+  // get the uploads for each frame.
+  std::unique_ptr<FrameTelemetry> telemetry;
+  u64 telemetry_upload_bytes = 0;
+  TexturePool::UploadCounts telemetry_upload_counts;
+
   std::string imgui_log_filename, imgui_filename;
   GameVersion version;
 
@@ -267,6 +287,17 @@ static std::shared_ptr<GfxDisplay> gl_make_display(int width,
     {
       auto p = scoped_prof("startup::sdl::gfx_data_init");
       g_gfx_data = std::make_unique<GraphicsData>(game_version);
+      g_gfx_data->loader->set_memory_budget((u64)Gfx::g_debug_settings.level_memory_budget_mb *
+                                            1024 * 1024);
+      if (!Gfx::g_global_settings.telemetry_path.empty()) {
+        g_gfx_data->telemetry = std::make_unique<FrameTelemetry>(
+            Gfx::g_global_settings.telemetry_path,
+            Gfx::g_global_settings.telemetry_binary ? FrameTelemetry::Format::BINARY
+                                                    : FrameTelemetry::Format::CSV,
+            g_gfx_data->ogl_renderer.bucket_names(),
+            std::vector<std::string>(std::begin(BUCKET_CATEGORY_NAMES),
+                                     std::end(BUCKET_CATEGORY_NAMES)));
+      }
     }
     gl_inited = true;
     const char* gl_version = (const char*)glGetString(GL_VERSION);
@@ -346,6 +377,49 @@ GLDisplay::~GLDisplay() {
   }
 }
 
+/*!
+ * Add the frame that was just presented to the telemetry file. Call after the swap, before the
+ * frame timer is restarted.
+ */
+static void record_frame_telemetry(bool rendered, const DmaStats& dma_stats) {
+  auto& renderer = g_gfx_data->ogl_renderer;
+  const auto& render_stats = renderer.last_frame_stats();
+  FrameTelemetryRecord record;
+  record.frame = g_gfx_data->frame_idx;
+  record.frame_ms = g_gfx_data->frame_timer.getMs();
+  record.target_ms = 1000. * g_gfx_data->frame_limiter.target_seconds(
+                                 Gfx::g_global_settings.target_fps,
+                                 Gfx::g_global_settings.experimental_accurate_lag,
+                                 g_gfx_data->last_engine_time);
+  record.game_ms = g_gfx_data->last_engine_time * 1000.;
+  record.sync_path_wait_ms = dma_stats.sync_path_wait_ms;
+  record.send_chain_ms = dma_stats.send_chain_ms;
+  record.latency_ms = dma_stats.frame_latency_ms;
+  record.rendered = rendered;
+  if (rendered) {
+    record.render_ms = render_stats.render_ms;
+    record.loader_ms = render_stats.loader_ms;
+    record.draw_calls = render_stats.draw_calls;
+    record.triangles = render_stats.triangles;
+  }
+
+  u64 upload_bytes = g_gfx_data->loader->upload_scheduler().total_bytes();
+  record.loader_upload_kb = (upload_bytes - g_gfx_data->telemetry_upload_bytes) / 1024;
+  g_gfx_data->telemetry_upload_bytes = upload_bytes;
+  auto upload_counts = g_gfx_data->texture_pool->upload_counts();
+  record.tpage_uploads = upload_counts.tpages - g_gfx_data->telemetry_upload_counts.tpages;
+  record.texture_uploads = upload_counts.slots - g_gfx_data->telemetry_upload_counts.slots;
+  g_gfx_data->telemetry_upload_counts = upload_counts;
+
+  if (rendered) {
+    g_gfx_data->telemetry->add_frame(record, renderer.bucket_times_ms(), render_stats.category_ms);
+  } else {
+    // the renderer's times are still from the last frame it rendered.
+    g_gfx_data->telemetry->add_frame(record, std::vector<float>(renderer.bucket_names().size()),
+                                     std::vector<float>(render_stats.category_ms.size()));
+  }
+}
+
 void render_game_frame(int game_width,
                        int game_height,
                        int window_fb_width,
@@ -362,6 +436,10 @@ void render_game_frame(int game_width,
     // there's a timeout here, so imgui can still be responsive even if we don't render anything
     got_chain = g_gfx_data->dma_cv.wait_for(lock, std::chrono::milliseconds(40),
                                             [=] { return g_gfx_data->has_data_to_render; });
+    g_gfx_data->rendered_chain = got_chain;
+    if (got_chain) {
+      g_gfx_data->render_chain_timer = g_gfx_data->chain_send_timer;
+    }
   }
   // render that chain.
   if (got_chain) {
@@ -404,6 +482,11 @@ void render_game_frame(int game_width,
     options.draw_small_profiler_window =
         g_gfx_data->debug_gui.master_enable && g_gfx_data->debug_gui.small_profiler;
     options.pmode_alp_register = g_gfx_data->pmode_alp;
+    double target_seconds = g_gfx_data->frame_limiter.target_seconds(
+        Gfx::g_global_settings.target_fps, Gfx::g_global_settings.experimental_accurate_lag,
+        g_gfx_data->last_engine_time);
+    options.target_frame_time_ms = target_seconds * 1000;
+    options.frame_time_so_far_ms = g_gfx_data->frame_timer.getMs();
 
     GLint msaa_max;
     glGetIntegerv(GL_MAX_SAMPLES, &msaa_max);
@@ -411,7 +494,7 @@ void render_game_frame(int game_width,
       options.msaa_samples = msaa_max;
     }
 
-    if constexpr (run_dma_copy) {
+    if (g_gfx_data->dma_was_copied) {
       auto& chain = g_gfx_data->dma_copier.get_last_result();
       g_gfx_data->ogl_renderer.render(DmaFollower(chain.data.data(), chain.start_offset), options);
     } else {
@@ -531,7 +614,13 @@ void GLDisplay::render() {
   // render debug
   if (is_imgui_visible()) {
     auto p = scoped_prof("debug-gui");
-    g_gfx_data->debug_gui.draw(g_gfx_data->dma_copier.get_last_result().stats);
+    DmaStats dma_stats;
+    {
+      std::unique_lock<std::mutex> lock(g_gfx_data->dma_mutex);
+      dma_stats = g_gfx_data->dma_stats;
+      dma_stats.frame_latency_ms = g_gfx_data->frame_latency_ms;
+    }
+    g_gfx_data->debug_gui.draw(dma_stats);
   }
   {
     auto p = scoped_prof("imgui-render");
@@ -558,6 +647,25 @@ void GLDisplay::render() {
     glFinish();
   }
 
+  // the chain rendered this frame is now on the screen.
+  bool rendered = false;
+  DmaStats dma_stats;
+  {
+    std::unique_lock<std::mutex> lock(g_gfx_data->dma_mutex);
+    if (g_gfx_data->rendered_chain) {
+      rendered = true;
+      g_gfx_data->rendered_chain = false;
+      g_gfx_data->chains_presented++;
+      g_gfx_data->frame_latency_ms = g_gfx_data->render_chain_timer.getMs();
+    }
+    dma_stats = g_gfx_data->dma_stats;
+    dma_stats.frame_latency_ms = g_gfx_data->frame_latency_ms;
+  }
+
+  if (g_gfx_data->telemetry) {
+    record_frame_telemetry(rendered, dma_stats);
+  }
+
   // switch vsync modes, if requested
   if (Gfx::g_global_settings.vsync != Gfx::g_global_settings.old_vsync) {
     Gfx::g_global_settings.old_vsync = Gfx::g_global_settings.vsync;
@@ -568,6 +676,7 @@ void GLDisplay::render() {
 
   // Start timing for the next frame.
   g_gfx_data->debug_gui.start_frame();
+  g_gfx_data->frame_timer.start();
   prof().instant_event("ROOT");
   update_global_profiler();
 
@@ -607,10 +716,16 @@ u32 gl_vsync() {
     return 0;
   }
   std::unique_lock<std::mutex> lock(g_gfx_data->sync_mutex);
-  auto init_frame = g_gfx_data->frame_idx_of_input_data;
+  // In lockstep mode, wait until the frame with the last chain has been swapped to the screen.
+  // When pipelining, the game only waits for the next display frame to start. The game already
+  // waited in sync_path for the renderer to stop reading its DMA buffer, so it can start the next
+  // frame while the renderer is still presenting the last one. This adds a frame of latency.
+  auto init_frame = Gfx::g_global_settings.pipeline_frames ? g_gfx_data->frame_idx_of_last_vsync
+                                                           : g_gfx_data->frame_idx_of_input_data;
   g_gfx_data->sync_cv.wait(lock, [=] {
     return (MasterExit != RuntimeExitStatus::RUNNING) || g_gfx_data->frame_idx > init_frame;
   });
+  g_gfx_data->frame_idx_of_last_vsync = g_gfx_data->frame_idx;
   return g_gfx_data->frame_idx & 1;
 }
 
@@ -618,12 +733,16 @@ u32 gl_sync_path() {
   if (!g_gfx_data) {
     return 0;
   }
-  std::unique_lock<std::mutex> lock(g_gfx_data->sync_mutex);
-  g_gfx_data->last_engine_time = g_gfx_data->engine_timer.getSeconds();
-  if (!g_gfx_data->has_data_to_render) {
-    return 0;
+  Timer wait_timer;
+  {
+    std::unique_lock<std::mutex> lock(g_gfx_data->sync_mutex);
+    g_gfx_data->last_engine_time = g_gfx_data->engine_timer.getSeconds();
+    if (g_gfx_data->has_data_to_render) {
+      g_gfx_data->sync_cv.wait(lock, [=] { return !g_gfx_data->has_data_to_render; });
+    }
   }
-  g_gfx_data->sync_cv.wait(lock, [=] { return !g_gfx_data->has_data_to_render; });
+  std::unique_lock<std::mutex> lock(g_gfx_data->dma_mutex);
+  g_gfx_data->dma_stats.sync_path_wait_ms = wait_timer.getMs();
   return 0;
 }
 
@@ -641,20 +760,30 @@ void gl_send_chain(const void* data, u32 offset) {
       return;
     }
 
-    // we copy the dma data and give a copy of it to the render.
-    // the copy has a few advantages:
-    // - if the game code has a bug and corrupts the DMA buffer, the renderer won't see it.
-    // - the copied DMA is much smaller than the entire game memory, so it can be dumped to a
-    // file
-    //    separate of the entire RAM.
-    // - it verifies the DMA data is valid early on.
-    // but it may also be pretty expensive. Both the renderer and the game wait on this to
-    // complete.
+    // By default, the renderer reads the chain directly from game memory. The game builds the next
+    // frame in its other DMA buffer, and waits in sync_path for the renderer to finish before
+    // reusing this one, so nothing needs to wait here.
 
-    // The renderers should just operate on DMA chains, so eliminating this step in the future
-    // may be easy.
+    // The copy is still available for debugging. It has a few advantages:
+    // - if the game code has a bug and corrupts the DMA buffer, the renderer won't see it.
+    // - it can verify the DMA data is valid early on.
+    // but it's expensive, and both the renderer and the game wait on it to complete.
+    Timer send_timer;
+    bool copy = g_gfx_data->debug_gui.copy_dma || g_gfx_data->debug_gui.verify_dma_copy;
+    if (copy) {
+      g_gfx_data->dma_copier.run(data, offset, g_gfx_data->debug_gui.verify_dma_copy);
+    } else {
+      g_gfx_data->dma_copier.set_input_data(data, offset, false);
+    }
+    g_gfx_data->dma_was_copied = copy;
 
-    g_gfx_data->dma_copier.set_input_data(data, offset, run_dma_copy);
+    double sync_path_wait_ms = g_gfx_data->dma_stats.sync_path_wait_ms;
+    g_gfx_data->dma_stats = copy ? g_gfx_data->dma_copier.get_last_result().stats : DmaStats();
+    g_gfx_data->dma_stats.sync_path_wait_ms = sync_path_wait_ms;
+    g_gfx_data->dma_stats.send_chain_ms = send_timer.getMs();
+    g_gfx_data->chain_send_timer.start();
+    g_gfx_data->chains_sent++;
+    g_gfx_data->dma_stats.frames_in_flight = g_gfx_data->chains_sent - g_gfx_data->chains_presented;
 
     g_gfx_data->has_data_to_render = true;
     g_gfx_data->dma_cv.notify_all();
@@ -690,21 +819,34 @@ void gl_set_levels(const std::vector<std::string>& levels) {
   g_gfx_data->loader->set_want_levels(levels);
 }
 
+void gl_set_prefetch_levels(const std::vector<std::string>& levels) {
+  g_gfx_data->loader->set_prefetch_levels(levels);
+}
+
 void gl_set_pmode_alp(float val) {
   g_gfx_data->pmode_alp = val;
 }
 
+std::vector<float> gl_bucket_times_ms() {
+  if (!g_gfx_data) {
+    return {};
+  }
+  return g_gfx_data->ogl_renderer.bucket_times_ms();
+}
+
 const GfxRendererModule gRendererOpenGL = {
-    gl_init,                // init
-    gl_make_display,        // make_display
-    gl_exit,                // exit
-    gl_vsync,               // vsync
-    gl_sync_path,           // sync_path
-    gl_send_chain,          // send_chain
-    gl_texture_upload_now,  // texture_upload_now
-    gl_texture_relocate,    // texture_relocate
-    gl_set_levels,          // set_levels
-    gl_set_pmode_alp,       // set_pmode_alp
-    GfxPipeline::OpenGL,    // pipeline
-    "OpenGL 4.3"            // name
+    gl_init,                 // init
+    gl_make_display,         // make_display
+    gl_exit,                 // exit
+    gl_vsync,                // vsync
+    gl_sync_path,            // sync_path
+    gl_send_chain,           // send_chain
+    gl_texture_upload_now,   // texture_upload_now
+    gl_texture_relocate,     // texture_relocate
+    gl_set_levels,           // set_levels
+    gl_set_prefetch_levels,  // set_prefetch_levels
+    gl_set_pmode_alp,        // set_pmode_alp
+    gl_bucket_times_ms,      // bucket_times_ms
+    GfxPipeline::OpenGL,     // pipeline
+    "OpenGL 4.3"             // name
 };
@@ -1,11 +1,96 @@
 #include "TextureConverter.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "common/texture/texture_conversion.h"
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
 
 #include "third-party/fmt/core.h"
 
+namespace {
+
+// every format has 8 kB pages.
+constexpr u32 PAGE_BYTES = 8192;
+
+/*!
+ * The offset of each pixel within a GS page, for each format. The swizzle within a page doesn't
+ * depend on the buffer width, so the address of a pixel is just the page's address plus the entry
+ * for (x % page width, y % page height). The tables are built with the *_addr functions, so they
+ * match them exactly.
+ */
+struct PageSwizzleTables {
+  u16 ct16[64][64];    // bytes
+  u16 t8[64][128];     // bytes
+  u16 t4[128][128];    // half bytes
+  u8 channel5to8[32];  // the color conversion in rgba16_to_rgba32
+
+  PageSwizzleTables() {
+    for (u32 y = 0; y < 64; y++) {
+      for (u32 x = 0; x < 64; x++) {
+        ct16[y][x] = psmct16_addr(x, y, 64);
+      }
+      for (u32 x = 0; x < 128; x++) {
+        t8[y][x] = psmt8_addr(x, y, 128);
+      }
+    }
+    for (u32 y = 0; y < 128; y++) {
+      for (u32 x = 0; x < 128; x++) {
+        t4[y][x] = psmt4_addr_half_byte(x, y, 128);
+      }
+    }
+    for (u32 i = 0; i < 32; i++) {
+      channel5to8[i] = rgba16_to_rgba32(i) & 0xff;
+    }
+  }
+
+  // same as rgba16_to_rgba32
+  u32 convert_rgba16(u16 in) const {
+    u32 r = channel5to8[in & 0b11111];
+    u32 g = channel5to8[(in >> 5) & 0b11111];
+    u32 b = channel5to8[(in >> 10) & 0b11111];
+    u32 a = (in & 0x8000) ? 0x80 : 0;
+    return (a << 24) | (b << 16) | (g << 8) | r;
+  }
+};
+
+const PageSwizzleTables& page_tables() {
+  static PageSwizzleTables tables;
+  return tables;
+}
+
+/*!
+ * Convert a texture with a W x H page swizzle, one page-wide strip of each row at a time, so the
+ * page address and table row are only computed once per strip. get(addr, x) reads the pixel at the
+ * address from the table (plus base), and returns it as RGBA8888.
+ */
+template <u32 W, u32 H, typename Get>
+void convert_by_page(u32* out,
+                     u32 base,
+                     u32 read_width,
+                     u32 w,
+                     u32 h,
+                     const u16 (&table)[H][W],
+                     u32 page_size,
+                     Get&& get) {
+  // can be 0 for narrow textures, which puts all pages of a column at the same address.
+  // this is what the address functions do, so we do the same.
+  u32 pages_per_row = read_width / W;
+  for (u32 y = 0; y < h; y++) {
+    const u16* table_row = table[y % H];
+    u32 row_base = base + (y / H) * pages_per_row * page_size;
+    for (u32 page_x0 = 0; page_x0 < w; page_x0 += W) {
+      u32 page_base = row_base + (page_x0 / W) * page_size;
+      u32 end = std::min(W, w - page_x0);
+      for (u32 x = 0; x < end; x++) {
+        *out++ = get(page_base + table_row[x]);
+      }
+    }
+  }
+}
+}  // namespace
+
 TextureConverter::TextureConverter() {
   m_vram.resize(4 * 1024 * 1024);
 }
@@ -25,15 +110,15 @@ void TextureConverter::upload(const u8* data, u32 dest, u32 size_vram_words) {
   }
 }
 
-void TextureConverter::download_rgba8888(u8* result,
-                                         u32 vram_addr,
-                                         u32 goal_tex_width,
-                                         u32 w,
-                                         u32 h,
-                                         u32 psm,
-                                         u32 clut_psm,
-                                         u32 clut_vram_addr,
-                                         u32 expected_size_bytes) {
+void TextureConverter::download_rgba8888_slow(u8* result,
+                                              u32 vram_addr,
+                                              u32 goal_tex_width,
+                                              u32 w,
+                                              u32 h,
+                                              u32 psm,
+                                              u32 clut_psm,
+                                              u32 clut_vram_addr,
+                                              u32 expected_size_bytes) {
   u32 out_offset = 0;
   if (psm == int(PSM::PSMT8) && clut_psm == int(CPSM::PSMCT32)) {
     // width is like the TEX0 register, in 64 texel units.
@@ -200,6 +285,91 @@ void TextureConverter::download_rgba8888(u8* result,
   ASSERT(out_offset == expected_size_bytes);
 }
 
+/*!
+ * Look up every color of a CLUT once, in the same way as download_rgba8888_slow does per pixel.
+ */
+void TextureConverter::resolve_clut(u32* palette,
+                                    u32 count,
+                                    u32 clut_psm,
+                                    u32 clut_vram_addr) const {
+  for (u32 value = 0; value < count; value++) {
+    u32 clx, cly;
+    if (count == 256) {
+      // See GS manual 2.7.3 CLUT Storage Mode, IDTEX8 in CSM1 mode.
+      u32 clut_chunk = value / 16;
+      u32 off_in_chunk = value % 16;
+      clx = (clut_chunk & 1) ? 8 : 0;
+      cly = (clut_chunk >> 1) * 2;
+      if (off_in_chunk >= 8) {
+        off_in_chunk -= 8;
+        cly++;
+      }
+      clx += off_in_chunk;
+    } else {
+      // IDTEX4 in CSM1 mode.
+      clx = value & 0x7;
+      cly = value >> 3;
+    }
+
+    if (clut_psm == int(CPSM::PSMCT32)) {
+      u32 clut_addr = psmct32_addr(clx, cly, 64) + clut_vram_addr * 256;
+      memcpy(&palette[value], m_vram.data() + clut_addr, 4);
+    } else {
+      ASSERT(clut_psm == int(CPSM::PSMCT16));
+      u32 clut_addr = psmct16_addr(clx, cly, 64) + clut_vram_addr * 256;
+      u16 clut_value;
+      memcpy(&clut_value, m_vram.data() + clut_addr, 2);
+      palette[value] = page_tables().convert_rgba16(clut_value);
+    }
+  }
+}
+
+/*!
+ * Convert a texture in VRAM to RGBA8888. Same result as download_rgba8888_slow, but the swizzle is
+ * looked up from per-page tables, and the CLUT is converted to a palette once per texture.
+ */
+void TextureConverter::download_rgba8888(u8* result,
+                                         u32 vram_addr,
+                                         u32 goal_tex_width,
+                                         u32 w,
+                                         u32 h,
+                                         u32 psm,
+                                         u32 clut_psm,
+                                         u32 clut_vram_addr,
+                                         u32 expected_size_bytes) {
+  ASSERT(w * h * 4 == expected_size_bytes);
+  const auto& tables = page_tables();
+  const u8* vram = m_vram.data();
+  u32* out = (u32*)result;
+  // width is like the TEX0 register, in 64 texel units.
+  u32 read_width = 64 * goal_tex_width;
+  u32 palette[256];
+
+  if (psm == int(PSM::PSMT8) &&
+      (clut_psm == int(CPSM::PSMCT32) || clut_psm == int(CPSM::PSMCT16))) {
+    resolve_clut(palette, 256, clut_psm, clut_vram_addr);
+    convert_by_page(out, vram_addr * 256, read_width, w, h, tables.t8, PAGE_BYTES,
+                    [&](u32 addr) { return palette[vram[addr]]; });
+  } else if (psm == int(PSM::PSMT4) &&
+             (clut_psm == int(CPSM::PSMCT32) || clut_psm == int(CPSM::PSMCT16))) {
+    resolve_clut(palette, 16, clut_psm, clut_vram_addr);
+    // half byte addressing, the odd addresses are the upper 4 bits.
+    convert_by_page(out, vram_addr * 512, read_width, w, h, tables.t4, PAGE_BYTES * 2,
+                    [&](u32 addr4) {
+                      return palette[(vram[addr4 / 2] >> ((addr4 & 1) * 4)) & 0xf];
+                    });
+  } else if (psm == int(PSM::PSMCT16) && clut_psm == 0) {
+    convert_by_page(out, vram_addr * 256, read_width, w, h, tables.ct16, PAGE_BYTES,
+                    [&](u32 addr) {
+                      u16 value;
+                      memcpy(&value, vram + addr, 2);
+                      return tables.convert_rgba16(value);
+                    });
+  } else {
+    ASSERT(false);
+  }
+}
+
 void TextureConverter::serialize(Serializer& ser) {
   ser.from_pod_vector(&m_vram);
 }
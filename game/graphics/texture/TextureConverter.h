@@ -18,8 +18,19 @@ class TextureConverter {
                          u32 clut_psm,
                          u32 clut_vram_addr,
                          u32 expected_size_bytes);
+  // reference version of download_rgba8888, which computes the address of every pixel.
+  void download_rgba8888_slow(u8* result,
+                              u32 vram_addr,
+                              u32 goal_tex_width,
+                              u32 w,
+                              u32 h,
+                              u32 psm,
+                              u32 clut_psm,
+                              u32 clut_vram_addr,
+                              u32 expected_size_bytes);
   void serialize(Serializer& ser);
 
  private:
+  void resolve_clut(u32* palette, u32 count, u32 clut_psm, u32 clut_vram_addr) const;
   std::vector<u8> m_vram;
 };
@@ -84,30 +84,54 @@ GpuTexture* TexturePool::give_texture(const TextureInput& in) {
 }
 
 GpuTexture* TexturePool::give_texture_and_load_to_vram(const TextureInput& in, u32 vram_slot) {
+  auto lk = lock();
   auto tex = give_texture(in);
-  move_existing_to_vram(tex, vram_slot);
+  move_to_vram(tex, vram_slot);
   return tex;
 }
 
 void TexturePool::move_existing_to_vram(GpuTexture* tex, u32 slot_addr) {
+  auto lk = lock();
+  move_to_vram(tex, slot_addr);
+}
+
+void TexturePool::move_to_vram(GpuTexture* tex, u32 slot_addr) {
   ASSERT(!tex->is_placeholder);
   ASSERT(!tex->gpu_textures.empty());
   auto& slot = m_textures[slot_addr];
   if (std::find(tex->slots.begin(), tex->slots.end(), slot_addr) == tex->slots.end()) {
     tex->slots.push_back(slot_addr);
   }
-  if (slot.source) {
-    if (slot.source == tex) {
-      // we already have it, no need to do anything
-    } else {
-      slot.source->remove_slot(slot_addr);
-      slot.source = tex;
-      slot.gpu_texture = tex->gpu_textures.front().gl;
-    }
-  } else {
-    slot.source = tex;
-    slot.gpu_texture = tex->gpu_textures.front().gl;
+  GpuTexture* old_source = slot.source.load(std::memory_order_relaxed);
+  if (old_source == tex) {
+    // we already have it, no need to do anything
+    return;
+  }
+  if (old_source) {
+    old_source->remove_slot(slot_addr);
   }
+  slot.set(tex, tex->gpu_textures.front().gl);
+  m_slot_uploads.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::unique_lock<std::mutex> TexturePool::lock() {
+  m_lock_count.fetch_add(1, std::memory_order_relaxed);
+  std::unique_lock<std::mutex> lk(m_mutex, std::try_to_lock);
+  if (!lk.owns_lock()) {
+    Timer wait_timer;
+    lk.lock();
+    m_contended_lock_count.fetch_add(1, std::memory_order_relaxed);
+    m_lock_wait_ns.fetch_add(wait_timer.getNs(), std::memory_order_relaxed);
+  }
+  return lk;
+}
+
+TexturePool::LockStats TexturePool::lock_stats() const {
+  LockStats stats;
+  stats.locks = m_lock_count.load(std::memory_order_relaxed);
+  stats.contended = m_contended_lock_count.load(std::memory_order_relaxed);
+  stats.wait_ms = m_lock_wait_ns.load(std::memory_order_relaxed) / 1.e6;
+  return stats;
 }
 
 void TexturePool::refresh_links(GpuTexture& texture) {
@@ -117,13 +141,14 @@ void TexturePool::refresh_links(GpuTexture& texture) {
   for (auto slot : texture.slots) {
     auto& t = m_textures[slot];
     ASSERT(t.source == &texture);
-    t.gpu_texture = tex_to_use;
+    t.gpu_texture.store(tex_to_use, std::memory_order_relaxed);
   }
 
   for (auto slot : texture.mt4hh_slots) {
-    for (auto& tex : m_mt4hh_textures) {
+    for (int i = 0; i < m_mt4hh_count.load(std::memory_order_relaxed); i++) {
+      auto& tex = m_mt4hh_textures[i];
       if (tex.slot == slot) {
-        tex.ref.gpu_texture = tex_to_use;
+        tex.ref.gpu_texture.store(tex_to_use, std::memory_order_relaxed);
       }
     }
   }
@@ -175,7 +200,6 @@ void GpuTexture::add_slot(u32 slot) {
  * multiple frames.
  */
 void TexturePool::handle_upload_now(const u8* tpage, int mode, const u8* memory_base, u32 s7_ptr) {
-  std::unique_lock<std::mutex> lk(m_mutex);
   // extract the texture-page object. This is just a description of the page data.
   GoalTexturePage texture_page;
   memcpy(&texture_page, tpage, sizeof(GoalTexturePage));
@@ -196,6 +220,16 @@ void TexturePool::handle_upload_now(const u8* tpage, int mode, const u8* memory_
     lg::error("TexturePool skipping upload now with mode {}.", mode);
     return;
   }
+  m_tpage_uploads.fetch_add(1, std::memory_order_relaxed);
+
+  // find every slot the upload touches before locking. This only reads game memory, so the
+  // renderer doesn't have to wait for it.
+  struct SlotUpload {
+    PcTextureId id;
+    u32 slot;
+    u32 name_ptr;
+  };
+  std::vector<SlotUpload> uploads;
 
   // loop over all texture in the tpage and download them.
   for (int tex_idx = 0; tex_idx < texture_page.length; tex_idx++) {
@@ -204,48 +238,75 @@ void TexturePool::handle_upload_now(const u8* tpage, int mode, const u8* memory_
       // each texture may have multiple mip levels.
       for (int mip_idx = 0; mip_idx < tex.num_mips; mip_idx++) {
         if (has_segment[tex.segment_of_mip(mip_idx)]) {
-          PcTextureId current_id(texture_page.id, tex_idx);
-          if (!m_id_to_name.lookup_existing(current_id)) {
-            auto name = std::string(goal_string(texture_page.name_ptr, memory_base)) +
-                        goal_string(tex.name_ptr, memory_base);
-            *m_id_to_name.lookup_or_insert(current_id).first = name;
-            m_name_to_id[name] = current_id;
-          }
-
-          auto& slot = m_textures[tex.dest[mip_idx]];
-
-          if (slot.source) {
-            if (slot.source->tex_id == current_id) {
-              // we already have it, no need to do anything
-            } else {
-              slot.source->remove_slot(tex.dest[mip_idx]);
-              slot.source = get_gpu_texture_for_slot(current_id, tex.dest[mip_idx]);
-              ASSERT(slot.gpu_texture != (GLuint)-1);
-            }
-          } else {
-            slot.source = get_gpu_texture_for_slot(current_id, tex.dest[mip_idx]);
-            ASSERT(slot.gpu_texture != (GLuint)-1);
-          }
+          uploads.push_back(
+              {PcTextureId(texture_page.id, tex_idx), tex.dest[mip_idx], tex.name_ptr});
         }
       }
     } else {
       // texture was #f, skip it.
     }
   }
+
+  // then apply them all at once.
+  auto lk = lock();
+  for (auto& upload : uploads) {
+    if (!m_id_to_name.lookup_existing(upload.id)) {
+      auto name = std::string(goal_string(texture_page.name_ptr, memory_base)) +
+                  goal_string(upload.name_ptr, memory_base);
+      *m_id_to_name.lookup_or_insert(upload.id).first = name;
+      m_name_to_id[name] = upload.id;
+    }
+
+    auto& slot = m_textures[upload.slot];
+    GpuTexture* old_source = slot.source.load(std::memory_order_relaxed);
+    if (old_source) {
+      if (old_source->tex_id == upload.id) {
+        // we already have it, no need to do anything
+        continue;
+      }
+      old_source->remove_slot(upload.slot);
+    }
+    // sets the slot's gpu_texture, so the source can be published after.
+    auto* source = get_gpu_texture_for_slot(upload.id, upload.slot);
+    ASSERT(slot.gpu_texture != (GLuint)-1);
+    slot.source.store(source, std::memory_order_release);
+    m_slot_uploads.fetch_add(1, std::memory_order_relaxed);
+  }
 }
 
 void TexturePool::relocate(u32 destination, u32 source, u32 format) {
-  std::unique_lock<std::mutex> lk(m_mutex);
+  auto lk = lock();
   GpuTexture* src = lookup_gpu_texture(source);
   ASSERT(src);
   if (format == 44) {
-    m_mt4hh_textures.emplace_back();
-    m_mt4hh_textures.back().slot = destination;
-    m_mt4hh_textures.back().ref.source = src;
-    m_mt4hh_textures.back().ref.gpu_texture = src->gpu_textures.at(0).gl;
-    src->mt4hh_slots.push_back(destination);
+    int count = m_mt4hh_count.load(std::memory_order_relaxed);
+    Mt4hhTexture* entry = nullptr;
+    for (int i = 0; i < count; i++) {
+      if (m_mt4hh_textures[i].slot == destination) {
+        entry = &m_mt4hh_textures[i];
+      }
+    }
+
+    if (entry) {
+      // relocated here again, replace the old texture.
+      auto* old_source = entry->ref.source.load(std::memory_order_relaxed);
+      if (old_source != src) {
+        auto& old_slots = old_source->mt4hh_slots;
+        old_slots.erase(std::remove(old_slots.begin(), old_slots.end(), destination),
+                        old_slots.end());
+        src->mt4hh_slots.push_back(destination);
+      }
+      entry->ref.set(src, src->gpu_textures.at(0).gl);
+    } else {
+      ASSERT_MSG(count < MAX_MT4HH_TEXTURES, "too many mt4hh textures");
+      entry = &m_mt4hh_textures[count];
+      entry->slot = destination;
+      entry->ref.set(src, src->gpu_textures.at(0).gl);
+      src->mt4hh_slots.push_back(destination);
+      m_mt4hh_count.store(count + 1, std::memory_order_release);
+    }
   } else {
-    move_existing_to_vram(src, destination);
+    move_to_vram(src, destination);
   }
 }
 
@@ -258,22 +319,25 @@ GpuTexture* TexturePool::get_gpu_texture_for_slot(PcTextureId id, u32 slot) {
     placeholder.slots.push_back(slot);
 
     // auto r = m_loaded_textures.insert({name, placeholder});
-    m_textures[slot].gpu_texture = m_placeholder_texture_id;
+    m_textures[slot].gpu_texture.store(m_placeholder_texture_id, std::memory_order_relaxed);
     return it.first;
   } else {
     auto result = it.first;
     result->add_slot(slot);
-    m_textures[slot].gpu_texture =
-        result->is_placeholder ? m_placeholder_texture_id : result->gpu_textures.at(0).gl;
+    m_textures[slot].gpu_texture.store(
+        result->is_placeholder ? m_placeholder_texture_id : result->gpu_textures.at(0).gl,
+        std::memory_order_relaxed);
     return result;
   }
 }
 
 std::optional<u64> TexturePool::lookup_mt4hh(u32 location) {
-  for (auto& t : m_mt4hh_textures) {
+  int count = m_mt4hh_count.load(std::memory_order_acquire);
+  for (int i = 0; i < count; i++) {
+    auto& t = m_mt4hh_textures[i];
     if (t.slot == location) {
-      if (t.ref.source) {
-        return t.ref.gpu_texture;
+      if (t.ref.source.load(std::memory_order_acquire)) {
+        return t.ref.gpu_texture.load(std::memory_order_relaxed);
       }
     }
   }
@@ -319,18 +383,17 @@ void TexturePool::draw_debug_window() {
   std::regex regex(use_regex ? m_regex_input : ".*");
 
   for (size_t i = 0; i < m_textures.size(); i++) {
-    auto& record = m_textures[i];
+    auto* source = m_textures[i].source.load(std::memory_order_acquire);
     total_textures++;
-    if (record.source) {
-      if (!use_regex || std::regex_search(get_debug_texture_name(record.source->tex_id), regex)) {
+    if (source) {
+      if (!use_regex || std::regex_search(get_debug_texture_name(source->tex_id), regex)) {
         ImGui::PushID(id++);
-        draw_debug_for_tex(get_debug_texture_name(record.source->tex_id), record.source, i);
+        draw_debug_for_tex(get_debug_texture_name(source->tex_id), source, i);
         ImGui::PopID();
         total_displayed_textures++;
       }
-      if (!record.source->gpu_textures.empty()) {
-        total_vram_bytes +=
-            record.source->w * record.source->h * 4;  // todo, if we support other formats
+      if (!source->gpu_textures.empty()) {
+        total_vram_bytes += source->w * source->h * 4;  // todo, if we support other formats
       }
 
       total_uploaded_textures++;
@@ -341,6 +404,10 @@ void TexturePool::draw_debug_window() {
   ImGui::Text("Total Textures: %d Uploaded: %d Shown: %d VRAM: %.3f MB", total_textures,
               total_uploaded_textures, total_displayed_textures,
               (float)total_vram_bytes / (1024 * 1024));
+  auto locks = lock_stats();
+  ImGui::Text("Locks: %lld, waited for %lld (%.1f%%), %.2f ms total", (long long)locks.locks,
+              (long long)locks.contended,
+              locks.locks ? 100. * locks.contended / locks.locks : 0., locks.wait_ms);
 }
 
 void TexturePool::draw_debug_for_tex(const std::string& name, GpuTexture* tex, u32 slot) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -195,10 +196,18 @@ struct GpuTexture {
  * If the source is nullptr, the game has not loaded anything to this address.
  * If the game has loaded something, but the loader hasn't loaded the converted texture, the
  * source will be non-null and the gpu_texture will be a placeholder that is safe to use.
+ *
+ * Renderers read slots without locking. Writers hold the pool lock, and store gpu_texture before
+ * source, so a reader that sees a source will also see a usable gpu_texture.
  */
 struct TextureVRAMReference {
-  GLuint gpu_texture = -1;  // the OpenGL texture to use when rendering.
-  GpuTexture* source = nullptr;
+  std::atomic<GLuint> gpu_texture{(GLuint)-1};  // the OpenGL texture to use when rendering.
+  std::atomic<GpuTexture*> source{nullptr};
+
+  void set(GpuTexture* src, GLuint gl) {
+    gpu_texture.store(gl, std::memory_order_relaxed);
+    source.store(src, std::memory_order_release);
+  }
 };
 
 /*!
@@ -289,7 +298,9 @@ struct GoalTexturePage {
  * Moving textures around should be done with locking. (the game EE thread and the loader run
  * simultaneously)
  *
- * Lookups can be done without locking.
+ * Lookups can be done without locking, and never wait: each VRAM slot is read with a single atomic
+ * load. Uploads from the game find all the slots they change before locking, so the lock is only
+ * held to apply the changes.
  * It is safe for renderers to use textures without worrying about locking - OpenGL textures
  * themselves are only removed from the rendering thread.
  *
@@ -314,13 +325,14 @@ class TexturePool {
    */
   std::optional<u64> lookup(u32 location) {
     auto& t = m_textures[location];
-    if (t.source) {
+    auto* source = t.source.load(std::memory_order_acquire);
+    if (source) {
       if constexpr (EXTRA_TEX_DEBUG) {
-        if (t.source->is_placeholder) {
+        if (source->is_placeholder) {
           ASSERT(t.gpu_texture == m_placeholder_texture_id);
         } else {
           bool fnd = false;
-          for (auto& tt : t.source->gpu_textures) {
+          for (auto& tt : source->gpu_textures) {
             if (tt.gl == t.gpu_texture) {
               fnd = true;
               break;
@@ -329,7 +341,7 @@ class TexturePool {
           ASSERT(fnd);
         }
       }
-      return t.gpu_texture;
+      return t.gpu_texture.load(std::memory_order_relaxed);
     } else {
       return {};
     }
@@ -342,7 +354,9 @@ class TexturePool {
    * You should probably not use this to lookup textures that could be uploaded with
    * handle_upload_now.
    */
-  GpuTexture* lookup_gpu_texture(u32 location) { return m_textures[location].source; }
+  GpuTexture* lookup_gpu_texture(u32 location) {
+    return m_textures[location].source.load(std::memory_order_acquire);
+  }
   std::optional<u64> lookup_mt4hh(u32 location);
   u64 get_placeholder_texture() { return m_placeholder_texture_id; }
   void draw_debug_window();
@@ -353,7 +367,25 @@ class TexturePool {
   }
   void move_existing_to_vram(GpuTexture* tex, u32 slot_addr);
 
-  std::mutex& mutex() { return m_mutex; }
+  // lock before calling give_texture or unload_texture. The other functions lock for you.
+  std::unique_lock<std::mutex> lock();
+
+  struct LockStats {
+    u64 locks = 0;
+    u64 contended = 0;  // had to wait for another thread
+    double wait_ms = 0;
+  };
+  LockStats lock_stats() const;
+
+  // totals since startup, safe to read from any thread.
+  struct UploadCounts {
+    u64 tpages = 0;  // calls to handle_upload_now
+    u64 slots = 0;   // VRAM slots that were given a different texture
+  };
+  UploadCounts upload_counts() const {
+    return {m_tpage_uploads.load(std::memory_order_relaxed),
+            m_slot_uploads.load(std::memory_order_relaxed)};
+  }
   PcTextureId allocate_pc_port_texture(GameVersion version);
 
   std::string get_debug_texture_name(PcTextureId id);
@@ -361,14 +393,19 @@ class TexturePool {
  private:
   void refresh_links(GpuTexture& texture);
   GpuTexture* get_gpu_texture_for_slot(PcTextureId id, u32 slot);
+  void move_to_vram(GpuTexture* tex, u32 slot_addr);
 
   char m_regex_input[256] = "";
   std::array<TextureVRAMReference, 1024 * 1024 * 4 / 256> m_textures;
+  // only a few textures (the font) are relocated to mt4hh. This is a fixed array so it can be read
+  // without locking: entries are filled in before m_mt4hh_count is increased, and never removed.
+  static constexpr int MAX_MT4HH_TEXTURES = 64;
   struct Mt4hhTexture {
     TextureVRAMReference ref;
-    u32 slot;
+    u32 slot = 0;
   };
-  std::vector<Mt4hhTexture> m_mt4hh_textures;
+  std::array<Mt4hhTexture, MAX_MT4HH_TEXTURES> m_mt4hh_textures;
+  std::atomic<int> m_mt4hh_count = 0;
 
   std::vector<u32> m_placeholder_data;
   u64 m_placeholder_texture_id = 0;
@@ -383,5 +420,11 @@ class TexturePool {
   u32 m_next_pc_texture_to_allocate = 0;
   u32 m_tpage_dir_size = 0;
 
+  std::atomic<u64> m_tpage_uploads = 0;
+  std::atomic<u64> m_slot_uploads = 0;
+  std::atomic<u64> m_lock_count = 0;
+  std::atomic<u64> m_contended_lock_count = 0;
+  std::atomic<u64> m_lock_wait_ns = 0;
+
   std::mutex m_mutex;
 };
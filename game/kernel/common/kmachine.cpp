@@ -355,9 +355,11 @@ void DecodeTime(u32 ptr) {
 
 void vif_interrupt_callback(int bucket_id) {
   // added for the PC port for faking VIF interrupts from the graphics system.
+  Gfx::begin_vif_interrupt(bucket_id);
   if (vif1_interrupt_handler && MasterExit == RuntimeExitStatus::RUNNING) {
     call_goal(Ptr<Function>(vif1_interrupt_handler), bucket_id, 0, 0, s7.offset, g_ee_main_mem);
   }
+  Gfx::end_vif_interrupt();
 }
 
 /// PC PORT FUNCTIONS BEGIN
@@ -426,19 +428,19 @@ void pc_memmove(u32 dst, u32 src, u32 size) {
 
 void send_gfx_dma_chain(u32 /*bank*/, u32 chain) {
   if (Gfx::GetCurrentRenderer()) {
-    Gfx::GetCurrentRenderer()->send_chain(g_ee_main_mem, chain);
+    Gfx::send_chain(g_ee_main_mem, chain);
   }
 }
 
 void pc_texture_upload_now(u32 page, u32 mode) {
   if (Gfx::GetCurrentRenderer()) {
-    Gfx::GetCurrentRenderer()->texture_upload_now(Ptr<u8>(page).c(), mode, s7.offset);
+    Gfx::texture_upload_now(Ptr<u8>(page).c(), mode, s7.offset);
   }
 }
 
 void pc_texture_relocate(u32 dst, u32 src, u32 format) {
   if (Gfx::GetCurrentRenderer()) {
-    Gfx::GetCurrentRenderer()->texture_relocate(dst, src, format);
+    Gfx::texture_relocate(dst, src, format);
   }
 }
 
@@ -534,7 +534,22 @@ void pc_set_levels(u32 l0, u32 l1) {
     levels.push_back(l1s);
   }
 
-  Gfx::GetCurrentRenderer()->set_levels(levels);
+  Gfx::set_levels(levels);
+}
+
+void pc_prefetch_levels(u32 l0, u32 l1) {
+  if (!Gfx::GetCurrentRenderer()) {
+    return;
+  }
+  std::vector<std::string> levels;
+  for (auto l : {l0, l1}) {
+    std::string ls = Ptr<String>(l).c()->data();
+    if (ls != "none" && ls != "#f") {
+      levels.push_back(ls);
+    }
+  }
+
+  Gfx::set_prefetch_levels(levels);
 }
 
 void InitMachine_PCPort() {
@@ -553,6 +568,9 @@ void InitMachine_PCPort() {
   // Called from the game thread at each frame to tell the PC rendering code which levels to start
   // loading. The loader internally handles locking.
   make_function_symbol_from_c("__pc-set-levels", (void*)pc_set_levels);
+  // Called from the game thread with levels that are nearby, but not loaded. The PC rendering code
+  // can read them ahead of time, so they are ready sooner when the game wants them.
+  make_function_symbol_from_c("__pc-prefetch-levels", (void*)pc_prefetch_levels);
 
   make_function_symbol_from_c("pc-discord-rpc-update", (void*)update_discord_rpc);
 
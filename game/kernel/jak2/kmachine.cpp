@@ -648,7 +648,23 @@ void pc_set_levels(u32 lev_list) {
     }
   }
 
-  Gfx::GetCurrentRenderer()->set_levels(levels);
+  Gfx::set_levels(levels);
+}
+
+void pc_prefetch_levels(u32 lev_list, u32 count) {
+  if (!Gfx::GetCurrentRenderer()) {
+    return;
+  }
+  std::vector<std::string> levels;
+  for (u32 i = 0; i < count; i++) {
+    u32 lev = *Ptr<u32>(lev_list + i * 4);
+    std::string ls = Ptr<String>(lev).c()->data();
+    if (ls != "none" && ls != "#f" && ls != "") {
+      levels.push_back(ls);
+    }
+  }
+
+  Gfx::set_prefetch_levels(levels);
 }
 
 void init_autosplit_struct() {
@@ -691,6 +707,7 @@ void InitMachine_PCPort() {
       make_string_from_c);
 
   make_function_symbol_from_c("__pc-set-levels", (void*)pc_set_levels);
+  make_function_symbol_from_c("__pc-prefetch-levels", (void*)pc_prefetch_levels);
   make_function_symbol_from_c("__pc-get-tex-remap", (void*)lookup_jak2_texture_dest_offset);
   make_function_symbol_from_c("pc-init-autosplitter-struct", (void*)init_autosplit_struct);
 
@@ -90,6 +90,12 @@ int main(int argc, char** argv) {
   bool verbose_logging = false;
   bool disable_avx2 = false;
   bool disable_display = false;
+  bool null_renderer = false;
+  std::string gfx_capture_path = "";
+  int gfx_capture_skip_frames = 0;
+  int gfx_capture_frames = 300;
+  std::string telemetry_path = "";
+  bool telemetry_binary = false;
   bool enable_debug_vm = false;
   bool enable_profiling = false;
   std::string gpu_test = "";
@@ -106,6 +112,18 @@ int main(int argc, char** argv) {
       "Specify port number for listener connection (default is 8112 for Jak 1 and 8113 for Jak 2)");
   app.add_flag("--no-avx2", verbose_logging, "Disable AVX2 for testing");
   app.add_flag("--no-display", disable_display, "Disable video display");
+  app.add_flag("--null-renderer", null_renderer,
+               "Process graphics on the CPU without a display or GPU, and report the time spent");
+  app.add_option("--gfx-capture", gfx_capture_path,
+                 "Record graphics input to this file, for replaying with gfx_replay");
+  app.add_option("--gfx-capture-skip", gfx_capture_skip_frames,
+                 "Number of frames to wait before starting the graphics capture");
+  app.add_option("--gfx-capture-frames", gfx_capture_frames,
+                 "Number of frames to record in the graphics capture (default 300)");
+  app.add_option("--telemetry", telemetry_path,
+                 "Write renderer timings for every frame to this file, and a summary at exit");
+  app.add_flag("--telemetry-binary", telemetry_binary,
+               "Write telemetry in a binary format with times for every bucket, instead of CSV");
   app.add_flag("--vm", enable_debug_vm, "Enable debug PS2 VM (defaulted to off)");
   app.add_flag("--profile", enable_profiling, "Enables profiling immediately from startup");
   app.add_option("--gpu-test", gpu_test,
@@ -142,6 +160,12 @@ int main(int argc, char** argv) {
   GameLaunchOptions game_options;
   game_options.disable_debug_vm = !enable_debug_vm;
   game_options.disable_display = disable_display;
+  game_options.null_renderer = null_renderer;
+  game_options.gfx_capture_path = gfx_capture_path;
+  game_options.gfx_capture_skip_frames = gfx_capture_skip_frames;
+  game_options.gfx_capture_frames = gfx_capture_frames;
+  game_options.telemetry_path = telemetry_path;
+  game_options.telemetry_binary = telemetry_binary;
   game_options.game_version = game_name_to_version(game_name);
   game_options.server_port =
       port_number == -1 ? DECI2_PORT - 1 + (int)game_options.game_version : port_number;
@@ -171,20 +195,19 @@ int main(int argc, char** argv) {
     // for debugging the non-avx2 code paths, there's a flag to manually disable.
     lg::info("Note: AVX2 code has been manually disabled.");
     get_cpu_info().has_avx2 = false;
+    get_cpu_info().has_avx512 = false;
   }
 
-#ifndef __AVX2__
-  if (get_cpu_info().has_avx2) {
-    // printf("Note: your CPU supports AVX2, but this build was not compiled with AVX2 support\n");
-    get_cpu_info().has_avx2 = false;
-  }
-#endif
-
+  // the AVX2 and AVX-512 functions are built for those instructions on their own, so they can be
+  // used even though the rest of the build isn't.
   if (get_cpu_info().has_avx2) {
     lg::info("AVX2 mode enabled");
   } else {
     lg::info("AVX2 mode disabled");
   }
+  if (get_cpu_info().has_avx512) {
+    lg::info("AVX-512 mode enabled");
+  }
 
   try {
     setup_logging(verbose_logging);
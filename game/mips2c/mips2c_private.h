@@ -182,6 +182,9 @@ enum class DEST {
   xyzw = 15
 };
 
+// store_masked relies on DEST and Mask having the same bits.
+static_assert((int)DEST::xzw == (int)Mask::xzw && (int)DEST::yw == (int)Mask::yw);
+
 enum class BC { x = 0, y = 1, z = 2, w = 3 };
 
 struct Mips2c_vf {
@@ -247,6 +250,24 @@ struct ExecutionContext {
     }
   }
 
+  __m128 vf_src_sse(int idx) {
+    if (idx == 0) {
+      return _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+    } else {
+      return _mm_loadu_ps(vfs[idx].f);
+    }
+  }
+
+  /*!
+   * Store the lanes of val selected by mask to dst. The other lanes of dst are unchanged.
+   * DEST uses the same bits as the VU Mask, so this shares the blend from vu.h.
+   */
+  static void store_masked(DEST mask, float* dst, __m128 val) {
+    _mm_storeu_ps(dst, vu_blend_mask(_mm_loadu_ps(dst), val, (Mask)mask));
+  }
+
+  __m128 vf_bc_sse(int idx, BC bc) { return _mm_set1_ps(vf_src(idx).f[(int)bc]); }
+
   u128 gpr_src(int idx) {
     if (idx == 0) {
       u128 result;
@@ -389,14 +410,7 @@ struct ExecutionContext {
   }
 
   void vadd_bc(DEST mask, BC bc, int dest, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dest].f[i] = s0.f[i] + s1.f[(int)bc];
-      }
-    }
+    store_masked(mask, vfs[dest].f, _mm_add_ps(vf_src_sse(src0), vf_bc_sse(src1, bc)));
   }
 
   void vmini_bc(DEST mask, BC bc, int dest, int src0, int src1) {
@@ -772,47 +786,19 @@ struct ExecutionContext {
   }
 
   void vsub_bc(DEST mask, BC bc, int dest, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dest].f[i] = s0.f[i] - s1.f[(int)bc];
-      }
-    }
+    store_masked(mask, vfs[dest].f, _mm_sub_ps(vf_src_sse(src0), vf_bc_sse(src1, bc)));
   }
 
   void vmul_bc(DEST mask, BC bc, int dest, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dest].f[i] = s0.f[i] * s1.f[(int)bc];
-      }
-    }
+    store_masked(mask, vfs[dest].f, _mm_mul_ps(vf_src_sse(src0), vf_bc_sse(src1, bc)));
   }
 
   void vmul(DEST mask, int dest, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dest].f[i] = s0.f[i] * s1.f[i];
-      }
-    }
+    store_masked(mask, vfs[dest].f, _mm_mul_ps(vf_src_sse(src0), vf_src_sse(src1)));
   }
 
   void vadd(DEST mask, int dest, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dest].f[i] = s0.f[i] + s1.f[i];
-      }
-    }
+    store_masked(mask, vfs[dest].f, _mm_add_ps(vf_src_sse(src0), vf_src_sse(src1)));
   }
 
   void vmini(DEST mask, int dest, int src0, int src1) {
@@ -857,135 +843,59 @@ struct ExecutionContext {
   }
 
   void vsub(DEST mask, int dest, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dest].f[i] = s0.f[i] - s1.f[i];
-      }
-    }
+    store_masked(mask, vfs[dest].f, _mm_sub_ps(vf_src_sse(src0), vf_src_sse(src1)));
   }
 
   void vmula_bc(DEST mask, BC bc, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        acc.f[i] = s0.f[i] * s1.f[(int)bc];
-      }
-    }
+    store_masked(mask, acc.f, _mm_mul_ps(vf_src_sse(src0), vf_bc_sse(src1, bc)));
   }
 
   void vmula(DEST mask, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        acc.f[i] = s0.f[i] * s1.f[i];
-      }
-    }
+    store_masked(mask, acc.f, _mm_mul_ps(vf_src_sse(src0), vf_src_sse(src1)));
   }
 
   void vadda_bc(DEST mask, BC bc, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        acc.f[i] = s0.f[i] + s1.f[(int)bc];
-      }
-    }
+    store_masked(mask, acc.f, _mm_add_ps(vf_src_sse(src0), vf_bc_sse(src1, bc)));
   }
 
   void vmadda_bc(DEST mask, BC bc, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        acc.f[i] += s0.f[i] * s1.f[(int)bc];
-      }
-    }
+    __m128 prod = _mm_mul_ps(vf_src_sse(src0), vf_bc_sse(src1, bc));
+    store_masked(mask, acc.f, _mm_add_ps(_mm_loadu_ps(acc.f), prod));
   }
 
   void vmadda(DEST mask, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        acc.f[i] += s0.f[i] * s1.f[i];
-      }
-    }
+    __m128 prod = _mm_mul_ps(vf_src_sse(src0), vf_src_sse(src1));
+    store_masked(mask, acc.f, _mm_add_ps(_mm_loadu_ps(acc.f), prod));
   }
 
   void vmsuba(DEST mask, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        acc.f[i] -= s0.f[i] * s1.f[i];
-      }
-    }
+    __m128 prod = _mm_mul_ps(vf_src_sse(src0), vf_src_sse(src1));
+    store_masked(mask, acc.f, _mm_sub_ps(_mm_loadu_ps(acc.f), prod));
   }
 
   void vmsuba_bc(DEST mask, BC bc, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        acc.f[i] -= s0.f[i] * s1.f[(int)bc];
-      }
-    }
+    __m128 prod = _mm_mul_ps(vf_src_sse(src0), vf_bc_sse(src1, bc));
+    store_masked(mask, acc.f, _mm_sub_ps(_mm_loadu_ps(acc.f), prod));
   }
 
   void vmadd_bc(DEST mask, BC bc, int dst, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dst].f[i] = acc.f[i] + s0.f[i] * s1.f[(int)bc];
-      }
-    }
+    __m128 prod = _mm_mul_ps(vf_src_sse(src0), vf_bc_sse(src1, bc));
+    store_masked(mask, vfs[dst].f, _mm_add_ps(_mm_loadu_ps(acc.f), prod));
   }
 
   void vmadd(DEST mask, int dst, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dst].f[i] = acc.f[i] + s0.f[i] * s1.f[i];
-      }
-    }
+    __m128 prod = _mm_mul_ps(vf_src_sse(src0), vf_src_sse(src1));
+    store_masked(mask, vfs[dst].f, _mm_add_ps(_mm_loadu_ps(acc.f), prod));
   }
 
   void vmsub_bc(DEST mask, BC bc, int dst, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dst].f[i] = acc.f[i] - s0.f[i] * s1.f[(int)bc];
-      }
-    }
+    __m128 prod = _mm_mul_ps(vf_src_sse(src0), vf_bc_sse(src1, bc));
+    store_masked(mask, vfs[dst].f, _mm_sub_ps(_mm_loadu_ps(acc.f), prod));
   }
 
   void vmsub(DEST mask, int dst, int src0, int src1) {
-    auto s0 = vf_src(src0);
-    auto s1 = vf_src(src1);
-
-    for (int i = 0; i < 4; i++) {
-      if ((u64)mask & (1 << i)) {
-        vfs[dst].f[i] = acc.f[i] - s0.f[i] * s1.f[i];
-      }
-    }
+    __m128 prod = _mm_mul_ps(vf_src_sse(src0), vf_src_sse(src1));
+    store_masked(mask, vfs[dst].f, _mm_sub_ps(_mm_loadu_ps(acc.f), prod));
   }
 
   void vmsubq(DEST mask, int dst, int src0) {
@@ -370,7 +370,7 @@ RuntimeExitStatus exec_runtime(GameLaunchOptions game_options, int argc, const c
   g_argv = argv;
   g_main_thread_id = std::this_thread::get_id();
 
-  bool enable_display = !game_options.disable_display;
+  bool enable_display = !game_options.disable_display && !game_options.null_renderer;
   VM::use = !game_options.disable_debug_vm;
   g_game_version = game_options.game_version;
   g_server_port = game_options.server_port;
@@ -386,8 +386,17 @@ RuntimeExitStatus exec_runtime(GameLaunchOptions game_options, int argc, const c
   // want the graphics system to catch them.
   {
     auto p = scoped_prof("startup::exec_runtime::init_gfx");
+    Gfx::g_global_settings.telemetry_path = game_options.telemetry_path;
+    Gfx::g_global_settings.telemetry_binary = game_options.telemetry_binary;
     if (enable_display) {
       Gfx::Init(g_game_version);
+    } else if (game_options.null_renderer) {
+      Gfx::Init(g_game_version, GfxPipeline::Null);
+    }
+    if ((enable_display || game_options.null_renderer) &&
+        !game_options.gfx_capture_path.empty()) {
+      Gfx::start_capture(game_options.gfx_capture_path, game_options.gfx_capture_skip_frames,
+                         game_options.gfx_capture_frames);
     }
   }
 
@@ -457,7 +466,7 @@ RuntimeExitStatus exec_runtime(GameLaunchOptions game_options, int argc, const c
 
   // kill renderer after all threads are stopped.
   // this makes sure the std::shared_ptr<Display> is destroyed in the main thread.
-  if (enable_display) {
+  if (enable_display || game_options.null_renderer) {
     Gfx::Exit();
   }
   lg::info("GOAL Runtime Shutdown (code {})", fmt::underlying(MasterExit));
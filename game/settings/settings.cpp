@@ -16,7 +16,8 @@ void to_json(json& j, const DebugSettings& obj) {
            {"ignore_hide_imgui", obj.ignore_hide_imgui},
            {"text_filters", obj.text_filters},
            {"text_check_range", obj.text_check_range},
-           {"text_max_range", obj.text_max_range}};
+           {"text_max_range", obj.text_max_range},
+           {"level_memory_budget_mb", obj.level_memory_budget_mb}};
 }
 
 void from_json(const json& j, DebugSettings& obj) {
@@ -29,6 +30,7 @@ void from_json(const json& j, DebugSettings& obj) {
   json_deserialize_if_exists(text_filters);
   json_deserialize_if_exists(text_check_range);
   json_deserialize_if_exists(text_max_range);
+  json_deserialize_if_exists(level_memory_budget_mb);
 }
 
 DebugSettings::DebugSettings() {
@@ -22,6 +22,9 @@ struct DebugSettings {
   bool text_check_range = false;
   float text_max_range = 0;
 
+  // levels are unloaded when the renderer's copy of them uses more than this.
+  int level_memory_budget_mb = 2048;
+
   void save_settings();
 };
 void to_json(json& j, const DebugSettings& obj);
@@ -0,0 +1,161 @@
+#include <iterator>
+#include <limits>
+
+#include "decompiler/Disasm/InstructionParser.h"
+#include "decompiler/analysis/mips2c.h"
+#include "game/mips2c/mips2c_private.h"
+#include "gtest/gtest.h"
+
+using namespace decompiler;
+
+namespace {
+std::unordered_map<int, u8> masks_for_program(const std::string& program) {
+  InstructionParser parser;
+  auto parsed = parser.parse_program(program);
+  return find_vf_write_masks(parsed.instructions, 0, parsed.instructions.size());
+}
+}  // namespace
+
+TEST(Mips2C, VfWriteMasksRemoveDeadWrite) {
+  auto masks = masks_for_program(
+      "  vmul.xyzw vf1, vf2, vf3\n"
+      "  vadd.xyzw vf1, vf4, vf5\n");
+  ASSERT_EQ(masks.size(), 1u);
+  EXPECT_EQ(masks.at(0), 0);
+}
+
+TEST(Mips2C, VfWriteMasksNarrowPartialOverwrite) {
+  auto masks = masks_for_program(
+      "  vmul.xyzw vf1, vf2, vf3\n"
+      "  vadd.xy vf1, vf4, vf5\n");
+  ASSERT_EQ(masks.size(), 1u);
+  EXPECT_EQ(masks.at(0), 0b0011);  // zw
+}
+
+TEST(Mips2C, VfWriteMasksKeepUsedLanes) {
+  auto masks = masks_for_program(
+      "  vmul.xyzw vf1, vf2, vf3\n"
+      "  vadd.xyzw vf6, vf1, vf5\n"
+      "  vadd.xyzw vf1, vf4, vf5\n"
+      "  sqc2 vf1, 0(a0)\n");
+  EXPECT_TRUE(masks.empty());
+}
+
+TEST(Mips2C, VfWriteMasksBroadcast) {
+  auto masks = masks_for_program(
+      "  vmul.xyzw vf1, vf2, vf3\n"
+      "  vaddy.xyzw vf6, vf4, vf1\n"
+      "  vadd.xyzw vf1, vf7, vf7\n");
+  ASSERT_EQ(masks.size(), 1u);
+  EXPECT_EQ(masks.at(0), 0b0100);  // y
+}
+
+TEST(Mips2C, VfWriteMasksLoadKills) {
+  auto masks = masks_for_program(
+      "  vmul.xyzw vf1, vf2, vf3\n"
+      "  lqc2 vf1, 0(a0)\n");
+  ASSERT_EQ(masks.size(), 1u);
+  EXPECT_EQ(masks.at(0), 0);
+}
+
+namespace {
+void setup_context(Mips2C::ExecutionContext& c, bool special_values) {
+  for (int r = 0; r < 32; r++) {
+    for (int i = 0; i < 4; i++) {
+      c.vfs[r].f[i] = 0.25f * r - 1.5f * i + 0.1f;
+    }
+  }
+  if (special_values) {
+    // the generated code never relied on these, but the SSE ops should still give the same bits.
+    const float values[] = {std::numeric_limits<float>::infinity(),
+                            -std::numeric_limits<float>::infinity(),
+                            std::numeric_limits<float>::quiet_NaN(),
+                            -0.f,
+                            std::numeric_limits<float>::denorm_min(),
+                            std::numeric_limits<float>::max()};
+    int n = 0;
+    for (int r = 1; r < 32; r++) {
+      c.vfs[r].f[r % 4] = values[n++ % std::size(values)];
+    }
+  }
+  for (int i = 0; i < 4; i++) {
+    c.acc.f[i] = 3.f - 0.7f * i;
+  }
+}
+
+// round the product before accumulating, like the VU does. Without this, the compiler may use
+// fused multiply-add for the reference, which gives slightly different results.
+float mul(float a, float b) {
+  volatile float result = a * b;
+  return result;
+}
+
+float lane(const Mips2C::ExecutionContext& c, int reg, int i) {
+  if (reg == 0) {
+    return i == 3 ? 1.f : 0.f;
+  }
+  return c.vfs[reg].f[i];
+}
+}  // namespace
+
+TEST(Mips2C, VectorOpsMatchScalar) {
+  using Mips2C::BC;
+  using Mips2C::DEST;
+  // include vf0 as a source and an aliased source/destination.
+  const int srcs[][2] = {{2, 3}, {0, 4}, {5, 0}, {6, 6}, {8, 9}, {10, 11}};
+  for (int m = 0; m < 16; m++) {
+    for (int b = 0; b < 4; b++) {
+      for (auto& src : srcs) {
+        for (bool special : {false, true}) {
+          Mips2C::ExecutionContext c;
+          setup_context(c, special);
+          Mips2C::ExecutionContext ref = c;
+          auto mask = (DEST)m;
+          auto bc = (BC)b;
+
+          c.vadd(mask, 1, src[0], src[1]);
+          c.vsub_bc(mask, bc, 7, src[0], src[1]);
+          c.vmadda_bc(mask, bc, src[0], src[1]);
+          c.vmadd(mask, 6, src[0], src[1]);
+          c.vmsuba(mask, src[0], src[1]);
+          c.vmsub_bc(mask, bc, 8, src[0], src[1]);
+
+          auto expect = ref;
+          for (int i = 0; i < 4; i++) {
+            if (!(m & (1 << i))) {
+              continue;
+            }
+            expect.vfs[1].f[i] = lane(ref, src[0], i) + lane(ref, src[1], i);
+            expect.vfs[7].f[i] = lane(ref, src[0], i) - lane(ref, src[1], b);
+          }
+          for (int i = 0; i < 4; i++) {
+            if (m & (1 << i)) {
+              expect.acc.f[i] += mul(lane(expect, src[0], i), lane(expect, src[1], b));
+            }
+          }
+          for (int i = 0; i < 4; i++) {
+            if (m & (1 << i)) {
+              float prod = mul(lane(expect, src[0], i), lane(expect, src[1], i));
+              expect.vfs[6].f[i] = expect.acc.f[i] + prod;
+            }
+          }
+          for (int i = 0; i < 4; i++) {
+            if (m & (1 << i)) {
+              expect.acc.f[i] -= mul(lane(expect, src[0], i), lane(expect, src[1], i));
+            }
+          }
+          for (int i = 0; i < 4; i++) {
+            if (m & (1 << i)) {
+              float prod = mul(lane(expect, src[0], i), lane(expect, src[1], b));
+              expect.vfs[8].f[i] = expect.acc.f[i] - prod;
+            }
+          }
+
+          EXPECT_EQ(0, memcmp(c.vfs, expect.vfs, sizeof(c.vfs))) << m << " " << b << " " << special;
+          EXPECT_EQ(0, memcmp(c.acc.f, expect.acc.f, sizeof(c.acc.f)))
+              << m << " " << b << " " << special;
+        }
+      }
+    }
+  }
+}
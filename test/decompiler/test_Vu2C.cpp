@@ -0,0 +1,175 @@
+#include <random>
+
+#include "common/util/FileUtil.h"
+
+#include "decompiler/VuDisasm/Vu2C.h"
+#include "decompiler/VuDisasm/VuInterpreter.h"
+#include "decompiler/util/DataParser.h"
+#include "gtest/gtest.h"
+#include "test/decompiler/vu_reference/jak2/ocean-texture-vu2c.h"
+#include "test/decompiler/vu_reference/jak2/sprite-distort-vu2c.h"
+
+#include "third-party/fmt/core.h"
+
+using namespace decompiler;
+
+namespace {
+std::vector<u32> get_test_data(const std::string& name) {
+  auto text = file_util::read_text_file(
+      file_util::get_file_path({fmt::format("test/decompiler/vu_reference/{}.txt", name)}));
+
+  auto parsed = parse_data(text);
+
+  std::vector<u32> data;
+  for (auto& w : parsed.words) {
+    EXPECT_EQ(w.kind(), LinkedWord::Kind::PLAIN_DATA);
+    data.push_back(w.data);
+  }
+  return data;
+}
+
+std::string get_expected(const std::string& name) {
+  return file_util::read_text_file(
+      file_util::get_file_path({fmt::format("test/decompiler/vu_reference/{}-vu2c.h", name)}));
+}
+
+constexpr int kVu1Words = 16 * 1024 / 4;
+
+struct Kick {
+  u16 addr;
+  std::vector<u32> memory;
+};
+
+/*!
+ * A VU with random registers and memory, all finite floats, so results don't depend on which NaN
+ * comes out of an operation.
+ */
+struct TestVu {
+  explicit TestVu(u32 seed) : memory(kVu1Words) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-100.f, 100.f);
+    for (auto& word : memory) {
+      float f = dist(rng);
+      memcpy(&word, &f, 4);
+    }
+    for (int i = 1; i < 32; i++) {
+      for (int j = 0; j < 4; j++) {
+        state.vf[i][j] = dist(rng);
+      }
+    }
+    for (int i = 1; i < 16; i++) {
+      state.vi[i] = rng() & 0x3ff;
+    }
+    state.top = rng() & 0x3ff;
+    state.data = (u8*)memory.data();
+  }
+
+  void set_int(int qw, int lane, u32 value) { memory.at(qw * 4 + lane) = value; }
+
+  std::function<void(u16)> kicker() {
+    return [this](u16 addr) { kicks.push_back({addr, memory}); };
+  }
+
+  std::vector<u32> memory;
+  VuState state;
+  std::vector<Kick> kicks;
+};
+
+void expect_same(const TestVu& expected, const TestVu& actual) {
+  for (int i = 0; i < 32; i++) {
+    EXPECT_EQ(0, memcmp(expected.state.vf[i].data, actual.state.vf[i].data, 16)) << "vf" << i;
+  }
+  EXPECT_EQ(0, memcmp(expected.state.acc.data, actual.state.acc.data, 16));
+  for (int i = 0; i < 16; i++) {
+    EXPECT_EQ(expected.state.vi[i], actual.state.vi[i]) << "vi" << i;
+  }
+  EXPECT_EQ(expected.state.Q, actual.state.Q);
+  EXPECT_EQ(expected.state.P, actual.state.P);
+  EXPECT_EQ(expected.state.I, actual.state.I);
+  EXPECT_EQ(expected.state.clip_flags, actual.state.clip_flags);
+  EXPECT_TRUE(expected.memory == actual.memory);
+  ASSERT_EQ(expected.kicks.size(), actual.kicks.size());
+  for (size_t i = 0; i < expected.kicks.size(); i++) {
+    EXPECT_EQ(expected.kicks[i].addr, actual.kicks[i].addr);
+    EXPECT_TRUE(expected.kicks[i].memory == actual.kicks[i].memory) << "kick " << i;
+  }
+}
+
+Vu2CSettings ocean_texture_settings() {
+  Vu2CSettings settings;
+  settings.function_name = "ocean_texture_program";
+  settings.source = "ocean-texture.txt";
+  settings.entry_points = {0, 4};
+  return settings;
+}
+
+Vu2CSettings sprite_distort_settings() {
+  Vu2CSettings settings;
+  settings.function_name = "sprite_distort_program";
+  settings.source = "sprite-distort.txt";
+  return settings;
+}
+}  // namespace
+
+// the checked-in headers are up to date with the generator.
+TEST(Vu2C, OceanTexture_Jak2) {
+  auto data = get_test_data("jak2/ocean-texture");
+  VuDisassembler disasm(VuDisassembler::VuKind::VU1);
+  auto prog = disasm.disassemble(data.data(), data.size() * 4, false);
+  EXPECT_EQ(vu_program_to_cpp(prog, disasm, ocean_texture_settings()),
+            get_expected("jak2/ocean-texture"));
+}
+
+TEST(Vu2C, SpriteDistort_Jak2) {
+  auto data = get_test_data("jak2/sprite-distort");
+  VuDisassembler disasm(VuDisassembler::VuKind::VU1);
+  auto prog = disasm.disassemble(data.data(), data.size() * 4, false);
+  EXPECT_EQ(vu_program_to_cpp(prog, disasm, sprite_distort_settings()),
+            get_expected("jak2/sprite-distort"));
+}
+
+// the generated code does the same thing as the interpreter.
+TEST(Vu2C, OceanTextureMatchesInterpreter_Jak2) {
+  auto data = get_test_data("jak2/ocean-texture");
+  VuDisassembler disasm(VuDisassembler::VuKind::VU1);
+  auto prog = disasm.disassemble(data.data(), data.size() * 4, false);
+  VuInterpreter interp(prog, disasm);
+
+  for (u32 seed = 0; seed < 20; seed++) {
+    for (u16 entry : {0, 4}) {
+      TestVu expected(seed), actual(seed);
+      interp.run(expected.state, entry, expected.kicker());
+      ocean_texture_program(actual.state, entry, actual.kicker());
+      ASSERT_FALSE(expected.kicks.empty());
+      expect_same(expected, actual);
+    }
+  }
+}
+
+TEST(Vu2C, SpriteDistortMatchesInterpreter_Jak2) {
+  auto data = get_test_data("jak2/sprite-distort");
+  VuDisassembler disasm(VuDisassembler::VuKind::VU1);
+  auto prog = disasm.disassemble(data.data(), data.size() * 4, false);
+  VuInterpreter interp(prog, disasm);
+
+  for (u32 seed = 0; seed < 20; seed++) {
+    auto setup = [&](TestVu* vu) {
+      std::mt19937 rng(seed);
+      int sprites = 1 + rng() % 4;
+      vu->set_int(511, 0, sprites);
+      for (int i = 0; i < sprites; i++) {
+        // the number of slices for the sprite, and where its table of points is.
+        u32 slices = 1 + rng() % 3;
+        vu->set_int(0x200 + 3 * i + 1, 3, slices);
+        vu->set_int(477 + slices, 0, 0x300 + rng() % 0x40);
+      }
+    };
+    TestVu expected(seed), actual(seed);
+    setup(&expected);
+    setup(&actual);
+    interp.run(expected.state, 0, expected.kicker());
+    sprite_distort_program(actual.state, 0, actual.kicker());
+    ASSERT_FALSE(expected.kicks.empty());
+    expect_same(expected, actual);
+  }
+}
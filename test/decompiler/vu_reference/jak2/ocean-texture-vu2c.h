@@ -0,0 +1,972 @@
+#pragma once
+
+// Generated by tools/vu2c from ocean-texture.txt, regenerate it instead of editing it.
+
+#include "game/common/vu2c.h"
+
+/*!
+ * Run the program from the instruction start (the mscal address / 8) until it ends.
+ * xgkick is called with the address for each xgkick.
+ */
+template <typename Kick>
+void ocean_texture_program(VuState& vu, u16 start, Kick&& xgkick) {
+  const __m128 vf00 = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+  __m128 vf01 = vu.vf[1].load();
+  __m128 vf02 = vu.vf[2].load();
+  __m128 vf03 = vu.vf[3].load();
+  __m128 vf04 = vu.vf[4].load();
+  __m128 vf05 = vu.vf[5].load();
+  __m128 vf06 = vu.vf[6].load();
+  __m128 vf07 = vu.vf[7].load();
+  __m128 vf14 = vu.vf[14].load();
+  __m128 vf15 = vu.vf[15].load();
+  __m128 vf16 = vu.vf[16].load();
+  __m128 vf17 = vu.vf[17].load();
+  __m128 vf18 = vu.vf[18].load();
+  __m128 vf19 = vu.vf[19].load();
+  __m128 vf20 = vu.vf[20].load();
+  __m128 vf21 = vu.vf[21].load();
+  __m128 vf22 = vu.vf[22].load();
+  __m128 vf23 = vu.vf[23].load();
+  __m128 vf24 = vu.vf[24].load();
+  __m128 vf26 = vu.vf[26].load();
+  __m128 vf28 = vu.vf[28].load();
+  __m128 vf29 = vu.vf[29].load();
+  __m128 vf30 = vu.vf[30].load();
+  __m128 vf31 = vu.vf[31].load();
+  u16 vi01 = vu.vi[1];
+  u16 vi03 = vu.vi[3];
+  u16 vi04 = vu.vi[4];
+  u16 vi05 = vu.vi[5];
+  u16 vi06 = vu.vi[6];
+  u16 vi07 = vu.vi[7];
+  u16 vi08 = vu.vi[8];
+  u16 vi09 = vu.vi[9];
+  u16 vi11 = vu.vi[11];
+  u16 vi12 = vu.vi[12];
+  bool bc = false;
+  u16 jr_target = 0;
+
+  switch (start) {
+    case 0:
+      goto I0;
+    case 4:
+      goto I4;
+    default:
+      ASSERT_NOT_REACHED();
+  }
+
+I0:
+  // lq. vf00, 124(vi00)        |  addx. vf00, vf00, vf00         0
+  // lq. vf00, 62(vi00)         |  addx. vf00, vf00, vf00         1
+  // b L1                       |  nop                            2
+  // nop                        |  nop                            3
+  goto L1;
+I4:
+  // b L2                       |  nop                            4
+  // nop                        |  nop                            5
+  goto L2;
+L1:
+  // lq.xyzw vf14, 988(vi00)    |  maxw.xyzw vf01, vf00, vf00     8
+  vf01 = vu_max_ps(vf00, vu_bc<3>(vf00));
+  vf14 = vu_lq(vu.data, 988);
+  // lq.xyzw vf02, 989(vi00)    |  nop                            9
+  vf02 = vu_lq(vu.data, 989);
+  // lq.xyzw vf03, 986(vi00)    |  nop                            10
+  vf03 = vu_lq(vu.data, 986);
+  // lq.xyzw vf04, 987(vi00)    |  nop                            11
+  vf04 = vu_lq(vu.data, 987);
+  // lq.xyzw vf05, 985(vi00)    |  nop                            12
+  vf05 = vu_lq(vu.data, 985);
+  // lq.xyzw vf06, 991(vi00)    |  nop                            13
+  vf06 = vu_lq(vu.data, 991);
+  // lq.xyzw vf07, 990(vi00)    |  nop                            14
+  vf07 = vu_lq(vu.data, 990);
+  // iaddiu vi11, vi00, 0x80    |  nop                            15
+  vi11 = 0x80;
+  // mtir vi08, vf03.x          |  nop                            16
+  vi08 = vu_lane_u16<0>(vf03);
+  // mtir vi09, vf03.x          |  nop                            17
+  vi09 = vu_lane_u16<0>(vf03);
+  // mr32.xyzw vf03, vf03       |  nop                            18
+  vf03 = vu_mr32(vf03);
+  // xtop vi05                  |  nop                            19
+  vi05 = vu.top;
+  // mtir vi06, vf04.x          |  nop                            20
+  vi06 = vu_lane_u16<0>(vf04);
+  // bal vi12, L3               |  nop                            21
+  vi12 = 23;
+  // mr32.xyzw vf04, vf04       |  nop                            22
+  vf04 = vu_mr32(vf04);
+  goto L3;
+I23:
+  // mtir vi06, vf04.x          |  nop                            23
+  vi06 = vu_lane_u16<0>(vf04);
+  // bal vi12, L3               |  nop                            24
+  vi12 = 26;
+  // mr32.xyzw vf04, vf04       |  nop                            25
+  vf04 = vu_mr32(vf04);
+  goto L3;
+I26:
+  // mtir vi03, vf04.x          |  nop                            26
+  vi03 = vu_lane_u16<0>(vf04);
+  // bal vi12, L5               |  nop                            27
+  vi12 = 29;
+  // mtir vi04, vf04.y          |  nop                            28
+  vi04 = vu_lane_u16<1>(vf04);
+  goto L5;
+I29:
+  // mtir vi06, vf04.x          |  nop                            29
+  vi06 = vu_lane_u16<0>(vf04);
+  // bal vi12, L3               |  nop                            30
+  vi12 = 32;
+  // mr32.xyzw vf04, vf04       |  nop                            31
+  vf04 = vu_mr32(vf04);
+  goto L3;
+I32:
+  // mtir vi03, vf04.x          |  nop                            32
+  vi03 = vu_lane_u16<0>(vf04);
+  // bal vi12, L5               |  nop                            33
+  vi12 = 35;
+  // mtir vi04, vf04.y          |  nop                            34
+  vi04 = vu_lane_u16<1>(vf04);
+  goto L5;
+I35:
+  // nop                        |  nop :e                         35
+  // nop                        |  nop                            36
+  goto END;
+L2:
+  // xtop vi05                  |  nop                            37
+  vi05 = vu.top;
+  // mtir vi06, vf04.x          |  nop                            38
+  vi06 = vu_lane_u16<0>(vf04);
+  // bal vi12, L3               |  nop                            39
+  vi12 = 41;
+  // mr32.xyzw vf04, vf04       |  nop                            40
+  vf04 = vu_mr32(vf04);
+  goto L3;
+I41:
+  // mtir vi03, vf04.x          |  nop                            41
+  vi03 = vu_lane_u16<0>(vf04);
+  // bal vi12, L5               |  nop                            42
+  vi12 = 44;
+  // mtir vi04, vf04.y          |  nop                            43
+  vi04 = vu_lane_u16<1>(vf04);
+  goto L5;
+I44:
+  // mtir vi06, vf04.x          |  nop                            44
+  vi06 = vu_lane_u16<0>(vf04);
+  // bal vi12, L3               |  nop                            45
+  vi12 = 47;
+  // mr32.xyzw vf04, vf04       |  nop                            46
+  vf04 = vu_mr32(vf04);
+  goto L3;
+I47:
+  // mtir vi03, vf04.x          |  nop                            47
+  vi03 = vu_lane_u16<0>(vf04);
+  // bal vi12, L5               |  nop                            48
+  vi12 = 50;
+  // mtir vi04, vf04.y          |  nop                            49
+  vi04 = vu_lane_u16<1>(vf04);
+  goto L5;
+I50:
+  // mtir vi06, vf04.x          |  nop                            50
+  vi06 = vu_lane_u16<0>(vf04);
+  // bal vi12, L3               |  nop                            51
+  vi12 = 53;
+  // mr32.xyzw vf04, vf04       |  nop                            52
+  vf04 = vu_mr32(vf04);
+  goto L3;
+I53:
+  // mtir vi03, vf04.x          |  nop                            53
+  vi03 = vu_lane_u16<0>(vf04);
+  // bal vi12, L5               |  nop                            54
+  vi12 = 56;
+  // mtir vi04, vf04.y          |  nop                            55
+  vi04 = vu_lane_u16<1>(vf04);
+  goto L5;
+I56:
+  // nop                        |  nop :e                         56
+  // nop                        |  nop                            57
+  goto END;
+L3:
+  // ior vi07, vi06, vi00       |  nop                            58
+  vi07 = vi06;
+  // move.xyzw vf15, vf14       |  nop                            59
+  vf15 = vf14;
+  // iaddi vi01, vi00, 0x8      |  nop                            60
+  vi01 = 0x8;
+  // lq.xyzw vf24, 1(vi05)      |  mulw.xyzw vf20, vf15, vf00     61
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  mulw.xyzw vf21, vf15, vf00     62
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  mulw.xyzw vf22, vf15, vf00     63
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  // nop                        |  mulw.xyzw vf23, vf15, vf00     64
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  // nop                        |  addx.x vf21, vf21, vf02        65
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // nop                        |  addy.x vf22, vf22, vf02        66
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  // unrolled loop: iteration 1 of 8
+  // nop                        |  addz.x vf23, vf23, vf02        67
+  vf23 = _mm_blend_ps(vf23, _mm_add_ps(vf23, vu_bc<2>(vf02)), 0b0001);
+  // nop                        |  addw.x vf15, vf15, vf02        68
+  vf15 = _mm_blend_ps(vf15, _mm_add_ps(vf15, vu_bc<3>(vf02)), 0b0001);
+  // sq.xyzw vf20, 2(vi06)      |  mulx.x vf28, vf01, vf24        69
+  vf28 = _mm_mul_ps(vf01, vu_bc<0>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf21, 5(vi06)      |  muly.x vf29, vf01, vf24        70
+  vf29 = _mm_mul_ps(vf01, vu_bc<1>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 5) & 0x3ff, vf21);
+  // sq.xyzw vf22, 8(vi06)      |  mulz.x vf30, vf01, vf24        71
+  vf30 = _mm_mul_ps(vf01, vu_bc<2>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 8) & 0x3ff, vf22);
+  // sq.xyzw vf23, 11(vi06)     |  mulw.x vf31, vf01, vf24        72
+  vf31 = _mm_mul_ps(vf01, vu_bc<3>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 11) & 0x3ff, vf23);
+  // lq.xyzw vf16, 0(vi05)      |  mulx.y vf28, vf01, vf26        73
+  vf28 = _mm_blend_ps(vf28, _mm_mul_ps(vf01, vu_bc<0>(vf26)), 0b0010);
+  vf16 = vu_lq(vu.data, vi05 & 0x3ff);
+  // lq.xyzw vf17, 2(vi05)      |  muly.y vf29, vf01, vf26        74
+  vf29 = _mm_blend_ps(vf29, _mm_mul_ps(vf01, vu_bc<1>(vf26)), 0b0010);
+  vf17 = vu_lq(vu.data, (vi05 + 2) & 0x3ff);
+  // lq.xyzw vf18, 4(vi05)      |  mulz.y vf30, vf01, vf26        75
+  vf30 = _mm_blend_ps(vf30, _mm_mul_ps(vf01, vu_bc<2>(vf26)), 0b0010);
+  vf18 = vu_lq(vu.data, (vi05 + 4) & 0x3ff);
+  // lq.xyzw vf19, 6(vi05)      |  mulw.y vf31, vf01, vf26        76
+  vf31 = _mm_blend_ps(vf31, _mm_mul_ps(vf01, vu_bc<3>(vf26)), 0b0010);
+  vf19 = vu_lq(vu.data, (vi05 + 6) & 0x3ff);
+  // iaddi vi05, vi05, 0x8      |  ftoi0.xyzw vf16, vf16          77
+  vf16 = vu_ftoi<0>(vf16);
+  vi05 = vi05 + 8;
+  // nop                        |  ftoi0.xyzw vf17, vf17          78
+  vf17 = vu_ftoi<0>(vf17);
+  // nop                        |  ftoi0.xyzw vf18, vf18          79
+  vf18 = vu_ftoi<0>(vf18);
+  // iaddi vi01, vi01, -0x1     |  ftoi0.xyzw vf19, vf19          80
+  vf19 = vu_ftoi<0>(vf19);
+  vi01 = vi01 - 1;
+  // sq.xyzw vf16, 1(vi06)      |  add.xyzw vf28, vf28, vf07      81
+  vf28 = _mm_add_ps(vf28, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf17, 4(vi06)      |  add.xyzw vf29, vf29, vf07      82
+  vf29 = _mm_add_ps(vf29, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf18, 7(vi06)      |  add.xyzw vf30, vf30, vf07      83
+  vf30 = _mm_add_ps(vf30, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 7) & 0x3ff, vf18);
+  // sq.xyzw vf19, 10(vi06)     |  add.xyzw vf31, vf31, vf07      84
+  vf31 = _mm_add_ps(vf31, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 10) & 0x3ff, vf19);
+  // lq.xyzw vf24, 1(vi05)      |  sub.zw vf28, vf01, vf00        85
+  vf28 = _mm_blend_ps(vf28, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  sub.zw vf29, vf01, vf00        86
+  vf29 = _mm_blend_ps(vf29, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  sub.zw vf30, vf01, vf00        87
+  vf30 = _mm_blend_ps(vf30, _mm_sub_ps(vf01, vf00), 0b1100);
+  // nop                        |  sub.zw vf31, vf01, vf00        88
+  vf31 = _mm_blend_ps(vf31, _mm_sub_ps(vf01, vf00), 0b1100);
+  // sq.xyzw vf28, 0(vi06)      |  mulw.xyzw vf20, vf15, vf00     89
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // sq.xyzw vf29, 3(vi06)      |  mulw.xyzw vf21, vf15, vf00     90
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf30, 6(vi06)      |  mulw.xyzw vf22, vf15, vf00     91
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 6) & 0x3ff, vf30);
+  // sq.xyzw vf31, 9(vi06)      |  mulw.xyzw vf23, vf15, vf00     92
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 9) & 0x3ff, vf31);
+  // ibgtz vi01, L4             |  addx.x vf21, vf21, vf02        93
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // iaddi vi06, vi06, 0xc      |  addy.x vf22, vf22, vf02        94
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  vi06 = vi06 + 12;
+  // unrolled loop: iteration 2 of 8
+  // nop                        |  addz.x vf23, vf23, vf02        67
+  vf23 = _mm_blend_ps(vf23, _mm_add_ps(vf23, vu_bc<2>(vf02)), 0b0001);
+  // nop                        |  addw.x vf15, vf15, vf02        68
+  vf15 = _mm_blend_ps(vf15, _mm_add_ps(vf15, vu_bc<3>(vf02)), 0b0001);
+  // sq.xyzw vf20, 2(vi06)      |  mulx.x vf28, vf01, vf24        69
+  vf28 = _mm_mul_ps(vf01, vu_bc<0>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf21, 5(vi06)      |  muly.x vf29, vf01, vf24        70
+  vf29 = _mm_mul_ps(vf01, vu_bc<1>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 5) & 0x3ff, vf21);
+  // sq.xyzw vf22, 8(vi06)      |  mulz.x vf30, vf01, vf24        71
+  vf30 = _mm_mul_ps(vf01, vu_bc<2>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 8) & 0x3ff, vf22);
+  // sq.xyzw vf23, 11(vi06)     |  mulw.x vf31, vf01, vf24        72
+  vf31 = _mm_mul_ps(vf01, vu_bc<3>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 11) & 0x3ff, vf23);
+  // lq.xyzw vf16, 0(vi05)      |  mulx.y vf28, vf01, vf26        73
+  vf28 = _mm_blend_ps(vf28, _mm_mul_ps(vf01, vu_bc<0>(vf26)), 0b0010);
+  vf16 = vu_lq(vu.data, vi05 & 0x3ff);
+  // lq.xyzw vf17, 2(vi05)      |  muly.y vf29, vf01, vf26        74
+  vf29 = _mm_blend_ps(vf29, _mm_mul_ps(vf01, vu_bc<1>(vf26)), 0b0010);
+  vf17 = vu_lq(vu.data, (vi05 + 2) & 0x3ff);
+  // lq.xyzw vf18, 4(vi05)      |  mulz.y vf30, vf01, vf26        75
+  vf30 = _mm_blend_ps(vf30, _mm_mul_ps(vf01, vu_bc<2>(vf26)), 0b0010);
+  vf18 = vu_lq(vu.data, (vi05 + 4) & 0x3ff);
+  // lq.xyzw vf19, 6(vi05)      |  mulw.y vf31, vf01, vf26        76
+  vf31 = _mm_blend_ps(vf31, _mm_mul_ps(vf01, vu_bc<3>(vf26)), 0b0010);
+  vf19 = vu_lq(vu.data, (vi05 + 6) & 0x3ff);
+  // iaddi vi05, vi05, 0x8      |  ftoi0.xyzw vf16, vf16          77
+  vf16 = vu_ftoi<0>(vf16);
+  vi05 = vi05 + 8;
+  // nop                        |  ftoi0.xyzw vf17, vf17          78
+  vf17 = vu_ftoi<0>(vf17);
+  // nop                        |  ftoi0.xyzw vf18, vf18          79
+  vf18 = vu_ftoi<0>(vf18);
+  // iaddi vi01, vi01, -0x1     |  ftoi0.xyzw vf19, vf19          80
+  vf19 = vu_ftoi<0>(vf19);
+  vi01 = vi01 - 1;
+  // sq.xyzw vf16, 1(vi06)      |  add.xyzw vf28, vf28, vf07      81
+  vf28 = _mm_add_ps(vf28, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf17, 4(vi06)      |  add.xyzw vf29, vf29, vf07      82
+  vf29 = _mm_add_ps(vf29, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf18, 7(vi06)      |  add.xyzw vf30, vf30, vf07      83
+  vf30 = _mm_add_ps(vf30, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 7) & 0x3ff, vf18);
+  // sq.xyzw vf19, 10(vi06)     |  add.xyzw vf31, vf31, vf07      84
+  vf31 = _mm_add_ps(vf31, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 10) & 0x3ff, vf19);
+  // lq.xyzw vf24, 1(vi05)      |  sub.zw vf28, vf01, vf00        85
+  vf28 = _mm_blend_ps(vf28, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  sub.zw vf29, vf01, vf00        86
+  vf29 = _mm_blend_ps(vf29, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  sub.zw vf30, vf01, vf00        87
+  vf30 = _mm_blend_ps(vf30, _mm_sub_ps(vf01, vf00), 0b1100);
+  // nop                        |  sub.zw vf31, vf01, vf00        88
+  vf31 = _mm_blend_ps(vf31, _mm_sub_ps(vf01, vf00), 0b1100);
+  // sq.xyzw vf28, 0(vi06)      |  mulw.xyzw vf20, vf15, vf00     89
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // sq.xyzw vf29, 3(vi06)      |  mulw.xyzw vf21, vf15, vf00     90
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf30, 6(vi06)      |  mulw.xyzw vf22, vf15, vf00     91
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 6) & 0x3ff, vf30);
+  // sq.xyzw vf31, 9(vi06)      |  mulw.xyzw vf23, vf15, vf00     92
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 9) & 0x3ff, vf31);
+  // ibgtz vi01, L4             |  addx.x vf21, vf21, vf02        93
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // iaddi vi06, vi06, 0xc      |  addy.x vf22, vf22, vf02        94
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  vi06 = vi06 + 12;
+  // unrolled loop: iteration 3 of 8
+  // nop                        |  addz.x vf23, vf23, vf02        67
+  vf23 = _mm_blend_ps(vf23, _mm_add_ps(vf23, vu_bc<2>(vf02)), 0b0001);
+  // nop                        |  addw.x vf15, vf15, vf02        68
+  vf15 = _mm_blend_ps(vf15, _mm_add_ps(vf15, vu_bc<3>(vf02)), 0b0001);
+  // sq.xyzw vf20, 2(vi06)      |  mulx.x vf28, vf01, vf24        69
+  vf28 = _mm_mul_ps(vf01, vu_bc<0>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf21, 5(vi06)      |  muly.x vf29, vf01, vf24        70
+  vf29 = _mm_mul_ps(vf01, vu_bc<1>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 5) & 0x3ff, vf21);
+  // sq.xyzw vf22, 8(vi06)      |  mulz.x vf30, vf01, vf24        71
+  vf30 = _mm_mul_ps(vf01, vu_bc<2>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 8) & 0x3ff, vf22);
+  // sq.xyzw vf23, 11(vi06)     |  mulw.x vf31, vf01, vf24        72
+  vf31 = _mm_mul_ps(vf01, vu_bc<3>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 11) & 0x3ff, vf23);
+  // lq.xyzw vf16, 0(vi05)      |  mulx.y vf28, vf01, vf26        73
+  vf28 = _mm_blend_ps(vf28, _mm_mul_ps(vf01, vu_bc<0>(vf26)), 0b0010);
+  vf16 = vu_lq(vu.data, vi05 & 0x3ff);
+  // lq.xyzw vf17, 2(vi05)      |  muly.y vf29, vf01, vf26        74
+  vf29 = _mm_blend_ps(vf29, _mm_mul_ps(vf01, vu_bc<1>(vf26)), 0b0010);
+  vf17 = vu_lq(vu.data, (vi05 + 2) & 0x3ff);
+  // lq.xyzw vf18, 4(vi05)      |  mulz.y vf30, vf01, vf26        75
+  vf30 = _mm_blend_ps(vf30, _mm_mul_ps(vf01, vu_bc<2>(vf26)), 0b0010);
+  vf18 = vu_lq(vu.data, (vi05 + 4) & 0x3ff);
+  // lq.xyzw vf19, 6(vi05)      |  mulw.y vf31, vf01, vf26        76
+  vf31 = _mm_blend_ps(vf31, _mm_mul_ps(vf01, vu_bc<3>(vf26)), 0b0010);
+  vf19 = vu_lq(vu.data, (vi05 + 6) & 0x3ff);
+  // iaddi vi05, vi05, 0x8      |  ftoi0.xyzw vf16, vf16          77
+  vf16 = vu_ftoi<0>(vf16);
+  vi05 = vi05 + 8;
+  // nop                        |  ftoi0.xyzw vf17, vf17          78
+  vf17 = vu_ftoi<0>(vf17);
+  // nop                        |  ftoi0.xyzw vf18, vf18          79
+  vf18 = vu_ftoi<0>(vf18);
+  // iaddi vi01, vi01, -0x1     |  ftoi0.xyzw vf19, vf19          80
+  vf19 = vu_ftoi<0>(vf19);
+  vi01 = vi01 - 1;
+  // sq.xyzw vf16, 1(vi06)      |  add.xyzw vf28, vf28, vf07      81
+  vf28 = _mm_add_ps(vf28, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf17, 4(vi06)      |  add.xyzw vf29, vf29, vf07      82
+  vf29 = _mm_add_ps(vf29, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf18, 7(vi06)      |  add.xyzw vf30, vf30, vf07      83
+  vf30 = _mm_add_ps(vf30, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 7) & 0x3ff, vf18);
+  // sq.xyzw vf19, 10(vi06)     |  add.xyzw vf31, vf31, vf07      84
+  vf31 = _mm_add_ps(vf31, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 10) & 0x3ff, vf19);
+  // lq.xyzw vf24, 1(vi05)      |  sub.zw vf28, vf01, vf00        85
+  vf28 = _mm_blend_ps(vf28, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  sub.zw vf29, vf01, vf00        86
+  vf29 = _mm_blend_ps(vf29, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  sub.zw vf30, vf01, vf00        87
+  vf30 = _mm_blend_ps(vf30, _mm_sub_ps(vf01, vf00), 0b1100);
+  // nop                        |  sub.zw vf31, vf01, vf00        88
+  vf31 = _mm_blend_ps(vf31, _mm_sub_ps(vf01, vf00), 0b1100);
+  // sq.xyzw vf28, 0(vi06)      |  mulw.xyzw vf20, vf15, vf00     89
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // sq.xyzw vf29, 3(vi06)      |  mulw.xyzw vf21, vf15, vf00     90
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf30, 6(vi06)      |  mulw.xyzw vf22, vf15, vf00     91
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 6) & 0x3ff, vf30);
+  // sq.xyzw vf31, 9(vi06)      |  mulw.xyzw vf23, vf15, vf00     92
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 9) & 0x3ff, vf31);
+  // ibgtz vi01, L4             |  addx.x vf21, vf21, vf02        93
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // iaddi vi06, vi06, 0xc      |  addy.x vf22, vf22, vf02        94
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  vi06 = vi06 + 12;
+  // unrolled loop: iteration 4 of 8
+  // nop                        |  addz.x vf23, vf23, vf02        67
+  vf23 = _mm_blend_ps(vf23, _mm_add_ps(vf23, vu_bc<2>(vf02)), 0b0001);
+  // nop                        |  addw.x vf15, vf15, vf02        68
+  vf15 = _mm_blend_ps(vf15, _mm_add_ps(vf15, vu_bc<3>(vf02)), 0b0001);
+  // sq.xyzw vf20, 2(vi06)      |  mulx.x vf28, vf01, vf24        69
+  vf28 = _mm_mul_ps(vf01, vu_bc<0>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf21, 5(vi06)      |  muly.x vf29, vf01, vf24        70
+  vf29 = _mm_mul_ps(vf01, vu_bc<1>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 5) & 0x3ff, vf21);
+  // sq.xyzw vf22, 8(vi06)      |  mulz.x vf30, vf01, vf24        71
+  vf30 = _mm_mul_ps(vf01, vu_bc<2>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 8) & 0x3ff, vf22);
+  // sq.xyzw vf23, 11(vi06)     |  mulw.x vf31, vf01, vf24        72
+  vf31 = _mm_mul_ps(vf01, vu_bc<3>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 11) & 0x3ff, vf23);
+  // lq.xyzw vf16, 0(vi05)      |  mulx.y vf28, vf01, vf26        73
+  vf28 = _mm_blend_ps(vf28, _mm_mul_ps(vf01, vu_bc<0>(vf26)), 0b0010);
+  vf16 = vu_lq(vu.data, vi05 & 0x3ff);
+  // lq.xyzw vf17, 2(vi05)      |  muly.y vf29, vf01, vf26        74
+  vf29 = _mm_blend_ps(vf29, _mm_mul_ps(vf01, vu_bc<1>(vf26)), 0b0010);
+  vf17 = vu_lq(vu.data, (vi05 + 2) & 0x3ff);
+  // lq.xyzw vf18, 4(vi05)      |  mulz.y vf30, vf01, vf26        75
+  vf30 = _mm_blend_ps(vf30, _mm_mul_ps(vf01, vu_bc<2>(vf26)), 0b0010);
+  vf18 = vu_lq(vu.data, (vi05 + 4) & 0x3ff);
+  // lq.xyzw vf19, 6(vi05)      |  mulw.y vf31, vf01, vf26        76
+  vf31 = _mm_blend_ps(vf31, _mm_mul_ps(vf01, vu_bc<3>(vf26)), 0b0010);
+  vf19 = vu_lq(vu.data, (vi05 + 6) & 0x3ff);
+  // iaddi vi05, vi05, 0x8      |  ftoi0.xyzw vf16, vf16          77
+  vf16 = vu_ftoi<0>(vf16);
+  vi05 = vi05 + 8;
+  // nop                        |  ftoi0.xyzw vf17, vf17          78
+  vf17 = vu_ftoi<0>(vf17);
+  // nop                        |  ftoi0.xyzw vf18, vf18          79
+  vf18 = vu_ftoi<0>(vf18);
+  // iaddi vi01, vi01, -0x1     |  ftoi0.xyzw vf19, vf19          80
+  vf19 = vu_ftoi<0>(vf19);
+  vi01 = vi01 - 1;
+  // sq.xyzw vf16, 1(vi06)      |  add.xyzw vf28, vf28, vf07      81
+  vf28 = _mm_add_ps(vf28, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf17, 4(vi06)      |  add.xyzw vf29, vf29, vf07      82
+  vf29 = _mm_add_ps(vf29, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf18, 7(vi06)      |  add.xyzw vf30, vf30, vf07      83
+  vf30 = _mm_add_ps(vf30, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 7) & 0x3ff, vf18);
+  // sq.xyzw vf19, 10(vi06)     |  add.xyzw vf31, vf31, vf07      84
+  vf31 = _mm_add_ps(vf31, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 10) & 0x3ff, vf19);
+  // lq.xyzw vf24, 1(vi05)      |  sub.zw vf28, vf01, vf00        85
+  vf28 = _mm_blend_ps(vf28, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  sub.zw vf29, vf01, vf00        86
+  vf29 = _mm_blend_ps(vf29, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  sub.zw vf30, vf01, vf00        87
+  vf30 = _mm_blend_ps(vf30, _mm_sub_ps(vf01, vf00), 0b1100);
+  // nop                        |  sub.zw vf31, vf01, vf00        88
+  vf31 = _mm_blend_ps(vf31, _mm_sub_ps(vf01, vf00), 0b1100);
+  // sq.xyzw vf28, 0(vi06)      |  mulw.xyzw vf20, vf15, vf00     89
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // sq.xyzw vf29, 3(vi06)      |  mulw.xyzw vf21, vf15, vf00     90
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf30, 6(vi06)      |  mulw.xyzw vf22, vf15, vf00     91
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 6) & 0x3ff, vf30);
+  // sq.xyzw vf31, 9(vi06)      |  mulw.xyzw vf23, vf15, vf00     92
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 9) & 0x3ff, vf31);
+  // ibgtz vi01, L4             |  addx.x vf21, vf21, vf02        93
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // iaddi vi06, vi06, 0xc      |  addy.x vf22, vf22, vf02        94
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  vi06 = vi06 + 12;
+  // unrolled loop: iteration 5 of 8
+  // nop                        |  addz.x vf23, vf23, vf02        67
+  vf23 = _mm_blend_ps(vf23, _mm_add_ps(vf23, vu_bc<2>(vf02)), 0b0001);
+  // nop                        |  addw.x vf15, vf15, vf02        68
+  vf15 = _mm_blend_ps(vf15, _mm_add_ps(vf15, vu_bc<3>(vf02)), 0b0001);
+  // sq.xyzw vf20, 2(vi06)      |  mulx.x vf28, vf01, vf24        69
+  vf28 = _mm_mul_ps(vf01, vu_bc<0>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf21, 5(vi06)      |  muly.x vf29, vf01, vf24        70
+  vf29 = _mm_mul_ps(vf01, vu_bc<1>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 5) & 0x3ff, vf21);
+  // sq.xyzw vf22, 8(vi06)      |  mulz.x vf30, vf01, vf24        71
+  vf30 = _mm_mul_ps(vf01, vu_bc<2>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 8) & 0x3ff, vf22);
+  // sq.xyzw vf23, 11(vi06)     |  mulw.x vf31, vf01, vf24        72
+  vf31 = _mm_mul_ps(vf01, vu_bc<3>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 11) & 0x3ff, vf23);
+  // lq.xyzw vf16, 0(vi05)      |  mulx.y vf28, vf01, vf26        73
+  vf28 = _mm_blend_ps(vf28, _mm_mul_ps(vf01, vu_bc<0>(vf26)), 0b0010);
+  vf16 = vu_lq(vu.data, vi05 & 0x3ff);
+  // lq.xyzw vf17, 2(vi05)      |  muly.y vf29, vf01, vf26        74
+  vf29 = _mm_blend_ps(vf29, _mm_mul_ps(vf01, vu_bc<1>(vf26)), 0b0010);
+  vf17 = vu_lq(vu.data, (vi05 + 2) & 0x3ff);
+  // lq.xyzw vf18, 4(vi05)      |  mulz.y vf30, vf01, vf26        75
+  vf30 = _mm_blend_ps(vf30, _mm_mul_ps(vf01, vu_bc<2>(vf26)), 0b0010);
+  vf18 = vu_lq(vu.data, (vi05 + 4) & 0x3ff);
+  // lq.xyzw vf19, 6(vi05)      |  mulw.y vf31, vf01, vf26        76
+  vf31 = _mm_blend_ps(vf31, _mm_mul_ps(vf01, vu_bc<3>(vf26)), 0b0010);
+  vf19 = vu_lq(vu.data, (vi05 + 6) & 0x3ff);
+  // iaddi vi05, vi05, 0x8      |  ftoi0.xyzw vf16, vf16          77
+  vf16 = vu_ftoi<0>(vf16);
+  vi05 = vi05 + 8;
+  // nop                        |  ftoi0.xyzw vf17, vf17          78
+  vf17 = vu_ftoi<0>(vf17);
+  // nop                        |  ftoi0.xyzw vf18, vf18          79
+  vf18 = vu_ftoi<0>(vf18);
+  // iaddi vi01, vi01, -0x1     |  ftoi0.xyzw vf19, vf19          80
+  vf19 = vu_ftoi<0>(vf19);
+  vi01 = vi01 - 1;
+  // sq.xyzw vf16, 1(vi06)      |  add.xyzw vf28, vf28, vf07      81
+  vf28 = _mm_add_ps(vf28, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf17, 4(vi06)      |  add.xyzw vf29, vf29, vf07      82
+  vf29 = _mm_add_ps(vf29, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf18, 7(vi06)      |  add.xyzw vf30, vf30, vf07      83
+  vf30 = _mm_add_ps(vf30, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 7) & 0x3ff, vf18);
+  // sq.xyzw vf19, 10(vi06)     |  add.xyzw vf31, vf31, vf07      84
+  vf31 = _mm_add_ps(vf31, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 10) & 0x3ff, vf19);
+  // lq.xyzw vf24, 1(vi05)      |  sub.zw vf28, vf01, vf00        85
+  vf28 = _mm_blend_ps(vf28, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  sub.zw vf29, vf01, vf00        86
+  vf29 = _mm_blend_ps(vf29, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  sub.zw vf30, vf01, vf00        87
+  vf30 = _mm_blend_ps(vf30, _mm_sub_ps(vf01, vf00), 0b1100);
+  // nop                        |  sub.zw vf31, vf01, vf00        88
+  vf31 = _mm_blend_ps(vf31, _mm_sub_ps(vf01, vf00), 0b1100);
+  // sq.xyzw vf28, 0(vi06)      |  mulw.xyzw vf20, vf15, vf00     89
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // sq.xyzw vf29, 3(vi06)      |  mulw.xyzw vf21, vf15, vf00     90
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf30, 6(vi06)      |  mulw.xyzw vf22, vf15, vf00     91
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 6) & 0x3ff, vf30);
+  // sq.xyzw vf31, 9(vi06)      |  mulw.xyzw vf23, vf15, vf00     92
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 9) & 0x3ff, vf31);
+  // ibgtz vi01, L4             |  addx.x vf21, vf21, vf02        93
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // iaddi vi06, vi06, 0xc      |  addy.x vf22, vf22, vf02        94
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  vi06 = vi06 + 12;
+  // unrolled loop: iteration 6 of 8
+  // nop                        |  addz.x vf23, vf23, vf02        67
+  vf23 = _mm_blend_ps(vf23, _mm_add_ps(vf23, vu_bc<2>(vf02)), 0b0001);
+  // nop                        |  addw.x vf15, vf15, vf02        68
+  vf15 = _mm_blend_ps(vf15, _mm_add_ps(vf15, vu_bc<3>(vf02)), 0b0001);
+  // sq.xyzw vf20, 2(vi06)      |  mulx.x vf28, vf01, vf24        69
+  vf28 = _mm_mul_ps(vf01, vu_bc<0>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf21, 5(vi06)      |  muly.x vf29, vf01, vf24        70
+  vf29 = _mm_mul_ps(vf01, vu_bc<1>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 5) & 0x3ff, vf21);
+  // sq.xyzw vf22, 8(vi06)      |  mulz.x vf30, vf01, vf24        71
+  vf30 = _mm_mul_ps(vf01, vu_bc<2>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 8) & 0x3ff, vf22);
+  // sq.xyzw vf23, 11(vi06)     |  mulw.x vf31, vf01, vf24        72
+  vf31 = _mm_mul_ps(vf01, vu_bc<3>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 11) & 0x3ff, vf23);
+  // lq.xyzw vf16, 0(vi05)      |  mulx.y vf28, vf01, vf26        73
+  vf28 = _mm_blend_ps(vf28, _mm_mul_ps(vf01, vu_bc<0>(vf26)), 0b0010);
+  vf16 = vu_lq(vu.data, vi05 & 0x3ff);
+  // lq.xyzw vf17, 2(vi05)      |  muly.y vf29, vf01, vf26        74
+  vf29 = _mm_blend_ps(vf29, _mm_mul_ps(vf01, vu_bc<1>(vf26)), 0b0010);
+  vf17 = vu_lq(vu.data, (vi05 + 2) & 0x3ff);
+  // lq.xyzw vf18, 4(vi05)      |  mulz.y vf30, vf01, vf26        75
+  vf30 = _mm_blend_ps(vf30, _mm_mul_ps(vf01, vu_bc<2>(vf26)), 0b0010);
+  vf18 = vu_lq(vu.data, (vi05 + 4) & 0x3ff);
+  // lq.xyzw vf19, 6(vi05)      |  mulw.y vf31, vf01, vf26        76
+  vf31 = _mm_blend_ps(vf31, _mm_mul_ps(vf01, vu_bc<3>(vf26)), 0b0010);
+  vf19 = vu_lq(vu.data, (vi05 + 6) & 0x3ff);
+  // iaddi vi05, vi05, 0x8      |  ftoi0.xyzw vf16, vf16          77
+  vf16 = vu_ftoi<0>(vf16);
+  vi05 = vi05 + 8;
+  // nop                        |  ftoi0.xyzw vf17, vf17          78
+  vf17 = vu_ftoi<0>(vf17);
+  // nop                        |  ftoi0.xyzw vf18, vf18          79
+  vf18 = vu_ftoi<0>(vf18);
+  // iaddi vi01, vi01, -0x1     |  ftoi0.xyzw vf19, vf19          80
+  vf19 = vu_ftoi<0>(vf19);
+  vi01 = vi01 - 1;
+  // sq.xyzw vf16, 1(vi06)      |  add.xyzw vf28, vf28, vf07      81
+  vf28 = _mm_add_ps(vf28, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf17, 4(vi06)      |  add.xyzw vf29, vf29, vf07      82
+  vf29 = _mm_add_ps(vf29, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf18, 7(vi06)      |  add.xyzw vf30, vf30, vf07      83
+  vf30 = _mm_add_ps(vf30, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 7) & 0x3ff, vf18);
+  // sq.xyzw vf19, 10(vi06)     |  add.xyzw vf31, vf31, vf07      84
+  vf31 = _mm_add_ps(vf31, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 10) & 0x3ff, vf19);
+  // lq.xyzw vf24, 1(vi05)      |  sub.zw vf28, vf01, vf00        85
+  vf28 = _mm_blend_ps(vf28, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  sub.zw vf29, vf01, vf00        86
+  vf29 = _mm_blend_ps(vf29, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  sub.zw vf30, vf01, vf00        87
+  vf30 = _mm_blend_ps(vf30, _mm_sub_ps(vf01, vf00), 0b1100);
+  // nop                        |  sub.zw vf31, vf01, vf00        88
+  vf31 = _mm_blend_ps(vf31, _mm_sub_ps(vf01, vf00), 0b1100);
+  // sq.xyzw vf28, 0(vi06)      |  mulw.xyzw vf20, vf15, vf00     89
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // sq.xyzw vf29, 3(vi06)      |  mulw.xyzw vf21, vf15, vf00     90
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf30, 6(vi06)      |  mulw.xyzw vf22, vf15, vf00     91
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 6) & 0x3ff, vf30);
+  // sq.xyzw vf31, 9(vi06)      |  mulw.xyzw vf23, vf15, vf00     92
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 9) & 0x3ff, vf31);
+  // ibgtz vi01, L4             |  addx.x vf21, vf21, vf02        93
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // iaddi vi06, vi06, 0xc      |  addy.x vf22, vf22, vf02        94
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  vi06 = vi06 + 12;
+  // unrolled loop: iteration 7 of 8
+  // nop                        |  addz.x vf23, vf23, vf02        67
+  vf23 = _mm_blend_ps(vf23, _mm_add_ps(vf23, vu_bc<2>(vf02)), 0b0001);
+  // nop                        |  addw.x vf15, vf15, vf02        68
+  vf15 = _mm_blend_ps(vf15, _mm_add_ps(vf15, vu_bc<3>(vf02)), 0b0001);
+  // sq.xyzw vf20, 2(vi06)      |  mulx.x vf28, vf01, vf24        69
+  vf28 = _mm_mul_ps(vf01, vu_bc<0>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf21, 5(vi06)      |  muly.x vf29, vf01, vf24        70
+  vf29 = _mm_mul_ps(vf01, vu_bc<1>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 5) & 0x3ff, vf21);
+  // sq.xyzw vf22, 8(vi06)      |  mulz.x vf30, vf01, vf24        71
+  vf30 = _mm_mul_ps(vf01, vu_bc<2>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 8) & 0x3ff, vf22);
+  // sq.xyzw vf23, 11(vi06)     |  mulw.x vf31, vf01, vf24        72
+  vf31 = _mm_mul_ps(vf01, vu_bc<3>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 11) & 0x3ff, vf23);
+  // lq.xyzw vf16, 0(vi05)      |  mulx.y vf28, vf01, vf26        73
+  vf28 = _mm_blend_ps(vf28, _mm_mul_ps(vf01, vu_bc<0>(vf26)), 0b0010);
+  vf16 = vu_lq(vu.data, vi05 & 0x3ff);
+  // lq.xyzw vf17, 2(vi05)      |  muly.y vf29, vf01, vf26        74
+  vf29 = _mm_blend_ps(vf29, _mm_mul_ps(vf01, vu_bc<1>(vf26)), 0b0010);
+  vf17 = vu_lq(vu.data, (vi05 + 2) & 0x3ff);
+  // lq.xyzw vf18, 4(vi05)      |  mulz.y vf30, vf01, vf26        75
+  vf30 = _mm_blend_ps(vf30, _mm_mul_ps(vf01, vu_bc<2>(vf26)), 0b0010);
+  vf18 = vu_lq(vu.data, (vi05 + 4) & 0x3ff);
+  // lq.xyzw vf19, 6(vi05)      |  mulw.y vf31, vf01, vf26        76
+  vf31 = _mm_blend_ps(vf31, _mm_mul_ps(vf01, vu_bc<3>(vf26)), 0b0010);
+  vf19 = vu_lq(vu.data, (vi05 + 6) & 0x3ff);
+  // iaddi vi05, vi05, 0x8      |  ftoi0.xyzw vf16, vf16          77
+  vf16 = vu_ftoi<0>(vf16);
+  vi05 = vi05 + 8;
+  // nop                        |  ftoi0.xyzw vf17, vf17          78
+  vf17 = vu_ftoi<0>(vf17);
+  // nop                        |  ftoi0.xyzw vf18, vf18          79
+  vf18 = vu_ftoi<0>(vf18);
+  // iaddi vi01, vi01, -0x1     |  ftoi0.xyzw vf19, vf19          80
+  vf19 = vu_ftoi<0>(vf19);
+  vi01 = vi01 - 1;
+  // sq.xyzw vf16, 1(vi06)      |  add.xyzw vf28, vf28, vf07      81
+  vf28 = _mm_add_ps(vf28, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf17, 4(vi06)      |  add.xyzw vf29, vf29, vf07      82
+  vf29 = _mm_add_ps(vf29, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf18, 7(vi06)      |  add.xyzw vf30, vf30, vf07      83
+  vf30 = _mm_add_ps(vf30, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 7) & 0x3ff, vf18);
+  // sq.xyzw vf19, 10(vi06)     |  add.xyzw vf31, vf31, vf07      84
+  vf31 = _mm_add_ps(vf31, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 10) & 0x3ff, vf19);
+  // lq.xyzw vf24, 1(vi05)      |  sub.zw vf28, vf01, vf00        85
+  vf28 = _mm_blend_ps(vf28, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  sub.zw vf29, vf01, vf00        86
+  vf29 = _mm_blend_ps(vf29, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  sub.zw vf30, vf01, vf00        87
+  vf30 = _mm_blend_ps(vf30, _mm_sub_ps(vf01, vf00), 0b1100);
+  // nop                        |  sub.zw vf31, vf01, vf00        88
+  vf31 = _mm_blend_ps(vf31, _mm_sub_ps(vf01, vf00), 0b1100);
+  // sq.xyzw vf28, 0(vi06)      |  mulw.xyzw vf20, vf15, vf00     89
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // sq.xyzw vf29, 3(vi06)      |  mulw.xyzw vf21, vf15, vf00     90
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf30, 6(vi06)      |  mulw.xyzw vf22, vf15, vf00     91
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 6) & 0x3ff, vf30);
+  // sq.xyzw vf31, 9(vi06)      |  mulw.xyzw vf23, vf15, vf00     92
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 9) & 0x3ff, vf31);
+  // ibgtz vi01, L4             |  addx.x vf21, vf21, vf02        93
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // iaddi vi06, vi06, 0xc      |  addy.x vf22, vf22, vf02        94
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  vi06 = vi06 + 12;
+  // unrolled loop: iteration 8 of 8
+  // nop                        |  addz.x vf23, vf23, vf02        67
+  vf23 = _mm_blend_ps(vf23, _mm_add_ps(vf23, vu_bc<2>(vf02)), 0b0001);
+  // nop                        |  addw.x vf15, vf15, vf02        68
+  vf15 = _mm_blend_ps(vf15, _mm_add_ps(vf15, vu_bc<3>(vf02)), 0b0001);
+  // sq.xyzw vf20, 2(vi06)      |  mulx.x vf28, vf01, vf24        69
+  vf28 = _mm_mul_ps(vf01, vu_bc<0>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf21, 5(vi06)      |  muly.x vf29, vf01, vf24        70
+  vf29 = _mm_mul_ps(vf01, vu_bc<1>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 5) & 0x3ff, vf21);
+  // sq.xyzw vf22, 8(vi06)      |  mulz.x vf30, vf01, vf24        71
+  vf30 = _mm_mul_ps(vf01, vu_bc<2>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 8) & 0x3ff, vf22);
+  // sq.xyzw vf23, 11(vi06)     |  mulw.x vf31, vf01, vf24        72
+  vf31 = _mm_mul_ps(vf01, vu_bc<3>(vf24));
+  vu_sq<0b1111>(vu.data, (vi06 + 11) & 0x3ff, vf23);
+  // lq.xyzw vf16, 0(vi05)      |  mulx.y vf28, vf01, vf26        73
+  vf28 = _mm_blend_ps(vf28, _mm_mul_ps(vf01, vu_bc<0>(vf26)), 0b0010);
+  vf16 = vu_lq(vu.data, vi05 & 0x3ff);
+  // lq.xyzw vf17, 2(vi05)      |  muly.y vf29, vf01, vf26        74
+  vf29 = _mm_blend_ps(vf29, _mm_mul_ps(vf01, vu_bc<1>(vf26)), 0b0010);
+  vf17 = vu_lq(vu.data, (vi05 + 2) & 0x3ff);
+  // lq.xyzw vf18, 4(vi05)      |  mulz.y vf30, vf01, vf26        75
+  vf30 = _mm_blend_ps(vf30, _mm_mul_ps(vf01, vu_bc<2>(vf26)), 0b0010);
+  vf18 = vu_lq(vu.data, (vi05 + 4) & 0x3ff);
+  // lq.xyzw vf19, 6(vi05)      |  mulw.y vf31, vf01, vf26        76
+  vf31 = _mm_blend_ps(vf31, _mm_mul_ps(vf01, vu_bc<3>(vf26)), 0b0010);
+  vf19 = vu_lq(vu.data, (vi05 + 6) & 0x3ff);
+  // iaddi vi05, vi05, 0x8      |  ftoi0.xyzw vf16, vf16          77
+  vf16 = vu_ftoi<0>(vf16);
+  vi05 = vi05 + 8;
+  // nop                        |  ftoi0.xyzw vf17, vf17          78
+  vf17 = vu_ftoi<0>(vf17);
+  // nop                        |  ftoi0.xyzw vf18, vf18          79
+  vf18 = vu_ftoi<0>(vf18);
+  // iaddi vi01, vi01, -0x1     |  ftoi0.xyzw vf19, vf19          80
+  vf19 = vu_ftoi<0>(vf19);
+  vi01 = vi01 - 1;
+  // sq.xyzw vf16, 1(vi06)      |  add.xyzw vf28, vf28, vf07      81
+  vf28 = _mm_add_ps(vf28, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf17, 4(vi06)      |  add.xyzw vf29, vf29, vf07      82
+  vf29 = _mm_add_ps(vf29, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf18, 7(vi06)      |  add.xyzw vf30, vf30, vf07      83
+  vf30 = _mm_add_ps(vf30, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 7) & 0x3ff, vf18);
+  // sq.xyzw vf19, 10(vi06)     |  add.xyzw vf31, vf31, vf07      84
+  vf31 = _mm_add_ps(vf31, vf07);
+  vu_sq<0b1111>(vu.data, (vi06 + 10) & 0x3ff, vf19);
+  // lq.xyzw vf24, 1(vi05)      |  sub.zw vf28, vf01, vf00        85
+  vf28 = _mm_blend_ps(vf28, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf24 = vu_lq(vu.data, (vi05 + 1) & 0x3ff);
+  // lq.xyzw vf26, 5(vi05)      |  sub.zw vf29, vf01, vf00        86
+  vf29 = _mm_blend_ps(vf29, _mm_sub_ps(vf01, vf00), 0b1100);
+  vf26 = vu_lq(vu.data, (vi05 + 5) & 0x3ff);
+  // nop                        |  sub.zw vf30, vf01, vf00        87
+  vf30 = _mm_blend_ps(vf30, _mm_sub_ps(vf01, vf00), 0b1100);
+  // nop                        |  sub.zw vf31, vf01, vf00        88
+  vf31 = _mm_blend_ps(vf31, _mm_sub_ps(vf01, vf00), 0b1100);
+  // sq.xyzw vf28, 0(vi06)      |  mulw.xyzw vf20, vf15, vf00     89
+  vf20 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // sq.xyzw vf29, 3(vi06)      |  mulw.xyzw vf21, vf15, vf00     90
+  vf21 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf30, 6(vi06)      |  mulw.xyzw vf22, vf15, vf00     91
+  vf22 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 6) & 0x3ff, vf30);
+  // sq.xyzw vf31, 9(vi06)      |  mulw.xyzw vf23, vf15, vf00     92
+  vf23 = _mm_mul_ps(vf15, vu_bc<3>(vf00));
+  vu_sq<0b1111>(vu.data, (vi06 + 9) & 0x3ff, vf31);
+  // ibgtz vi01, L4             |  addx.x vf21, vf21, vf02        93
+  vf21 = _mm_blend_ps(vf21, _mm_add_ps(vf21, vu_bc<0>(vf02)), 0b0001);
+  // iaddi vi06, vi06, 0xc      |  addy.x vf22, vf22, vf02        94
+  vf22 = _mm_blend_ps(vf22, _mm_add_ps(vf22, vu_bc<1>(vf02)), 0b0001);
+  vi06 = vi06 + 12;
+  // lq.xyzw vf28, 0(vi07)      |  addx.y vf14, vf14, vf02        95
+  vf14 = _mm_blend_ps(vf14, _mm_add_ps(vf14, vu_bc<0>(vf02)), 0b0010);
+  vf28 = vu_lq(vu.data, vi07 & 0x3ff);
+  // lq.xyzw vf16, 1(vi07)      |  nop                            96
+  vf16 = vu_lq(vu.data, (vi07 + 1) & 0x3ff);
+  // sq.xyzw vf20, 2(vi06)      |  nop                            97
+  vu_sq<0b1111>(vu.data, (vi06 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf28, 0(vi06)      |  nop                            98
+  vu_sq<0b1111>(vu.data, vi06 & 0x3ff, vf28);
+  // jr vi12                    |  nop                            99
+  jr_target = vi12;
+  // sq.xyzw vf16, 1(vi06)      |  nop                            100
+  vu_sq<0b1111>(vu.data, (vi06 + 1) & 0x3ff, vf16);
+  goto JUMP_REGISTER;
+L5:
+  // iaddiu vi01, vi00, 0x21    |  nop                            101
+  vi01 = 0x21;
+  // sq.xyzw vf05, 0(vi08)      |  nop                            102
+  vu_sq<0b1111>(vu.data, vi08 & 0x3ff, vf05);
+  // iaddi vi08, vi08, 0x1      |  nop                            103
+  vi08 = vi08 + 1;
+L6:
+  // iaddi vi01, vi01, -0x1     |  nop                            104
+  vi01 = vi01 - 1;
+  // lq.xyzw vf20, 2(vi03)      |  nop                            105
+  vf20 = vu_lq(vu.data, (vi03 + 2) & 0x3ff);
+  // lq.xyzw vf21, 2(vi04)      |  nop                            106
+  vf21 = vu_lq(vu.data, (vi04 + 2) & 0x3ff);
+  // lq.xyzw vf28, 0(vi03)      |  nop                            107
+  vf28 = vu_lq(vu.data, vi03 & 0x3ff);
+  // lq.xyzw vf16, 1(vi03)      |  nop                            108
+  vf16 = vu_lq(vu.data, (vi03 + 1) & 0x3ff);
+  // lq.xyzw vf29, 0(vi04)      |  ftoi4.xyzw vf20, vf20          109
+  vf20 = vu_ftoi<4>(vf20);
+  vf29 = vu_lq(vu.data, vi04 & 0x3ff);
+  // lq.xyzw vf17, 1(vi04)      |  ftoi4.xyzw vf21, vf21          110
+  vf21 = vu_ftoi<4>(vf21);
+  vf17 = vu_lq(vu.data, (vi04 + 1) & 0x3ff);
+  // sq.xyzw vf28, 0(vi08)      |  nop                            111
+  vu_sq<0b1111>(vu.data, vi08 & 0x3ff, vf28);
+  // sq.xyzw vf16, 1(vi08)      |  nop                            112
+  vu_sq<0b1111>(vu.data, (vi08 + 1) & 0x3ff, vf16);
+  // sq.xyzw vf20, 2(vi08)      |  nop                            113
+  vu_sq<0b1111>(vu.data, (vi08 + 2) & 0x3ff, vf20);
+  // sq.xyzw vf29, 3(vi08)      |  nop                            114
+  vu_sq<0b1111>(vu.data, (vi08 + 3) & 0x3ff, vf29);
+  // sq.xyzw vf17, 4(vi08)      |  nop                            115
+  vu_sq<0b1111>(vu.data, (vi08 + 4) & 0x3ff, vf17);
+  // sq.xyzw vf21, 5(vi08)      |  nop                            116
+  vu_sq<0b1111>(vu.data, (vi08 + 5) & 0x3ff, vf21);
+  // iaddi vi03, vi03, 0x3      |  nop                            117
+  vi03 = vi03 + 3;
+  // iaddi vi04, vi04, 0x3      |  nop                            118
+  vi04 = vi04 + 3;
+  // ibgtz vi01, L6             |  nop                            119
+  bc = ((s16)vi01) > 0;
+  // iaddi vi08, vi08, 0x6      |  nop                            120
+  vi08 = vi08 + 6;
+  if (bc) {
+    goto L6;
+  }
+  // xgkick vi09                |  nop                            121
+  xgkick(vi09);
+  // mtir vi08, vf03.x          |  nop                            122
+  vi08 = vu_lane_u16<0>(vf03);
+  // mtir vi09, vf03.x          |  nop                            123
+  vi09 = vu_lane_u16<0>(vf03);
+  // jr vi12                    |  nop                            124
+  jr_target = vi12;
+  // mr32.xyzw vf03, vf03       |  nop                            125
+  vf03 = vu_mr32(vf03);
+  goto JUMP_REGISTER;
+END:
+  _mm_store_ps(vu.vf[1].data, vf01);
+  _mm_store_ps(vu.vf[2].data, vf02);
+  _mm_store_ps(vu.vf[3].data, vf03);
+  _mm_store_ps(vu.vf[4].data, vf04);
+  _mm_store_ps(vu.vf[5].data, vf05);
+  _mm_store_ps(vu.vf[6].data, vf06);
+  _mm_store_ps(vu.vf[7].data, vf07);
+  _mm_store_ps(vu.vf[14].data, vf14);
+  _mm_store_ps(vu.vf[15].data, vf15);
+  _mm_store_ps(vu.vf[16].data, vf16);
+  _mm_store_ps(vu.vf[17].data, vf17);
+  _mm_store_ps(vu.vf[18].data, vf18);
+  _mm_store_ps(vu.vf[19].data, vf19);
+  _mm_store_ps(vu.vf[20].data, vf20);
+  _mm_store_ps(vu.vf[21].data, vf21);
+  _mm_store_ps(vu.vf[22].data, vf22);
+  _mm_store_ps(vu.vf[23].data, vf23);
+  _mm_store_ps(vu.vf[24].data, vf24);
+  _mm_store_ps(vu.vf[26].data, vf26);
+  _mm_store_ps(vu.vf[28].data, vf28);
+  _mm_store_ps(vu.vf[29].data, vf29);
+  _mm_store_ps(vu.vf[30].data, vf30);
+  _mm_store_ps(vu.vf[31].data, vf31);
+  vu.vi[1] = vi01;
+  vu.vi[3] = vi03;
+  vu.vi[4] = vi04;
+  vu.vi[5] = vi05;
+  vu.vi[6] = vi06;
+  vu.vi[7] = vi07;
+  vu.vi[8] = vi08;
+  vu.vi[9] = vi09;
+  vu.vi[11] = vi11;
+  vu.vi[12] = vi12;
+  return;
+
+JUMP_REGISTER:
+  switch (jr_target) {
+    case 23:
+      goto I23;
+    case 26:
+      goto I26;
+    case 29:
+      goto I29;
+    case 32:
+      goto I32;
+    case 35:
+      goto I35;
+    case 41:
+      goto I41;
+    case 44:
+      goto I44;
+    case 47:
+      goto I47;
+    case 50:
+      goto I50;
+    case 53:
+      goto I53;
+    case 56:
+      goto I56;
+    default:
+      ASSERT_NOT_REACHED();
+  }
+}
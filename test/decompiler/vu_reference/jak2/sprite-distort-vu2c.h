@@ -0,0 +1,221 @@
+#pragma once
+
+// Generated by tools/vu2c from sprite-distort.txt, regenerate it instead of editing it.
+
+#include "game/common/vu2c.h"
+
+/*!
+ * Run the program from the instruction start (the mscal address / 8) until it ends.
+ * xgkick is called with the address for each xgkick.
+ */
+template <typename Kick>
+void sprite_distort_program(VuState& vu, u16 start, Kick&& xgkick) {
+  __m128 vf01 = vu.vf[1].load();
+  __m128 vf02 = vu.vf[2].load();
+  __m128 vf03 = vu.vf[3].load();
+  __m128 vf04 = vu.vf[4].load();
+  __m128 vf05 = vu.vf[5].load();
+  __m128 vf06 = vu.vf[6].load();
+  __m128 vf07 = vu.vf[7].load();
+  __m128 vf08 = vu.vf[8].load();
+  __m128 vf09 = vu.vf[9].load();
+  __m128 vf10 = vu.vf[10].load();
+  __m128 vf11 = vu.vf[11].load();
+  __m128 vf12 = vu.vf[12].load();
+  __m128 vf13 = vu.vf[13].load();
+  __m128 vf14 = vu.vf[14].load();
+  u16 vi01 = vu.vi[1];
+  u16 vi02 = vu.vi[2];
+  u16 vi03 = vu.vi[3];
+  u16 vi04 = vu.vi[4];
+  u16 vi05 = vu.vi[5];
+  u16 vi06 = vu.vi[6];
+  u16 vi07 = vu.vi[7];
+  u16 vi08 = vu.vi[8];
+  bool bc = false;
+
+  switch (start) {
+    case 0:
+      goto I0;
+    default:
+      ASSERT_NOT_REACHED();
+  }
+
+I0:
+  // lq.xyzw vf01, 489(vi00)    |  nop                            0
+  vf01 = vu_lq(vu.data, 489);
+  // lq.xyzw vf05, 490(vi00)    |  nop                            1
+  vf05 = vu_lq(vu.data, 490);
+  // ilw.x vi01, 511(vi00)      |  nop                            2
+  vi01 = vu_ilw<0>(vu.data, 511);
+  // iaddiu vi04, vi00, 0x200   |  nop                            3
+  vi04 = 0x200;
+  // iaddi vi02, vi00, 0x0      |  nop                            4
+  vi02 = 0x0;
+L1:
+  // ilw.w vi07, 1(vi04)        |  nop                            5
+  vi07 = vu_ilw<3>(vu.data, (vi04 + 1) & 0x3ff);
+  // ior vi05, vi02, vi00       |  nop                            6
+  vi05 = vi02;
+  // ilw.x vi06, 477(vi07)      |  nop                            7
+  vi06 = vu_ilw<0>(vu.data, (vi07 + 477) & 0x3ff);
+  // sqi.xyzw vf01, vi05        |  nop                            8
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf01);
+  vi05++;
+  // iaddiu vi08, vi07, 0x4000  |  nop                            9
+  vi08 = vi07 + 16384;
+  // iaddiu vi08, vi08, 0x4000  |  nop                            10
+  vi08 = vi08 + 16384;
+  // isw.x vi08, -1(vi05)       |  nop                            11
+  vu_isw<0b0001>(vu.data, (vi05 - 1) & 0x3ff, vi08);
+  // lqi.xyzw vf02, vi04        |  nop                            12
+  vf02 = vu_lq(vu.data, vi04 & 0x3ff);
+  vi04++;
+  // lqi.xyzw vf03, vi04        |  nop                            13
+  vf03 = vu_lq(vu.data, vi04 & 0x3ff);
+  vi04++;
+  // lqi.xyzw vf04, vi04        |  nop                            14
+  vf04 = vu_lq(vu.data, vi04 & 0x3ff);
+  vi04++;
+  // nop                        |  ftoi4.xyzw vf14, vf02          15
+  vf14 = vu_ftoi<4>(vf02);
+L2:
+  // lqi.xyzw vf06, vi06        |  nop                            16
+  vf06 = vu_lq(vu.data, vi06 & 0x3ff);
+  vi06++;
+  // lqi.xyzw vf07, vi06        |  nop                            17
+  vf07 = vu_lq(vu.data, vi06 & 0x3ff);
+  vi06++;
+  // lq.xyzw vf08, 0(vi06)      |  nop                            18
+  vf08 = vu_lq(vu.data, vi06 & 0x3ff);
+  // lq.xyzw vf09, 1(vi06)      |  nop                            19
+  vf09 = vu_lq(vu.data, (vi06 + 1) & 0x3ff);
+  // iaddi vi07, vi07, -0x1     |  muly.xyzw vf10, vf06, vf04     20
+  vf10 = _mm_mul_ps(vf06, vu_bc<1>(vf04));
+  vi07 = vi07 - 1;
+  // nop                        |  mulz.xyzw vf11, vf07, vf04     21
+  vf11 = _mm_mul_ps(vf07, vu_bc<2>(vf04));
+  // nop                        |  muly.xyzw vf12, vf08, vf04     22
+  vf12 = _mm_mul_ps(vf08, vu_bc<1>(vf04));
+  // nop                        |  mulz.xyzw vf13, vf09, vf04     23
+  vf13 = _mm_mul_ps(vf09, vu_bc<2>(vf04));
+  // nop                        |  mulx.xyzw vf06, vf06, vf04     24
+  vf06 = _mm_mul_ps(vf06, vu_bc<0>(vf04));
+  // nop                        |  mulx.xyzw vf07, vf07, vf04     25
+  vf07 = _mm_mul_ps(vf07, vu_bc<0>(vf04));
+  // nop                        |  mulx.xyzw vf08, vf08, vf04     26
+  vf08 = _mm_mul_ps(vf08, vu_bc<0>(vf04));
+  // nop                        |  mulx.xyzw vf09, vf09, vf04     27
+  vf09 = _mm_mul_ps(vf09, vu_bc<0>(vf04));
+  // nop                        |  add.xyzw vf10, vf10, vf02      28
+  vf10 = _mm_add_ps(vf10, vf02);
+  // nop                        |  add.xyzw vf11, vf11, vf03      29
+  vf11 = _mm_add_ps(vf11, vf03);
+  // nop                        |  add.xyzw vf12, vf12, vf02      30
+  vf12 = _mm_add_ps(vf12, vf02);
+  // nop                        |  add.xyzw vf13, vf13, vf03      31
+  vf13 = _mm_add_ps(vf13, vf03);
+  // nop                        |  add.xyzw vf06, vf06, vf02      32
+  vf06 = _mm_add_ps(vf06, vf02);
+  // nop                        |  add.xyzw vf07, vf07, vf03      33
+  vf07 = _mm_add_ps(vf07, vf03);
+  // nop                        |  add.xyzw vf08, vf08, vf02      34
+  vf08 = _mm_add_ps(vf08, vf02);
+  // nop                        |  add.xyzw vf09, vf09, vf03      35
+  vf09 = _mm_add_ps(vf09, vf03);
+  // nop                        |  ftoi4.xyzw vf10, vf10          36
+  vf10 = vu_ftoi<4>(vf10);
+  // nop                        |  ftoi4.xyzw vf12, vf12          37
+  vf12 = vu_ftoi<4>(vf12);
+  // nop                        |  ftoi4.xyzw vf06, vf06          38
+  vf06 = vu_ftoi<4>(vf06);
+  // nop                        |  ftoi4.xyzw vf08, vf08          39
+  vf08 = vu_ftoi<4>(vf08);
+  // sqi.xyzw vf07, vi05        |  nop                            40
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf07);
+  vi05++;
+  // sqi.xyzw vf05, vi05        |  nop                            41
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf05);
+  vi05++;
+  // sqi.xyzw vf06, vi05        |  nop                            42
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf06);
+  vi05++;
+  // sqi.xyzw vf09, vi05        |  nop                            43
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf09);
+  vi05++;
+  // sqi.xyzw vf05, vi05        |  nop                            44
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf05);
+  vi05++;
+  // sqi.xyzw vf08, vi05        |  nop                            45
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf08);
+  vi05++;
+  // sqi.xyzw vf11, vi05        |  nop                            46
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf11);
+  vi05++;
+  // sqi.xyzw vf05, vi05        |  nop                            47
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf05);
+  vi05++;
+  // sqi.xyzw vf10, vi05        |  nop                            48
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf10);
+  vi05++;
+  // sqi.xyzw vf13, vi05        |  nop                            49
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf13);
+  vi05++;
+  // sqi.xyzw vf05, vi05        |  nop                            50
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf05);
+  vi05++;
+  // sqi.xyzw vf12, vi05        |  nop                            51
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf12);
+  vi05++;
+  // sqi.xyzw vf03, vi05        |  nop                            52
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf03);
+  vi05++;
+  // sqi.xyzw vf05, vi05        |  nop                            53
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf05);
+  vi05++;
+  // ibne vi00, vi07, L2        |  nop                            54
+  bc = 0 != vi07;
+  // sqi.xyzw vf14, vi05        |  nop                            55
+  vu_sq<0b1111>(vu.data, vi05 & 0x3ff, vf14);
+  vi05++;
+  if (bc) {
+    goto L2;
+  }
+  // xgkick vi02                |  nop                            56
+  xgkick(vi02);
+  // iaddi vi01, vi01, -0x1     |  nop                            57
+  vi01 = vi01 - 1;
+  // iaddiu vi03, vi00, 0xb0    |  nop                            58
+  vi03 = 0xb0;
+  // ibne vi00, vi01, L1        |  nop                            59
+  bc = 0 != vi01;
+  // isub vi02, vi03, vi02      |  nop                            60
+  vi02 = vi03 - vi02;
+  if (bc) {
+    goto L1;
+  }
+  // nop                        |  nop :e                         61
+  // nop                        |  nop                            62
+  _mm_store_ps(vu.vf[1].data, vf01);
+  _mm_store_ps(vu.vf[2].data, vf02);
+  _mm_store_ps(vu.vf[3].data, vf03);
+  _mm_store_ps(vu.vf[4].data, vf04);
+  _mm_store_ps(vu.vf[5].data, vf05);
+  _mm_store_ps(vu.vf[6].data, vf06);
+  _mm_store_ps(vu.vf[7].data, vf07);
+  _mm_store_ps(vu.vf[8].data, vf08);
+  _mm_store_ps(vu.vf[9].data, vf09);
+  _mm_store_ps(vu.vf[10].data, vf10);
+  _mm_store_ps(vu.vf[11].data, vf11);
+  _mm_store_ps(vu.vf[12].data, vf12);
+  _mm_store_ps(vu.vf[13].data, vf13);
+  _mm_store_ps(vu.vf[14].data, vf14);
+  vu.vi[1] = vi01;
+  vu.vi[2] = vi02;
+  vu.vi[3] = vi03;
+  vu.vi[4] = vi04;
+  vu.vi[5] = vi05;
+  vu.vi[6] = vi06;
+  vu.vi[7] = vi07;
+  vu.vi[8] = vi08;
+}
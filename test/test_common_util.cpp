@@ -8,8 +8,10 @@
 #include "common/util/CopyOnWrite.h"
 #include "common/util/FileUtil.h"
 #include "common/util/Range.h"
+#include "common/util/Serializer.h"
 #include "common/util/SmallVector.h"
 #include "common/util/Trie.h"
+#include "common/util/WorkStealingPool.h"
 #include "common/util/crc32.h"
 #include "common/util/json_util.h"
 #include "common/util/os.h"
@@ -423,5 +425,114 @@ TEST(CRC32, Reference) {
   }
 }
 
+TEST(WorkStealingPool, NestedTasks) {
+  WorkStealingPool pool(4);
+  std::vector<std::vector<int>> results(16);
+  TaskGroup outer(pool);
+  for (int i = 0; i < 16; i++) {
+    outer.run([&, i]() {
+      // each task splits itself into sub-tasks and waits on them from inside the pool.
+      results[i].resize(100);
+      TaskGroup inner(pool);
+      for (int j = 0; j < 100; j++) {
+        inner.run([&, i, j]() { results[i][j] = i * j; });
+      }
+      inner.wait();
+    });
+  }
+  outer.wait();
+
+  for (int i = 0; i < 16; i++) {
+    for (int j = 0; j < 100; j++) {
+      EXPECT_EQ(results[i][j], i * j);
+    }
+  }
+}
+
+TEST(WorkStealingPool, Exception) {
+  WorkStealingPool pool(2);
+  std::atomic<int> count = 0;
+  TaskGroup group(pool);
+  for (int i = 0; i < 10; i++) {
+    group.run([&, i]() {
+      count++;
+      if (i == 5) {
+        throw std::runtime_error("task failed");
+      }
+    });
+  }
+  EXPECT_THROW(group.wait(), std::runtime_error);
+  EXPECT_EQ(count, 10);
+}
+
+TEST(WorkStealingPool, WaitOnlyRunsOwnTasks) {
+  WorkStealingPool pool(1);
+  auto main_thread = std::this_thread::get_id();
+  std::atomic<bool> in_wait = false;
+  std::atomic<int> others_run_in_wait = 0;
+  std::atomic<int> mine_run = 0;
+
+  TaskGroup others(pool);
+  for (int i = 0; i < 20; i++) {
+    others.run([&]() {
+      if (in_wait && std::this_thread::get_id() == main_thread) {
+        others_run_in_wait++;
+      }
+    });
+  }
+  TaskGroup mine(pool);
+  for (int i = 0; i < 20; i++) {
+    mine.run([&]() { mine_run++; });
+  }
+
+  in_wait = true;
+  mine.wait();
+  in_wait = false;
+  EXPECT_EQ(mine_run, 20);
+  EXPECT_EQ(others_run_in_wait, 0);
+  others.wait();
+}
+
+TEST(Serializer, BorrowLoad) {
+  Serializer saver;
+  std::vector<u32> in_vec = {1, 2, 3, 4, 5};
+  std::string in_str = "hello";
+  saver.from_pod_vector(&in_vec);
+  saver.save_str(&in_str);
+  auto [data, size] = saver.get_save_result();
+
+  std::vector<u8> buffer(data, data + size);
+  Serializer loader(buffer.data(), buffer.size(), Serializer::LoadMode::BORROW);
+  std::vector<u32> out_vec;
+  loader.from_pod_vector(&out_vec);
+  EXPECT_EQ(out_vec, in_vec);
+  EXPECT_EQ(loader.load_string(), in_str);
+  EXPECT_TRUE(loader.get_load_finished());
+}
+
+TEST(FileUtil, MappedFile) {
+  auto path = fs::temp_directory_path() / "jak_mapped_file_test.bin";
+  std::vector<u8> data;
+  for (int i = 0; i < 10000; i++) {
+    data.push_back(i * 7);
+  }
+  file_util::write_binary_file(path, data.data(), data.size());
+  {
+    file_util::MappedFile file(path);
+    ASSERT_EQ(file.size(), data.size());
+    EXPECT_EQ(memcmp(file.data(), data.data(), data.size()), 0);
+  }
+
+  file_util::write_binary_file(path, data.data(), 0);
+  {
+    file_util::MappedFile file(path);
+    EXPECT_EQ(file.size(), 0u);
+  }
+  fs::remove(path);
+
+  EXPECT_THROW(file_util::MappedFile(fs::temp_directory_path() / "jak_missing_file.bin"),
+               std::runtime_error);
+}
+
 }  // namespace test
 }  // namespace cu
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <vector>
+
+#include "common/custom_data/Fr3File.h"
+#include "common/util/compress.h"
+
+#include "gtest/gtest.h"
+
+#include "third-party/fmt/core.h"
+
+namespace {
+tfrag3::Level make_test_level() {
+  tfrag3::Level level;
+  level.level_name = "test-level";
+  for (int i = 0; i < 5; i++) {
+    auto& tex = level.textures.emplace_back();
+    tex.w = 4;
+    tex.h = 4;
+    tex.combo_id = 100 + i;
+    tex.data.resize(16, 0xff000000 + i);
+    tex.debug_name = fmt::format("tex-{}", i);
+  }
+  level.tfrag_trees[0].resize(2);
+  level.tie_trees[1].resize(3);
+  level.shrub_trees.resize(1);
+  level.collision.vertices.resize(7);
+  level.merc_data.indices = {0, 1, 2, UINT32_MAX, 2, 1, 0};
+  level.merc_data.vertices.resize(3);
+  for (int i = 0; i < 2; i++) {
+    auto& model = level.merc_data.models.emplace_back();
+    model.name = fmt::format("model-{}", i);
+    model.max_draws = i;
+    model.max_bones = 2 * i;
+    model.st_vif_add = 3;
+    model.xyz_scale = 1.f;
+    model.st_magic = 2.f;
+  }
+  return level;
+}
+
+std::vector<u8> serialize_level(tfrag3::Level& level) {
+  Serializer ser;
+  level.serialize(ser);
+  auto [data, size] = ser.get_save_result();
+  return std::vector<u8>(data, data + size);
+}
+}  // namespace
+
+TEST(Fr3File, ChunkedRoundTrip) {
+  auto level = make_test_level();
+  auto expected = serialize_level(level);
+
+  auto file = tfrag3::write_fr3_chunked(level);
+  tfrag3::Fr3Reader reader(file.data(), file.size());
+  EXPECT_TRUE(reader.is_chunked());
+
+  // read all at once
+  tfrag3::Level loaded;
+  reader.read_all(&loaded);
+  EXPECT_EQ(serialize_level(loaded), expected);
+
+  // read section by section, in reverse, to check that the order doesn't matter.
+  tfrag3::Level loaded_sections;
+  reader.read_info(&loaded_sections);
+  auto sections = reader.data_sections();
+  std::reverse(sections.begin(), sections.end());
+  for (auto& section : sections) {
+    reader.read_section(section, &loaded_sections);
+  }
+  EXPECT_EQ(serialize_level(loaded_sections), expected);
+}
+
+TEST(Fr3File, ReadV1) {
+  auto level = make_test_level();
+  auto expected = serialize_level(level);
+  auto file = compression::compress_zstd(expected.data(), expected.size());
+
+  tfrag3::Fr3Reader reader(file.data(), file.size());
+  EXPECT_FALSE(reader.is_chunked());
+  tfrag3::Level loaded;
+  reader.read_all(&loaded);
+  EXPECT_EQ(serialize_level(loaded), expected);
+}
@@ -0,0 +1,129 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/util/FileUtil.h"
+
+#include "game/graphics/opengl_renderer/FrameTelemetry.h"
+#include "gtest/gtest.h"
+
+namespace {
+FrameTelemetryRecord make_frame(u64 idx, float frame_ms) {
+  FrameTelemetryRecord record;
+  record.frame = idx;
+  record.frame_ms = frame_ms;
+  record.target_ms = 1000.f / 60.f;
+  record.render_ms = frame_ms / 2;
+  record.rendered = 1;
+  return record;
+}
+}  // namespace
+
+TEST(FrameTelemetry, HistogramPercentiles) {
+  TimeHistogram hist;
+  EXPECT_EQ(hist.percentile(0.5f), 0.f);
+  for (int i = 1; i <= 100; i++) {
+    hist.add(i);
+  }
+  EXPECT_EQ(hist.count(), 100u);
+  EXPECT_NEAR(hist.percentile(0.5f), 50.f, TimeHistogram::BIN_MS);
+  EXPECT_NEAR(hist.percentile(0.95f), 95.f, TimeHistogram::BIN_MS);
+  EXPECT_NEAR(hist.percentile(0.99f), 99.f, TimeHistogram::BIN_MS);
+  EXPECT_EQ(hist.percentile(1.f), 100.f);
+  EXPECT_FLOAT_EQ(hist.mean(), 50.5f);
+
+  // past the last bin, percentiles are clamped to the slowest sample.
+  hist.add(1000.f);
+  EXPECT_EQ(hist.max(), 1000.f);
+  EXPECT_EQ(hist.percentile(1.f), 1000.f);
+}
+
+TEST(FrameTelemetry, Hitches) {
+  HitchDetector hitches;
+  u64 idx = 0;
+  for (int i = 0; i < 100; i++) {
+    EXPECT_FALSE(hitches.add(make_frame(idx++, 16.7f)));
+  }
+  // slow, but not late enough to notice.
+  EXPECT_FALSE(hitches.add(make_frame(idx++, 19.f)));
+  EXPECT_TRUE(hitches.add(make_frame(idx++, 50.f)));
+  EXPECT_TRUE(hitches.add(make_frame(idx++, 120.f)));
+  // the hitches didn't change what counts as normal.
+  EXPECT_TRUE(hitches.add(make_frame(idx++, 40.f)));
+  EXPECT_EQ(hitches.count(), 3u);
+  ASSERT_EQ(hitches.worst().size(), 3u);
+  EXPECT_EQ(hitches.worst()[0].frame_ms, 120.f);
+  EXPECT_EQ(hitches.worst()[1].frame_ms, 50.f);
+  EXPECT_EQ(hitches.worst()[2].frame_ms, 40.f);
+
+  for (int i = 0; i < 20; i++) {
+    hitches.add(make_frame(idx++, 60.f + i));
+  }
+  EXPECT_EQ(hitches.count(), 23u);
+  ASSERT_EQ((int)hitches.worst().size(), HitchDetector::WORST_COUNT);
+  EXPECT_EQ(hitches.worst().front().frame_ms, 120.f);
+  EXPECT_EQ(hitches.worst().back().frame_ms, 71.f);
+}
+
+TEST(FrameTelemetry, Csv) {
+  auto path = fs::temp_directory_path() / "jak_frame_telemetry_test.csv";
+  auto summary_path = path;
+  summary_path += ".summary.txt";
+  {
+    FrameTelemetry telemetry(path, FrameTelemetry::Format::CSV, {"sky", "tfrag"},
+                             {"tfrag", "other"});
+    ASSERT_TRUE(telemetry.ok());
+    for (int i = 0; i < 10; i++) {
+      telemetry.add_frame(make_frame(i, 16.f), {0.5f, 2.f}, {2.f, 0.5f});
+    }
+  }
+
+  std::istringstream csv(file_util::read_text_file(path));
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(csv, line);) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), 11u);
+  EXPECT_EQ(lines[0].find("frame,frame_ms,target_ms,"), 0u);
+  EXPECT_NE(lines[0].find(",rendered,tfrag_ms,other_ms"), std::string::npos);
+  EXPECT_EQ(lines[3],
+            "2,16.000,16.667,8.000,0.000,0.000,0.000,0.000,0.000,0,0,0,0,0,1,2.000,0.500");
+
+  auto summary = file_util::read_text_file(summary_path);
+  EXPECT_NE(summary.find("10 frames (10 rendered)"), std::string::npos);
+  EXPECT_NE(summary.find("tfrag"), std::string::npos);
+  fs::remove(path);
+  fs::remove(summary_path);
+}
+
+TEST(FrameTelemetry, Binary) {
+  auto path = fs::temp_directory_path() / "jak_frame_telemetry_test.bin";
+  auto summary_path = path;
+  summary_path += ".summary.txt";
+  {
+    FrameTelemetry telemetry(path, FrameTelemetry::Format::BINARY, {"sky", "tfrag", "merc"},
+                             {"tfrag", "other"});
+    ASSERT_TRUE(telemetry.ok());
+    // enough to flush a few times.
+    for (int i = 0; i < 2000; i++) {
+      auto record = make_frame(i, 16.f + (i % 7));
+      record.draw_calls = i;
+      telemetry.add_frame(record, {0.5f, 2.f, (float)i}, {2.f, 0.5f + i});
+    }
+  }
+
+  auto file = read_frame_telemetry(path);
+  EXPECT_EQ(file.bucket_names, std::vector<std::string>({"sky", "tfrag", "merc"}));
+  EXPECT_EQ(file.category_names, std::vector<std::string>({"tfrag", "other"}));
+  ASSERT_EQ(file.frames.size(), 2000u);
+  for (int i = 0; i < 2000; i++) {
+    auto& frame = file.frames[i];
+    EXPECT_EQ(frame.record.frame, (u64)i);
+    EXPECT_EQ(frame.record.frame_ms, 16.f + (i % 7));
+    EXPECT_EQ(frame.record.draw_calls, (u32)i);
+    EXPECT_EQ(frame.bucket_ms, std::vector<float>({0.5f, 2.f, (float)i}));
+    EXPECT_EQ(frame.category_ms, std::vector<float>({2.f, 0.5f + i}));
+  }
+  fs::remove(path);
+  fs::remove(summary_path);
+}
@@ -0,0 +1,77 @@
+#include <vector>
+
+#include "common/goal_constants.h"
+#include "common/util/FileUtil.h"
+
+#include "game/graphics/gfx_capture.h"
+#include "gtest/gtest.h"
+
+namespace {
+void add_event(GfxCaptureWriter& writer,
+               GfxCaptureEvent::Kind kind,
+               u32 arg,
+               int bucket,
+               const std::vector<u8>& memory,
+               bool sync_memory) {
+  GfxCaptureEvent event;
+  event.kind = kind;
+  event.args[0] = arg;
+  event.bucket = bucket;
+  writer.add(event, memory.data(), sync_memory);
+}
+}  // namespace
+
+TEST(GfxCapture, UploadsDuringChainsKeepTheirFrame) {
+  using Kind = GfxCaptureEvent::Kind;
+  auto path = fs::temp_directory_path() / "jak_gfx_capture_test.gcap";
+  std::vector<u8> memory(EE_MAIN_MEM_SIZE);
+  {
+    GfxCaptureWriter writer(path, GameVersion::Jak2, 0x1234, 2);
+    ASSERT_TRUE(writer.ok());
+    add_event(writer, Kind::SET_LEVELS, 0, -1, memory, false);
+    // from a chain sent before the capture, so it can't be replayed.
+    add_event(writer, Kind::TEXTURE_UPLOAD_NOW, 1, 5, memory, false);
+    memory[100] = 1;
+    add_event(writer, Kind::SEND_CHAIN, 2, -1, memory, true);
+    // the game thread starts on the next frame while the chain is rendered.
+    add_event(writer, Kind::TEXTURE_RELOCATE, 3, -1, memory, false);
+    add_event(writer, Kind::TEXTURE_UPLOAD_NOW, 4, 3, memory, false);
+    add_event(writer, Kind::SEND_CHAIN, 5, -1, memory, true);
+    add_event(writer, Kind::TEXTURE_UPLOAD_NOW, 6, 7, memory, false);
+    EXPECT_FALSE(writer.done());
+    // the chain after the last frame ends the capture.
+    add_event(writer, Kind::SEND_CHAIN, 7, -1, memory, true);
+    EXPECT_TRUE(writer.done());
+  }
+
+  auto capture = read_gfx_capture(path);
+  fs::remove(path);
+  EXPECT_EQ(capture.header.s7_offset, 0x1234u);
+  EXPECT_EQ(capture.frame_count, 2);
+  ASSERT_EQ(capture.events.size(), 6u);
+
+  std::vector<u32> args;
+  for (auto& event : capture.events) {
+    args.push_back(event.args[0]);
+  }
+  EXPECT_EQ(args, std::vector<u32>({0, 2, 3, 4, 5, 6}));
+
+  EXPECT_EQ(capture.events[2].frame, -1);
+  EXPECT_EQ(capture.events[2].bucket, -1);
+  EXPECT_EQ(capture.events[3].frame, 0);
+  EXPECT_EQ(capture.events[3].bucket, 3);
+  EXPECT_EQ(capture.events[5].frame, 1);
+  EXPECT_EQ(capture.events[5].bucket, 7);
+
+  // the first event has all of memory, and the chain has the chunk that changed.
+  EXPECT_EQ(capture.events[0].chunks.size(), EE_MAIN_MEM_SIZE / capture.header.chunk_size);
+  ASSERT_EQ(capture.events[1].chunks.size(), 1u);
+  EXPECT_EQ(capture.events[1].chunks[0], 0u);
+  EXPECT_TRUE(capture.events[3].chunks.empty());
+
+  std::vector<u8> replayed(EE_MAIN_MEM_SIZE);
+  for (auto& event : capture.events) {
+    event.apply_memory(replayed.data(), capture.header.chunk_size);
+  }
+  EXPECT_EQ(replayed[100], 1);
+}
@@ -0,0 +1,332 @@
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/dma/dma.h"
+#include "common/dma/dma_chain_read.h"
+#include "common/util/crc32.h"
+
+#include "game/graphics/opengl_renderer/BucketRenderer.h"
+#include "game/graphics/opengl_renderer/ocean/OceanMid.h"
+#include "game/graphics/pipelines/null.h"
+#include "game/graphics/texture/TexturePool.h"
+#include "gtest/gtest.h"
+
+#include "third-party/glad/include/glad/glad.h"
+
+/*!
+ * Runs the ocean-mid VU program on a chain built like draw-ocean-mid does, and compares the
+ * vertices and indices it sends to OpenGL against the output of the scalar VU code that the
+ * program was originally written against.
+ */
+
+namespace {
+
+// the vertex and index data given to glBufferData, in order.
+std::vector<std::vector<u8>> g_buffer_uploads;
+
+void APIENTRY capture_buffer_data(GLenum /*target*/,
+                                  GLsizeiptr size,
+                                  const void* data,
+                                  GLenum /*usage*/) {
+  if (data) {
+    g_buffer_uploads.emplace_back((const u8*)data, (const u8*)data + size);
+  }
+}
+
+u32 vif_code(VifCode::Kind kind, u16 imm, u8 num = 0) {
+  return (u32(kind) << 24) | (u32(num) << 16) | imm;
+}
+
+class ChainBuilder {
+ public:
+  void add_cnt(u32 vif0, u32 vif1, const void* data = nullptr, u32 qwc = 0) {
+    u64 tag = (u64(DmaTag::Kind::CNT) << 28) | qwc;
+    append(&tag, 8);
+    append(&vif0, 4);
+    append(&vif1, 4);
+    append(data, qwc * 16);
+  }
+
+  // the direct transfer at the end of the ocean-mid bucket, where OceanMid::run stops.
+  void add_end() {
+    u8 zero[32] = {};
+    add_cnt(vif_code(VifCode::Kind::NOP, 0), vif_code(VifCode::Kind::DIRECT, 2), zero, 2);
+  }
+
+  const std::vector<u8>& data() const { return m_data; }
+
+ private:
+  void append(const void* data, size_t size) {
+    m_data.insert(m_data.end(), (const u8*)data, (const u8*)data + size);
+  }
+  std::vector<u8> m_data;
+};
+
+struct Quad {
+  float f[4];
+};
+
+struct Matrix {
+  float m[4][4];
+};
+
+// row vector times matrix, like vector-matrix*!
+Quad transform(const Matrix& mat, const Quad& v) {
+  Quad result = {};
+  for (int j = 0; j < 4; j++) {
+    for (int i = 0; i < 4; i++) {
+      result.f[j] += v.f[i] * mat.m[i][j];
+    }
+  }
+  return result;
+}
+
+Matrix multiply(const Matrix& a, const Matrix& b) {
+  Matrix result = {};
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      for (int k = 0; k < 4; k++) {
+        result.m[i][j] += a.m[i][k] * b.m[k][j];
+      }
+    }
+  }
+  return result;
+}
+
+// the default NTSC, 4x3 math-camera.
+struct MathCamera {
+  Quad hmge_scale, inv_hmge_scale, hvdf_offset, fog;
+  Matrix perspective = {};
+  Matrix camera_rot = {};
+
+  MathCamera() {
+    const float d = 1024.f, f = 40960000.f;
+    const float x_pix = 256.f, y_pix = 112.f, x_clip = 1024.f, y_clip = 448.f;
+    const float fog_start = 40960.f, fog_end = 819200.f, fog_min = 150.f, fog_max = 255.f;
+    const float min_depth = 100.f, max_depth = 16760631.f;
+    const float x_ratio = 0x1.3feeep-1f;  // tan(32 degrees), for a 64 degree fov
+    const float y_ratio = 0.75f * x_ratio;
+
+    const float fog_slope = d * (fog_min - fog_max) / (fog_end - fog_start);
+    const float depth_half_range = -0.5f * (max_depth - min_depth);
+    const float depth_slope = depth_half_range / (d * (f - d));
+    perspective.m[0][0] = -(x_pix / (x_ratio * d));
+    perspective.m[1][1] = -(y_pix / (y_ratio * d));
+    perspective.m[2][2] = (f + d) * depth_slope;
+    perspective.m[2][3] = fog_slope / d;
+    perspective.m[3][2] = -2.f * depth_slope * f * d;
+
+    hmge_scale = {1.f / x_clip, 1.f / y_clip, 1.f / depth_half_range, 1.f / fog_slope};
+    inv_hmge_scale = {x_clip, y_clip, depth_half_range, fog_slope};
+    const float hvdf_w = (fog_end * fog_max - fog_start * fog_min) / (fog_end - fog_start);
+    hvdf_offset = {2048.f, 2048.f, 0.5f * (max_depth + min_depth), hvdf_w};
+    fog = {fog_slope, fog_min, fog_max, 3072.f};
+  }
+
+  // camera at pos, looking along +z, tilted down by 0.25 radians.
+  void look(const Quad& pos) {
+    const float cos_pitch = 0x1.f0154ap-1f, sin_pitch = 0x1.faaeeep-3f;
+    const Quad axes[3] = {{1.f, 0.f, 0.f, 0.f},
+                          {0.f, -cos_pitch, -sin_pitch, 0.f},
+                          {0.f, -sin_pitch, cos_pitch, 0.f}};
+    camera_rot = {};
+    for (int j = 0; j < 3; j++) {
+      for (int i = 0; i < 3; i++) {
+        camera_rot.m[i][j] = axes[j].f[i];
+        camera_rot.m[3][j] -= pos.f[i] * axes[j].f[i];
+      }
+    }
+    camera_rot.m[3][3] = 1.f;
+  }
+};
+
+constexpr float kCellSize = 393216.f;
+constexpr float kTileSize = 8 * kCellSize;
+
+u64 gif_tag(u32 nloop, bool eop, u32 prim, u32 nreg) {
+  return nloop | (u64(eop) << 15) | (u64(prim != 0) << 46) | (u64(prim) << 47) |
+         (u64(nreg) << 60);
+}
+
+// st, rgbaq, xyzf2
+constexpr u64 kVertexRegs = 0x412;
+// a+d
+constexpr u64 kAdGifRegs = 0xe;
+
+constexpr u32 kTriStrip = 4, kTriFan = 5;
+constexpr u32 kIip = 1 << 3, kTme = 1 << 4, kFge = 1 << 5, kAbe = 1 << 6;
+
+void set_quad(u8* constants, int qw, const Quad& val) {
+  memcpy(constants + 16 * qw, val.f, 16);
+}
+
+void set_u64s(u8* constants, int qw, u64 lo, u64 hi) {
+  memcpy(constants + 16 * qw, &lo, 8);
+  memcpy(constants + 16 * qw + 8, &hi, 8);
+}
+
+void set_adgif(u8* constants, int qw, u32 tbp, bool env) {
+  set_u64s(constants, qw, u64(tbp) | (2ull << 14) | (7ull << 26) | (7ull << 30) | (1ull << 34),
+           0x06);                                                               // tex0
+  set_u64s(constants, qw + 1, (1 << 5) | (5 << 6) | (0xeedull << 32), 0x14);  // tex1, mmag
+  set_u64s(constants, qw + 2, 0, 0x34);                                         // miptbp1
+  set_u64s(constants, qw + 3, 0, 0x08);                                         // clamp
+  set_u64s(constants, qw + 4, env ? 0x44 : 0, env ? 0x42 : 0x36);  // alpha or miptbp2
+}
+
+/*!
+ * The ocean-mid-constants, like ocean-mid-setup-constants makes them.
+ */
+std::vector<u8> make_constants(const MathCamera& cam) {
+  std::vector<u8> constants(0x240);
+  u8* c = constants.data();
+  set_quad(c, 0, cam.hmge_scale);
+  set_quad(c, 1, cam.inv_hmge_scale);
+  set_quad(c, 2, cam.hvdf_offset);
+  set_quad(c, 3, cam.fog);
+  set_quad(c, 4, {0.5f, 0.5f, 0.f, kCellSize});
+  set_quad(c, 5, {0.5f, 0.5f, 1.f, 0.f});
+  set_u64s(c, 6, gif_tag(4, true, kTriFan | kIip | kTme | kFge, 3), kVertexRegs);
+  set_u64s(c, 7, gif_tag(4, true, kTriFan | kIip | kTme | kAbe, 3), kVertexRegs);
+  set_u64s(c, 8, gif_tag(5, false, 0, 1), kAdGifRegs);
+  set_adgif(c, 9, 8160, false);
+  set_u64s(c, 14, gif_tag(18, false, kTriStrip | kIip | kTme | kFge, 3), kVertexRegs);
+  set_u64s(c, 15, gif_tag(18, true, kTriStrip | kIip | kTme | kFge, 3), kVertexRegs);
+  set_u64s(c, 16, gif_tag(5, false, 0, 1), kAdGifRegs);
+  set_adgif(c, 17, 0x2000, true);
+  set_u64s(c, 22, gif_tag(18, true, kTriStrip | kIip | kTme | kAbe, 3), kVertexRegs);
+  set_quad(c, 23, {96.f, 112.f, 128.f, 128.f});
+  const u32 index_table[8][4] = {{63, 84, 66, 0}, {54, 72, 57, 0}, {45, 60, 48, 0},
+                                 {36, 48, 39, 0}, {27, 36, 30, 0}, {18, 24, 21, 0},
+                                 {9, 12, 12, 0},  {0, 0, 3, 0}};
+  memcpy(c + 16 * 24, index_table, sizeof(index_table));
+  set_quad(c, 32, {0.f, 0.f, 0.f, 1.f});
+  set_quad(c, 33, {kCellSize, 0.f, 0.f, 1.f});
+  set_quad(c, 34, {0.f, 0.f, kCellSize, 1.f});
+  set_quad(c, 35, {kCellSize, 0.f, kCellSize, 1.f});
+  return constants;
+}
+
+/*!
+ * The uploads for one tile, like ocean-mid-add-upload, followed by a call to draw it.
+ */
+void add_tile(ChainBuilder& chain,
+              const MathCamera& cam,
+              const Quad& corner,
+              u32 seed,
+              u64 mid_mask,
+              u16 program) {
+  const auto stcycl = vif_code(VifCode::Kind::STCYCL, 0x404);
+
+  // ocean-mid-add-matrices
+  Matrix matrices[2];
+  matrices[0] = cam.camera_rot;
+  auto corner_cam = transform(cam.camera_rot, corner);
+  for (int i = 0; i < 3; i++) {
+    matrices[0].m[3][i] = corner_cam.f[i];
+  }
+  matrices[1] = multiply(matrices[0], cam.perspective);
+  chain.add_cnt(stcycl, vif_code(VifCode::Kind::UNPACK_V4_32, 0x8000, 8), matrices, 8);
+
+  // vertex colors, 9 rows of 9 (with some padding).
+  for (int row = 0; row < 9; row++) {
+    u8 colors[48];
+    for (int i = 0; i < 48; i++) {
+      seed = seed * 1664525 + 1013904223;
+      colors[i] = (i & 3) == 3 ? 0x80 : 0x20 + (seed >> 25);
+    }
+    chain.add_cnt(stcycl, vif_code(VifCode::Kind::UNPACK_V4_8, 0xc000 | (12 * row + 8), 12),
+                  colors, 3);
+  }
+
+  // a set bit skips that cell of the tile.
+  u64 masks[2] = {mid_mask, 0};
+  chain.add_cnt(vif_code(VifCode::Kind::STCYCL, 0x204),
+                vif_code(VifCode::Kind::UNPACK_V4_8, 0xc074, 2), masks, 1);
+
+  chain.add_cnt(stcycl, vif_code(VifCode::Kind::MSCALF, program));
+}
+
+/*!
+ * Draw a 3x3 grid of tiles in front of the camera with the ocean-mid renderer, and return the data
+ * it gave to OpenGL: the vertices, then the indices for the ocean texture and the environment map.
+ * If env_map is set, the closest row is drawn with the environment map, like close tiles are.
+ */
+std::vector<std::vector<u8>> run_ocean_mid(bool env_map) {
+  MathCamera cam;
+  const Quad start = {-2.f * kTileSize, 0.f, -kTileSize, 1.f};
+  cam.look({start.f[0] + 4.5f * kCellSize, 6.f * 4096.f, start.f[2] - kCellSize, 1.f});
+
+  ChainBuilder chain;
+  chain.add_cnt(vif_code(VifCode::Kind::BASE, 0), vif_code(VifCode::Kind::OFFSET, 0x76));
+  auto constants = make_constants(cam);
+  chain.add_cnt(vif_code(VifCode::Kind::STCYCL, 0x404),
+                vif_code(VifCode::Kind::UNPACK_V4_32, 0x2dd, 36), constants.data(), 36);
+  chain.add_cnt(vif_code(VifCode::Kind::STCYCL, 0x404), vif_code(VifCode::Kind::MSCALF, 0));
+
+  u32 seed = 1;
+  for (int z = 0; z < 3; z++) {
+    for (int x = 0; x < 3; x++) {
+      Quad corner = {start.f[0] + (x - 1) * kTileSize, start.f[1], start.f[2] + z * kTileSize, 1.f};
+      // skip some cells, and a whole row, in the middle tile.
+      u64 mask = (x == 1 && z == 1) ? 0x00ff00000000c300 : 0;
+      add_tile(chain, cam, corner, seed++, mask, env_map && z == 0 ? 73 : 46);
+    }
+  }
+  chain.add_cnt(vif_code(VifCode::Kind::MSCALF, 41), vif_code(VifCode::Kind::FLUSHA, 0));
+  chain.add_end();
+
+  g_buffer_uploads.clear();
+  auto saved_buffer_data = glad_glBufferData;
+  EXPECT_TRUE(load_null_gl_functions());
+  glad_glBufferData = capture_buffer_data;
+  {
+    auto pool = std::make_shared<TexturePool>(GameVersion::Jak1);
+    SharedRenderState render_state(pool, nullptr, GameVersion::Jak1);
+    ProfilerNode root("ocean-mid");
+    ScopedProfilerNode prof(&root);
+    OceanMid ocean_mid;
+    DmaFollower dma(chain.data().data(), 0);
+    ocean_mid.run(dma, &render_state, prof);
+  }
+  glad_glBufferData = saved_buffer_data;
+  return std::move(g_buffer_uploads);
+}
+
+u32 crc(const std::vector<u8>& data) {
+  return crc32(data.data(), data.size());
+}
+
+}  // namespace
+
+// The expected CRCs are the output of the scalar VU code, from before the masked VU ops used SSE.
+// To regenerate them, check out game/common/vu.h and ocean/OceanMid_PS2.cpp from the commit before
+// "Use SSE for the masked VU ops and clip in the ocean programs", and print crc(...) from these
+// tests instead of checking it. They were made with the -mavx build, which never fuses a multiply
+// and add. The inputs are exact float constants, so they don't depend on libm.
+
+TEST(OceanRenderer, MidMatchesScalarVu) {
+  auto uploads = run_ocean_mid(false);
+  ASSERT_EQ(uploads.size(), 3u);
+  EXPECT_EQ(uploads[0].size(), 1278u * 32);
+  EXPECT_EQ(crc(uploads[0]), 0xd9378b50u);
+  EXPECT_EQ(crc(uploads[1]), 0x36882eceu);
+  EXPECT_TRUE(uploads[2].empty());
+}
+
+TEST(OceanRenderer, MidEnvMapMatchesScalarVu) {
+  auto uploads = run_ocean_mid(true);
+  ASSERT_EQ(uploads.size(), 3u);
+  // the environment map texture coordinates use the reciprocal square root estimate, which isn't
+  // the same on every CPU. Everything else must match exactly.
+  auto& vertices = uploads[0];
+  ASSERT_EQ(vertices.size(), 2042u * 32);
+  for (size_t i = 0; i < vertices.size(); i += 32) {
+    memset(vertices.data() + i + 16, 0, 12);  // stq
+  }
+  EXPECT_EQ(crc(vertices), 0x0667effbu);
+  EXPECT_EQ(crc(uploads[1]), 0x2613f34au);
+  EXPECT_EQ(crc(uploads[2]), 0x7ff8e82bu);
+}
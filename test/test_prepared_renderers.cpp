@@ -0,0 +1,321 @@
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/dma/dma.h"
+#include "common/dma/dma_chain_read.h"
+#include "common/dma/gs.h"
+
+#include "game/graphics/opengl_renderer/BucketRenderer.h"
+#include "game/graphics/opengl_renderer/foreground/Generic2BucketRenderer.h"
+#include "game/graphics/opengl_renderer/foreground/Merc2BucketRenderer.h"
+#include "game/graphics/pipelines/null.h"
+#include "game/graphics/texture/TexturePool.h"
+#include "gtest/gtest.h"
+
+#include "third-party/glad/include/glad/glad.h"
+
+/*!
+ * Checks that bucket renderers draw the same thing when their buckets are prepared ahead of time
+ * on worker threads as when they are rendered one at a time. The OpenGL calls that send data are
+ * recorded, and must all come from the thread that submits.
+ */
+
+namespace {
+
+std::thread::id g_gl_thread;
+// the data given to OpenGL, in order.
+std::vector<std::vector<u8>> g_gl_log;
+
+void log_gl(u8 kind, const void* data, size_t size) {
+  EXPECT_EQ(std::this_thread::get_id(), g_gl_thread);
+  auto& entry = g_gl_log.emplace_back(1, kind);
+  entry.insert(entry.end(), (const u8*)data, (const u8*)data + size);
+}
+
+void APIENTRY capture_buffer_data(GLenum target, GLsizeiptr size, const void* data, GLenum) {
+  if (data) {
+    log_gl(target == GL_ARRAY_BUFFER ? 0 : 1, data, size);
+  }
+}
+
+void APIENTRY capture_draw_elements(GLenum, GLsizei count, GLenum, const void* indices) {
+  u64 draw[2] = {(u64)count, (u64)indices};
+  log_gl(2, draw, sizeof(draw));
+}
+
+void APIENTRY capture_uniform_4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+  float vals[5] = {(float)location, x, y, z, w};
+  log_gl(3, vals, sizeof(vals));
+}
+
+void APIENTRY capture_uniform_matrix_4fv(GLint, GLsizei count, GLboolean, const GLfloat* value) {
+  log_gl(4, value, count * 16 * sizeof(float));
+}
+
+void start_gl_log() {
+  EXPECT_TRUE(load_null_gl_functions());
+  glad_glBufferData = capture_buffer_data;
+  glad_glDrawElements = capture_draw_elements;
+  glad_glUniform4f = capture_uniform_4f;
+  glad_glUniformMatrix4fv = capture_uniform_matrix_4fv;
+  g_gl_thread = std::this_thread::get_id();
+  g_gl_log.clear();
+}
+
+u32 vif_code(VifCode::Kind kind, u16 imm, u8 num = 0) {
+  return (u32(kind) << 24) | (u32(num) << 16) | imm;
+}
+
+class ChainBuilder {
+ public:
+  void add_cnt(u32 vif0, u32 vif1, const void* data = nullptr, u32 qwc = 0) {
+    u64 tag = (u64(DmaTag::Kind::CNT) << 28) | qwc;
+    append(&tag, 8);
+    append(&vif0, 4);
+    append(&vif1, 4);
+    append(data, qwc * 16);
+  }
+
+  // the start of the next bucket, where the renderer stops.
+  u32 add_next_bucket() {
+    u32 offset = m_data.size();
+    u64 tag = u64(DmaTag::Kind::END) << 28;
+    append(&tag, 8);
+    append(nullptr, 8);
+    return offset;
+  }
+
+  const std::vector<u8>& data() const { return m_data; }
+
+ private:
+  void append(const void* data, size_t size) {
+    if (data) {
+      m_data.insert(m_data.end(), (const u8*)data, (const u8*)data + size);
+    } else {
+      m_data.resize(m_data.size() + size);
+    }
+  }
+  std::vector<u8> m_data;
+};
+
+struct Bucket {
+  ChainBuilder chain;
+  u32 next_bucket = 0;
+};
+
+// the matrix, giftag and extra adgif at the start of each generic fragment.
+constexpr int kFragHeaderSize = 16 * 7;
+
+struct LightningVertex {
+  s32 st[4];
+  u32 rgba[4];
+  float pos[4];
+};
+
+/*!
+ * A lightning bucket, like the generic renderer gets from the lightning code, with a triangle
+ * strip for each texture.
+ */
+Bucket lightning_bucket(const std::vector<u32>& tbps, float z) {
+  Bucket result;
+  auto& chain = result.chain;
+  u8 zero[160] = {};
+  chain.add_cnt(vif_code(VifCode::Kind::MARK, 0), 0);
+  chain.add_cnt(0, vif_code(VifCode::Kind::DIRECT, 2), zero, 2);
+  float constants[32] = {1.f, 0.f, 16777215.f};
+  chain.add_cnt(vif_code(VifCode::Kind::STCYCL, 0x404),
+                vif_code(VifCode::Kind::UNPACK_V4_32, 0, 8), constants, 8);
+  chain.add_cnt(vif_code(VifCode::Kind::MSCALF, 0), vif_code(VifCode::Kind::STMOD, 0));
+  chain.add_cnt(0, 0);
+
+  constexpr int kVerts = 6;
+  for (size_t i = 0; i < tbps.size(); i++) {
+    // header (projection matrix, giftag, extra adgif) then the adgif for this strip.
+    u8 upload[kFragHeaderSize + sizeof(AdGifData)] = {};
+    float proj[16] = {2.f, 0, 0, 0, 0, 2.f, 0, 0, 0, 0, -1.f, -1.f, 0, 0, 3.f, 0};
+    memcpy(upload, proj, sizeof(proj));
+    AdGifData adgif;
+    adgif.tex0_data = tbps[i] | (1ull << 34);  // tcc, modulate
+    adgif.tex0_addr = (u64)GsRegisterAddress::TEX0_1;
+    adgif.tex1_data = 0x60;  // bilinear
+    adgif.tex1_addr = (u64)GsRegisterAddress::TEX1_1 | (u64(kVerts) << 32);
+    adgif.mip_data = 0;
+    adgif.mip_addr = (u64)GsRegisterAddress::MIPTBP1_1;
+    adgif.clamp_data = 0b101;
+    adgif.clamp_addr = (u64)GsRegisterAddress::CLAMP_1;
+    adgif.alpha_data = 0x44;  // src, dst, src, dst
+    adgif.alpha_addr = (u64)GsRegisterAddress::ALPHA_1;
+    memcpy(upload + kFragHeaderSize, &adgif, sizeof(adgif));
+    chain.add_cnt(0, vif_code(VifCode::Kind::UNPACK_V4_32, 837, 12), upload, 12);
+
+    LightningVertex verts[kVerts] = {};
+    for (int v = 0; v < kVerts; v++) {
+      // the first two vertices don't draw a triangle.
+      verts[v].st[0] = (v * 16) | (v < 2 ? 1 : 0);
+      verts[v].st[1] = v * 32;
+      verts[v].rgba[0] = 0x80;
+      verts[v].rgba[1] = 0x40 + v;
+      verts[v].rgba[2] = 0x20 * i;
+      verts[v].rgba[3] = 0x80;
+      verts[v].pos[0] = 100.f * v + i;
+      verts[v].pos[1] = 50.f * (v & 1);
+      verts[v].pos[2] = z;
+      verts[v].pos[3] = 1.f;
+    }
+    chain.add_cnt(0, vif_code(VifCode::Kind::UNPACK_V4_32, 9, 3 * kVerts), verts, 3 * kVerts);
+    chain.add_cnt(0, vif_code(VifCode::Kind::MSCAL, 6));
+  }
+
+  chain.add_cnt(0, 0);
+  chain.add_cnt(vif_code(VifCode::Kind::FLUSHA, 0), vif_code(VifCode::Kind::DIRECT, 10), zero,
+                10);
+  chain.add_cnt(0, 0);
+  result.next_bucket = chain.add_next_bucket();
+  return result;
+}
+
+/*!
+ * A jak 2 merc bucket with only the setup, like when there are no models loaded.
+ */
+Bucket merc_setup_bucket(float fog) {
+  Bucket result;
+  auto& chain = result.chain;
+  chain.add_cnt(0, 0);
+
+  u32 setup[40] = {};
+  setup[0] = vif_code(VifCode::Kind::BASE, 442);
+  setup[1] = vif_code(VifCode::Kind::OFFSET, (u16)-442);
+  setup[2] = vif_code(VifCode::Kind::NOP, 0);
+  setup[3] = vif_code(VifCode::Kind::UNPACK_V4_32, 0, 8);
+  float low_memory[32] = {};
+  for (int i = 0; i < 4; i++) {
+    low_memory[8 + i] = 2048.f + i;        // hvdf offset
+    low_memory[12 + i * 5] = 1.f + i;      // perspective
+    low_memory[28 + i] = fog * (i + 1.f);  // fog
+  }
+  memcpy(setup + 4, low_memory, sizeof(low_memory));
+  setup[36] = vif_code(VifCode::Kind::FLUSHE, 0);
+  setup[39] = vif_code(VifCode::Kind::MSCAL, 0);
+  chain.add_cnt(vif_code(VifCode::Kind::STCYCL, 0x404), vif_code(VifCode::Kind::STMOD, 0), setup,
+                10);
+
+  u8 zero[48] = {};
+  chain.add_cnt(0, vif_code(VifCode::Kind::DIRECT, 3), zero, 3);
+  chain.add_cnt(0, 0);
+  result.next_bucket = chain.add_next_bucket();
+  return result;
+}
+
+/*!
+ * Render the buckets one at a time, with prepare running inside of render. Returns what was sent
+ * to OpenGL.
+ */
+std::vector<std::vector<u8>> render_serial(std::vector<std::unique_ptr<BucketRenderer>>& renderers,
+                                           const std::vector<Bucket>& buckets,
+                                           SharedRenderState* render_state) {
+  ProfilerNode root("serial");
+  ScopedProfilerNode prof(&root);
+  g_gl_log.clear();
+  for (size_t i = 0; i < renderers.size(); i++) {
+    DmaFollower dma(buckets[i].chain.data().data(), 0);
+    render_state->next_bucket = buckets[i].next_bucket;
+    renderers[i]->render(dma, render_state, prof);
+    EXPECT_EQ(dma.current_tag_offset(), buckets[i].next_bucket);
+  }
+  return g_gl_log;
+}
+
+/*!
+ * Prepare all the buckets at the same time on worker threads, then render them. Returns what was
+ * sent to OpenGL.
+ */
+std::vector<std::vector<u8>> render_prepared(
+    std::vector<std::unique_ptr<BucketRenderer>>& renderers,
+    const std::vector<Bucket>& buckets,
+    SharedRenderState* render_state) {
+  g_gl_log.clear();
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < renderers.size(); i++) {
+    EXPECT_TRUE(renderers[i]->can_prepare());
+    workers.emplace_back([&, i]() {
+      DmaFollower dma(buckets[i].chain.data().data(), 0);
+      renderers[i]->prepare(dma, buckets[i].next_bucket, *render_state);
+      EXPECT_EQ(dma.current_tag_offset(), buckets[i].next_bucket);
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  EXPECT_TRUE(g_gl_log.empty());
+
+  ProfilerNode root("prepared");
+  ScopedProfilerNode prof(&root);
+  for (size_t i = 0; i < renderers.size(); i++) {
+    DmaFollower dma(buckets[i].chain.data().data(), 0);
+    render_state->next_bucket = buckets[i].next_bucket;
+    renderers[i]->render(dma, render_state, prof);
+    EXPECT_EQ(dma.current_tag_offset(), buckets[i].next_bucket);
+  }
+  return g_gl_log;
+}
+
+int count_kind(const std::vector<std::vector<u8>>& log, u8 kind) {
+  int result = 0;
+  for (auto& entry : log) {
+    result += entry[0] == kind;
+  }
+  return result;
+}
+}  // namespace
+
+TEST(PreparedRenderers, Generic2PreparedMatchesSerial) {
+  start_gl_log();
+  {
+    auto pool = std::make_shared<TexturePool>(GameVersion::Jak2);
+    SharedRenderState render_state(pool, nullptr, GameVersion::Jak2);
+    auto generic = std::make_shared<Generic2>(render_state.shaders);
+    std::vector<Bucket> buckets = {lightning_bucket({100, 200, 100}, 10.f),
+                                   lightning_bucket({300}, 20.f),
+                                   lightning_bucket({200, 400}, 30.f)};
+    std::vector<std::unique_ptr<BucketRenderer>> renderers;
+    for (size_t i = 0; i < buckets.size(); i++) {
+      renderers.push_back(std::make_unique<Generic2BucketRenderer>(
+          "generic", i, generic, Generic2::Mode::LIGHTNING));
+    }
+
+    auto serial = render_serial(renderers, buckets, &render_state);
+    // a vertex and index upload for each bucket, and a draw for each texture.
+    EXPECT_EQ(count_kind(serial, 0), 3);
+    EXPECT_EQ(count_kind(serial, 1), 3);
+    EXPECT_EQ(count_kind(serial, 2), 5);
+
+    auto prepared = render_prepared(renderers, buckets, &render_state);
+    EXPECT_EQ(serial, prepared);
+  }
+  load_null_gl_functions();
+}
+
+TEST(PreparedRenderers, Merc2PreparedMatchesSerial) {
+  start_gl_log();
+  {
+    auto pool = std::make_shared<TexturePool>(GameVersion::Jak2);
+    SharedRenderState render_state(pool, nullptr, GameVersion::Jak2);
+    auto merc = std::make_shared<Merc2>(render_state.shaders);
+    std::vector<Bucket> buckets = {merc_setup_bucket(1.f), merc_setup_bucket(2.f)};
+    std::vector<std::unique_ptr<BucketRenderer>> renderers;
+    for (size_t i = 0; i < buckets.size(); i++) {
+      renderers.push_back(std::make_unique<Merc2BucketRenderer>("merc", i, merc));
+    }
+
+    auto serial = render_serial(renderers, buckets, &render_state);
+    // the perspective matrix for merc and emerc, for each bucket.
+    EXPECT_EQ(count_kind(serial, 4), 4);
+
+    auto prepared = render_prepared(renderers, buckets, &render_state);
+    EXPECT_EQ(serial, prepared);
+  }
+  load_null_gl_functions();
+}
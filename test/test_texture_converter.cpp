@@ -0,0 +1,72 @@
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/texture/texture_conversion.h"
+
+#include "game/graphics/texture/TextureConverter.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+/*!
+ * Fill all of VRAM with random data. Every byte is a valid pixel in every format, so this covers
+ * all colors and palette indices.
+ */
+void fill_random_vram(TextureConverter* converter, std::mt19937& rng) {
+  constexpr u32 kVramWords = 1024 * 1024;
+  std::vector<u32> data(kVramWords);
+  for (auto& x : data) {
+    x = rng();
+  }
+  converter->upload((const u8*)data.data(), 0, kVramWords);
+}
+
+struct TextureSize {
+  u32 w, h, goal_tex_width;
+};
+
+void check_against_slow(u32 psm, u32 clut_psm) {
+  std::mt19937 rng(1234);
+  TextureConverter converter;
+  fill_random_vram(&converter, rng);
+
+  // includes sizes that aren't a multiple of the page size, and a texture wider than the buffer.
+  const TextureSize sizes[] = {{8, 8, 1},    {64, 32, 1},    {64, 64, 1},  {128, 128, 2},
+                               {256, 64, 4}, {256, 256, 4},  {16, 256, 1}, {200, 100, 4},
+                               {128, 32, 1}, {512, 128, 8}};
+  std::uniform_int_distribution<u32> addr_dist(0, 6000);
+  for (const auto& size : sizes) {
+    u32 vram_addr = addr_dist(rng);
+    u32 clut_addr = addr_dist(rng);
+    u32 bytes = size.w * size.h * 4;
+    std::vector<u8> expected(bytes);
+    std::vector<u8> result(bytes);
+    converter.download_rgba8888_slow(expected.data(), vram_addr, size.goal_tex_width, size.w,
+                                     size.h, psm, clut_psm, clut_addr, bytes);
+    converter.download_rgba8888(result.data(), vram_addr, size.goal_tex_width, size.w, size.h,
+                                psm, clut_psm, clut_addr, bytes);
+    EXPECT_EQ(expected, result) << size.w << "x" << size.h << " width " << size.goal_tex_width;
+  }
+}
+}  // namespace
+
+TEST(TextureConverter, Psmt8Clut32) {
+  check_against_slow(int(PSM::PSMT8), int(CPSM::PSMCT32));
+}
+
+TEST(TextureConverter, Psmt8Clut16) {
+  check_against_slow(int(PSM::PSMT8), int(CPSM::PSMCT16));
+}
+
+TEST(TextureConverter, Psmt4Clut32) {
+  check_against_slow(int(PSM::PSMT4), int(CPSM::PSMCT32));
+}
+
+TEST(TextureConverter, Psmt4Clut16) {
+  check_against_slow(int(PSM::PSMT4), int(CPSM::PSMCT16));
+}
+
+TEST(TextureConverter, Psmct16) {
+  check_against_slow(int(PSM::PSMCT16), 0);
+}
@@ -0,0 +1,105 @@
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/util/os.h"
+
+#include "game/graphics/opengl_renderer/background/background_common.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// not a multiple of 4, and an odd number of groups of 4.
+constexpr int COLOR_COUNT = 1001;
+
+std::vector<tfrag3::TimeOfDayColor> random_colors(std::mt19937& rng) {
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<tfrag3::TimeOfDayColor> result(COLOR_COUNT);
+  for (auto& color : result) {
+    for (auto& palette : color.rgba) {
+      for (int channel = 0; channel < 4; channel++) {
+        palette[channel] = dist(rng);
+      }
+    }
+  }
+  return result;
+}
+
+/*!
+ * Random itimes. The weights for each channel add up to at most 128, like they do in game, so the
+ * integer versions don't saturate before the final clamp.
+ */
+void random_itimes(std::mt19937& rng, math::Vector<s32, 4> itimes[4]) {
+  std::uniform_int_distribution<int> dist(0, 16);
+  for (int i = 0; i < 4; i++) {
+    itimes[i] = math::Vector<s32, 4>::zero();
+  }
+  for (int component = 0; component < 8; component++) {
+    for (int channel = 0; channel < 4; channel++) {
+      u32 weight = dist(rng);
+      int word = (component % 2 * 2) + (channel / 2);
+      int shift = (channel % 2) ? 16 : 0;
+      itimes[component / 2][word] |= weight << shift;
+    }
+  }
+}
+
+using InterpFunc = void (*)(const math::Vector<s32, 4>*,
+                            const SwizzledTimeOfDay&,
+                            math::Vector<u8, 4>*);
+
+void check_against_slow(InterpFunc func) {
+  std::mt19937 rng(1234);
+  auto colors = random_colors(rng);
+  auto swizzled = swizzle_time_of_day(colors);
+  for (int trial = 0; trial < 20; trial++) {
+    math::Vector<s32, 4> itimes[4];
+    random_itimes(rng, itimes);
+    std::vector<math::Vector<u8, 4>> expected(swizzled.color_count);
+    std::vector<math::Vector<u8, 4>> result(swizzled.color_count);
+    interp_time_of_day_slow(itimes, colors, expected.data());
+    func(itimes, swizzled, result.data());
+    for (int i = 0; i < COLOR_COUNT; i++) {
+      ASSERT_EQ(expected[i], result[i]) << "color " << i << " trial " << trial;
+    }
+  }
+}
+}  // namespace
+
+TEST(TimeOfDay, InterpSse) {
+  check_against_slow(interp_time_of_day_sse);
+}
+
+TEST(TimeOfDay, InterpAvx2) {
+  setup_cpu_info();
+  if (!get_cpu_info().has_avx2) {
+    GTEST_SKIP() << "CPU doesn't support AVX2";
+  }
+  check_against_slow(interp_time_of_day_avx2);
+}
+
+TEST(TimeOfDay, InterpAvx512) {
+  setup_cpu_info();
+  if (!get_cpu_info().has_avx512) {
+    GTEST_SKIP() << "CPU doesn't support AVX-512";
+  }
+  check_against_slow(interp_time_of_day_avx512);
+}
+
+TEST(TimeOfDay, InterpFast) {
+  // whichever kernel this CPU picks.
+  setup_cpu_info();
+  check_against_slow(interp_time_of_day_fast);
+}
+
+TEST(TimeOfDay, NeedsUpdate) {
+  std::mt19937 rng(1234);
+  auto swizzled = swizzle_time_of_day(random_colors(rng));
+  math::Vector<s32, 4> itimes[4];
+  random_itimes(rng, itimes);
+  EXPECT_TRUE(time_of_day_needs_update(&swizzled, itimes));
+  EXPECT_FALSE(time_of_day_needs_update(&swizzled, itimes));
+  itimes[3][1] ^= 1;
+  EXPECT_TRUE(time_of_day_needs_update(&swizzled, itimes));
+  EXPECT_FALSE(time_of_day_needs_update(&swizzled, itimes));
+}
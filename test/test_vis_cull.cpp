@@ -0,0 +1,298 @@
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/custom_data/Tfrag3Data.h"
+
+#include "game/graphics/opengl_renderer/background/background_common.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr u16 FIRST_ROOT = 100;
+
+/*!
+ * Add children for node_idx. Children are placed inside of their parent's bsphere, like they are in
+ * the game's trees.
+ */
+void add_children(std::mt19937& rng, tfrag3::BVH* bvh, size_t node_idx, int levels_left) {
+  std::uniform_int_distribution<int> kids_dist(1, 8);
+  std::uniform_real_distribution<float> unit_dist(-1.f, 1.f);
+  std::uniform_real_distribution<float> frac_dist(0.1f, 0.6f);
+
+  auto& parent = bvh->vis_nodes.at(node_idx);
+  parent.num_kids = kids_dist(rng);
+  parent.flags = levels_left > 1 ? 1 : 0;
+  if (!parent.flags) {
+    // children are leaves, which are not in the vis nodes.
+    parent.child_id = 0;
+    return;
+  }
+
+  parent.child_id = FIRST_ROOT + bvh->vis_nodes.size();
+  auto parent_sphere = parent.bsphere;
+  int num_kids = parent.num_kids;
+  size_t first_kid = bvh->vis_nodes.size();
+  for (int i = 0; i < num_kids; i++) {
+    auto& kid = bvh->vis_nodes.emplace_back();
+    kid.my_id = FIRST_ROOT + bvh->vis_nodes.size() - 1;
+    float r = parent_sphere.w() * frac_dist(rng);
+    // a point in a cube with half-width (R - r) / 2 is always inside of a sphere of radius (R - r).
+    float max_offset = (parent_sphere.w() - r) * 0.5f;
+    kid.bsphere = math::Vector4f(parent_sphere.x() + max_offset * unit_dist(rng),
+                                 parent_sphere.y() + max_offset * unit_dist(rng),
+                                 parent_sphere.z() + max_offset * unit_dist(rng), r);
+  }
+  for (int i = 0; i < num_kids; i++) {
+    add_children(rng, bvh, first_kid + i, levels_left - 1);
+  }
+}
+
+tfrag3::BVH random_bvh(std::mt19937& rng, int num_roots, int levels) {
+  std::uniform_real_distribution<float> pos_dist(-400000.f, 400000.f);
+  std::uniform_real_distribution<float> rad_dist(20000.f, 200000.f);
+  tfrag3::BVH bvh;
+  bvh.first_root = FIRST_ROOT;
+  bvh.num_roots = num_roots;
+  for (int i = 0; i < num_roots; i++) {
+    auto& root = bvh.vis_nodes.emplace_back();
+    root.my_id = FIRST_ROOT + i;
+    root.bsphere = math::Vector4f(pos_dist(rng), pos_dist(rng), pos_dist(rng), rad_dist(rng));
+  }
+  for (int i = 0; i < num_roots; i++) {
+    add_children(rng, &bvh, i, levels);
+  }
+  return bvh;
+}
+
+/*!
+ * Four random planes, in the transposed layout used by the renderers.
+ */
+void random_planes(std::mt19937& rng, math::Vector4f planes[4]) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::uniform_real_distribution<float> offset_dist(-300000.f, 100000.f);
+  for (int i = 0; i < 4; i++) {
+    math::Vector3f normal(dist(rng), dist(rng), dist(rng));
+    normal.normalize();
+    planes[0][i] = normal.x();
+    planes[1][i] = normal.y();
+    planes[2][i] = normal.z();
+    planes[3][i] = offset_dist(rng);
+  }
+}
+
+std::vector<u8> random_occlusion_string(std::mt19937& rng, const tfrag3::BVH& bvh) {
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<u8> result((FIRST_ROOT + bvh.vis_nodes.size()) / 8 + 1);
+  for (auto& x : result) {
+    // mostly visible, like in game.
+    x = dist(rng) | dist(rng);
+  }
+  return result;
+}
+
+/*!
+ * Random draws with sorted vis groups, using nodes [0, node_count).
+ */
+std::vector<tfrag3::StripDraw> random_draws(std::mt19937& rng, int node_count, u32* index_count) {
+  std::uniform_int_distribution<int> skip_dist(0, 2);
+  std::uniform_int_distribution<int> size_dist(1, 40);
+  std::uniform_int_distribution<int> proto_dist(0, 7);
+  std::vector<tfrag3::StripDraw> draws(10);
+  u32 first_idx = 0;
+  for (auto& draw : draws) {
+    draw.unpacked.idx_of_first_idx_in_full_buffer = first_idx;
+    for (int node = 0; node < node_count; node += skip_dist(rng) + 1) {
+      auto& grp = draw.vis_groups.emplace_back();
+      grp.vis_idx_in_pc_bvh = node;
+      grp.num_inds = size_dist(rng);
+      grp.num_tris = grp.num_inds / 2;
+      grp.tie_proto_idx = proto_dist(rng);
+    }
+    if (skip_dist(rng)) {
+      auto& grp = draw.vis_groups.emplace_back();
+      grp.vis_idx_in_pc_bvh = UINT16_MAX;
+      grp.num_inds = size_dist(rng);
+      grp.tie_proto_idx = proto_dist(rng);
+    }
+    draw.compute_vis_group_starts();
+    first_idx += draw.vis_group_starts.back().first_ind;
+  }
+  *index_count = first_idx;
+  return draws;
+}
+
+/*!
+ * Visibility in blocks, like the output of culling a real tree.
+ */
+std::vector<u8> random_block_vis(std::mt19937& rng, int node_count) {
+  std::uniform_int_distribution<int> block_dist(1, 60);
+  std::uniform_int_distribution<int> vis_dist(0, 1);
+  std::vector<u8> result;
+  while ((int)result.size() < node_count) {
+    u8 vis = vis_dist(rng);
+    for (int i = block_dist(rng); i > 0 && (int)result.size() < node_count; i--) {
+      result.push_back(vis);
+    }
+  }
+  return result;
+}
+
+void check_against_slow(const tfrag3::BVH& bvh, std::mt19937& rng, int* visible_count) {
+  auto culling = make_culling_tree(bvh);
+  auto occlusion = random_occlusion_string(rng, bvh);
+  for (int trial = 0; trial < 50; trial++) {
+    math::Vector4f planes[4];
+    random_planes(rng, planes);
+    for (const u8* occlusion_string : {(const u8*)nullptr, (const u8*)occlusion.data()}) {
+      std::vector<u8> expected(bvh.vis_nodes.size());
+      std::vector<u8> result(bvh.vis_nodes.size(), 0xcd);
+      cull_check_all_slow(planes, bvh.vis_nodes, occlusion_string, expected.data());
+      cull_check_all_fast(planes, culling, occlusion_string, result.data());
+      for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i], result[i]) << "node " << i << " trial " << trial;
+        *visible_count += result[i];
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(VisCull, RootsOnly) {
+  std::mt19937 rng(1234);
+  // no children, so the spheres don't have to be nested.
+  auto bvh = random_bvh(rng, 37, 1);
+  int visible = 0;
+  check_against_slow(bvh, rng, &visible);
+  EXPECT_GT(visible, 0);
+}
+
+TEST(VisCull, Tree) {
+  std::mt19937 rng(1234);
+  auto bvh = random_bvh(rng, 13, 4);
+  int visible = 0;
+  check_against_slow(bvh, rng, &visible);
+  EXPECT_GT(visible, 0);
+}
+
+TEST(VisCull, OnlyChildren) {
+  tfrag3::BVH bvh;
+  bvh.first_root = FIRST_ROOT;
+  bvh.num_roots = 12;
+  bvh.only_children = true;
+  auto culling = make_culling_tree(bvh);
+  EXPECT_EQ(culling.num_roots, 0);
+  math::Vector4f planes[4];
+  for (auto& plane : planes) {
+    plane = math::Vector4f::zero();
+  }
+  u8 out = 0xcd;
+  cull_check_all_fast(planes, culling, nullptr, &out);
+  EXPECT_EQ(out, 0xcd);
+}
+
+TEST(VisCull, FindVisRuns) {
+  std::vector<u8> vis = {1, 1, 0, 0, 1, 0, 1, 1, 1};
+  VisRuns runs;
+  find_vis_runs(vis.data(), vis.size(), &runs);
+  std::vector<std::pair<u32, u32>> expected = {
+      {0, 2}, {4, 5}, {6, 9}, {UINT16_MAX, UINT16_MAX + 1}};
+  EXPECT_EQ(runs.runs, expected);
+}
+
+TEST(VisCull, SortByVisGroup) {
+  tfrag3::StripDraw draw;
+  for (u16 vis : {5, UINT16_MAX, 2, 5, 2}) {
+    auto& grp = draw.vis_groups.emplace_back();
+    grp.vis_idx_in_pc_bvh = vis;
+    grp.num_inds = 3;
+    grp.num_tris = 1;
+    draw.runs.push_back({(u32)draw.runs.size(), 2});
+  }
+  draw.sort_by_vis_group();
+  draw.compute_vis_group_starts();
+  std::vector<u32> expected_runs = {2, 4, 0, 3, 1};
+  for (size_t i = 0; i < expected_runs.size(); i++) {
+    EXPECT_EQ(draw.runs[i].vertex0, expected_runs[i]);
+  }
+  EXPECT_EQ(draw.vis_groups.front().vis_idx_in_pc_bvh, 2);
+  EXPECT_EQ(draw.vis_groups.back().vis_idx_in_pc_bvh, UINT16_MAX);
+  ASSERT_EQ(draw.vis_group_starts.size(), 6u);
+  EXPECT_EQ(draw.vis_group_starts.back().first_ind, 15u);
+  EXPECT_EQ(draw.vis_group_starts.back().first_tri, 5u);
+}
+
+/*!
+ * The draws built from the vis runs must be the same as checking every group.
+ */
+TEST(VisCull, DrawsFromVisRuns) {
+  std::mt19937 rng(1234);
+  constexpr int kNodeCount = 600;
+  std::uniform_int_distribution<int> proto_vis_dist(0, 3);
+  for (int trial = 0; trial < 20; trial++) {
+    u32 index_count = 0;
+    auto sorted_draws = random_draws(rng, kNodeCount, &index_count);
+    auto unsorted_draws = sorted_draws;
+    for (auto& draw : unsorted_draws) {
+      draw.vis_group_starts.clear();
+    }
+    auto vis = random_block_vis(rng, kNodeCount);
+    VisRuns runs;
+    find_vis_runs(vis.data(), vis.size(), &runs);
+    std::vector<u8> proto_vis(8);
+    for (auto& x : proto_vis) {
+      x = proto_vis_dist(rng) != 0;
+    }
+    std::vector<u32> idx_in(index_count);
+    std::iota(idx_in.begin(), idx_in.end(), 0);
+
+    for (bool use_proto : {false, true}) {
+      // multidraw
+      std::vector<std::pair<int, int>> expected_ptrs(sorted_draws.size()),
+          ptrs(sorted_draws.size());
+      std::vector<GLsizei> expected_counts(index_count), counts(index_count);
+      std::vector<void*> expected_offsets(index_count), offsets(index_count);
+      u32 expected_tris, tris;
+      if (use_proto) {
+        expected_tris = make_multidraws_from_vis_and_proto_string(
+            expected_ptrs.data(), expected_counts.data(), expected_offsets.data(), unsorted_draws,
+            vis, runs, proto_vis);
+        tris = make_multidraws_from_vis_and_proto_string(ptrs.data(), counts.data(),
+                                                         offsets.data(), sorted_draws, vis, runs,
+                                                         proto_vis);
+      } else {
+        expected_tris =
+            make_multidraws_from_vis_string(expected_ptrs.data(), expected_counts.data(),
+                                            expected_offsets.data(), unsorted_draws, vis, runs);
+        tris = make_multidraws_from_vis_string(ptrs.data(), counts.data(), offsets.data(),
+                                               sorted_draws, vis, runs);
+      }
+      EXPECT_EQ(expected_tris, tris);
+      EXPECT_EQ(expected_ptrs, ptrs);
+      EXPECT_EQ(expected_counts, counts);
+      EXPECT_EQ(expected_offsets, offsets);
+
+      // index list
+      std::vector<u32> expected_idx(index_count), idx(index_count);
+      u32 expected_size, size;
+      if (use_proto) {
+        expected_size = make_index_list_from_vis_and_proto_string(
+            expected_ptrs.data(), expected_idx.data(), unsorted_draws, vis, runs, proto_vis,
+            idx_in.data(), &expected_tris);
+        size = make_index_list_from_vis_and_proto_string(
+            ptrs.data(), idx.data(), sorted_draws, vis, runs, proto_vis, idx_in.data(), &tris);
+      } else {
+        expected_size = make_index_list_from_vis_string(expected_ptrs.data(), expected_idx.data(),
+                                                        unsorted_draws, vis, runs, idx_in.data(),
+                                                        &expected_tris);
+        size = make_index_list_from_vis_string(ptrs.data(), idx.data(), sorted_draws, vis, runs,
+                                               idx_in.data(), &tris);
+      }
+      EXPECT_EQ(expected_size, size);
+      EXPECT_EQ(expected_tris, tris);
+      EXPECT_EQ(expected_ptrs, ptrs);
+      EXPECT_EQ(expected_idx, idx);
+    }
+  }
+}
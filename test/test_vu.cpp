@@ -0,0 +1,248 @@
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+
+#include "common/common_types.h"
+
+#include "game/common/vu.h"
+#include "gtest/gtest.h"
+
+/*!
+ * The masked VU operations are done with SSE on all four lanes, then blended. These compare them
+ * against the scalar version (only computing the selected lanes), which is what the ocean and
+ * shadow VU programs were written against.
+ */
+
+namespace {
+
+float random_float(std::mt19937& rng) {
+  static const float kSpecial[] = {0.f,
+                                   -0.f,
+                                   1.f,
+                                   -1.f,
+                                   std::numeric_limits<float>::infinity(),
+                                   -std::numeric_limits<float>::infinity(),
+                                   std::numeric_limits<float>::quiet_NaN(),
+                                   std::numeric_limits<float>::denorm_min(),
+                                   std::numeric_limits<float>::max(),
+                                   -std::numeric_limits<float>::max()};
+  std::uniform_int_distribution<int> special_dist(0, 15);
+  int idx = special_dist(rng);
+  if (idx < (int)(sizeof(kSpecial) / sizeof(kSpecial[0]))) {
+    return kSpecial[idx];
+  }
+  std::uniform_real_distribution<float> dist(-10000.f, 10000.f);
+  return dist(rng);
+}
+
+Vf random_vf(std::mt19937& rng) {
+  return Vf(random_float(rng), random_float(rng), random_float(rng), random_float(rng));
+}
+
+// for conversions to integers, which are only defined for values in range.
+Vf random_vf_in_range(std::mt19937& rng, float range) {
+  std::uniform_real_distribution<float> dist(-range, range);
+  return Vf(dist(rng), dist(rng), dist(rng), dist(rng));
+}
+
+Vf random_vf_int(std::mt19937& rng) {
+  std::uniform_int_distribution<s32> dist(std::numeric_limits<s32>::min(),
+                                          std::numeric_limits<s32>::max());
+  Vf result;
+  result.set_u32s(dist(rng), dist(rng), dist(rng), dist(rng));
+  return result;
+}
+
+// the same bits, or both NaN. The payload of a NaN depends on the order of the operands, which the
+// compiler is free to swap in the scalar version.
+bool same_value(const float* a, const float* b) {
+  for (int i = 0; i < 4; i++) {
+    if (std::isnan(a[i]) && std::isnan(b[i])) {
+      continue;
+    }
+    if (memcmp(&a[i], &b[i], 4)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Vf masked_ref(Mask mask, Vf dest, const std::function<float(int)>& f) {
+  for (int i = 0; i < 4; i++) {
+    if ((u64)mask & (1 << i)) {
+      dest[i] = f(i);
+    }
+  }
+  return dest;
+}
+
+Vf masked_ref_int(Mask mask, Vf dest, const std::function<s32(int)>& f) {
+  for (int i = 0; i < 4; i++) {
+    if ((u64)mask & (1 << i)) {
+      s32 val = f(i);
+      memcpy(&dest[i], &val, 4);
+    }
+  }
+  return dest;
+}
+
+s32 as_s32(float f) {
+  s32 result;
+  memcpy(&result, &f, 4);
+  return result;
+}
+
+u32 clip_ref(const Vf& vector, float val, u32 old_clip) {
+  u32 result = (old_clip << 6);
+  float plus = std::abs(val);
+  float minus = -plus;
+  for (int i = 0; i < 3; i++) {
+    if (vector[i] > plus) {
+      result |= 1 << (2 * i);
+    }
+    if (vector[i] < minus) {
+      result |= 2 << (2 * i);
+    }
+  }
+  return result & 0xffffff;
+}
+
+constexpr int kIterations = 2000;
+
+}  // namespace
+
+TEST(VuSimd, VfMaskedOps) {
+  std::mt19937 rng(12);
+  for (int iter = 0; iter < kIterations; iter++) {
+    for (int m = 0; m < 16; m++) {
+      Mask mask = (Mask)m;
+      Vf a = random_vf(rng);
+      Vf b = random_vf(rng);
+      Vf dest = random_vf(rng);
+      float s = random_float(rng);
+
+      auto check = [&](const char* name, const std::function<void(Vf&)>& op, const Vf& expected) {
+        Vf result = dest;
+        op(result);
+        EXPECT_TRUE(same_value(result.data, expected.data))
+            << name << " mask " << m << ": " << result.print() << " vs " << expected.print();
+      };
+
+      check("move", [&](Vf& v) { v.move(mask, a); }, masked_ref(mask, dest, [&](int i) {
+              return a[i];
+            }));
+      check("mfp", [&](Vf& v) { v.mfp(mask, s); }, masked_ref(mask, dest, [&](int) { return s; }));
+      check("add", [&](Vf& v) { v.add(mask, a, b); }, masked_ref(mask, dest, [&](int i) {
+              return a[i] + b[i];
+            }));
+      check("add bc", [&](Vf& v) { v.add(mask, a, s); }, masked_ref(mask, dest, [&](int i) {
+              return a[i] + s;
+            }));
+      check("sub", [&](Vf& v) { v.sub(mask, a, b); }, masked_ref(mask, dest, [&](int i) {
+              return a[i] - b[i];
+            }));
+      check("sub bc", [&](Vf& v) { v.sub(mask, a, s); }, masked_ref(mask, dest, [&](int i) {
+              return a[i] - s;
+            }));
+      check("mul", [&](Vf& v) { v.mul(mask, a, b); }, masked_ref(mask, dest, [&](int i) {
+              return a[i] * b[i];
+            }));
+      check("mul bc", [&](Vf& v) { v.mul(mask, a, s); }, masked_ref(mask, dest, [&](int i) {
+              return a[i] * s;
+            }));
+
+      // the destination is often also a source.
+      check("mul self", [&](Vf& v) { v.mul(mask, v, v.w()); }, masked_ref(mask, dest, [&](int i) {
+              return dest[i] * dest.w();
+            }));
+
+      Vf ints = random_vf_int(rng);
+      check("itof0", [&](Vf& v) { v.itof0(mask, ints); }, masked_ref(mask, dest, [&](int i) {
+              return (float)as_s32(ints[i]);
+            }));
+      check("itof12", [&](Vf& v) { v.itof12(mask, ints); }, masked_ref(mask, dest, [&](int i) {
+              return ((float)as_s32(ints[i])) * (1.f / 4096.f);
+            }));
+      check("itof15", [&](Vf& v) { v.itof15(mask, ints); }, masked_ref(mask, dest, [&](int i) {
+              return ((float)as_s32(ints[i])) * (1.f / 32768.f);
+            }));
+
+      Vf floats = random_vf_in_range(rng, 100000.f);
+      check("ftoi0", [&](Vf& v) { v.ftoi0(mask, floats); },
+            masked_ref_int(mask, dest, [&](int i) { return (s32)floats[i]; }));
+      check("ftoi4", [&](Vf& v) { v.ftoi4(mask, floats); },
+            masked_ref_int(mask, dest, [&](int i) { return (s32)(floats[i] * 16.f); }));
+      check("ftoi12", [&](Vf& v) { v.ftoi12(mask, floats); },
+            masked_ref_int(mask, dest, [&](int i) { return (s32)(floats[i] * 4096.f); }));
+    }
+  }
+}
+
+TEST(VuSimd, AccumulatorMaskedOps) {
+  std::mt19937 rng(34);
+  for (int iter = 0; iter < kIterations; iter++) {
+    for (int m = 0; m < 16; m++) {
+      Mask mask = (Mask)m;
+      Vf a = random_vf(rng);
+      Vf b = random_vf(rng);
+      Vf dest = random_vf(rng);
+      Vf acc_start = random_vf(rng);
+      float s = random_float(rng);
+      Accumulator acc;
+      memcpy(acc.data, acc_start.data, 16);
+
+      auto check_acc = [&](const char* name, const std::function<void(Accumulator&)>& op,
+                           const Vf& expected) {
+        Accumulator result = acc;
+        op(result);
+        EXPECT_TRUE(same_value(result.data, expected.data)) << name << " mask " << m;
+      };
+
+      auto check_dest = [&](const char* name, const std::function<void(Vf&)>& op,
+                            const Vf& expected) {
+        Vf result = dest;
+        op(result);
+        EXPECT_TRUE(same_value(result.data, expected.data)) << name << " mask " << m;
+      };
+
+      check_acc("adda", [&](Accumulator& r) { r.adda(mask, a, s); },
+                masked_ref(mask, acc_start, [&](int i) { return a[i] + s; }));
+      check_acc("madda", [&](Accumulator& r) { r.madda(mask, a, b); },
+                masked_ref(mask, acc_start, [&](int i) { return acc_start[i] + a[i] * b[i]; }));
+      check_acc("madda bc", [&](Accumulator& r) { r.madda(mask, a, s); },
+                masked_ref(mask, acc_start, [&](int i) { return acc_start[i] + a[i] * s; }));
+      check_acc("msuba", [&](Accumulator& r) { r.msuba(mask, a, s); },
+                masked_ref(mask, acc_start, [&](int i) { return acc_start[i] - a[i] * s; }));
+      check_acc("mula", [&](Accumulator& r) { r.mula(mask, a, b); },
+                masked_ref(mask, acc_start, [&](int i) { return a[i] * b[i]; }));
+      check_acc("mula bc", [&](Accumulator& r) { r.mula(mask, a, s); },
+                masked_ref(mask, acc_start, [&](int i) { return a[i] * s; }));
+
+      check_dest("madd", [&](Vf& v) { acc.madd(mask, v, a, b); },
+                 masked_ref(mask, dest, [&](int i) { return acc_start[i] + a[i] * b[i]; }));
+      check_dest("madd bc", [&](Vf& v) { acc.madd(mask, v, a, s); },
+                 masked_ref(mask, dest, [&](int i) { return acc_start[i] + a[i] * s; }));
+      check_dest("msub", [&](Vf& v) { acc.msub(mask, v, a, s); },
+                 masked_ref(mask, dest, [&](int i) { return acc_start[i] - a[i] * s; }));
+    }
+  }
+}
+
+TEST(VuSimd, Clip) {
+  std::mt19937 rng(56);
+  std::uniform_int_distribution<u32> flag_dist(0, 0xffffff);
+  for (int iter = 0; iter < kIterations * 16; iter++) {
+    Vf v = random_vf(rng);
+    float w = random_float(rng);
+    // values right on the boundary are not clipped.
+    if (iter % 8 == 0) {
+      v.x() = std::abs(w);
+      v.y() = -std::abs(w);
+    }
+    u32 old_clip = flag_dist(rng);
+    EXPECT_EQ(vu_clip(v, w, old_clip), clip_ref(v, w, old_clip))
+        << v.print() << " w " << w << " old " << old_clip;
+  }
+}
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -56,4 +58,51 @@ TEST(ZSTD, CommonLibrary) {
   }
 
   EXPECT_TRUE(compressed.size() < 0.5 * all.size());
-}
\ No newline at end of file
+}
+
+TEST(ZSTD, StreamingSettings) {
+  std::string all;
+  for (auto& x : all_syms) {
+    all.append(x);
+    all.append("\n");
+  }
+
+  compression::ZstdSettings single_thread;
+  for (const auto& settings :
+       {single_thread, compression::ZstdSettings::fast(), compression::ZstdSettings::release()}) {
+    // add in uneven pieces
+    compression::ZstdCompressor compressor(settings);
+    size_t offset = 0;
+    size_t piece = 1;
+    while (offset < all.size()) {
+      size_t len = std::min(piece, all.size() - offset);
+      compressor.add(all.data() + offset, len);
+      offset += len;
+      piece = piece * 3 + 7;
+    }
+    auto compressed = compressor.finish();
+    auto decompressed = compression::decompress_zstd(compressed.data(), compressed.size());
+    ASSERT_EQ(decompressed.size(), all.size());
+    EXPECT_EQ(0, memcmp(decompressed.data(), all.data(), all.size()));
+    EXPECT_TRUE(compressed.size() < 0.5 * all.size());
+  }
+}
+
+TEST(ZSTD, StreamingReuse) {
+  compression::ZstdCompressor compressor(compression::ZstdSettings::fast());
+  for (size_t i = 0; i < 3; i++) {
+    std::string data;
+    for (size_t j = 0; j < 1000 + 100 * i; j++) {
+      data.push_back('a' + (j * (i + 3)) % 26);
+    }
+    compressor.add(data.data(), data.size());
+    auto compressed = compressor.finish();
+    auto decompressed = compression::decompress_zstd(compressed.data(), compressed.size());
+    ASSERT_EQ(decompressed.size(), data.size());
+    EXPECT_EQ(0, memcmp(decompressed.data(), data.data(), data.size()));
+  }
+
+  // nothing added since the last finish
+  auto empty = compressor.finish();
+  EXPECT_TRUE(compression::decompress_zstd(empty.data(), empty.size()).empty());
+}
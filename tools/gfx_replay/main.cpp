@@ -0,0 +1,224 @@
+/*!
+ * Replay a graphics capture recorded with the runtime's --gfx-capture option, and print the time
+ * spent per frame and per bucket. Frames are sent as fast as possible, with the frame limiter and
+ * vsync disabled, so the results only depend on the capture and the renderer.
+ */
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+#include "common/util/unicode_util.h"
+
+#include "game/graphics/display.h"
+#include "game/graphics/gfx.h"
+#include "game/graphics/gfx_capture.h"
+#include "game/kernel/common/kscheme.h"
+#include "game/runtime.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+
+namespace {
+
+struct BucketStats {
+  double total_ms = 0;
+  float max_ms = 0;
+};
+
+struct ReplayStats {
+  std::vector<double> frame_ms;
+  std::vector<BucketStats> buckets;
+};
+
+/*!
+ * Send a frame to the renderer, and wait for it to be finished.
+ */
+void replay_frame(const GfxRendererModule* renderer, u32 chain_offset, ReplayStats* stats) {
+  Timer timer;
+  renderer->send_chain(g_ee_main_mem, chain_offset);
+  auto display = Display::GetMainDisplay();
+  if (display) {
+    display->render();
+  } else {
+    renderer->vsync();
+  }
+  if (!stats) {
+    return;
+  }
+  stats->frame_ms.push_back(timer.getMs());
+  auto bucket_times = renderer->bucket_times_ms();
+  if (stats->buckets.size() < bucket_times.size()) {
+    stats->buckets.resize(bucket_times.size());
+  }
+  for (size_t i = 0; i < bucket_times.size(); i++) {
+    stats->buckets[i].total_ms += bucket_times[i];
+    stats->buckets[i].max_ms = std::max(stats->buckets[i].max_ms, bucket_times[i]);
+  }
+}
+
+void replay(const GfxCapture& capture, const GfxRendererModule* renderer, ReplayStats* stats) {
+  // uploads from the VIF interrupt handler are done when the renderer gets to the same bucket.
+  std::vector<std::vector<const GfxCaptureEvent*>> chain_uploads(capture.frame_count);
+  for (const auto& event : capture.events) {
+    if (event.bucket >= 0) {
+      chain_uploads.at(event.frame).push_back(&event);
+    }
+  }
+  int frame = 0;
+  Gfx::register_vif_interrupt_replay_callback([&](int bucket_id) {
+    for (const auto* event : chain_uploads.at(frame)) {
+      if (event->bucket == bucket_id) {
+        renderer->texture_upload_now(g_ee_main_mem + event->args[0], event->args[1],
+                                     event->args[2]);
+      }
+    }
+  });
+
+  for (const auto& event : capture.events) {
+    if (event.bucket >= 0) {
+      continue;
+    }
+    event.apply_memory(g_ee_main_mem, capture.header.chunk_size);
+    switch (event.kind) {
+      case GfxCaptureEvent::Kind::SEND_CHAIN:
+        replay_frame(renderer, event.args[0], stats);
+        frame++;
+        break;
+      case GfxCaptureEvent::Kind::TEXTURE_UPLOAD_NOW:
+        renderer->texture_upload_now(g_ee_main_mem + event.args[0], event.args[1],
+                                     event.args[2]);
+        break;
+      case GfxCaptureEvent::Kind::TEXTURE_RELOCATE:
+        renderer->texture_relocate(event.args[0], event.args[1], event.args[2]);
+        break;
+      case GfxCaptureEvent::Kind::SET_LEVELS:
+        renderer->set_levels(event.levels);
+        break;
+      case GfxCaptureEvent::Kind::SET_PREFETCH_LEVELS:
+        renderer->set_prefetch_levels(event.levels);
+        break;
+      default:
+        ASSERT_NOT_REACHED();
+    }
+  }
+  Gfx::clear_vif_interrupt_replay_callback();
+}
+
+void print_stats(const ReplayStats& stats, bool per_frame) {
+  if (stats.frame_ms.empty()) {
+    lg::print("No frames replayed.\n");
+    return;
+  }
+  int frames = stats.frame_ms.size();
+  if (per_frame) {
+    for (int i = 0; i < frames; i++) {
+      lg::print("frame {:5d}: {:8.3f} ms\n", i, stats.frame_ms[i]);
+    }
+  }
+
+  double total = 0;
+  for (auto ms : stats.frame_ms) {
+    total += ms;
+  }
+  auto sorted = stats.frame_ms;
+  std::sort(sorted.begin(), sorted.end());
+  lg::print("{} frames: avg {:.3f} ms, min {:.3f}, median {:.3f}, p99 {:.3f}, max {:.3f}\n", frames,
+            total / frames, sorted.front(), sorted[frames / 2], sorted[frames * 99 / 100],
+            sorted.back());
+
+  std::vector<int> order;
+  double bucket_total = 0;
+  for (size_t i = 0; i < stats.buckets.size(); i++) {
+    bucket_total += stats.buckets[i].total_ms;
+    if (stats.buckets[i].total_ms > 0) {
+      order.push_back(i);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return stats.buckets[a].total_ms > stats.buckets[b].total_ms;
+  });
+  lg::print("buckets: {:.3f} ms/frame\n", bucket_total / frames);
+  for (int idx : order) {
+    const auto& bucket = stats.buckets[idx];
+    lg::print("  bucket {:3d}: avg {:8.3f} ms, max {:8.3f} ms, {:5.1f}%\n", idx,
+              bucket.total_ms / frames, bucket.max_ms, 100. * bucket.total_ms / bucket_total);
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  ArgumentGuard u8_guard(argc, argv);
+
+  fs::path capture_path;
+  std::string renderer_name = "null";
+  int loops = 3;
+  int warmup_loops = 1;
+  bool per_frame = false;
+  fs::path project_path_override;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL Graphics Replay"};
+  app.add_option("capture", capture_path, "Capture file from the runtime's --gfx-capture option")
+      ->required();
+  app.add_option("-r,--renderer", renderer_name, "Renderer to use: 'null' or 'opengl'");
+  app.add_option("-l,--loops", loops, "Number of times to replay the capture");
+  app.add_option("-w,--warmup", warmup_loops, "Number of loops to leave out of the statistics");
+  app.add_flag("--per-frame", per_frame, "Print the time of each frame");
+  app.add_option("--proj-path", project_path_override,
+                 "Specify the location of the 'data/' folder");
+  app.validate_positionals();
+  CLI11_PARSE(app, argc, argv);
+
+  GfxPipeline pipeline;
+  if (renderer_name == "null") {
+    pipeline = GfxPipeline::Null;
+  } else if (renderer_name == "opengl") {
+    pipeline = GfxPipeline::OpenGL;
+  } else {
+    lg::error("Unknown renderer {}", renderer_name);
+    return 1;
+  }
+
+  // both renderers load levels and shaders from the project.
+  if (!file_util::setup_project_path(
+          project_path_override.empty() ? std::nullopt
+                                        : std::optional<fs::path>(project_path_override))) {
+    lg::error("couldn't setup project path, exiting");
+    return 1;
+  }
+
+  auto capture = read_gfx_capture(capture_path);
+  lg::info("Loaded {} frames ({} events) from {}", capture.frame_count, capture.events.size(),
+           capture_path.string());
+
+  // the renderers read game memory, so set up a copy of it and the globals that point to it.
+  std::vector<u8> memory(capture.header.memory_size);
+  g_ee_main_mem = memory.data();
+  s7 = Ptr<u32>(capture.header.s7_offset);
+  g_game_version = (GameVersion)capture.header.game_version;
+  g_main_thread_id = std::this_thread::get_id();
+
+  if (Gfx::Init(g_game_version, pipeline)) {
+    return 1;
+  }
+  Gfx::g_global_settings.framelimiter = false;
+  Gfx::g_global_settings.vsync = false;
+  const auto* renderer = Gfx::GetCurrentRenderer();
+
+  ReplayStats stats;
+  for (int loop = 0; loop < loops; loop++) {
+    replay(capture, renderer, loop < warmup_loops ? nullptr : &stats);
+  }
+  print_stats(stats, per_frame);
+
+  Gfx::Exit();
+  g_ee_main_mem = nullptr;
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*!
+ * Compare zstd settings on extracted .fr3 level files.
+ * For each level, reports compression time, compression ratio, and the time to decompress, which
+ * is what the Loader has to do before it can use the level. Each setting is tried on both the
+ * single-frame (v1) and the chunked (v2) layout.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "common/custom_data/Fr3File.h"
+#include "common/util/Assert.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+#include "common/util/compress.h"
+#include "common/util/unicode_util.h"
+
+#include "third-party/fmt/core.h"
+
+namespace {
+struct Preset {
+  std::string name;
+  compression::ZstdSettings settings;
+};
+
+struct Result {
+  double compress_ms = 0;
+  double decompress_ms = 0;
+  size_t compressed_size = 0;
+};
+
+Result run_preset(const std::vector<u8>& data, const compression::ZstdSettings& settings) {
+  Result result;
+  Timer compress_timer;
+  auto compressed = compression::compress_zstd(data.data(), data.size(), settings);
+  result.compress_ms = compress_timer.getMs();
+  result.compressed_size = compressed.size();
+
+  Timer decompress_timer;
+  auto decompressed = compression::decompress_zstd(compressed.data(), compressed.size());
+  result.decompress_ms = decompress_timer.getMs();
+  ASSERT(decompressed == data);
+  return result;
+}
+
+Result run_preset_chunked(const tfrag3::Level& level, const compression::ZstdSettings& settings) {
+  Result result;
+  Timer compress_timer;
+  auto compressed = tfrag3::write_fr3_chunked(level, settings);
+  result.compress_ms = compress_timer.getMs();
+  result.compressed_size = compressed.size();
+
+  // this is done on a single thread, the Loader can do sections in parallel.
+  Timer decompress_timer;
+  tfrag3::Level loaded;
+  tfrag3::Fr3Reader(compressed.data(), compressed.size()).read_all(&loaded);
+  result.decompress_ms = decompress_timer.getMs();
+  return result;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  ArgumentGuard u8_guard(argc, argv);
+
+  if (argc < 2) {
+    fmt::print("usage: fr3_compression_bench <fr3 folder or files...>\n");
+    return 1;
+  }
+
+  std::vector<fs::path> files;
+  for (int i = 1; i < argc; i++) {
+    fs::path path = argv[i];
+    if (fs::is_directory(path)) {
+      for (auto& entry : fs::directory_iterator(path)) {
+        if (entry.path().extension() == ".fr3") {
+          files.push_back(entry.path());
+        }
+      }
+    } else {
+      files.push_back(path);
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  compression::ZstdSettings single_thread;
+  std::vector<Preset> presets = {{"level 1, 1 thread", single_thread},
+                                 {"fast", compression::ZstdSettings::fast()},
+                                 {"release", compression::ZstdSettings::release()}};
+  std::vector<std::string> row_names;
+  for (auto& preset : presets) {
+    row_names.push_back(preset.name);
+    row_names.push_back(preset.name + " (v2)");
+  }
+
+  fmt::print("{:>12} {:>20} {:>10} {:>12} {:>8} {:>14}\n", "level", "settings", "size (kB)",
+             "compress ms", "ratio", "decompress ms");
+  std::vector<Result> totals(row_names.size());
+  size_t total_size = 0;
+  for (auto& file : files) {
+    // accept either layout, and compare both.
+    auto file_data = file_util::read_binary_file(file);
+    tfrag3::Level level;
+    tfrag3::Fr3Reader(file_data.data(), file_data.size()).read_all(&level);
+    Serializer ser;
+    level.serialize(ser);
+    auto [ser_data, ser_size] = ser.get_save_result();
+    std::vector<u8> data(ser_data, ser_data + ser_size);
+    total_size += data.size();
+
+    for (size_t i = 0; i < row_names.size(); i++) {
+      auto& settings = presets[i / 2].settings;
+      auto result = (i % 2) ? run_preset_chunked(level, settings) : run_preset(data, settings);
+      fmt::print("{:>12} {:>20} {:>10} {:>12.1f} {:>7.2f}% {:>14.1f}\n", file.stem().string(),
+                 row_names[i], data.size() / 1024, result.compress_ms,
+                 100. * result.compressed_size / data.size(), result.decompress_ms);
+      totals[i].compress_ms += result.compress_ms;
+      totals[i].decompress_ms += result.decompress_ms;
+      totals[i].compressed_size += result.compressed_size;
+    }
+  }
+
+  if (total_size) {
+    for (size_t i = 0; i < row_names.size(); i++) {
+      fmt::print("{:>12} {:>20} {:>10} {:>12.1f} {:>7.2f}% {:>14.1f}\n", "total", row_names[i],
+                 total_size / 1024, totals[i].compress_ms,
+                 100. * totals[i].compressed_size / total_size, totals[i].decompress_ms);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*!
+ * Benchmark the time of day color interpolation kernels used by the background renderers.
+ * Each kernel runs on the same random colors and reports the time per color.
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/util/Timer.h"
+#include "common/util/os.h"
+
+#include "game/graphics/opengl_renderer/background/background_common.h"
+
+#include "third-party/fmt/core.h"
+
+namespace {
+// about the size of a big tfrag tree.
+constexpr int COLOR_COUNT = 8192;
+constexpr int ITERATIONS = 2000;
+
+using InterpFunc = void (*)(const math::Vector<s32, 4>*,
+                            const SwizzledTimeOfDay&,
+                            math::Vector<u8, 4>*);
+
+struct Kernel {
+  std::string name;
+  InterpFunc func;
+  bool supported;
+};
+
+void run_kernel(const Kernel& kernel,
+                const math::Vector<s32, 4> itimes[4],
+                const SwizzledTimeOfDay& colors,
+                std::vector<math::Vector<u8, 4>>* out) {
+  if (!kernel.supported) {
+    fmt::print("{:>8}: not supported\n", kernel.name);
+    return;
+  }
+  // warm up
+  kernel.func(itimes, colors, out->data());
+  Timer timer;
+  for (int i = 0; i < ITERATIONS; i++) {
+    kernel.func(itimes, colors, out->data());
+  }
+  double ns_per_color = timer.getNs() / double(ITERATIONS * COLOR_COUNT);
+  fmt::print("{:>8}: {:6.3f} ns/color, {:7.1f} us per tree\n", kernel.name, ns_per_color,
+             ns_per_color * COLOR_COUNT / 1000.);
+}
+}  // namespace
+
+int main(int, char**) {
+  setup_cpu_info();
+
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> color_dist(0, 255);
+  std::vector<tfrag3::TimeOfDayColor> colors(COLOR_COUNT);
+  for (auto& color : colors) {
+    for (auto& palette : color.rgba) {
+      for (int channel = 0; channel < 4; channel++) {
+        palette[channel] = color_dist(rng);
+      }
+    }
+  }
+  auto swizzled = swizzle_time_of_day(colors);
+  std::vector<math::Vector<u8, 4>> out(swizzled.color_count);
+
+  // two palettes blended, like the game does between times of day.
+  math::Vector<s32, 4> itimes[4];
+  for (auto& itime : itimes) {
+    itime = math::Vector<s32, 4>::zero();
+  }
+  itimes[0] = math::Vector<s32, 4>(0x00200020, 0x00200020, 0x00200020, 0x00200020);
+
+  std::vector<Kernel> kernels = {
+      {"sse", interp_time_of_day_sse, true},
+      {"avx2", interp_time_of_day_avx2, get_cpu_info().has_avx2},
+      {"avx512", interp_time_of_day_avx512, get_cpu_info().has_avx512}};
+
+  {
+    // the slow version takes different input, so time it separately.
+    interp_time_of_day_slow(itimes, colors, out.data());
+    Timer timer;
+    for (int i = 0; i < ITERATIONS; i++) {
+      interp_time_of_day_slow(itimes, colors, out.data());
+    }
+    double ns_per_color = timer.getNs() / double(ITERATIONS * COLOR_COUNT);
+    fmt::print("{:>8}: {:6.3f} ns/color, {:7.1f} us per tree\n", "slow", ns_per_color,
+               ns_per_color * COLOR_COUNT / 1000.);
+  }
+  for (auto& kernel : kernels) {
+    run_kernel(kernel, itimes, swizzled, &out);
+  }
+
+  // and the cost when the cache says there's nothing to do.
+  Timer cache_timer;
+  int updates = 0;
+  for (int i = 0; i < ITERATIONS; i++) {
+    updates += time_of_day_needs_update(&swizzled, itimes);
+  }
+  fmt::print("{:>8}: {:6.3f} ns per tree ({} updates)\n", "cached",
+             cache_timer.getNs() / double(ITERATIONS), updates);
+  return 0;
+}
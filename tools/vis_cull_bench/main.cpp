@@ -0,0 +1,111 @@
+/*!
+ * Benchmark the frustum culling used by the background renderers on a large random BVH, and check
+ * that the fast version gives the same result as the slow version.
+ */
+
+#include <random>
+#include <vector>
+
+#include "common/custom_data/Tfrag3Data.h"
+#include "common/util/Timer.h"
+
+#include "game/graphics/opengl_renderer/background/background_common.h"
+
+#include "third-party/fmt/core.h"
+
+namespace {
+constexpr int NUM_ROOTS = 16;
+constexpr int LEVELS = 5;
+constexpr int ITERATIONS = 2000;
+
+/*!
+ * Add children inside of the parent's bsphere, like the game's trees.
+ */
+void add_children(std::mt19937& rng, tfrag3::BVH* bvh, size_t node_idx, int levels_left) {
+  std::uniform_int_distribution<int> kids_dist(4, 8);
+  std::uniform_real_distribution<float> unit_dist(-1.f, 1.f);
+
+  auto& parent = bvh->vis_nodes.at(node_idx);
+  parent.num_kids = kids_dist(rng);
+  parent.flags = levels_left > 1 ? 1 : 0;
+  if (!parent.flags) {
+    parent.child_id = 0;
+    return;
+  }
+
+  parent.child_id = bvh->first_root + bvh->vis_nodes.size();
+  auto parent_sphere = parent.bsphere;
+  int num_kids = parent.num_kids;
+  size_t first_kid = bvh->vis_nodes.size();
+  for (int i = 0; i < num_kids; i++) {
+    auto& kid = bvh->vis_nodes.emplace_back();
+    kid.my_id = bvh->first_root + bvh->vis_nodes.size() - 1;
+    float r = parent_sphere.w() * 0.4f;
+    float max_offset = (parent_sphere.w() - r) * 0.5f;
+    kid.bsphere = math::Vector4f(parent_sphere.x() + max_offset * unit_dist(rng),
+                                 parent_sphere.y() + max_offset * unit_dist(rng),
+                                 parent_sphere.z() + max_offset * unit_dist(rng), r);
+  }
+  for (int i = 0; i < num_kids; i++) {
+    add_children(rng, bvh, first_kid + i, levels_left - 1);
+  }
+}
+}  // namespace
+
+int main(int, char**) {
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> pos_dist(-2000000.f, 2000000.f);
+  tfrag3::BVH bvh;
+  bvh.num_roots = NUM_ROOTS;
+  for (int i = 0; i < NUM_ROOTS; i++) {
+    auto& root = bvh.vis_nodes.emplace_back();
+    root.my_id = i;
+    root.bsphere = math::Vector4f(pos_dist(rng), pos_dist(rng), pos_dist(rng), 400000.f);
+  }
+  for (int i = 0; i < NUM_ROOTS; i++) {
+    add_children(rng, &bvh, i, LEVELS);
+  }
+  auto culling = make_culling_tree(bvh);
+  std::vector<u8> occlusion(bvh.vis_nodes.size() / 8 + 1, 0xff);
+
+  // a 90 degree view looking down +z from the origin.
+  math::Vector4f planes[4];
+  const float s = 0.70710678f;
+  math::Vector3f normals[4] = {math::Vector3f(s, 0, s), math::Vector3f(-s, 0, s),
+                               math::Vector3f(0, s, s), math::Vector3f(0, -s, s)};
+  for (int i = 0; i < 4; i++) {
+    planes[0][i] = normals[i].x();
+    planes[1][i] = normals[i].y();
+    planes[2][i] = normals[i].z();
+    planes[3][i] = 0;
+  }
+
+  std::vector<u8> slow_out(bvh.vis_nodes.size());
+  std::vector<u8> fast_out(bvh.vis_nodes.size());
+  for (const u8* occlusion_string : {(const u8*)nullptr, (const u8*)occlusion.data()}) {
+    Timer slow_timer;
+    for (int i = 0; i < ITERATIONS; i++) {
+      cull_check_all_slow(planes, bvh.vis_nodes, occlusion_string, slow_out.data());
+    }
+    double slow_us = slow_timer.getUs() / ITERATIONS;
+
+    Timer fast_timer;
+    for (int i = 0; i < ITERATIONS; i++) {
+      cull_check_all_fast(planes, culling, occlusion_string, fast_out.data());
+    }
+    double fast_us = fast_timer.getUs() / ITERATIONS;
+
+    int visible = 0;
+    for (auto x : fast_out) {
+      visible += x;
+    }
+    fmt::print("{} nodes, {} visible, {} occlusion string\n", bvh.vis_nodes.size(), visible,
+               occlusion_string ? "with" : "without");
+    fmt::print("  slow: {:8.2f} us\n  fast: {:8.2f} us\n", slow_us, fast_us);
+    if (slow_out != fast_out) {
+      fmt::print("  results don't match!\n");
+      return 1;
+    }
+  }
+  return 0;
+}
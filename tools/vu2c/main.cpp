@@ -0,0 +1,73 @@
+// Converts a VU program to a C++ header that runs it on the CPU. The input is VU microcode in the
+// format of the files in test/decompiler/vu_reference. See decompiler/VuDisasm/Vu2C.h.
+
+#include <stdexcept>
+
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/unicode_util.h"
+
+#include "decompiler/VuDisasm/Vu2C.h"
+#include "decompiler/util/DataParser.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+
+int main(int argc, char** argv) {
+  ArgumentGuard u8_guard(argc, argv);
+
+  fs::path input_path;
+  fs::path output_path;
+  bool vu0 = false;
+  bool no_live_regs = false;
+  decompiler::Vu2CSettings settings;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL VU to C++ Converter"};
+  app.add_option("input", input_path, "VU microcode, as 32-bit words")->required();
+  app.add_option("-o,--output", output_path, "Where to write the header, defaults to stdout");
+  app.add_flag("--vu0", vu0, "The program is for VU0 (4 KB of data memory), defaults to VU1");
+  app.add_option("-n,--name", settings.function_name, "Name of the generated function");
+  app.add_option("-e,--entry", settings.entry_points,
+                 "Instructions the program is started from (the mscal address / 8), defaults to 0");
+  app.add_flag("--no-live-regs", no_live_regs,
+               "Don't write vf registers and the accumulator back to the VuState at the end");
+  app.add_option("--max-unroll", settings.max_unroll,
+                 "Loops with more iterations than this are not unrolled");
+  app.validate_positionals();
+  CLI11_PARSE(app, argc, argv);
+
+  settings.registers_live_on_exit = !no_live_regs;
+  settings.source = input_path.filename().string();
+
+  std::vector<u32> data;
+  for (auto& word : decompiler::parse_data(file_util::read_text_file(input_path)).words) {
+    if (word.kind() != decompiler::LinkedWord::Kind::PLAIN_DATA) {
+      lg::error("{} has a word that isn't plain data", input_path.string());
+      return 1;
+    }
+    data.push_back(word.data);
+  }
+
+  decompiler::VuDisassembler disasm(vu0 ? decompiler::VuDisassembler::VuKind::VU0
+                                        : decompiler::VuDisassembler::VuKind::VU1);
+  auto prog = disasm.disassemble(data.data(), data.size() * 4, false);
+
+  std::string result;
+  try {
+    result = decompiler::vu_program_to_cpp(prog, disasm, settings);
+  } catch (const std::exception& e) {
+    lg::error("{}", e.what());
+    return 1;
+  }
+
+  if (output_path.empty()) {
+    fmt::print("{}", result);
+  } else {
+    // write_text_file adds the final newline.
+    result.pop_back();
+    file_util::write_text_file(output_path, result);
+  }
+  return 0;
+}